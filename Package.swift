@@ -70,5 +70,10 @@ let package = Package(
             dependencies: ["TikTokBusinessSDKCore", "TikTokBusinessSDK"],
             path: "TikTokBusinessSDKTests/IAP"
         ),
+        .testTarget(
+            name: "TikTokBusinessSDKTestsCrash",
+            dependencies: ["TikTokBusinessSDKCore"],
+            path: "TikTokBusinessSDKTests/Crash"
+        ),
     ]
 )
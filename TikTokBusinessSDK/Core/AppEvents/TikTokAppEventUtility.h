@@ -20,6 +20,7 @@ typedef NS_ENUM(NSUInteger, TikTokAppEventsFlushReason)
     TikTokAppEventsFlushReasonAppBecameActive,
     TikTokAppEventsFlushReasonExplicitlyFlush,
     TikTokAppEventsFlushReasonLogout,
+    TikTokAppEventsFlushReasonReconnect,
 };
 
 @interface TikTokAppEventUtility : NSObject
@@ -0,0 +1 @@
+../../TikTokPipelineMetrics.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../TikTokStartupTrace.h
\ No newline at end of file
@@ -8,6 +8,8 @@
 
 #import <Foundation/Foundation.h>
 #import "TikTokDatabase.h"
+#import "TikTokLaneScheduler.h"
+#import "TikTokConfig.h"
 
 static const TTDBOrderBy TTDBOrderByNone = {0, 0};
 static const TTDBLimit TTDBLimitNone = {0, 0};
@@ -20,16 +22,37 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (NSString *)tableName;
 
+/**
+ * @brief Switch the store events are kept in. Unsent events are moved to the new store,
+ *        including those a journal kept from an earlier launch. SQLite is used until this is called.
+ */
+- (void)useStorageBackend:(TikTokEventStorageBackend)backend;
+
 - (BOOL)persistEvents:(NSArray *)events;
 
 - (NSArray *)retrievePersistedEvents;
 
+/// Unsent events of one lane, marked as sending
+- (NSArray *)retrievePersistedEventsInLane:(TikTokEventLane)lane;
+
+/// The oldest unsent events of one lane, at most limit of them, marked as sending
+- (NSArray *)retrievePersistedEventsInLane:(TikTokEventLane)lane limit:(NSUInteger)limit;
+
 - (NSInteger)eventsCount;
 
+- (NSInteger)eventsCountInLane:(TikTokEventLane)lane;
+
+/// Events a lane may hold before new ones are rejected
++ (NSInteger)maxEventCountInLane:(TikTokEventLane)lane;
+
 - (BOOL)clearEvents;
 
+/// Remove sent events, or mark them as unsent again and count a retry if the server failed them
 - (BOOL)handleSentResult:(BOOL)success events:(NSArray *)events;
 
+/// Mark events whose request never reached the server as unsent again, without counting a retry
+- (BOOL)handleUnsentEvents:(NSArray *)events;
+
 @end
 
 @interface TikTokAppEventPersistence : TikTokBaseEventPersistence
@@ -12,12 +12,17 @@
 #import "TikTokAppEvent.h"
 #import "TikTokBUsinessSDKMacros.h"
 #import "TikTokTypeUtility.h"
+#import "TikTokSQLiteEventStore.h"
+#import "TikTokJournalEventStore.h"
 
 #define TT_DB_LIMIT 500
+#define TT_DB_REVENUE_LIMIT 500
+#define TT_JOURNAL_SEGMENT_SIZE (256 * 1024)
 
 @interface TikTokBaseEventPersistence ()
 
 @property (nonatomic, strong) TikTokDatabase *db;
+@property (atomic, strong) id<TikTokEventStore> store;
 
 @end
 
@@ -34,15 +39,7 @@
 }
 
 + (NSDictionary *)tableFields {
-    NSDictionary<NSString *, NSString *> *fields = @{
-        @"id": @"INTEGER PRIMARY KEY AUTOINCREMENT",
-        @"event_data": @"BLOB",
-        @"ts": @"TEXT",
-        @"retry_times": @"INTEGER",
-        @"sending": @"INTEGER",
-        @"is_edp_event": @"INTEGER"
-    };
-    return fields;
+    return [TikTokSQLiteEventStore tableFields];
 }
 
 + (NSString *)tableName {
@@ -62,117 +59,162 @@
         } else {
             [TikTokErrorHandler handleErrorWithOrigin:NSStringFromClass([self class]) message:@"Failed to open database"];
         }
+        self.store = [[TikTokSQLiteEventStore alloc] initWithDatabase:self.db tableName:[[self class] tableName]];
     }
     return self;
 }
 
++ (NSString *)journalDirectory {
+    NSString *documentsDirectory = [NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES) firstObject];
+    return [[documentsDirectory stringByAppendingPathComponent:@"TikTokEventJournal"] stringByAppendingPathComponent:[self tableName]];
+}
+
+- (void)useStorageBackend:(TikTokEventStorageBackend)backend {
+    id<TikTokEventStore> currentStore = self.store;
+    NSString *journalDirectory = [[self class] journalDirectory];
+    if (backend != TikTokEventStorageBackendJournal) {
+        if ([currentStore isKindOfClass:[TikTokSQLiteEventStore class]]
+            && [[NSFileManager defaultManager] fileExistsAtPath:journalDirectory]) {
+            // events left in the journal when it was last used
+            TikTokJournalEventStore *journal = [[TikTokJournalEventStore alloc] initWithDirectory:journalDirectory segmentSize:TT_JOURNAL_SEGMENT_SIZE];
+            if (journal && [self moveUnsentEventsFromStore:journal toStore:currentStore]) {
+                journal = nil;
+                [[NSFileManager defaultManager] removeItemAtPath:journalDirectory error:nil];
+            }
+        }
+        return;
+    }
+    if ([currentStore isKindOfClass:[TikTokJournalEventStore class]]) {
+        return;
+    }
+    TikTokJournalEventStore *journal = [[TikTokJournalEventStore alloc] initWithDirectory:journalDirectory segmentSize:TT_JOURNAL_SEGMENT_SIZE];
+    if (journal == nil) {
+        [TikTokErrorHandler handleErrorWithOrigin:NSStringFromClass([self class]) message:@"Failed to open event journal"];
+        return;
+    }
+    [self moveUnsentEventsFromStore:currentStore toStore:journal];
+    self.store = journal;
+}
+
+/// Returns NO if some events could not be moved and were left in the source store.
+- (BOOL)moveUnsentEventsFromStore:(id<TikTokEventStore>)source toStore:(id<TikTokEventStore>)destination {
+    NSArray<TikTokStoredEvent *> *events = [source takeUnsentEventsInLane:TikTokEventStoreAnyLane limit:0];
+    NSMutableArray<NSString *> *movedIDs = [NSMutableArray array];
+    NSMutableArray<NSString *> *failedIDs = [NSMutableArray array];
+    for (TikTokStoredEvent *event in events) {
+        [([destination appendEvent:event] ? movedIDs : failedIDs) addObject:event.identifier];
+    }
+    [source removeEventsWithIdentifiers:movedIDs];
+    [source releaseEventsWithIdentifiers:failedIDs countingRetry:NO];
+    return failedIDs.count == 0;
+}
+
++ (NSInteger)maxEventCountInLane:(TikTokEventLane)lane {
+    return lane == TikTokEventLaneRevenue ? TT_DB_REVENUE_LIMIT : TT_DB_LIMIT;
+}
+
 - (BOOL)persistEvents:(NSArray *)events {
-    if ([self.db openDatabase]) {
-        if ([self eventsCount] > TT_DB_LIMIT) {
-            return NO;
+    BOOL result = YES;
+    id<TikTokEventStore> store = self.store;
+    // each lane has its own budget, so a standard backlog can't keep revenue events out
+    NSMutableDictionary<NSNumber *, NSNumber *> *laneCounts = [NSMutableDictionary dictionary];
+    for (int i = 0; i < events.count; i++) {
+        if (![[events objectAtIndex:i] isKindOfClass:[TikTokAppEvent class]]) {
+            continue;
         }
-        for (int i = 0; i < events.count; i++) {
-            if (![[events objectAtIndex:i] isKindOfClass:[TikTokAppEvent class]]) {
-                continue;
-            }
-            TikTokAppEvent *event = [events objectAtIndex:i];
-            
-            NSError *errorArchiving;
-            NSData *eventData = [NSKeyedArchiver archivedDataWithRootObject:event requiringSecureCoding:YES error:&errorArchiving];
-            if (errorArchiving) {
-                NSLog(@"Failed to serialize event to data: %@", errorArchiving.localizedDescription);
-                NSAssert(NO, @"Failed to serialize event to data: %@", errorArchiving.localizedDescription);
-                [self.db closeDatabase];
-                return NO;
-            }
-            if (![self.db insertIntoTable:[[self class] tableName] fields:@{
-                @"event_data":eventData,
-                @"ts": TTSafeString(event.timestamp),
-                @"retry_times": @(event.retryTimes),
-                @"sending": @(0),
-                @"is_edp_event": @(event.isEDPEvent)
-            }]) {
-                [self.db closeDatabase];
-                return NO;
-            }
+        TikTokAppEvent *event = [events objectAtIndex:i];
+        TikTokEventLane lane = TikTokEventLaneForEvent(event);
+        NSNumber *laneCount = laneCounts[@(lane)] ?: @([store eventCountInLane:lane]);
+        if (laneCount.integerValue > [[self class] maxEventCountInLane:lane]) {
+            result = NO;
+            continue;
         }
         
+        NSError *errorArchiving;
+        NSData *eventData = [NSKeyedArchiver archivedDataWithRootObject:event requiringSecureCoding:YES error:&errorArchiving];
+        if (errorArchiving) {
+            NSLog(@"Failed to serialize event to data: %@", errorArchiving.localizedDescription);
+            NSAssert(NO, @"Failed to serialize event to data: %@", errorArchiving.localizedDescription);
+            return NO;
+        }
+        TikTokStoredEvent *storedEvent = [[TikTokStoredEvent alloc] init];
+        storedEvent.data = eventData;
+        storedEvent.timestamp = TTSafeString(event.timestamp);
+        storedEvent.retryTimes = event.retryTimes;
+        storedEvent.lane = lane;
+        storedEvent.isEDPEvent = event.isEDPEvent;
+        if (![store appendEvent:storedEvent]) {
+            return NO;
+        }
+        laneCounts[@(lane)] = @(laneCount.integerValue + 1);
     }
-    return YES;
+    return result;
 }
 
 - (NSArray *)retrievePersistedEvents {
+    return [self retrievePersistedEventsInStoreLane:TikTokEventStoreAnyLane limit:0];
+}
+
+- (NSArray *)retrievePersistedEventsInLane:(TikTokEventLane)lane {
+    return [self retrievePersistedEventsInStoreLane:lane limit:0];
+}
+
+- (NSArray *)retrievePersistedEventsInLane:(TikTokEventLane)lane limit:(NSUInteger)limit {
+    return [self retrievePersistedEventsInStoreLane:lane limit:limit];
+}
+
+- (NSArray *)retrievePersistedEventsInStoreLane:(NSInteger)lane limit:(NSUInteger)limit {
     NSMutableArray *allEvents = [NSMutableArray array];
-    if ([self.db openDatabase]) {
-        NSString *whereCondition = @"sending = 0";
-        NSArray *res = [self.db queryTable:[[self class] tableName] withWhere:whereCondition orderBy:TTDBOrderByNone limit:TTDBLimitNone];
-        NSMutableArray *dbIDs = [NSMutableArray array];
-        for (NSDictionary *row in res) {
-            if (!TTCheckValidDictionary(row)) {
-                continue;
-            }
-            NSData *eventData = [row objectForKey:@"event_data"];
-            NSInteger eID = [[row objectForKey:@"id"] integerValue];
-            NSInteger retry_times = [[row objectForKey:@"retry_times"] integerValue];
-            NSError *error;
-            id obj = [NSKeyedUnarchiver unarchivedObjectOfClass:[TikTokAppEvent class] fromData:eventData error:&error];
-            TikTokAppEvent *event = nil;
-            if ([obj isKindOfClass:[TikTokAppEvent class]]) {
-                event = (TikTokAppEvent *)obj;
-                event.dbID = [NSString stringWithFormat:@"%ld",(long)eID];
-                event.retryTimes = retry_times;
-                
-                [dbIDs addObject:TTSafeString(event.dbID)];
-            }
-            if (!error && event) {
-                [allEvents addObject:event];
-            }
-        }
-        if (dbIDs.count > 0) {
-            NSString *dbIDList = [dbIDs componentsJoinedByString:@", "];
-            NSString *sendingWhereCondition = [NSString stringWithFormat:@"id IN (%@)",dbIDList];
-            
-            [self.db updateTable:[[self class] tableName] setField:@"sending" value:@(1) withWhere:sendingWhereCondition];
+    for (TikTokStoredEvent *storedEvent in [self.store takeUnsentEventsInLane:lane limit:limit]) {
+        NSError *error;
+        id obj = [NSKeyedUnarchiver unarchivedObjectOfClass:[TikTokAppEvent class] fromData:storedEvent.data error:&error];
+        if (!error && [obj isKindOfClass:[TikTokAppEvent class]]) {
+            TikTokAppEvent *event = (TikTokAppEvent *)obj;
+            event.dbID = storedEvent.identifier;
+            event.retryTimes = storedEvent.retryTimes;
+            [allEvents addObject:event];
         }
     }
     return allEvents.copy;
 }
 
 - (NSInteger)eventsCount {
-    return [self.db getCount:[[self class] tableName]];
+    return [self.store eventCountInLane:TikTokEventStoreAnyLane];
+}
+
+- (NSInteger)eventsCountInLane:(TikTokEventLane)lane {
+    return [self.store eventCountInLane:lane];
 }
 
 - (BOOL)clearEvents{
-    if ([self.db openDatabase]) {
-        if (![self.db deleteTable:[[self class] tableName] withWhere:nil orderBy:TTDBOrderByNone limit:TTDBLimitNone]) {
-            [self.db closeDatabase];
-            return NO;
+    return [self.store removeAllEvents];
+}
+
+- (NSArray<NSString *> *)identifiersOfEvents:(NSArray *)events {
+    NSMutableArray *dbIDs = [NSMutableArray array];
+    for(id obj in events) {
+        if ([obj isKindOfClass:[TikTokAppEvent class]]) {
+            TikTokAppEvent *event = (TikTokAppEvent *)obj;
+            [dbIDs addObject:TTSafeString(event.dbID)];
         }
     }
-    return YES;
+    return dbIDs;
 }
 
 - (BOOL)handleSentResult:(BOOL)success events:(NSArray *)events {
-    if ([self.db openDatabase]) {
-        NSMutableArray *dbIDs = [NSMutableArray array];
-        for(id obj in events) {
-            if ([obj isKindOfClass:[TikTokAppEvent class]]) {
-                TikTokAppEvent *event = (TikTokAppEvent *)obj;
-                [dbIDs addObject:TTSafeString(event.dbID)];
-            }
-        }
-        NSString *dbIDList = [dbIDs componentsJoinedByString:@", "];
-        NSString *whereCondition = [NSString stringWithFormat:@"id IN (%@)",dbIDList];
-        if (success) {
-            [self.db deleteTable:[[self class] tableName] withWhere:whereCondition orderBy:TTDBOrderByNone limit:TTDBLimitNone];
-        } else {
-            [self.db updateTable:[[self class] tableName] setField:@"sending" value:@(0) withWhere:whereCondition];
-            [self.db updateTable:[[self class] tableName] setField:@"retry_times" value:@"retry_times + 1" withWhere:whereCondition];
-        }
+    NSArray<NSString *> *dbIDs = [self identifiersOfEvents:events];
+    if (success) {
+        [self.store removeEventsWithIdentifiers:dbIDs];
+    } else {
+        [self.store releaseEventsWithIdentifiers:dbIDs countingRetry:YES];
     }
     return YES;
 }
 
+- (BOOL)handleUnsentEvents:(NSArray *)events {
+    return [self.store releaseEventsWithIdentifiers:[self identifiersOfEvents:events] countingRetry:NO];
+}
+
 @end
 
 
@@ -202,14 +244,7 @@
 }
 
 - (BOOL)clearEDPEvents {
-    NSString *edpCondition = @"is_edp_event = 1";
-    if ([self.db openDatabase]) {
-        if (![self.db deleteTable:[[self class] tableName] withWhere:edpCondition orderBy:TTDBOrderByNone limit:TTDBLimitNone]) {
-            [self.db closeDatabase];
-            return NO;
-        }
-    }
-    return YES;
+    return [self.store removeEDPEvents];
 }
 
 @end
@@ -54,6 +54,8 @@ static inline TTDBLimit TTDBLimitMake(int offset, int count) {
 
 - (NSInteger)getCount:(NSString *)tableName;
 
+- (NSInteger)getCount:(NSString *)tableName withWhere:(nullable NSString *)where;
+
 
 @end
 
@@ -336,13 +336,17 @@ static NSString *TTDBDefaultTableName = @"TikTokBusiness.default.sqlite";
 }
 
 - (NSInteger)getCount:(NSString *)tableName {
+    return [self getCount:tableName withWhere:nil];
+}
+
+- (NSInteger)getCount:(NSString *)tableName withWhere:(NSString *)where {
     pthread_mutex_lock(&_databaseMutex);
     if (![self openDatabase]) {
         pthread_mutex_unlock(&_databaseMutex);
         return 0;
     }
     
-    NSString *countQuery = [NSString stringWithFormat:@"SELECT COUNT(*) FROM %@", tableName];
+    NSString *countQuery = [NSString stringWithFormat:@"SELECT COUNT(*) FROM %@%@", tableName, [self _whereString:where]];
     sqlite3_stmt *statement;
     NSInteger rowCount = 0;
     
@@ -0,0 +1,77 @@
+//
+//  TikTokEventDeduplicator.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class TikTokAppEvent;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief Remembers the keys of recently tracked events in a pair of Bloom filters mapped
+ *        from a small file, so duplicates can be dropped without a database lookup.
+ *
+ *        Keys are kept for between half a window and a full window: one filter takes new
+ *        keys while the other holds the previous half window, and they swap when the half
+ *        window ends or the filter is full. A key can be reported as seen when it was not,
+ *        at roughly the false-positive rate; a seen key is never missed within half a window.
+ */
+@interface TikTokEventDeduplicator : NSObject
+
+/**
+ * @brief Key identifying an event across duplicate calls: the event name with the
+ *        app-supplied event ID or, failing that, the StoreKit order ID. Nil if the event
+ *        has neither, in which case it is never treated as a duplicate.
+ */
++ (nullable NSString *)deduplicationKeyForEvent:(TikTokAppEvent *)event;
+
+/**
+ * @brief Open or create the filter file. Falls back to memory if the file can't be mapped.
+ *
+ * @param path File backing the filters. A file written with other parameters is reset.
+ * @param window Seconds a key is remembered for
+ * @param falsePositiveRate Target false-positive rate, between 0 and 1
+ * @param capacity Keys each filter holds before it is rotated early
+ */
+- (nullable instancetype)initWithPath:(NSString *)path
+                               window:(NSTimeInterval)window
+                    falsePositiveRate:(double)falsePositiveRate
+                             capacity:(NSUInteger)capacity;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Size of the filters in bytes
+@property (nonatomic, assign, readonly) NSUInteger byteCount;
+
+/**
+ * @brief YES if the key was probably seen within the window. Otherwise remembers it
+ *        and returns NO. Safe to call from any thread.
+ */
+- (BOOL)checkAndInsertKey:(NSString *)key;
+
+/**
+ * @brief Same as checkAndInsertKey:, at the given time since 1970. For testing.
+ */
+- (BOOL)checkAndInsertKey:(NSString *)key now:(NSTimeInterval)now;
+
+/**
+ * @brief YES if the key was probably seen within the window, without remembering it.
+ *        Lets an event be checked before it is stored and remembered only once it is.
+ */
+- (BOOL)containsKey:(NSString *)key;
+- (BOOL)containsKey:(NSString *)key now:(NSTimeInterval)now;
+
+/**
+ * @brief Remember the key for the window.
+ */
+- (void)insertKey:(NSString *)key;
+- (void)insertKey:(NSString *)key now:(NSTimeInterval)now;
+
+@end
+
+NS_ASSUME_NONNULL_END
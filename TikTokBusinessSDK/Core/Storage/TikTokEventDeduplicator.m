@@ -0,0 +1,271 @@
+//
+//  TikTokEventDeduplicator.m
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokEventDeduplicator.h"
+#import "TikTokAppEvent.h"
+#import "TikTokTypeUtility.h"
+#import <fcntl.h>
+#import <math.h>
+#import <pthread.h>
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import <unistd.h>
+
+#define TT_DEDUP_MAGIC 0x46445454 // "TTDF"
+#define TT_DEDUP_VERSION 1
+#define TT_DEDUP_MAX_HASHES 20
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t bitCount;
+    uint32_t hashCount;
+    uint32_t current;
+    uint32_t insertCount[2];
+    uint32_t reserved;
+    double generationStart[2];
+} TTDedupHeader;
+
+static uint64_t fnv1a64(const char *bytes, size_t length)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static uint64_t mix64(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+@interface TikTokEventDeduplicator ()
+{
+    pthread_mutex_t _mutex;
+    TTDedupHeader *_header;
+    uint8_t *_bits[2];
+    size_t _mappedSize;
+}
+
+@property (nonatomic, assign) NSTimeInterval window;
+@property (nonatomic, assign) NSUInteger capacity;
+
+@end
+
+@implementation TikTokEventDeduplicator
+
++ (NSString *)deduplicationKeyForEvent:(TikTokAppEvent *)event
+{
+    if ([event.type isEqualToString:@"monitor"]) {
+        return nil;
+    }
+    if (TTCheckValidString(event.tteventID)) {
+        return [NSString stringWithFormat:@"%@|id:%@", event.eventName, event.tteventID];
+    }
+    NSDictionary *order = [event.properties objectForKey:@"order"];
+    if ([order isKindOfClass:[NSDictionary class]]) {
+        NSString *orderID = [order objectForKey:@"order_id"];
+        if (TTCheckValidString(orderID)) {
+            return [NSString stringWithFormat:@"%@|order:%@", event.eventName, orderID];
+        }
+    }
+    return nil;
+}
+
+- (instancetype)initWithPath:(NSString *)path
+                      window:(NSTimeInterval)window
+           falsePositiveRate:(double)falsePositiveRate
+                    capacity:(NSUInteger)capacity
+{
+    if (window <= 0 || capacity == 0 || falsePositiveRate <= 0 || falsePositiveRate >= 1) {
+        return nil;
+    }
+    self = [super init];
+    if (self == nil) {
+        return nil;
+    }
+    _window = window;
+    _capacity = MIN(capacity, (NSUInteger)UINT32_MAX);
+
+    // Optimal Bloom filter size for the capacity and false-positive target
+    double bits = ceil(-(double)_capacity * log(falsePositiveRate) / (M_LN2 * M_LN2));
+    uint32_t bitCount = (uint32_t)MIN(MAX((((uint64_t)bits + 63) / 64) * 64, 64), (uint64_t)UINT32_MAX - 63);
+    uint32_t hashCount = (uint32_t)MIN(MAX(lround((double)bitCount / _capacity * M_LN2), 1), TT_DEDUP_MAX_HASHES);
+    size_t filterSize = bitCount / 8;
+    _mappedSize = sizeof(TTDedupHeader) + 2 * filterSize;
+
+    void *memory = MAP_FAILED;
+    int fd = open(path.fileSystemRepresentation, O_RDWR | O_CREAT, 0644);
+    if (fd >= 0) {
+        struct stat st;
+        BOOL sizeMatches = fstat(fd, &st) == 0 && (size_t)st.st_size == _mappedSize;
+        if (sizeMatches || ftruncate(fd, (off_t)_mappedSize) == 0) {
+            memory = mmap(NULL, _mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+    }
+    if (memory == MAP_FAILED) {
+        memory = mmap(NULL, _mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+        if (memory == MAP_FAILED) {
+            return nil;
+        }
+    }
+
+    _header = memory;
+    _bits[0] = (uint8_t *)memory + sizeof(TTDedupHeader);
+    _bits[1] = _bits[0] + filterSize;
+    if (_header->magic != TT_DEDUP_MAGIC || _header->version != TT_DEDUP_VERSION
+        || _header->bitCount != bitCount || _header->hashCount != hashCount || _header->current > 1) {
+        memset(memory, 0, _mappedSize);
+        _header->magic = TT_DEDUP_MAGIC;
+        _header->version = TT_DEDUP_VERSION;
+        _header->bitCount = bitCount;
+        _header->hashCount = hashCount;
+    }
+    pthread_mutex_init(&_mutex, NULL);
+    return self;
+}
+
+- (void)dealloc
+{
+    if (_header != NULL) {
+        munmap(_header, _mappedSize);
+        pthread_mutex_destroy(&_mutex);
+    }
+}
+
+- (NSUInteger)byteCount
+{
+    return _header->bitCount / 4;
+}
+
+- (BOOL)checkAndInsertKey:(NSString *)key
+{
+    return [self checkAndInsertKey:key now:[[NSDate date] timeIntervalSince1970]];
+}
+
+- (BOOL)checkAndInsertKey:(NSString *)key now:(NSTimeInterval)now
+{
+    uint32_t positions[TT_DEDUP_MAX_HASHES];
+    [self getPositions:positions forKey:key];
+    pthread_mutex_lock(&_mutex);
+    [self rotateIfNeededAt:now];
+    BOOL seen = [self containsPositions:positions];
+    if (!seen) {
+        [self insertPositions:positions];
+    }
+    pthread_mutex_unlock(&_mutex);
+    return seen;
+}
+
+- (BOOL)containsKey:(NSString *)key
+{
+    return [self containsKey:key now:[[NSDate date] timeIntervalSince1970]];
+}
+
+- (BOOL)containsKey:(NSString *)key now:(NSTimeInterval)now
+{
+    uint32_t positions[TT_DEDUP_MAX_HASHES];
+    [self getPositions:positions forKey:key];
+    pthread_mutex_lock(&_mutex);
+    [self rotateIfNeededAt:now];
+    BOOL seen = [self containsPositions:positions];
+    pthread_mutex_unlock(&_mutex);
+    return seen;
+}
+
+- (void)insertKey:(NSString *)key
+{
+    [self insertKey:key now:[[NSDate date] timeIntervalSince1970]];
+}
+
+- (void)insertKey:(NSString *)key now:(NSTimeInterval)now
+{
+    uint32_t positions[TT_DEDUP_MAX_HASHES];
+    [self getPositions:positions forKey:key];
+    pthread_mutex_lock(&_mutex);
+    [self rotateIfNeededAt:now];
+    if (![self containsPositions:positions]) {
+        [self insertPositions:positions];
+    }
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (void)getPositions:(uint32_t *)positions forKey:(NSString *)key
+{
+    NSData *data = [key dataUsingEncoding:NSUTF8StringEncoding];
+    uint64_t hash1 = fnv1a64(data.bytes, data.length);
+    uint64_t hash2 = mix64(hash1) | 1;
+    uint32_t bitCount = _header->bitCount;
+    for (uint32_t i = 0; i < _header->hashCount; i++) {
+        positions[i] = (uint32_t)((hash1 + i * hash2) % bitCount);
+    }
+}
+
+// Called with _mutex held.
+- (BOOL)containsPositions:(const uint32_t *)positions
+{
+    for (int generation = 0; generation < 2; generation++) {
+        BOOL seen = YES;
+        for (uint32_t i = 0; i < _header->hashCount; i++) {
+            if (!(_bits[generation][positions[i] >> 3] & (1 << (positions[i] & 7)))) {
+                seen = NO;
+                break;
+            }
+        }
+        if (seen) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+// Called with _mutex held.
+- (void)insertPositions:(const uint32_t *)positions
+{
+    uint8_t *bits = _bits[_header->current];
+    for (uint32_t i = 0; i < _header->hashCount; i++) {
+        bits[positions[i] >> 3] |= (uint8_t)(1 << (positions[i] & 7));
+    }
+    _header->insertCount[_header->current]++;
+}
+
+// Called with _mutex held.
+- (void)rotateIfNeededAt:(NSTimeInterval)now
+{
+    uint32_t current = _header->current;
+    double start = _header->generationStart[current];
+    if (start == 0) {
+        _header->generationStart[current] = now;
+        return;
+    }
+    // A clock set backwards rotates too, rather than keeping keys indefinitely.
+    BOOL expired = now - start >= self.window / 2 || now < start;
+    if (!expired && _header->insertCount[current] < self.capacity) {
+        return;
+    }
+    uint32_t next = 1 - current;
+    if (now - start >= self.window || now < start) {
+        // Nothing was tracked for a whole window, so the filling generation is stale too
+        memset(_bits[current], 0, _header->bitCount / 8);
+        _header->insertCount[current] = 0;
+    }
+    memset(_bits[next], 0, _header->bitCount / 8);
+    _header->insertCount[next] = 0;
+    _header->generationStart[next] = now;
+    _header->current = next;
+}
+
+@end
@@ -0,0 +1,858 @@
+//
+//  TikTokEventJournal.c
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#include "TikTokEventJournal.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#define TT_JOURNAL_SEGMENT_MAGIC 0x4A455454 // "TTEJ"
+#define TT_JOURNAL_CHECKPOINT_MAGIC 0x50435454 // "TTCP"
+#define TT_JOURNAL_VERSION 1
+#define TT_JOURNAL_MIN_SEGMENT_SIZE 4096
+// Beyond this, the live events of the oldest segment are copied forward so it can be deleted
+#define TT_JOURNAL_MAX_SEGMENTS 8
+#define TT_JOURNAL_PATH_MAX 1024
+
+enum {
+    TTRecordTypeEvent = 1,
+    TTRecordTypeAcknowledge = 2,
+    TTRecordTypeRetry = 3,
+};
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t number;
+} TTSegmentHeader;
+
+typedef struct {
+    // Bytes in the record including this header, written last. Zero marks the end of the segment.
+    uint32_t length;
+    // CRC32 of the rest of the record
+    uint32_t crc;
+    uint32_t type;
+    int32_t lane;
+    uint32_t flags;
+    uint32_t retryTimes;
+    // Event identifier. Acknowledge and retry records list identifiers in their body instead.
+    uint64_t identifier;
+} TTRecordHeader;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    // Segments numbered below this are fully acknowledged
+    uint64_t firstSegment;
+    // Events up to this identifier are acknowledged
+    uint64_t acknowledgedThrough;
+    uint32_t crc;
+    uint32_t reserved;
+} TTCheckpoint;
+
+typedef struct {
+    uint64_t number;
+    uint8_t *base;
+    size_t size;
+    size_t tail;
+    size_t liveCount;
+} TTSegment;
+
+typedef struct {
+    uint64_t identifier;
+    uint64_t segment;
+    uint32_t offset;
+    uint32_t length;
+    int32_t lane;
+    uint32_t flags;
+    uint32_t retryTimes;
+    bool live;
+    bool sending;
+} TTEntry;
+
+struct TikTokEventJournal {
+    pthread_mutex_t mutex;
+    char *directory;
+    size_t segmentSize;
+    TTSegment *segments;
+    size_t segmentCount;
+    size_t segmentCapacity;
+    // Sorted by identifier. Removed events stay as dead entries until the array is compacted.
+    TTEntry *entries;
+    size_t entryCount;
+    size_t entryCapacity;
+    size_t deadCount;
+    uint64_t nextIdentifier;
+    uint64_t acknowledgedThrough;
+    uint64_t firstSegment;
+};
+
+static size_t alignedLength(size_t length)
+{
+    return (length + 7) & ~(size_t)7;
+}
+
+static uint32_t recordCRC(const uint8_t *record, uint32_t length)
+{
+    size_t skipped = offsetof(TTRecordHeader, type);
+    return (uint32_t)crc32(0, record + skipped, (uInt)(length - skipped));
+}
+
+static uint32_t checkpointCRC(const TTCheckpoint *checkpoint)
+{
+    return (uint32_t)crc32(0, (const Bytef *)checkpoint, (uInt)offsetof(TTCheckpoint, crc));
+}
+
+static void segmentPath(TikTokEventJournal *journal, uint64_t number, char *path)
+{
+    snprintf(path, TT_JOURNAL_PATH_MAX, "%s/%016llx.segment", journal->directory, (unsigned long long)number);
+}
+
+static void checkpointPath(TikTokEventJournal *journal, const char *suffix, char *path)
+{
+    snprintf(path, TT_JOURNAL_PATH_MAX, "%s/checkpoint%s", journal->directory, suffix);
+}
+
+#pragma mark - Segments
+
+static TTSegment *segmentWithNumber(TikTokEventJournal *journal, uint64_t number)
+{
+    for (size_t i = 0; i < journal->segmentCount; i++) {
+        if (journal->segments[i].number == number) {
+            return &journal->segments[i];
+        }
+    }
+    return NULL;
+}
+
+static bool pushSegment(TikTokEventJournal *journal, TTSegment segment)
+{
+    if (journal->segmentCount == journal->segmentCapacity) {
+        size_t capacity = journal->segmentCapacity ? journal->segmentCapacity * 2 : 8;
+        TTSegment *segments = realloc(journal->segments, capacity * sizeof(TTSegment));
+        if (segments == NULL) {
+            return false;
+        }
+        journal->segments = segments;
+        journal->segmentCapacity = capacity;
+    }
+    journal->segments[journal->segmentCount++] = segment;
+    return true;
+}
+
+static uint8_t *mapFile(const char *path, bool create, size_t *size)
+{
+    int fd = open(path, create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0644);
+    if (fd < 0) {
+        return NULL;
+    }
+    if (create) {
+        if (ftruncate(fd, (off_t)*size) != 0) {
+            close(fd);
+            return NULL;
+        }
+    } else {
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TTSegmentHeader)) {
+            close(fd);
+            return NULL;
+        }
+        *size = (size_t)st.st_size;
+    }
+    void *base = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    return base == MAP_FAILED ? NULL : base;
+}
+
+static bool createSegment(TikTokEventJournal *journal, size_t minimumSize)
+{
+    uint64_t number = journal->firstSegment;
+    if (journal->segmentCount > 0) {
+        TTSegment *active = &journal->segments[journal->segmentCount - 1];
+        number = active->number + 1;
+        msync(active->base, active->size, MS_ASYNC);
+    }
+    size_t size = journal->segmentSize;
+    if (minimumSize + sizeof(TTSegmentHeader) > size) {
+        size_t page = (size_t)getpagesize();
+        size = (minimumSize + sizeof(TTSegmentHeader) + page - 1) / page * page;
+    }
+    char path[TT_JOURNAL_PATH_MAX];
+    segmentPath(journal, number, path);
+    uint8_t *base = mapFile(path, true, &size);
+    if (base == NULL) {
+        return false;
+    }
+    TTSegmentHeader *header = (TTSegmentHeader *)base;
+    header->magic = TT_JOURNAL_SEGMENT_MAGIC;
+    header->version = TT_JOURNAL_VERSION;
+    header->number = number;
+    TTSegment segment = {number, base, size, sizeof(TTSegmentHeader), 0};
+    if (!pushSegment(journal, segment)) {
+        munmap(base, size);
+        unlink(path);
+        return false;
+    }
+    return true;
+}
+
+static void removeSegmentFile(TikTokEventJournal *journal, TTSegment *segment)
+{
+    char path[TT_JOURNAL_PATH_MAX];
+    segmentPath(journal, segment->number, path);
+    munmap(segment->base, segment->size);
+    unlink(path);
+}
+
+/// Append a record to the active segment, starting a new one if it doesn't fit.
+static bool writeRecord(TikTokEventJournal *journal, uint32_t type, int32_t lane, uint32_t flags, uint32_t retryTimes,
+                        uint64_t identifier, const void *body, size_t bodyLength,
+                        uint64_t *segmentNumber, uint32_t *offset)
+{
+    size_t length = sizeof(TTRecordHeader) + bodyLength;
+    if (length > UINT32_MAX) {
+        return false;
+    }
+    TTSegment *active = journal->segmentCount > 0 ? &journal->segments[journal->segmentCount - 1] : NULL;
+    if (active == NULL || active->tail + alignedLength(length) > active->size) {
+        if (!createSegment(journal, alignedLength(length))) {
+            return false;
+        }
+        active = &journal->segments[journal->segmentCount - 1];
+    }
+    uint8_t *record = active->base + active->tail;
+    TTRecordHeader header = {0, 0, type, lane, flags, retryTimes, identifier};
+    memcpy(record, &header, sizeof(header));
+    if (bodyLength > 0) {
+        memcpy(record + sizeof(header), body, bodyLength);
+    }
+    ((TTRecordHeader *)record)->crc = recordCRC(record, (uint32_t)length);
+    // The length goes in last, so a record interrupted before this point ends the segment on replay.
+    __atomic_store_n(&((TTRecordHeader *)record)->length, (uint32_t)length, __ATOMIC_RELEASE);
+    if (segmentNumber) {
+        *segmentNumber = active->number;
+    }
+    if (offset) {
+        *offset = (uint32_t)active->tail;
+    }
+    active->tail += alignedLength(length);
+    return true;
+}
+
+#pragma mark - Entries
+
+/// Index of the entry with identifier, or of where it would be inserted.
+static size_t entryIndex(TikTokEventJournal *journal, uint64_t identifier)
+{
+    size_t low = 0, high = journal->entryCount;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (journal->entries[middle].identifier < identifier) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static TTEntry *findEntry(TikTokEventJournal *journal, uint64_t identifier)
+{
+    size_t index = entryIndex(journal, identifier);
+    if (index < journal->entryCount && journal->entries[index].identifier == identifier) {
+        return &journal->entries[index];
+    }
+    return NULL;
+}
+
+static TTEntry *insertEntry(TikTokEventJournal *journal, uint64_t identifier)
+{
+    if (journal->entryCount == journal->entryCapacity) {
+        size_t capacity = journal->entryCapacity ? journal->entryCapacity * 2 : 64;
+        TTEntry *entries = realloc(journal->entries, capacity * sizeof(TTEntry));
+        if (entries == NULL) {
+            return NULL;
+        }
+        journal->entries = entries;
+        journal->entryCapacity = capacity;
+    }
+    size_t index = entryIndex(journal, identifier);
+    memmove(&journal->entries[index + 1], &journal->entries[index], (journal->entryCount - index) * sizeof(TTEntry));
+    journal->entryCount++;
+    TTEntry *entry = &journal->entries[index];
+    memset(entry, 0, sizeof(TTEntry));
+    entry->identifier = identifier;
+    return entry;
+}
+
+static void removeEntry(TikTokEventJournal *journal, TTEntry *entry)
+{
+    TTSegment *segment = segmentWithNumber(journal, entry->segment);
+    if (segment && segment->liveCount > 0) {
+        segment->liveCount--;
+    }
+    entry->live = false;
+    journal->deadCount++;
+}
+
+static void compactEntries(TikTokEventJournal *journal)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < journal->entryCount; i++) {
+        if (journal->entries[i].live) {
+            journal->entries[count++] = journal->entries[i];
+        }
+    }
+    journal->entryCount = count;
+    journal->deadCount = 0;
+}
+
+/// Point a live entry at a new copy of its record.
+static void moveEntry(TikTokEventJournal *journal, TTEntry *entry, uint64_t segmentNumber, uint32_t offset)
+{
+    TTSegment *previous = segmentWithNumber(journal, entry->segment);
+    if (previous && previous->liveCount > 0) {
+        previous->liveCount--;
+    }
+    entry->segment = segmentNumber;
+    entry->offset = offset;
+    TTSegment *segment = segmentWithNumber(journal, segmentNumber);
+    if (segment) {
+        segment->liveCount++;
+    }
+}
+
+#pragma mark - Checkpoint
+
+static void readCheckpoint(TikTokEventJournal *journal)
+{
+    char path[TT_JOURNAL_PATH_MAX];
+    checkpointPath(journal, "", path);
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    TTCheckpoint checkpoint;
+    ssize_t bytes = read(fd, &checkpoint, sizeof(checkpoint));
+    close(fd);
+    if (bytes != sizeof(checkpoint) || checkpoint.magic != TT_JOURNAL_CHECKPOINT_MAGIC
+        || checkpoint.version != TT_JOURNAL_VERSION || checkpoint.crc != checkpointCRC(&checkpoint)) {
+        return;
+    }
+    journal->firstSegment = checkpoint.firstSegment;
+    journal->acknowledgedThrough = checkpoint.acknowledgedThrough;
+}
+
+/// Replace the checkpoint atomically. Segments below firstSegment may only be deleted after this.
+static bool writeCheckpoint(TikTokEventJournal *journal, uint64_t firstSegment, uint64_t acknowledgedThrough)
+{
+    TTCheckpoint checkpoint = {TT_JOURNAL_CHECKPOINT_MAGIC, TT_JOURNAL_VERSION, firstSegment, acknowledgedThrough, 0, 0};
+    checkpoint.crc = checkpointCRC(&checkpoint);
+    char temporaryPath[TT_JOURNAL_PATH_MAX];
+    char path[TT_JOURNAL_PATH_MAX];
+    checkpointPath(journal, ".tmp", temporaryPath);
+    checkpointPath(journal, "", path);
+    int fd = open(temporaryPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool written = write(fd, &checkpoint, sizeof(checkpoint)) == sizeof(checkpoint) && fsync(fd) == 0;
+    close(fd);
+    if (!written || rename(temporaryPath, path) != 0) {
+        unlink(temporaryPath);
+        return false;
+    }
+    journal->firstSegment = firstSegment;
+    journal->acknowledgedThrough = acknowledgedThrough;
+    return true;
+}
+
+#pragma mark - Garbage collection
+
+/// Copy the live events of the oldest segment to the active one.
+static bool relocateOldestSegment(TikTokEventJournal *journal)
+{
+    uint64_t oldest = journal->segments[0].number;
+    uint8_t *base = journal->segments[0].base;
+    for (size_t i = 0; i < journal->entryCount; i++) {
+        TTEntry *entry = &journal->entries[i];
+        if (!entry->live || entry->segment != oldest) {
+            continue;
+        }
+        uint64_t segmentNumber;
+        uint32_t offset;
+        if (!writeRecord(journal, TTRecordTypeEvent, entry->lane, entry->flags, entry->retryTimes, entry->identifier,
+                         base + entry->offset + sizeof(TTRecordHeader), entry->length, &segmentNumber, &offset)) {
+            return false;
+        }
+        moveEntry(journal, entry, segmentNumber, offset);
+    }
+    return true;
+}
+
+static void collectGarbage(TikTokEventJournal *journal)
+{
+    if (journal->segmentCount > TT_JOURNAL_MAX_SEGMENTS && journal->segments[0].liveCount > 0) {
+        if (!relocateOldestSegment(journal)) {
+            return;
+        }
+    }
+    // The active segment is kept even when empty
+    size_t removable = 0;
+    while (removable + 1 < journal->segmentCount && journal->segments[removable].liveCount == 0) {
+        removable++;
+    }
+    if (removable == 0) {
+        return;
+    }
+    uint64_t acknowledgedThrough = journal->nextIdentifier - 1;
+    for (size_t i = 0; i < journal->entryCount; i++) {
+        if (journal->entries[i].live) {
+            acknowledgedThrough = journal->entries[i].identifier - 1;
+            break;
+        }
+    }
+    if (!writeCheckpoint(journal, journal->segments[removable].number, acknowledgedThrough)) {
+        return;
+    }
+    for (size_t i = 0; i < removable; i++) {
+        removeSegmentFile(journal, &journal->segments[i]);
+    }
+    journal->segmentCount -= removable;
+    memmove(journal->segments, journal->segments + removable, journal->segmentCount * sizeof(TTSegment));
+}
+
+static void removeEntries(TikTokEventJournal *journal, const uint64_t *identifiers, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        TTEntry *entry = findEntry(journal, identifiers[i]);
+        if (entry && entry->live) {
+            removeEntry(journal, entry);
+        }
+    }
+    if (journal->deadCount > 64 && journal->deadCount * 2 > journal->entryCount) {
+        compactEntries(journal);
+    }
+    collectGarbage(journal);
+}
+
+#pragma mark - Replay
+
+static void applyRecord(TikTokEventJournal *journal, TTSegment *segment, size_t offset, const TTRecordHeader *header)
+{
+    const uint64_t *identifiers = (const uint64_t *)(segment->base + offset + sizeof(TTRecordHeader));
+    size_t identifierCount = (header->length - sizeof(TTRecordHeader)) / sizeof(uint64_t);
+    switch (header->type) {
+        case TTRecordTypeEvent: {
+            if (header->identifier <= journal->acknowledgedThrough) {
+                break;
+            }
+            if (header->identifier >= journal->nextIdentifier) {
+                journal->nextIdentifier = header->identifier + 1;
+            }
+            TTEntry *entry = findEntry(journal, header->identifier);
+            if (entry && !entry->live) {
+                break;
+            }
+            if (entry == NULL) {
+                entry = insertEntry(journal, header->identifier);
+                if (entry == NULL) {
+                    break;
+                }
+                entry->live = true;
+                entry->segment = segment->number;
+                entry->offset = (uint32_t)offset;
+                segment->liveCount++;
+            } else {
+                // a copy made when an old segment was collected
+                moveEntry(journal, entry, segment->number, (uint32_t)offset);
+            }
+            entry->length = header->length - (uint32_t)sizeof(TTRecordHeader);
+            entry->lane = header->lane;
+            entry->flags = header->flags;
+            entry->retryTimes = header->retryTimes;
+            break;
+        }
+        case TTRecordTypeAcknowledge:
+            for (size_t i = 0; i < identifierCount; i++) {
+                TTEntry *entry = findEntry(journal, identifiers[i]);
+                if (entry && entry->live) {
+                    removeEntry(journal, entry);
+                }
+            }
+            break;
+        case TTRecordTypeRetry:
+            for (size_t i = 0; i < identifierCount; i++) {
+                TTEntry *entry = findEntry(journal, identifiers[i]);
+                if (entry && entry->live) {
+                    entry->retryTimes++;
+                }
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/// Replay the records of a segment. Returns false if it ends with a damaged record.
+static bool replaySegment(TikTokEventJournal *journal, TTSegment *segment)
+{
+    size_t offset = sizeof(TTSegmentHeader);
+    bool intact = true;
+    while (offset + sizeof(TTRecordHeader) <= segment->size) {
+        const TTRecordHeader *header = (const TTRecordHeader *)(segment->base + offset);
+        uint32_t length = header->length;
+        if (length == 0) {
+            break;
+        }
+        if (length < sizeof(TTRecordHeader) || length > segment->size - offset
+            || header->crc != recordCRC(segment->base + offset, length)) {
+            intact = false;
+            break;
+        }
+        applyRecord(journal, segment, offset, header);
+        offset += alignedLength(length);
+    }
+    segment->tail = offset;
+    return intact;
+}
+
+static int compareNumbers(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+static void loadSegments(TikTokEventJournal *journal)
+{
+    DIR *directory = opendir(journal->directory);
+    if (directory == NULL) {
+        return;
+    }
+    uint64_t *numbers = NULL;
+    size_t count = 0, capacity = 0;
+    struct dirent *item;
+    while ((item = readdir(directory)) != NULL) {
+        unsigned long long number;
+        char suffix[16];
+        if (strlen(item->d_name) != 24 || sscanf(item->d_name, "%16llx.%8s", &number, suffix) != 2
+            || strcmp(suffix, "segment") != 0) {
+            continue;
+        }
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 16;
+            uint64_t *grown = realloc(numbers, capacity * sizeof(uint64_t));
+            if (grown == NULL) {
+                break;
+            }
+            numbers = grown;
+        }
+        numbers[count++] = number;
+    }
+    closedir(directory);
+    if (numbers == NULL) {
+        return;
+    }
+    qsort(numbers, count, sizeof(uint64_t), compareNumbers);
+
+    bool lastIntact = true;
+    for (size_t i = 0; i < count; i++) {
+        char path[TT_JOURNAL_PATH_MAX];
+        segmentPath(journal, numbers[i], path);
+        if (numbers[i] < journal->firstSegment) {
+            // collected, but deleting it was interrupted
+            unlink(path);
+            continue;
+        }
+        size_t size = 0;
+        uint8_t *base = mapFile(path, false, &size);
+        const TTSegmentHeader *header = (const TTSegmentHeader *)base;
+        if (base == NULL || header->magic != TT_JOURNAL_SEGMENT_MAGIC
+            || header->version != TT_JOURNAL_VERSION || header->number != numbers[i]) {
+            if (base) {
+                munmap(base, size);
+            }
+            unlink(path);
+            continue;
+        }
+        TTSegment segment = {numbers[i], base, size, sizeof(TTSegmentHeader), 0};
+        if (!pushSegment(journal, segment)) {
+            munmap(base, size);
+            break;
+        }
+        lastIntact = replaySegment(journal, &journal->segments[journal->segmentCount - 1]);
+    }
+    free(numbers);
+
+    if (!lastIntact) {
+        // Clear the damaged tail, so records appended over it can't run into stale bytes
+        TTSegment *active = &journal->segments[journal->segmentCount - 1];
+        memset(active->base + active->tail, 0, active->size - active->tail);
+    }
+}
+
+#pragma mark - Public
+
+TikTokEventJournal *TikTokEventJournalOpen(const char *directory, size_t segmentSize)
+{
+    if (directory == NULL || strlen(directory) + 32 > TT_JOURNAL_PATH_MAX) {
+        return NULL;
+    }
+    if (mkdir(directory, 0755) != 0 && errno != EEXIST) {
+        return NULL;
+    }
+    TikTokEventJournal *journal = calloc(1, sizeof(TikTokEventJournal));
+    if (journal == NULL) {
+        return NULL;
+    }
+    journal->directory = strdup(directory);
+    if (journal->directory == NULL) {
+        free(journal);
+        return NULL;
+    }
+    journal->segmentSize = segmentSize > TT_JOURNAL_MIN_SEGMENT_SIZE ? segmentSize : TT_JOURNAL_MIN_SEGMENT_SIZE;
+    journal->nextIdentifier = 1;
+    pthread_mutex_init(&journal->mutex, NULL);
+
+    readCheckpoint(journal);
+    loadSegments(journal);
+    if (journal->nextIdentifier <= journal->acknowledgedThrough) {
+        journal->nextIdentifier = journal->acknowledgedThrough + 1;
+    }
+    compactEntries(journal);
+    collectGarbage(journal);
+    return journal;
+}
+
+void TikTokEventJournalClose(TikTokEventJournal *journal)
+{
+    if (journal == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < journal->segmentCount; i++) {
+        msync(journal->segments[i].base, journal->segments[i].size, MS_ASYNC);
+        munmap(journal->segments[i].base, journal->segments[i].size);
+    }
+    pthread_mutex_destroy(&journal->mutex);
+    free(journal->segments);
+    free(journal->entries);
+    free(journal->directory);
+    free(journal);
+}
+
+bool TikTokEventJournalAppend(TikTokEventJournal *journal, int32_t lane, uint32_t flags, uint32_t retryTimes,
+                              const void *payload, uint32_t length, uint64_t *identifier)
+{
+    if (journal == NULL || (payload == NULL && length > 0)) {
+        return false;
+    }
+    pthread_mutex_lock(&journal->mutex);
+    uint64_t newIdentifier = journal->nextIdentifier;
+    uint64_t segmentNumber;
+    uint32_t offset;
+    size_t segmentCount = journal->segmentCount;
+    bool appended = writeRecord(journal, TTRecordTypeEvent, lane, flags, retryTimes, newIdentifier,
+                                payload, length, &segmentNumber, &offset);
+    if (appended) {
+        journal->nextIdentifier++;
+        TTEntry *entry = insertEntry(journal, newIdentifier);
+        if (entry) {
+            entry->live = true;
+            entry->segment = segmentNumber;
+            entry->offset = offset;
+            entry->length = length;
+            entry->lane = lane;
+            entry->flags = flags;
+            entry->retryTimes = retryTimes;
+            segmentWithNumber(journal, segmentNumber)->liveCount++;
+        } else {
+            appended = false;
+        }
+        if (journal->segmentCount != segmentCount) {
+            collectGarbage(journal);
+        }
+    }
+    pthread_mutex_unlock(&journal->mutex);
+    if (appended && identifier) {
+        *identifier = newIdentifier;
+    }
+    return appended;
+}
+
+size_t TikTokEventJournalCount(TikTokEventJournal *journal, int32_t lane)
+{
+    if (journal == NULL) {
+        return 0;
+    }
+    size_t count = 0;
+    pthread_mutex_lock(&journal->mutex);
+    for (size_t i = 0; i < journal->entryCount; i++) {
+        const TTEntry *entry = &journal->entries[i];
+        if (entry->live && (lane == TikTokEventJournalAnyLane || entry->lane == lane)) {
+            count++;
+        }
+    }
+    pthread_mutex_unlock(&journal->mutex);
+    return count;
+}
+
+size_t TikTokEventJournalTakeUnsent(TikTokEventJournal *journal, int32_t lane, size_t limit,
+                                    TikTokEventJournalVisitor visitor, void *context)
+{
+    if (journal == NULL || visitor == NULL) {
+        return 0;
+    }
+    size_t count = 0;
+    pthread_mutex_lock(&journal->mutex);
+    for (size_t i = 0; i < journal->entryCount && (limit == 0 || count < limit); i++) {
+        TTEntry *entry = &journal->entries[i];
+        if (!entry->live || entry->sending || (lane != TikTokEventJournalAnyLane && entry->lane != lane)) {
+            continue;
+        }
+        TTSegment *segment = segmentWithNumber(journal, entry->segment);
+        if (segment == NULL) {
+            continue;
+        }
+        TikTokEventJournalRecord record = {
+            entry->identifier, entry->lane, entry->flags, entry->retryTimes,
+            segment->base + entry->offset + sizeof(TTRecordHeader), entry->length
+        };
+        visitor(&record, context);
+        entry->sending = true;
+        count++;
+    }
+    pthread_mutex_unlock(&journal->mutex);
+    return count;
+}
+
+bool TikTokEventJournalAcknowledge(TikTokEventJournal *journal, const uint64_t *identifiers, size_t count)
+{
+    if (journal == NULL || (identifiers == NULL && count > 0)) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+    pthread_mutex_lock(&journal->mutex);
+    bool written = writeRecord(journal, TTRecordTypeAcknowledge, 0, 0, 0, 0, identifiers, count * sizeof(uint64_t), NULL, NULL);
+    if (written) {
+        removeEntries(journal, identifiers, count);
+    }
+    pthread_mutex_unlock(&journal->mutex);
+    return written;
+}
+
+bool TikTokEventJournalRelease(TikTokEventJournal *journal, const uint64_t *identifiers, size_t count)
+{
+    if (journal == NULL || (identifiers == NULL && count > 0)) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+    pthread_mutex_lock(&journal->mutex);
+    bool written = writeRecord(journal, TTRecordTypeRetry, 0, 0, 0, 0, identifiers, count * sizeof(uint64_t), NULL, NULL);
+    if (written) {
+        for (size_t i = 0; i < count; i++) {
+            TTEntry *entry = findEntry(journal, identifiers[i]);
+            if (entry && entry->live) {
+                entry->sending = false;
+                entry->retryTimes++;
+            }
+        }
+    }
+    pthread_mutex_unlock(&journal->mutex);
+    return written;
+}
+
+void TikTokEventJournalPutBack(TikTokEventJournal *journal, const uint64_t *identifiers, size_t count)
+{
+    if (journal == NULL || identifiers == NULL) {
+        return;
+    }
+    // Sending is kept in memory only, so there is nothing to write
+    pthread_mutex_lock(&journal->mutex);
+    for (size_t i = 0; i < count; i++) {
+        TTEntry *entry = findEntry(journal, identifiers[i]);
+        if (entry && entry->live) {
+            entry->sending = false;
+        }
+    }
+    pthread_mutex_unlock(&journal->mutex);
+}
+
+bool TikTokEventJournalRemoveFlagged(TikTokEventJournal *journal, uint32_t flags)
+{
+    if (journal == NULL) {
+        return false;
+    }
+    pthread_mutex_lock(&journal->mutex);
+    size_t count = 0;
+    uint64_t *identifiers = malloc((journal->entryCount + 1) * sizeof(uint64_t));
+    bool removed = identifiers != NULL;
+    if (removed) {
+        for (size_t i = 0; i < journal->entryCount; i++) {
+            const TTEntry *entry = &journal->entries[i];
+            if (entry->live && (entry->flags & flags) == flags) {
+                identifiers[count++] = entry->identifier;
+            }
+        }
+        if (count > 0) {
+            removed = writeRecord(journal, TTRecordTypeAcknowledge, 0, 0, 0, 0, identifiers, count * sizeof(uint64_t), NULL, NULL);
+            if (removed) {
+                removeEntries(journal, identifiers, count);
+            }
+        }
+        free(identifiers);
+    }
+    pthread_mutex_unlock(&journal->mutex);
+    return removed;
+}
+
+bool TikTokEventJournalClear(TikTokEventJournal *journal)
+{
+    if (journal == NULL) {
+        return false;
+    }
+    pthread_mutex_lock(&journal->mutex);
+    uint64_t firstSegment = journal->firstSegment;
+    if (journal->segmentCount > 0) {
+        firstSegment = journal->segments[journal->segmentCount - 1].number + 1;
+    }
+    bool cleared = writeCheckpoint(journal, firstSegment, journal->nextIdentifier - 1);
+    if (cleared) {
+        for (size_t i = 0; i < journal->segmentCount; i++) {
+            removeSegmentFile(journal, &journal->segments[i]);
+        }
+        journal->segmentCount = 0;
+        journal->entryCount = 0;
+        journal->deadCount = 0;
+    }
+    pthread_mutex_unlock(&journal->mutex);
+    return cleared;
+}
+
+size_t TikTokEventJournalSegmentCount(TikTokEventJournal *journal)
+{
+    if (journal == NULL) {
+        return 0;
+    }
+    pthread_mutex_lock(&journal->mutex);
+    size_t count = journal->segmentCount;
+    pthread_mutex_unlock(&journal->mutex);
+    return count;
+}
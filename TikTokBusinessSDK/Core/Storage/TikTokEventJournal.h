@@ -0,0 +1,102 @@
+//
+//  TikTokEventJournal.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#ifndef TikTokEventJournal_h
+#define TikTokEventJournal_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Append-only event log kept in memory-mapped segment files.
+ *
+ * Each record is length-prefixed and carries a CRC32, so a torn write at the end of a
+ * segment is detected and cut off when the journal is reopened. Events are removed by
+ * appending acknowledgement records; once every event in the oldest segment is
+ * acknowledged, the checkpoint file is advanced past it and the segment is deleted.
+ * Live events left in old segments are copied forward when too many segments pile up.
+ *
+ * Whether an event is being sent is kept in memory only: after a relaunch every
+ * remaining event is unsent again, as with the SQLite store.
+ *
+ * All functions are thread-safe.
+ */
+typedef struct TikTokEventJournal TikTokEventJournal;
+
+#define TikTokEventJournalAnyLane (-1)
+
+typedef struct {
+    uint64_t identifier;
+    int32_t lane;
+    uint32_t flags;
+    uint32_t retryTimes;
+    const void *payload;
+    uint32_t length;
+} TikTokEventJournalRecord;
+
+/** Called for each record handed out. The payload is only valid during the call. */
+typedef void (*TikTokEventJournalVisitor)(const TikTokEventJournalRecord *record, void *context);
+
+/**
+ * Open or create a journal in directory, which is created if needed.
+ *
+ * @param segmentSize Bytes per segment file. Larger records get a segment of their own size.
+ * @return NULL if the directory can't be used
+ */
+TikTokEventJournal *TikTokEventJournalOpen(const char *directory, size_t segmentSize);
+
+void TikTokEventJournalClose(TikTokEventJournal *journal);
+
+/**
+ * Append an unsent event.
+ *
+ * @param identifier Receives the event's identifier. May be NULL.
+ */
+bool TikTokEventJournalAppend(TikTokEventJournal *journal, int32_t lane, uint32_t flags, uint32_t retryTimes,
+                              const void *payload, uint32_t length, uint64_t *identifier);
+
+/** Events not yet acknowledged in lane, or in every lane for TikTokEventJournalAnyLane. */
+size_t TikTokEventJournalCount(TikTokEventJournal *journal, int32_t lane);
+
+/**
+ * Visit the unsent events of lane in the order they were appended and mark them as sending.
+ *
+ * @param limit Most events to visit, or 0 for all of them
+ * @return Number of events visited
+ */
+size_t TikTokEventJournalTakeUnsent(TikTokEventJournal *journal, int32_t lane, size_t limit,
+                                    TikTokEventJournalVisitor visitor, void *context);
+
+/** Remove events, typically once they were sent. Unknown identifiers are ignored. */
+bool TikTokEventJournalAcknowledge(TikTokEventJournal *journal, const uint64_t *identifiers, size_t count);
+
+/** Mark sending events as unsent again and count a retry for each. */
+bool TikTokEventJournalRelease(TikTokEventJournal *journal, const uint64_t *identifiers, size_t count);
+
+/** Mark sending events as unsent again without counting a retry, e.g. when they never reached the server. */
+void TikTokEventJournalPutBack(TikTokEventJournal *journal, const uint64_t *identifiers, size_t count);
+
+/** Remove every event having all of flags set. */
+bool TikTokEventJournalRemoveFlagged(TikTokEventJournal *journal, uint32_t flags);
+
+/** Remove every event and delete all segments. */
+bool TikTokEventJournalClear(TikTokEventJournal *journal);
+
+/** Segment files currently in use. For testing. */
+size_t TikTokEventJournalSegmentCount(TikTokEventJournal *journal);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TikTokEventJournal_h */
@@ -0,0 +1,55 @@
+//
+//  TikTokEventStore.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Matches events of every lane
+static const NSInteger TikTokEventStoreAnyLane = -1;
+
+/**
+ * @brief An archived event as kept by a store
+ */
+@interface TikTokStoredEvent : NSObject
+
+@property (nonatomic, copy) NSString *identifier;
+@property (nonatomic, strong) NSData *data;
+@property (nonatomic, copy) NSString *timestamp;
+@property (nonatomic, assign) NSInteger retryTimes;
+@property (nonatomic, assign) NSInteger lane;
+@property (nonatomic, assign) BOOL isEDPEvent;
+
+@end
+
+/**
+ * @brief Backend behind TikTokBaseEventPersistence. Events are appended as unsent, handed
+ *        out once and marked as sending, then either removed or released to be retried.
+ */
+@protocol TikTokEventStore <NSObject>
+
+- (BOOL)appendEvent:(TikTokStoredEvent *)event;
+
+/// Unsent events of a lane in the order they were appended, now marked as sending.
+/// At most limit of them, or all for a limit of 0.
+- (NSArray<TikTokStoredEvent *> *)takeUnsentEventsInLane:(NSInteger)lane limit:(NSUInteger)limit;
+
+- (NSInteger)eventCountInLane:(NSInteger)lane;
+
+- (BOOL)removeEventsWithIdentifiers:(NSArray<NSString *> *)identifiers;
+
+/// Mark events as unsent again, counting a retry for each if countingRetry
+- (BOOL)releaseEventsWithIdentifiers:(NSArray<NSString *> *)identifiers countingRetry:(BOOL)countingRetry;
+
+- (BOOL)removeEDPEvents;
+
+- (BOOL)removeAllEvents;
+
+@end
+
+NS_ASSUME_NONNULL_END
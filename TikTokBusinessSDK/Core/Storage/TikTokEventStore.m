@@ -0,0 +1,13 @@
+//
+//  TikTokEventStore.m
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokEventStore.h"
+
+@implementation TikTokStoredEvent
+
+@end
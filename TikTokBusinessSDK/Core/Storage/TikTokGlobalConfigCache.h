@@ -0,0 +1,59 @@
+//
+//  TikTokGlobalConfigCache.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief Last good global config response, kept on disk so it can be applied at launch
+ *        while the config endpoint is revalidated in the background.
+ *
+ *        An entry is only served for the app ID and SDK version that stored it, and for
+ *        at most maxAge seconds after it was fetched or revalidated.
+ */
+@interface TikTokGlobalConfigCache : NSObject
+
+/**
+ * @brief Cache stored in the Library directory
+ */
++ (instancetype)sharedCache;
+
+/**
+ * @param path File holding the entry, created on the first store
+ * @param maxAge Seconds an entry stays usable after it was fetched or revalidated
+ */
+- (instancetype)initWithPath:(NSString *)path maxAge:(NSTimeInterval)maxAge;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * @brief The 'data' object of the cached response, nil if there is no usable entry for appId
+ */
+- (nullable NSDictionary *)configDataForAppId:(NSString *)appId;
+
+/**
+ * @brief ETag of the cached response to revalidate with, nil if there is no usable entry for appId
+ */
+- (nullable NSString *)ETagForAppId:(NSString *)appId;
+
+/**
+ * @brief Replace the entry with a freshly fetched response
+ */
+- (void)storeConfigData:(NSDictionary *)configData ETag:(nullable NSString *)ETag appId:(NSString *)appId;
+
+/**
+ * @brief Mark the entry as revalidated after the server answered 304 Not Modified
+ */
+- (void)markRevalidatedForAppId:(NSString *)appId;
+
+- (void)clear;
+
+@end
+
+NS_ASSUME_NONNULL_END
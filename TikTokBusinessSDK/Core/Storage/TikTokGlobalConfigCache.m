@@ -0,0 +1,161 @@
+//
+//  TikTokGlobalConfigCache.m
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokGlobalConfigCache.h"
+#import "TikTokTypeUtility.h"
+#import "TikTokBusinessSDKMacros.h"
+#import <pthread.h>
+
+// Bump when the layout of the entry changes
+static const NSInteger kGlobalConfigCacheVersion = 1;
+static const NSTimeInterval kGlobalConfigCacheMaxAge = 7 * 24 * 60 * 60;
+
+static NSString * const kVersionKey = @"version";
+static NSString * const kSDKVersionKey = @"sdk_version";
+static NSString * const kAppIdKey = @"app_id";
+static NSString * const kETagKey = @"etag";
+static NSString * const kFetchedAtKey = @"fetched_at";
+static NSString * const kDataKey = @"data";
+
+@interface TikTokGlobalConfigCache ()
+{
+    pthread_mutex_t _mutex;
+}
+
+@property (nonatomic, copy) NSString *path;
+@property (nonatomic, assign) NSTimeInterval maxAge;
+// Entry as read from or last written to the file, nil until loaded
+@property (nonatomic, copy, nullable) NSDictionary *entry;
+@property (nonatomic, assign) BOOL loaded;
+
+@end
+
+@implementation TikTokGlobalConfigCache
+
++ (instancetype)sharedCache
+{
+    static TikTokGlobalConfigCache *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *libraryDirectory = [NSSearchPathForDirectoriesInDomains(NSLibraryDirectory, NSUserDomainMask, YES) firstObject];
+        cache = [[TikTokGlobalConfigCache alloc] initWithPath:[libraryDirectory stringByAppendingPathComponent:@"tiktok_global_config.json"]
+                                                       maxAge:kGlobalConfigCacheMaxAge];
+    });
+    return cache;
+}
+
+- (instancetype)initWithPath:(NSString *)path maxAge:(NSTimeInterval)maxAge
+{
+    self = [super init];
+    if (self) {
+        _path = [path copy];
+        _maxAge = maxAge;
+        pthread_mutex_init(&_mutex, NULL);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_mutex);
+}
+
+// Must be called with the mutex held
+- (nullable NSDictionary *)usableEntryForAppId:(NSString *)appId
+{
+    if (!self.loaded) {
+        self.loaded = YES;
+        NSData *data = [NSData dataWithContentsOfFile:self.path];
+        if (TTCheckValidData(data)) {
+            id entry = [TikTokTypeUtility JSONObjectWithData:data options:0 error:nil origin:NSStringFromClass([self class])];
+            self.entry = TTCheckValidDictionary(entry) ? entry : nil;
+        }
+    }
+    NSDictionary *entry = self.entry;
+    if (!entry
+        || [[entry objectForKey:kVersionKey] integerValue] != kGlobalConfigCacheVersion
+        || ![[entry objectForKey:kSDKVersionKey] isEqual:SDK_VERSION]
+        || ![[entry objectForKey:kAppIdKey] isEqual:TTSafeString(appId)]
+        || !TTCheckValidDictionary([entry objectForKey:kDataKey])) {
+        return nil;
+    }
+    NSTimeInterval age = [[NSDate date] timeIntervalSince1970] - [[entry objectForKey:kFetchedAtKey] doubleValue];
+    if (age < 0 || age > self.maxAge) {
+        return nil;
+    }
+    return entry;
+}
+
+- (NSDictionary *)configDataForAppId:(NSString *)appId
+{
+    pthread_mutex_lock(&_mutex);
+    NSDictionary *configData = [[self usableEntryForAppId:appId] objectForKey:kDataKey];
+    pthread_mutex_unlock(&_mutex);
+    return configData;
+}
+
+- (NSString *)ETagForAppId:(NSString *)appId
+{
+    pthread_mutex_lock(&_mutex);
+    NSString *ETag = [[self usableEntryForAppId:appId] objectForKey:kETagKey];
+    pthread_mutex_unlock(&_mutex);
+    return TTCheckValidString(ETag) ? ETag : nil;
+}
+
+// Must be called with the mutex held
+- (void)writeEntry:(nullable NSDictionary *)entry
+{
+    self.entry = entry;
+    self.loaded = YES;
+    if (!entry) {
+        [[NSFileManager defaultManager] removeItemAtPath:self.path error:nil];
+        return;
+    }
+    NSData *data = [TikTokTypeUtility dataWithJSONObject:entry options:0 error:nil origin:NSStringFromClass([self class])];
+    if (TTCheckValidData(data)) {
+        [data writeToFile:self.path atomically:YES];
+    }
+}
+
+- (void)storeConfigData:(NSDictionary *)configData ETag:(NSString *)ETag appId:(NSString *)appId
+{
+    if (!TTCheckValidDictionary(configData)) {
+        return;
+    }
+    pthread_mutex_lock(&_mutex);
+    [self writeEntry:@{
+        kVersionKey: @(kGlobalConfigCacheVersion),
+        kSDKVersionKey: SDK_VERSION,
+        kAppIdKey: TTSafeString(appId),
+        kETagKey: TTSafeString(ETag),
+        kFetchedAtKey: @([[NSDate date] timeIntervalSince1970]),
+        kDataKey: configData
+    }];
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (void)markRevalidatedForAppId:(NSString *)appId
+{
+    pthread_mutex_lock(&_mutex);
+    NSDictionary *entry = [self usableEntryForAppId:appId];
+    if (entry) {
+        NSMutableDictionary *revalidated = entry.mutableCopy;
+        [revalidated setObject:@([[NSDate date] timeIntervalSince1970]) forKey:kFetchedAtKey];
+        [self writeEntry:revalidated];
+    }
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (void)clear
+{
+    pthread_mutex_lock(&_mutex);
+    [self writeEntry:nil];
+    pthread_mutex_unlock(&_mutex);
+}
+
+@end
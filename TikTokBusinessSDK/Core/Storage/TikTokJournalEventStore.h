@@ -0,0 +1,33 @@
+//
+//  TikTokJournalEventStore.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "TikTokEventStore.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief Event store appending to memory-mapped segment files. See TikTokEventJournal.h.
+ */
+@interface TikTokJournalEventStore : NSObject <TikTokEventStore>
+
+/**
+ * @param directory Directory holding the segments and checkpoint, created if needed
+ * @param segmentSize Bytes per segment file
+ * @return nil if the directory can't be used
+ */
+- (nullable instancetype)initWithDirectory:(NSString *)directory segmentSize:(NSUInteger)segmentSize;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Segment files in use. For testing.
+@property (nonatomic, assign, readonly) NSUInteger segmentCount;
+
+@end
+
+NS_ASSUME_NONNULL_END
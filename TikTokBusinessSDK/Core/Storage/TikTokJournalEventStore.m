@@ -0,0 +1,114 @@
+//
+//  TikTokJournalEventStore.m
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokJournalEventStore.h"
+#import "TikTokEventJournal.h"
+
+#define TT_JOURNAL_FLAG_EDP 1
+
+static void collectRecord(const TikTokEventJournalRecord *record, void *context)
+{
+    NSMutableArray<TikTokStoredEvent *> *events = (__bridge NSMutableArray *)context;
+    TikTokStoredEvent *event = [[TikTokStoredEvent alloc] init];
+    event.identifier = [NSString stringWithFormat:@"%llu", (unsigned long long)record->identifier];
+    event.data = [NSData dataWithBytes:record->payload length:record->length];
+    event.retryTimes = record->retryTimes;
+    event.lane = record->lane;
+    event.isEDPEvent = (record->flags & TT_JOURNAL_FLAG_EDP) != 0;
+    [events addObject:event];
+}
+
+static NSData *identifierData(NSArray<NSString *> *identifiers)
+{
+    NSMutableData *data = [NSMutableData dataWithLength:identifiers.count * sizeof(uint64_t)];
+    uint64_t *values = data.mutableBytes;
+    NSUInteger count = 0;
+    for (NSString *identifier in identifiers) {
+        unsigned long long value = strtoull(identifier.UTF8String, NULL, 10);
+        if (value > 0) {
+            values[count++] = value;
+        }
+    }
+    data.length = count * sizeof(uint64_t);
+    return data;
+}
+
+@interface TikTokJournalEventStore ()
+{
+    TikTokEventJournal *_journal;
+}
+
+@end
+
+@implementation TikTokJournalEventStore
+
+- (instancetype)initWithDirectory:(NSString *)directory segmentSize:(NSUInteger)segmentSize
+{
+    self = [super init];
+    if (self == nil) {
+        return nil;
+    }
+    [[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil];
+    _journal = TikTokEventJournalOpen(directory.fileSystemRepresentation, segmentSize);
+    if (_journal == NULL) {
+        return nil;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    TikTokEventJournalClose(_journal);
+}
+
+- (NSUInteger)segmentCount
+{
+    return TikTokEventJournalSegmentCount(_journal);
+}
+
+- (BOOL)appendEvent:(TikTokStoredEvent *)event {
+    if (event.data.length > UINT32_MAX) {
+        return NO;
+    }
+    return TikTokEventJournalAppend(_journal, (int32_t)event.lane, event.isEDPEvent ? TT_JOURNAL_FLAG_EDP : 0, (uint32_t)event.retryTimes,
+                                    event.data.bytes, (uint32_t)event.data.length, NULL);
+}
+
+- (NSArray<TikTokStoredEvent *> *)takeUnsentEventsInLane:(NSInteger)lane limit:(NSUInteger)limit {
+    NSMutableArray<TikTokStoredEvent *> *events = [NSMutableArray array];
+    TikTokEventJournalTakeUnsent(_journal, (int32_t)lane, limit, collectRecord, (__bridge void *)events);
+    return events;
+}
+
+- (NSInteger)eventCountInLane:(NSInteger)lane {
+    return TikTokEventJournalCount(_journal, (int32_t)lane);
+}
+
+- (BOOL)removeEventsWithIdentifiers:(NSArray<NSString *> *)identifiers {
+    NSData *data = identifierData(identifiers);
+    return TikTokEventJournalAcknowledge(_journal, data.bytes, data.length / sizeof(uint64_t));
+}
+
+- (BOOL)releaseEventsWithIdentifiers:(NSArray<NSString *> *)identifiers countingRetry:(BOOL)countingRetry {
+    NSData *data = identifierData(identifiers);
+    if (!countingRetry) {
+        TikTokEventJournalPutBack(_journal, data.bytes, data.length / sizeof(uint64_t));
+        return YES;
+    }
+    return TikTokEventJournalRelease(_journal, data.bytes, data.length / sizeof(uint64_t));
+}
+
+- (BOOL)removeEDPEvents {
+    return TikTokEventJournalRemoveFlagged(_journal, TT_JOURNAL_FLAG_EDP);
+}
+
+- (BOOL)removeAllEvents {
+    return TikTokEventJournalClear(_journal);
+}
+
+@end
@@ -0,0 +1,523 @@
+//
+//  TikTokKVStore.c
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#include "TikTokKVStore.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#define TT_KV_MAGIC 0x564B5454 // "TTKV"
+#define TT_KV_VERSION 1
+#define TT_KV_MIN_FILE_SIZE 4096
+#define TT_KV_MIN_SLOTS 64
+#define TT_KV_PATH_MAX 1024
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t reserved;
+} TTFileHeader;
+
+typedef struct {
+    // Bytes in the record including this header, written last. Zero marks the end of the log.
+    uint32_t length;
+    // CRC32 of the rest of the record
+    uint32_t crc;
+    // TikTokKVStoreTypeNone for a removal
+    uint8_t type;
+    uint8_t reserved;
+    uint16_t keyLength;
+    uint32_t valueLength;
+} TTRecordHeader;
+
+typedef struct {
+    uint32_t hash;
+    // Offset of the latest record of the key, zero for an empty slot
+    uint32_t offset;
+} TTSlot;
+
+struct TikTokKVStore {
+    pthread_mutex_t mutex;
+    char *path;
+    uint8_t *base;
+    size_t size;
+    size_t tail;
+    TTSlot *slots;
+    size_t slotCount;
+    // Slots in use, including keys whose latest record is a removal
+    size_t usedSlots;
+    size_t liveCount;
+    // Bytes taken by the latest record of each live key
+    size_t liveBytes;
+};
+
+static size_t alignedLength(size_t length)
+{
+    return (length + 7) & ~(size_t)7;
+}
+
+static size_t pageAlignedLength(size_t length)
+{
+    size_t page = (size_t)getpagesize();
+    return (length + page - 1) / page * page;
+}
+
+static uint32_t recordCRC(const uint8_t *record, uint32_t length)
+{
+    size_t skipped = offsetof(TTRecordHeader, type);
+    return (uint32_t)crc32(0, record + skipped, (uInt)(length - skipped));
+}
+
+static uint32_t keyHash(const char *key, size_t length)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)key[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static const TTRecordHeader *recordAt(TikTokKVStore *store, uint32_t offset)
+{
+    return (const TTRecordHeader *)(store->base + offset);
+}
+
+static const char *recordKey(const TTRecordHeader *record)
+{
+    return (const char *)(record + 1);
+}
+
+static const uint8_t *recordValue(const TTRecordHeader *record)
+{
+    return (const uint8_t *)(record + 1) + record->keyLength;
+}
+
+static uint8_t *mapFile(const char *path, bool create, size_t *size)
+{
+    int fd = open(path, create ? (O_RDWR | O_CREAT | O_TRUNC) : (O_RDWR | O_CREAT), 0644);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return NULL;
+    }
+    if ((size_t)st.st_size < *size) {
+        if (ftruncate(fd, (off_t)*size) != 0) {
+            close(fd);
+            return NULL;
+        }
+    } else {
+        *size = (size_t)st.st_size;
+    }
+    void *base = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    return base == MAP_FAILED ? NULL : base;
+}
+
+#pragma mark - Index
+
+/// Slot holding key, or the empty slot where it would go.
+static TTSlot *findSlot(TTSlot *slots, size_t slotCount, const uint8_t *base, const char *key, size_t keyLength, uint32_t hash)
+{
+    size_t mask = slotCount - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        TTSlot *slot = &slots[i];
+        if (slot->offset == 0) {
+            return slot;
+        }
+        if (slot->hash == hash) {
+            const TTRecordHeader *record = (const TTRecordHeader *)(base + slot->offset);
+            if (record->keyLength == keyLength && memcmp(recordKey(record), key, keyLength) == 0) {
+                return slot;
+            }
+        }
+    }
+}
+
+static bool resizeIndex(TikTokKVStore *store, size_t slotCount)
+{
+    TTSlot *slots = calloc(slotCount, sizeof(TTSlot));
+    if (slots == NULL) {
+        return false;
+    }
+    for (size_t i = 0; i < store->slotCount; i++) {
+        TTSlot *slot = &store->slots[i];
+        if (slot->offset == 0) {
+            continue;
+        }
+        const TTRecordHeader *record = recordAt(store, slot->offset);
+        *findSlot(slots, slotCount, store->base, recordKey(record), record->keyLength, slot->hash) = *slot;
+    }
+    free(store->slots);
+    store->slots = slots;
+    store->slotCount = slotCount;
+    return true;
+}
+
+/// Point key at the record at offset, which the index owns from now on.
+static bool indexRecord(TikTokKVStore *store, uint32_t offset)
+{
+    if ((store->usedSlots + 1) * 2 > store->slotCount && !resizeIndex(store, store->slotCount * 2)) {
+        return false;
+    }
+    const TTRecordHeader *record = recordAt(store, offset);
+    uint32_t hash = keyHash(recordKey(record), record->keyLength);
+    TTSlot *slot = findSlot(store->slots, store->slotCount, store->base, recordKey(record), record->keyLength, hash);
+    if (slot->offset == 0) {
+        store->usedSlots++;
+    } else {
+        const TTRecordHeader *previous = recordAt(store, slot->offset);
+        if (previous->type != TikTokKVStoreTypeNone) {
+            store->liveCount--;
+            store->liveBytes -= alignedLength(previous->length);
+        }
+    }
+    if (record->type != TikTokKVStoreTypeNone) {
+        store->liveCount++;
+        store->liveBytes += alignedLength(record->length);
+    }
+    slot->hash = hash;
+    slot->offset = offset;
+    return true;
+}
+
+static void resetIndex(TikTokKVStore *store)
+{
+    memset(store->slots, 0, store->slotCount * sizeof(TTSlot));
+    store->usedSlots = 0;
+    store->liveCount = 0;
+    store->liveBytes = 0;
+}
+
+#pragma mark - Log
+
+static void writeHeader(uint8_t *base)
+{
+    TTFileHeader *header = (TTFileHeader *)base;
+    header->magic = TT_KV_MAGIC;
+    header->version = TT_KV_VERSION;
+    header->reserved = 0;
+}
+
+static void writeRecord(uint8_t *destination, uint8_t type, const char *key, uint16_t keyLength, const void *value, uint32_t valueLength)
+{
+    uint32_t length = (uint32_t)(sizeof(TTRecordHeader) + keyLength + valueLength);
+    TTRecordHeader header = {0, 0, type, 0, keyLength, valueLength};
+    memcpy(destination, &header, sizeof(header));
+    memcpy(destination + sizeof(header), key, keyLength);
+    if (valueLength > 0) {
+        memcpy(destination + sizeof(header) + keyLength, value, valueLength);
+    }
+    ((TTRecordHeader *)destination)->crc = recordCRC(destination, length);
+    // The length goes in last, so a record interrupted before this point ends the log on replay.
+    __atomic_store_n(&((TTRecordHeader *)destination)->length, length, __ATOMIC_RELEASE);
+}
+
+/// Replay the log into the index. Returns false if it ends with a damaged record.
+static bool replay(TikTokKVStore *store)
+{
+    size_t offset = sizeof(TTFileHeader);
+    bool intact = true;
+    while (offset + sizeof(TTRecordHeader) <= store->size) {
+        const TTRecordHeader *record = (const TTRecordHeader *)(store->base + offset);
+        uint32_t length = record->length;
+        if (length == 0) {
+            break;
+        }
+        if (length < sizeof(TTRecordHeader) || length > store->size - offset
+            || length != sizeof(TTRecordHeader) + record->keyLength + (size_t)record->valueLength
+            || record->crc != recordCRC(store->base + offset, length)
+            || !indexRecord(store, (uint32_t)offset)) {
+            intact = false;
+            break;
+        }
+        offset += alignedLength(length);
+    }
+    store->tail = offset;
+    return intact;
+}
+
+/**
+ * Write the live records to a new file, sized so at least extra bytes fit after them,
+ * and swap it in for the current one.
+ */
+static bool rewrite(TikTokKVStore *store, size_t extra)
+{
+    size_t needed = sizeof(TTFileHeader) + store->liveBytes + extra;
+    size_t size = store->size;
+    // Keep half of the file free, so a full store doesn't rewrite on every update
+    while (needed > size / 2) {
+        size *= 2;
+    }
+    if (size > UINT32_MAX) {
+        return false;
+    }
+    char path[TT_KV_PATH_MAX];
+    snprintf(path, sizeof(path), "%s.tmp", store->path);
+    uint8_t *base = mapFile(path, true, &size);
+    if (base == NULL) {
+        unlink(path);
+        return false;
+    }
+    TTSlot *slots = calloc(store->slotCount, sizeof(TTSlot));
+    if (slots == NULL) {
+        munmap(base, size);
+        unlink(path);
+        return false;
+    }
+    writeHeader(base);
+    size_t tail = sizeof(TTFileHeader);
+    size_t usedSlots = 0;
+    for (size_t i = 0; i < store->slotCount; i++) {
+        TTSlot *slot = &store->slots[i];
+        if (slot->offset == 0) {
+            continue;
+        }
+        const TTRecordHeader *record = recordAt(store, slot->offset);
+        if (record->type == TikTokKVStoreTypeNone) {
+            continue;
+        }
+        memcpy(base + tail, record, record->length);
+        TTSlot *moved = findSlot(slots, store->slotCount, base, recordKey(record), record->keyLength, slot->hash);
+        moved->hash = slot->hash;
+        moved->offset = (uint32_t)tail;
+        usedSlots++;
+        tail += alignedLength(record->length);
+    }
+    // The new file only replaces the old one once all of it is on disk
+    if (msync(base, size, MS_SYNC) != 0 || rename(path, store->path) != 0) {
+        free(slots);
+        munmap(base, size);
+        unlink(path);
+        return false;
+    }
+    munmap(store->base, store->size);
+    free(store->slots);
+    store->base = base;
+    store->size = size;
+    store->tail = tail;
+    store->slots = slots;
+    store->usedSlots = usedSlots;
+    return true;
+}
+
+static bool append(TikTokKVStore *store, uint8_t type, const char *key, const void *value, uint32_t valueLength)
+{
+    size_t keyLength = strlen(key);
+    size_t length = sizeof(TTRecordHeader) + keyLength + valueLength;
+    if (keyLength == 0 || keyLength > UINT16_MAX || length > UINT32_MAX / 2) {
+        return false;
+    }
+    if (store->tail + alignedLength(length) > store->size && !rewrite(store, alignedLength(length))) {
+        return false;
+    }
+    uint32_t offset = (uint32_t)store->tail;
+    writeRecord(store->base + offset, type, key, (uint16_t)keyLength, value, valueLength);
+    if (!indexRecord(store, offset)) {
+        // Leave the record unreachable rather than pointing the key at a stale one
+        memset(store->base + offset, 0, length);
+        return false;
+    }
+    store->tail += alignedLength(length);
+    return true;
+}
+
+static const TTRecordHeader *lookup(TikTokKVStore *store, const char *key)
+{
+    size_t keyLength = strlen(key);
+    TTSlot *slot = findSlot(store->slots, store->slotCount, store->base, key, keyLength, keyHash(key, keyLength));
+    if (slot->offset == 0) {
+        return NULL;
+    }
+    const TTRecordHeader *record = recordAt(store, slot->offset);
+    return record->type == TikTokKVStoreTypeNone ? NULL : record;
+}
+
+#pragma mark - Public
+
+TikTokKVStore *TikTokKVStoreOpen(const char *path, size_t initialSize)
+{
+    if (path == NULL || strlen(path) + 8 > TT_KV_PATH_MAX) {
+        return NULL;
+    }
+    TikTokKVStore *store = calloc(1, sizeof(TikTokKVStore));
+    if (store == NULL) {
+        return NULL;
+    }
+    store->path = strdup(path);
+    store->slotCount = TT_KV_MIN_SLOTS;
+    store->slots = calloc(store->slotCount, sizeof(TTSlot));
+    store->size = pageAlignedLength(initialSize > TT_KV_MIN_FILE_SIZE ? initialSize : TT_KV_MIN_FILE_SIZE);
+    if (store->path == NULL || store->slots == NULL || store->size > UINT32_MAX
+        || (store->base = mapFile(path, false, &store->size)) == NULL) {
+        free(store->slots);
+        free(store->path);
+        free(store);
+        return NULL;
+    }
+    pthread_mutex_init(&store->mutex, NULL);
+
+    const TTFileHeader *header = (const TTFileHeader *)store->base;
+    if (header->magic != TT_KV_MAGIC || header->version != TT_KV_VERSION) {
+        // new file, or one this version can't read
+        memset(store->base, 0, store->size);
+        writeHeader(store->base);
+        store->tail = sizeof(TTFileHeader);
+    } else if (!replay(store)) {
+        // Clear the damaged tail, so records appended over it can't run into stale bytes
+        memset(store->base + store->tail, 0, store->size - store->tail);
+    }
+    // Rewrite a log that is mostly overwritten values
+    if (store->tail > store->size / 2 && store->tail - sizeof(TTFileHeader) > store->liveBytes * 2) {
+        rewrite(store, 0);
+    }
+    return store;
+}
+
+void TikTokKVStoreClose(TikTokKVStore *store)
+{
+    if (store == NULL) {
+        return;
+    }
+    msync(store->base, store->size, MS_ASYNC);
+    munmap(store->base, store->size);
+    pthread_mutex_destroy(&store->mutex);
+    free(store->slots);
+    free(store->path);
+    free(store);
+}
+
+bool TikTokKVStoreSet(TikTokKVStore *store, const char *key, uint8_t type, const void *value, uint32_t length)
+{
+    if (store == NULL || key == NULL || type == TikTokKVStoreTypeNone || (value == NULL && length > 0)) {
+        return false;
+    }
+    pthread_mutex_lock(&store->mutex);
+    const TTRecordHeader *current = lookup(store, key);
+    bool stored = true;
+    // Writing the same value again only grows the log
+    if (current == NULL || current->type != type || current->valueLength != length
+        || (length > 0 && memcmp(recordValue(current), value, length) != 0)) {
+        stored = append(store, type, key, value, length);
+    }
+    pthread_mutex_unlock(&store->mutex);
+    return stored;
+}
+
+bool TikTokKVStoreRemove(TikTokKVStore *store, const char *key)
+{
+    if (store == NULL || key == NULL) {
+        return false;
+    }
+    pthread_mutex_lock(&store->mutex);
+    bool removed = lookup(store, key) == NULL || append(store, TikTokKVStoreTypeNone, key, NULL, 0);
+    pthread_mutex_unlock(&store->mutex);
+    return removed;
+}
+
+uint8_t TikTokKVStoreGet(TikTokKVStore *store, const char *key, void *buffer, uint32_t capacity, uint32_t *length)
+{
+    if (store == NULL || key == NULL) {
+        return TikTokKVStoreTypeNone;
+    }
+    pthread_mutex_lock(&store->mutex);
+    const TTRecordHeader *record = lookup(store, key);
+    uint8_t type = TikTokKVStoreTypeNone;
+    if (record) {
+        type = record->type;
+        if (buffer) {
+            memcpy(buffer, recordValue(record), record->valueLength < capacity ? record->valueLength : capacity);
+        }
+        if (length) {
+            *length = record->valueLength;
+        }
+    }
+    pthread_mutex_unlock(&store->mutex);
+    return type;
+}
+
+uint8_t TikTokKVStoreCopy(TikTokKVStore *store, const char *key, void **value, uint32_t *length)
+{
+    if (store == NULL || key == NULL || value == NULL) {
+        return TikTokKVStoreTypeNone;
+    }
+    pthread_mutex_lock(&store->mutex);
+    const TTRecordHeader *record = lookup(store, key);
+    uint8_t type = TikTokKVStoreTypeNone;
+    if (record) {
+        // at least one byte, so an empty value still gets a buffer
+        *value = malloc(record->valueLength > 0 ? record->valueLength : 1);
+        if (*value) {
+            type = record->type;
+            memcpy(*value, recordValue(record), record->valueLength);
+            if (length) {
+                *length = record->valueLength;
+            }
+        }
+    }
+    pthread_mutex_unlock(&store->mutex);
+    return type;
+}
+
+size_t TikTokKVStoreCount(TikTokKVStore *store)
+{
+    if (store == NULL) {
+        return 0;
+    }
+    pthread_mutex_lock(&store->mutex);
+    size_t count = store->liveCount;
+    pthread_mutex_unlock(&store->mutex);
+    return count;
+}
+
+bool TikTokKVStoreClear(TikTokKVStore *store)
+{
+    if (store == NULL) {
+        return false;
+    }
+    pthread_mutex_lock(&store->mutex);
+    // Zeroing starts with the length of the first record, which ends the log right away
+    memset(store->base + sizeof(TTFileHeader), 0, store->tail - sizeof(TTFileHeader));
+    store->tail = sizeof(TTFileHeader);
+    resetIndex(store);
+    pthread_mutex_unlock(&store->mutex);
+    return true;
+}
+
+bool TikTokKVStoreCompact(TikTokKVStore *store)
+{
+    if (store == NULL) {
+        return false;
+    }
+    pthread_mutex_lock(&store->mutex);
+    bool compacted = rewrite(store, 0);
+    pthread_mutex_unlock(&store->mutex);
+    return compacted;
+}
+
+size_t TikTokKVStoreFileSize(TikTokKVStore *store)
+{
+    if (store == NULL) {
+        return 0;
+    }
+    pthread_mutex_lock(&store->mutex);
+    size_t size = store->size;
+    pthread_mutex_unlock(&store->mutex);
+    return size;
+}
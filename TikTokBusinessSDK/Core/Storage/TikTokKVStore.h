@@ -0,0 +1,83 @@
+//
+//  TikTokKVStore.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#ifndef TikTokKVStore_h
+#define TikTokKVStore_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Key-value store kept in a single memory-mapped file.
+ *
+ * Every update appends a length-prefixed record carrying a CRC32, and the length is
+ * written last, so a write interrupted by a crash is cut off when the file is reopened
+ * and the previous value of the key stays in effect. An in-memory hash index points each
+ * key at its latest record. When the file is full, the live records are rewritten to a
+ * new file which then replaces the old one with rename(2), growing it if needed.
+ *
+ * Values are opaque bytes with a caller-defined type tag. All functions are thread-safe.
+ */
+typedef struct TikTokKVStore TikTokKVStore;
+
+/** Returned by the getters for a missing key. Type tags passed to the setter must be above it. */
+#define TikTokKVStoreTypeNone 0
+
+/**
+ * Open or create the store at path.
+ *
+ * @param initialSize Bytes to create the file with. It grows as needed.
+ * @return NULL if the file can't be used
+ */
+TikTokKVStore *TikTokKVStoreOpen(const char *path, size_t initialSize);
+
+void TikTokKVStoreClose(TikTokKVStore *store);
+
+/** Set the value of key, replacing any previous one. */
+bool TikTokKVStoreSet(TikTokKVStore *store, const char *key, uint8_t type, const void *value, uint32_t length);
+
+/** Remove key. Removing a missing key succeeds. */
+bool TikTokKVStoreRemove(TikTokKVStore *store, const char *key);
+
+/**
+ * Copy up to capacity bytes of the value of key into buffer.
+ *
+ * @param length Receives the full length of the value. May be NULL.
+ * @return The type tag of the value, TikTokKVStoreTypeNone if key is missing
+ */
+uint8_t TikTokKVStoreGet(TikTokKVStore *store, const char *key, void *buffer, uint32_t capacity, uint32_t *length);
+
+/**
+ * Copy the value of key into a buffer allocated with malloc, which the caller frees.
+ *
+ * @return The type tag of the value, TikTokKVStoreTypeNone if key is missing or out of memory
+ */
+uint8_t TikTokKVStoreCopy(TikTokKVStore *store, const char *key, void **value, uint32_t *length);
+
+/** Number of keys with a value. */
+size_t TikTokKVStoreCount(TikTokKVStore *store);
+
+/** Remove every key. */
+bool TikTokKVStoreClear(TikTokKVStore *store);
+
+/** Rewrite the file with only the latest record of each key. Happens on its own when the file is full. */
+bool TikTokKVStoreCompact(TikTokKVStore *store);
+
+/** Current size of the file. For testing. */
+size_t TikTokKVStoreFileSize(TikTokKVStore *store);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TikTokKVStore_h */
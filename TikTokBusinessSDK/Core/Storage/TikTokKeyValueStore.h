@@ -0,0 +1,64 @@
+//
+//  TikTokKeyValueStore.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief Typed store for the SDK's own state, kept in a memory-mapped file (see TikTokKVStore.h)
+ *        instead of NSUserDefaults. A set is a copy into the mapping, so there is nothing
+ *        to synchronize, and a crash in the middle of one leaves the previous value in place.
+ *
+ *        Holds strings, numbers, dates, data, and arrays or dictionaries of those.
+ *        The accessors follow NSUserDefaults, and setting nil removes the key.
+ */
+@interface TikTokKeyValueStore : NSObject
+
+/**
+ * @brief Store in the Library directory. On first use, it takes over the values the SDK
+ *        kept in NSUserDefaults. If the file can't be used, it reads and writes
+ *        NSUserDefaults like before.
+ */
++ (instancetype)sharedStore NS_SWIFT_NAME(shared());
+
+/**
+ * @param path File holding the store, created if needed
+ * @return nil if the file can't be used
+ */
+- (nullable instancetype)initWithPath:(NSString *)path;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (nullable id)objectForKey:(NSString *)key;
+- (nullable NSString *)stringForKey:(NSString *)key;
+- (nullable NSData *)dataForKey:(NSString *)key;
+- (nullable NSDictionary *)dictionaryForKey:(NSString *)key;
+- (BOOL)boolForKey:(NSString *)key;
+- (NSInteger)integerForKey:(NSString *)key;
+- (double)doubleForKey:(NSString *)key;
+
+- (void)setObject:(nullable id)value forKey:(NSString *)key;
+- (void)setBool:(BOOL)value forKey:(NSString *)key;
+- (void)setInteger:(NSInteger)value forKey:(NSString *)key;
+- (void)setDouble:(double)value forKey:(NSString *)key;
+- (void)removeObjectForKey:(NSString *)key;
+
+/**
+ * @brief Copy keys that have no value yet from defaults
+ */
+- (void)migrateKeys:(NSArray<NSString *> *)keys fromUserDefaults:(NSUserDefaults *)defaults;
+
+/**
+ * @brief Remove every key
+ */
+- (void)clear;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,306 @@
+//
+//  TikTokKeyValueStore.m
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokKeyValueStore.h"
+#import "TikTokKVStore.h"
+#import "TikTokTypeUtility.h"
+
+static const size_t kKeyValueStoreInitialSize = 16 * 1024;
+// Values up to this size are read without a heap copy
+static const uint32_t kInlineValueLength = 256;
+static NSString * const kMigratedKey = @"TTKeyValueStoreMigrated";
+
+typedef NS_ENUM(uint8_t, TTValueType) {
+    TTValueTypeString = 1,
+    TTValueTypeInteger = 2,
+    TTValueTypeDouble = 3,
+    TTValueTypeBool = 4,
+    TTValueTypeDate = 5,
+    TTValueTypeData = 6,
+    // Binary property list of an array or dictionary
+    TTValueTypePropertyList = 7,
+};
+
+static id decodeValue(uint8_t type, const void *bytes, uint32_t length)
+{
+    switch (type) {
+        case TTValueTypeString:
+            return [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+        case TTValueTypeInteger: {
+            int64_t value = 0;
+            if (length != sizeof(value)) {
+                return nil;
+            }
+            memcpy(&value, bytes, sizeof(value));
+            return @(value);
+        }
+        case TTValueTypeDouble:
+        case TTValueTypeDate: {
+            double value = 0;
+            if (length != sizeof(value)) {
+                return nil;
+            }
+            memcpy(&value, bytes, sizeof(value));
+            return type == TTValueTypeDate ? [NSDate dateWithTimeIntervalSince1970:value] : @(value);
+        }
+        case TTValueTypeBool:
+            return length == 1 ? @(((const uint8_t *)bytes)[0] != 0) : nil;
+        case TTValueTypeData:
+            return [NSData dataWithBytes:bytes length:length];
+        case TTValueTypePropertyList: {
+            NSData *data = [NSData dataWithBytesNoCopy:(void *)bytes length:length freeWhenDone:NO];
+            return [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:nil];
+        }
+        default:
+            return nil;
+    }
+}
+
+@interface TikTokKeyValueStore ()
+{
+    TikTokKVStore *_store;
+}
+
+// Used instead of the file when it can't be opened
+@property (nonatomic, strong, nullable) NSUserDefaults *fallbackDefaults;
+
+@end
+
+@implementation TikTokKeyValueStore
+
++ (instancetype)sharedStore
+{
+    static TikTokKeyValueStore *store;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *libraryDirectory = [NSSearchPathForDirectoriesInDomains(NSLibraryDirectory, NSUserDomainMask, YES) firstObject];
+        store = [[TikTokKeyValueStore alloc] initWithPath:[libraryDirectory stringByAppendingPathComponent:@"tiktok_kv.store"]];
+        if (store == nil) {
+            store = [[TikTokKeyValueStore alloc] initWithFallbackDefaults:[NSUserDefaults standardUserDefaults]];
+        } else if (![store boolForKey:kMigratedKey]) {
+            [store migrateSDKDefaults];
+            [store setBool:YES forKey:kMigratedKey];
+        }
+    });
+    return store;
+}
+
+- (instancetype)initWithPath:(NSString *)path
+{
+    self = [super init];
+    if (self == nil) {
+        return nil;
+    }
+    [[NSFileManager defaultManager] createDirectoryAtPath:[path stringByDeletingLastPathComponent] withIntermediateDirectories:YES attributes:nil error:nil];
+    _store = TikTokKVStoreOpen(path.fileSystemRepresentation, kKeyValueStoreInitialSize);
+    if (_store == NULL) {
+        return nil;
+    }
+    return self;
+}
+
+- (instancetype)initWithFallbackDefaults:(NSUserDefaults *)defaults
+{
+    self = [super init];
+    if (self) {
+        _fallbackDefaults = defaults;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    TikTokKVStoreClose(_store);
+}
+
+// Values the SDK kept in NSUserDefaults before this store existed. They are left in
+// place, so an earlier SDK version still finds them after a downgrade.
+- (void)migrateSDKDefaults
+{
+    [self migrateKeys:@[
+        @"AreTimersOn", @"HasFirstFlushOccurred", @"HasBeenInitialized",
+        @"monitorInitStartTime", @"backgroundMonitorTime", @"foregroundMonitorTime",
+        @"tiktokInstallDate", @"tiktokLaunchedBefore", @"tiktokLogged2DRetention", @"tiktokPast2DLimit", @"tiktokMatchedInstall",
+        @"firstLaunchTime", @"SKANTimeWindow", @"accumulatedSKANValues", @"latestFineValue", @"latestCoarseValue",
+        @"AnonymousID", @"last_session_id_key", @"last_session_time_key",
+        @"source_url", @"refer", @"TT_UserAgent", @"TT_UserAgentCache",
+        @"bootTimeSDict", @"bootTimeMsDict", @"sensig_filtering_regex_pattern", @"sensig_filtering_regex_version",
+    ] fromUserDefaults:[NSUserDefaults standardUserDefaults]];
+    NSUserDefaults *sdkDefaults = [[NSUserDefaults alloc] initWithSuiteName:@"TikTokBusinessSDK"];
+    if (sdkDefaults) {
+        [self migrateKeys:@[@"TTIAP_TRANSACTION_CHECK_DATE_KEY"] fromUserDefaults:sdkDefaults];
+    }
+}
+
+- (void)migrateKeys:(NSArray<NSString *> *)keys fromUserDefaults:(NSUserDefaults *)defaults
+{
+    for (NSString *key in keys) {
+        id value = [defaults objectForKey:key];
+        if (value && [self objectForKey:key] == nil) {
+            [self setObject:value forKey:key];
+        }
+    }
+}
+
+#pragma mark - Getters
+
+- (id)objectForKey:(NSString *)key
+{
+    if (self.fallbackDefaults) {
+        return [self.fallbackDefaults objectForKey:key];
+    }
+    if (!TTCheckValidString(key)) {
+        return nil;
+    }
+    const char *name = key.UTF8String;
+    uint8_t buffer[kInlineValueLength];
+    uint32_t length = 0;
+    uint8_t type = TikTokKVStoreGet(_store, name, buffer, sizeof(buffer), &length);
+    if (type == TikTokKVStoreTypeNone) {
+        return nil;
+    }
+    if (length <= sizeof(buffer)) {
+        return decodeValue(type, buffer, length);
+    }
+    void *value = NULL;
+    type = TikTokKVStoreCopy(_store, name, &value, &length);
+    if (type == TikTokKVStoreTypeNone) {
+        return nil;
+    }
+    id object = decodeValue(type, value, length);
+    free(value);
+    return object;
+}
+
+- (NSString *)stringForKey:(NSString *)key
+{
+    id value = [self objectForKey:key];
+    if ([value isKindOfClass:[NSNumber class]]) {
+        return [value stringValue];
+    }
+    return [value isKindOfClass:[NSString class]] ? value : nil;
+}
+
+- (NSData *)dataForKey:(NSString *)key
+{
+    id value = [self objectForKey:key];
+    return TTCheckValidData(value) ? value : nil;
+}
+
+- (NSDictionary *)dictionaryForKey:(NSString *)key
+{
+    id value = [self objectForKey:key];
+    return [value isKindOfClass:[NSDictionary class]] ? value : nil;
+}
+
+- (BOOL)boolForKey:(NSString *)key
+{
+    id value = [self objectForKey:key];
+    return [value respondsToSelector:@selector(boolValue)] ? [value boolValue] : NO;
+}
+
+- (NSInteger)integerForKey:(NSString *)key
+{
+    id value = [self objectForKey:key];
+    return [value respondsToSelector:@selector(integerValue)] ? [value integerValue] : 0;
+}
+
+- (double)doubleForKey:(NSString *)key
+{
+    id value = [self objectForKey:key];
+    return [value respondsToSelector:@selector(doubleValue)] ? [value doubleValue] : 0;
+}
+
+#pragma mark - Setters
+
+- (void)storeBytes:(const void *)bytes length:(NSUInteger)length type:(TTValueType)type forKey:(NSString *)key
+{
+    if (!TTCheckValidString(key) || length > UINT32_MAX) {
+        return;
+    }
+    TikTokKVStoreSet(_store, key.UTF8String, type, bytes, (uint32_t)length);
+}
+
+- (void)setObject:(id)value forKey:(NSString *)key
+{
+    if (self.fallbackDefaults) {
+        [self.fallbackDefaults setObject:value forKey:key];
+        return;
+    }
+    if (value == nil) {
+        [self removeObjectForKey:key];
+    } else if ([value isKindOfClass:[NSString class]]) {
+        NSData *data = [value dataUsingEncoding:NSUTF8StringEncoding];
+        [self storeBytes:data.bytes length:data.length type:TTValueTypeString forKey:key];
+    } else if ([value isKindOfClass:[NSNumber class]]) {
+        NSNumber *number = value;
+        const char *objCType = number.objCType;
+        if (CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID()) {
+            [self setBool:number.boolValue forKey:key];
+        } else if (strcmp(objCType, @encode(float)) == 0 || strcmp(objCType, @encode(double)) == 0) {
+            [self setDouble:number.doubleValue forKey:key];
+        } else {
+            int64_t integer = number.longLongValue;
+            [self storeBytes:&integer length:sizeof(integer) type:TTValueTypeInteger forKey:key];
+        }
+    } else if ([value isKindOfClass:[NSDate class]]) {
+        double interval = [value timeIntervalSince1970];
+        [self storeBytes:&interval length:sizeof(interval) type:TTValueTypeDate forKey:key];
+    } else if ([value isKindOfClass:[NSData class]]) {
+        [self storeBytes:[value bytes] length:[value length] type:TTValueTypeData forKey:key];
+    } else if ([value isKindOfClass:[NSArray class]] || [value isKindOfClass:[NSDictionary class]]) {
+        NSData *data = [NSPropertyListSerialization dataWithPropertyList:value format:NSPropertyListBinaryFormat_v1_0 options:0 error:nil];
+        if (data) {
+            [self storeBytes:data.bytes length:data.length type:TTValueTypePropertyList forKey:key];
+        }
+    }
+}
+
+- (void)setBool:(BOOL)value forKey:(NSString *)key
+{
+    if (self.fallbackDefaults) {
+        [self.fallbackDefaults setBool:value forKey:key];
+        return;
+    }
+    uint8_t byte = value ? 1 : 0;
+    [self storeBytes:&byte length:sizeof(byte) type:TTValueTypeBool forKey:key];
+}
+
+- (void)setInteger:(NSInteger)value forKey:(NSString *)key
+{
+    [self setObject:@(value) forKey:key];
+}
+
+- (void)setDouble:(double)value forKey:(NSString *)key
+{
+    if (self.fallbackDefaults) {
+        [self.fallbackDefaults setDouble:value forKey:key];
+        return;
+    }
+    [self storeBytes:&value length:sizeof(value) type:TTValueTypeDouble forKey:key];
+}
+
+- (void)removeObjectForKey:(NSString *)key
+{
+    if (self.fallbackDefaults) {
+        [self.fallbackDefaults removeObjectForKey:key];
+        return;
+    }
+    if (TTCheckValidString(key)) {
+        TikTokKVStoreRemove(_store, key.UTF8String);
+    }
+}
+
+- (void)clear
+{
+    if (self.fallbackDefaults == nil) {
+        TikTokKVStoreClear(_store);
+    }
+}
+
+@end
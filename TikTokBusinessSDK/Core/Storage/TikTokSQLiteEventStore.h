@@ -0,0 +1,31 @@
+//
+//  TikTokSQLiteEventStore.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "TikTokEventStore.h"
+#import "TikTokDatabase.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief Event store keeping one row per event in a SQLite table
+ */
+@interface TikTokSQLiteEventStore : NSObject <TikTokEventStore>
+
++ (NSDictionary<NSString *, NSString *> *)tableFields;
+
+/**
+ * @brief Use a table of the database, which must already exist with tableFields
+ */
+- (instancetype)initWithDatabase:(TikTokDatabase *)database tableName:(NSString *)tableName;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,148 @@
+//
+//  TikTokSQLiteEventStore.m
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokSQLiteEventStore.h"
+#import "TikTokBaseEventPersistence.h"
+#import "TikTokTypeUtility.h"
+
+@interface TikTokSQLiteEventStore ()
+
+@property (nonatomic, strong) TikTokDatabase *db;
+@property (nonatomic, copy) NSString *tableName;
+
+@end
+
+@implementation TikTokSQLiteEventStore
+
++ (NSDictionary<NSString *, NSString *> *)tableFields {
+    NSDictionary<NSString *, NSString *> *fields = @{
+        @"id": @"INTEGER PRIMARY KEY AUTOINCREMENT",
+        @"event_data": @"BLOB",
+        @"ts": @"TEXT",
+        @"retry_times": @"INTEGER",
+        @"sending": @"INTEGER",
+        @"is_edp_event": @"INTEGER",
+        @"lane": @"INTEGER"
+    };
+    return fields;
+}
+
+- (instancetype)initWithDatabase:(TikTokDatabase *)database tableName:(NSString *)tableName
+{
+    self = [super init];
+    if (self) {
+        _db = database;
+        _tableName = [tableName copy];
+    }
+    return self;
+}
+
+- (NSString *)whereLane:(NSInteger)lane condition:(nullable NSString *)condition {
+    if (lane == TikTokEventStoreAnyLane) {
+        return condition;
+    }
+    NSString *laneCondition = [NSString stringWithFormat:@"lane = %ld", (long)lane];
+    return condition ? [NSString stringWithFormat:@"%@ AND %@", condition, laneCondition] : laneCondition;
+}
+
+- (NSString *)whereIdentifiers:(NSArray<NSString *> *)identifiers {
+    return [NSString stringWithFormat:@"id IN (%@)", [identifiers componentsJoinedByString:@", "]];
+}
+
+- (BOOL)appendEvent:(TikTokStoredEvent *)event {
+    if (![self.db openDatabase]) {
+        return YES;
+    }
+    if (![self.db insertIntoTable:self.tableName fields:@{
+        @"event_data": event.data,
+        @"ts": TTSafeString(event.timestamp),
+        @"retry_times": @(event.retryTimes),
+        @"sending": @(0),
+        @"is_edp_event": @(event.isEDPEvent),
+        @"lane": @(event.lane)
+    }]) {
+        [self.db closeDatabase];
+        return NO;
+    }
+    return YES;
+}
+
+- (NSArray<TikTokStoredEvent *> *)takeUnsentEventsInLane:(NSInteger)lane limit:(NSUInteger)limit {
+    NSMutableArray<TikTokStoredEvent *> *events = [NSMutableArray array];
+    if (![self.db openDatabase]) {
+        return events;
+    }
+    TTDBLimit rowLimit = limit > 0 ? TTDBLimitMake(0, (int)MIN(limit, (NSUInteger)INT_MAX)) : TTDBLimitNone;
+    NSArray *res = [self.db queryTable:self.tableName withWhere:[self whereLane:lane condition:@"sending = 0"] orderBy:TTDBOrderByNone limit:rowLimit];
+    NSMutableArray *dbIDs = [NSMutableArray array];
+    for (NSDictionary *row in res) {
+        if (!TTCheckValidDictionary(row)) {
+            continue;
+        }
+        NSData *eventData = [row objectForKey:@"event_data"];
+        if (![eventData isKindOfClass:[NSData class]]) {
+            continue;
+        }
+        TikTokStoredEvent *event = [[TikTokStoredEvent alloc] init];
+        event.identifier = [NSString stringWithFormat:@"%ld", (long)[[row objectForKey:@"id"] integerValue]];
+        event.data = eventData;
+        event.retryTimes = [[row objectForKey:@"retry_times"] integerValue];
+        event.lane = [[row objectForKey:@"lane"] integerValue];
+        event.isEDPEvent = [[row objectForKey:@"is_edp_event"] boolValue];
+        [events addObject:event];
+        [dbIDs addObject:event.identifier];
+    }
+    if (dbIDs.count > 0) {
+        [self.db updateTable:self.tableName setField:@"sending" value:@(1) withWhere:[self whereIdentifiers:dbIDs]];
+    }
+    return events;
+}
+
+- (NSInteger)eventCountInLane:(NSInteger)lane {
+    return [self.db getCount:self.tableName withWhere:[self whereLane:lane condition:nil]];
+}
+
+- (BOOL)removeEventsWithIdentifiers:(NSArray<NSString *> *)identifiers {
+    if (identifiers.count > 0 && [self.db openDatabase]) {
+        [self.db deleteTable:self.tableName withWhere:[self whereIdentifiers:identifiers] orderBy:TTDBOrderByNone limit:TTDBLimitNone];
+    }
+    return YES;
+}
+
+- (BOOL)releaseEventsWithIdentifiers:(NSArray<NSString *> *)identifiers countingRetry:(BOOL)countingRetry {
+    if (identifiers.count > 0 && [self.db openDatabase]) {
+        NSString *whereCondition = [self whereIdentifiers:identifiers];
+        [self.db updateTable:self.tableName setField:@"sending" value:@(0) withWhere:whereCondition];
+        if (countingRetry) {
+            [self.db updateTable:self.tableName setField:@"retry_times" value:@"retry_times + 1" withWhere:whereCondition];
+        }
+    }
+    return YES;
+}
+
+- (BOOL)removeEDPEvents {
+    if ([self.db openDatabase]) {
+        if (![self.db deleteTable:self.tableName withWhere:@"is_edp_event = 1" orderBy:TTDBOrderByNone limit:TTDBLimitNone]) {
+            [self.db closeDatabase];
+            return NO;
+        }
+    }
+    return YES;
+}
+
+- (BOOL)removeAllEvents {
+    if ([self.db openDatabase]) {
+        if (![self.db deleteTable:self.tableName withWhere:nil orderBy:TTDBOrderByNone limit:TTDBLimitNone]) {
+            [self.db closeDatabase];
+            return NO;
+        }
+    }
+    return YES;
+}
+
+@end
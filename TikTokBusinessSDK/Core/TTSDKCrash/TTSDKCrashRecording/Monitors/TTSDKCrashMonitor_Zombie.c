@@ -32,20 +32,18 @@
 #include "TTSDKCrashMonitorContext.h"
 #include "TTSDKLogger.h"
 #include "TTSDKObjC.h"
+#include "TTSDKZombieCache.h"
 
 #define CACHE_SIZE 0x8000
+#define CLASS_FLAG_CACHE_SIZE 0x1000
 
 // Compiler hints for "if" statements
 #define likely_if(x) if (__builtin_expect(x, 1))
 #define unlikely_if(x) if (__builtin_expect(x, 0))
 
-typedef struct {
-    const void *object;
-    const char *className;
-} Zombie;
-
-static volatile Zombie *g_zombieCache;
-static unsigned g_zombieHashMask;
+static TTSDKZombieCache *g_zombieCache;
+/** Whether a class is NSException or one of its subclasses. */
+static TTSDKClassFlagCache *g_exceptionClassFlags;
 
 static volatile bool g_isEnabled = false;
 
@@ -56,13 +54,6 @@ static struct {
     char reason[900];
 } g_lastDeallocedException;
 
-static inline unsigned hashIndex(const void *object)
-{
-    uintptr_t objPtr = (uintptr_t)object;
-    objPtr >>= (sizeof(object) - 1);
-    return objPtr & g_zombieHashMask;
-}
-
 static bool copyStringIvar(const void *self, const char *ivarName, char *buffer, int bufferLength)
 {
     Class class = object_getClass((id)self);
@@ -104,18 +95,31 @@ static void storeException(const void *exception)
     copyStringIvar(exception, "reason", g_lastDeallocedException.reason, sizeof(g_lastDeallocedException.reason));
 }
 
+static inline bool isExceptionClass(Class class)
+{
+    TTSDKClassFlag flag = ttsdkzc_classFlag(g_exceptionClassFlags, class);
+    likely_if(flag != TTSDKClassFlagUnknown) { return flag == TTSDKClassFlagSet; }
+
+    bool isException = false;
+    for (Class superclass = class; superclass != nil; superclass = class_getSuperclass(superclass)) {
+        unlikely_if(superclass == g_lastDeallocedException.class)
+        {
+            isException = true;
+            break;
+        }
+    }
+    ttsdkzc_setClassFlag(g_exceptionClassFlags, class, isException);
+    return isException;
+}
+
 static inline void handleDealloc(const void *self)
 {
-    volatile Zombie *cache = g_zombieCache;
+    TTSDKZombieCache *cache = g_zombieCache;
     likely_if(cache != NULL)
     {
-        Zombie *zombie = (Zombie *)cache + hashIndex(self);
-        zombie->object = self;
         Class class = object_getClass((id)self);
-        zombie->className = class_getName(class);
-        for (; class != nil; class = class_getSuperclass(class)) {
-            unlikely_if(class == g_lastDeallocedException.class) { storeException(self); }
-        }
+        ttsdkzc_add(cache, self, class_getName(class));
+        unlikely_if(isExceptionClass(class)) { storeException(self); }
     }
 }
 
@@ -146,12 +150,10 @@ CREATE_ZOMBIE_HANDLER_INSTALLER(NSProxy)
 
 static void install(void)
 {
-    unsigned cacheSize = CACHE_SIZE;
-    g_zombieHashMask = cacheSize - 1;
-    g_zombieCache = calloc(cacheSize, sizeof(*g_zombieCache));
+    g_exceptionClassFlags = ttsdkzc_createClassFlags(CLASS_FLAG_CACHE_SIZE);
+    g_zombieCache = ttsdkzc_create(CACHE_SIZE);
     if (g_zombieCache == NULL) {
-        TTSDKLOG_ERROR("Error: Could not allocate %u bytes of memory. TTSDKZombie NOT installed!",
-                    cacheSize * sizeof(*g_zombieCache));
+        TTSDKLOG_ERROR("Error: Could not allocate zombie cache of %d entries. TTSDKZombie NOT installed!", CACHE_SIZE);
         return;
     }
 
@@ -181,16 +183,7 @@ static void install(void)
 
 const char *ttsdkzombie_className(const void *object)
 {
-    volatile Zombie *cache = g_zombieCache;
-    if (cache == NULL || object == NULL) {
-        return NULL;
-    }
-
-    Zombie *zombie = (Zombie *)cache + hashIndex(object);
-    if (zombie->object == object) {
-        return zombie->className;
-    }
-    return NULL;
+    return ttsdkzc_className(g_zombieCache, object);
 }
 
 static const char *monitorId(void) { return "Zombie"; }
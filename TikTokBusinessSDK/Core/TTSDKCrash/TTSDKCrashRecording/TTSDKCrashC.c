@@ -42,6 +42,7 @@
 #include "TTSDKCrashReportC.h"
 #include "TTSDKCrashReportFixer.h"
 #include "TTSDKCrashReportStoreC+Private.h"
+#include "TTSDKDynamicLinker.h"
 #include "TTSDKFileUtils.h"
 #include "TTSDKObjC.h"
 #include "TTSDKString.h"
@@ -92,6 +93,8 @@ static volatile bool g_installed = 0;
 static bool g_shouldAddConsoleLogToReport = false;
 static bool g_shouldPrintPreviousLog = false;
 static char g_consoleLogPath[TTSDKFU_MAX_PATH_LENGTH];
+static char g_reportRegionPath[TTSDKFU_MAX_PATH_LENGTH];
+static int g_preallocatedReportSize = 0;
 static TTSDKCrashMonitorType g_monitoring = TTSDKCrashMonitorTypeProductionSafeMinimal;
 static char g_lastCrashReportFilePath[TTSDKFU_MAX_PATH_LENGTH];
 static TTSDKCrashReportStoreCConfiguration g_reportStoreConfig;
@@ -204,6 +207,7 @@ void handleConfiguration(TTSDKCrashCConfiguration *configuration)
     g_reportWrittenCallback = configuration->reportWrittenCallback;
     g_shouldAddConsoleLogToReport = configuration->addConsoleLogToReport;
     g_shouldPrintPreviousLog = configuration->printPreviousLogOnStartup;
+    g_preallocatedReportSize = configuration->preallocatedReportSize;
 
     if (configuration->enableSwapCxaThrow) {
         ttsdkcm_enableSwapCxaThrow();
@@ -270,8 +274,26 @@ TTSDKCrashInstallErrorCode ttsdkcrash_install(const char *appName, const char *c
         printPreviousLog(g_consoleLogPath);
     }
     ttsdklog_setLogFilename(g_consoleLogPath, true);
+    if (configuration->consoleLogBufferSize > 0 && !ttsdklog_enableRingBuffer(configuration->consoleLogBufferSize)) {
+        TTSDKLOG_ERROR("Could not enable the console log ring buffer. Logging will write directly.");
+    }
+
+    if (g_preallocatedReportSize > 0) {
+        if (snprintf(g_reportRegionPath, sizeof(g_reportRegionPath), "%s/Data/ReportRegion.json", installPath) >=
+            (int)sizeof(g_reportRegionPath)) {
+            TTSDKLOG_ERROR("Report region path is too long.");
+            return TTSDKCrashInstallErrorPathTooLong;
+        }
+        if (!ttsdkcrashreport_reserveReportRegion(g_reportRegionPath, g_preallocatedReportSize)) {
+            TTSDKLOG_ERROR("Could not reserve report region. Reports will use buffered writes.");
+        }
+    }
 
     ttsdkccd_init(60);
+    ttsdkdl_init();
+    if (configuration->symbolIndexPath != NULL && !ttsdkdl_loadSymbolIndex(configuration->symbolIndexPath)) {
+        TTSDKLOG_ERROR("Could not load symbol index %s", configuration->symbolIndexPath);
+    }
 
     ttsdkcm_setEventCallback(onCrash);
     setMonitors(configuration->monitors);
@@ -298,6 +320,10 @@ void ttsdkcrash_reportUserException(const char *name, const char *reason, const
     if (g_shouldAddConsoleLogToReport) {
         ttsdklog_clearLogFile();
     }
+    if (g_preallocatedReportSize > 0) {
+        // The report just written consumed the region, so map a fresh one for the next crash.
+        ttsdkcrashreport_reserveReportRegion(g_reportRegionPath, g_preallocatedReportSize);
+    }
 }
 
 void ttsdkcrash_notifyObjCLoad(void) { ttsdkcrashstate_notifyObjCLoad(); }
@@ -34,21 +34,15 @@
 #include <unistd.h>
 
 #include "TTSDKLogger.h"
+#include "TTSDKThreadRegistry.h"
 
-#define SWAP_POINTERS(A, B) \
-    {                       \
-        void *temp = A;     \
-        A = B;              \
-        B = temp;           \
-    }
+#define TTSDKCCD_InitialThreadCapacity 128
+#define TTSDKCCD_MaxThreadNameLength 64
+#define TTSDKCCD_MaxQueueNameLength 1000
 
 static int g_pollingIntervalInSeconds;
 static pthread_t g_cacheThread;
-static TTSDKThread *g_allMachThreads;
-static TTSDKThread *g_allPThreads;
-static const char **g_allThreadNames;
-static const char **g_allQueueNames;
-static int g_allThreadsCount;
+static TTSDKThreadRegistry *g_threadRegistry;
 static _Atomic(int) g_semaphoreCount;
 static bool g_searchQueueNames = false;
 static bool g_hasThreadStarted = false;
@@ -56,12 +50,6 @@ static bool g_hasThreadStarted = false;
 static void updateThreadList(void)
 {
     const task_t thisTask = mach_task_self();
-    int oldThreadsCount = g_allThreadsCount;
-    TTSDKThread *allMachThreads = NULL;
-    TTSDKThread *allPThreads = NULL;
-    static const char **allThreadNames;
-    static const char **allQueueNames;
-
     mach_msg_type_number_t allThreadsCount;
     thread_act_array_t threads;
     kern_return_t kr;
@@ -70,55 +58,24 @@ static void updateThreadList(void)
         return;
     }
 
-    allMachThreads = calloc(allThreadsCount, sizeof(*allMachThreads));
-    allPThreads = calloc(allThreadsCount, sizeof(*allPThreads));
-    allThreadNames = calloc(allThreadsCount, sizeof(*allThreadNames));
-    allQueueNames = calloc(allThreadsCount, sizeof(*allQueueNames));
-
-    for (mach_msg_type_number_t i = 0; i < allThreadsCount; i++) {
-        char buffer[1000];
-        thread_t thread = threads[i];
-        pthread_t pthread = pthread_from_mach_thread_np(thread);
-        allMachThreads[i] = (TTSDKThread)thread;
-        allPThreads[i] = (TTSDKThread)pthread;
-        if (pthread != 0 && pthread_getname_np(pthread, buffer, sizeof(buffer)) == 0 && buffer[0] != 0) {
-            allThreadNames[i] = strdup(buffer);
-        }
-        if (g_searchQueueNames && ttsdkthread_getQueueName((TTSDKThread)thread, buffer, sizeof(buffer)) && buffer[0] != 0) {
-            allQueueNames[i] = strdup(buffer);
-        }
-    }
-
-    g_allThreadsCount = g_allThreadsCount < (int)allThreadsCount ? g_allThreadsCount : (int)allThreadsCount;
-    SWAP_POINTERS(g_allMachThreads, allMachThreads);
-    SWAP_POINTERS(g_allPThreads, allPThreads);
-    SWAP_POINTERS(g_allThreadNames, allThreadNames);
-    SWAP_POINTERS(g_allQueueNames, allQueueNames);
-    g_allThreadsCount = (int)allThreadsCount;
-
-    if (allMachThreads != NULL) {
-        free(allMachThreads);
-    }
-    if (allPThreads != NULL) {
-        free(allPThreads);
-    }
-    if (allThreadNames != NULL) {
-        for (int i = 0; i < oldThreadsCount; i++) {
-            const char *name = allThreadNames[i];
-            if (name != NULL) {
-                free((void *)name);
-            }
+    // Names are read into reusable buffers; the registry only copies them if the snapshot changes.
+    if (ttsdktr_beginUpdate(g_threadRegistry, (int)allThreadsCount)) {
+        static char threadName[TTSDKCCD_MaxThreadNameLength + 1];
+        static char queueName[TTSDKCCD_MaxQueueNameLength];
+        for (mach_msg_type_number_t i = 0; i < allThreadsCount; i++) {
+            thread_t thread = threads[i];
+            pthread_t pthread = pthread_from_mach_thread_np(thread);
+            bool hasThreadName = pthread != 0 && pthread_getname_np(pthread, threadName, sizeof(threadName)) == 0 &&
+                                 threadName[0] != 0;
+            bool hasQueueName = g_searchQueueNames &&
+                                ttsdkthread_getQueueName((TTSDKThread)thread, queueName, sizeof(queueName)) &&
+                                queueName[0] != 0;
+            ttsdktr_addThread(g_threadRegistry, (TTSDKThread)thread, (TTSDKThread)pthread,
+                              hasThreadName ? threadName : NULL, hasQueueName ? queueName : NULL);
         }
-        free(allThreadNames);
-    }
-    if (allQueueNames != NULL) {
-        for (int i = 0; i < oldThreadsCount; i++) {
-            const char *name = allQueueNames[i];
-            if (name != NULL) {
-                free((void *)name);
-            }
+        if (ttsdktr_commitUpdate(g_threadRegistry)) {
+            TTSDKLOG_TRACE("Published thread list with %u threads", allThreadsCount);
         }
-        free(allQueueNames);
     }
 
     for (mach_msg_type_number_t i = 0; i < allThreadsCount; i++) {
@@ -153,6 +110,11 @@ void ttsdkccd_init(int pollingIntervalInSeconds)
     }
     g_hasThreadStarted = true;
     g_pollingIntervalInSeconds = pollingIntervalInSeconds;
+    g_threadRegistry = ttsdktr_create(TTSDKCCD_InitialThreadCapacity);
+    if (g_threadRegistry == NULL) {
+        TTSDKLOG_ERROR("Could not create thread registry. Thread names will be missing from reports.");
+        return;
+    }
     pthread_attr_t attr;
     pthread_attr_init(&attr);
     pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
@@ -181,34 +143,8 @@ void ttsdkccd_unfreeze(void)
 
 void ttsdkccd_setSearchQueueNames(bool searchQueueNames) { g_searchQueueNames = searchQueueNames; }
 
-TTSDKThread *ttsdkccd_getAllThreads(int *threadCount)
-{
-    if (threadCount != NULL) {
-        *threadCount = g_allThreadsCount;
-    }
-    return g_allMachThreads;
-}
+TTSDKThread *ttsdkccd_getAllThreads(int *threadCount) { return ttsdktr_getAllThreads(g_threadRegistry, threadCount); }
 
-const char *ttsdkccd_getThreadName(TTSDKThread thread)
-{
-    if (g_allThreadNames != NULL) {
-        for (int i = 0; i < g_allThreadsCount; i++) {
-            if (g_allMachThreads[i] == thread) {
-                return g_allThreadNames[i];
-            }
-        }
-    }
-    return NULL;
-}
+const char *ttsdkccd_getThreadName(TTSDKThread thread) { return ttsdktr_getThreadName(g_threadRegistry, thread); }
 
-const char *ttsdkccd_getQueueName(TTSDKThread thread)
-{
-    if (g_allQueueNames != NULL) {
-        for (int i = 0; i < g_allThreadsCount; i++) {
-            if (g_allMachThreads[i] == thread) {
-                return g_allQueueNames[i];
-            }
-        }
-    }
-    return NULL;
-}
+const char *ttsdkccd_getQueueName(TTSDKThread thread) { return ttsdktr_getQueueName(g_threadRegistry, thread); }
@@ -61,6 +61,9 @@
         _printPreviousLogOnStartup = cConfig.printPreviousLogOnStartup ? YES : NO;
         _enableSwapCxaThrow = cConfig.enableSwapCxaThrow ? YES : NO;
         _enableSigTermMonitoring = cConfig.enableSigTermMonitoring ? YES : NO;
+        _preallocatedReportSize = (NSInteger)cConfig.preallocatedReportSize;
+        _symbolIndexPath = nil;
+        _consoleLogBufferSize = (NSInteger)cConfig.consoleLogBufferSize;
 
         _reportStoreConfiguration = [TTSDKCrashReportStoreConfiguration new];
         _reportStoreConfiguration.appName = nil;
@@ -104,6 +107,9 @@
     config.printPreviousLogOnStartup = self.printPreviousLogOnStartup;
     config.enableSwapCxaThrow = self.enableSwapCxaThrow;
     config.enableSigTermMonitoring = self.enableSigTermMonitoring;
+    config.preallocatedReportSize = (int)self.preallocatedReportSize;
+    config.symbolIndexPath = self.symbolIndexPath ? strdup(self.symbolIndexPath.fileSystemRepresentation) : NULL;
+    config.consoleLogBufferSize = (int)self.consoleLogBufferSize;
 
     return config;
 }
@@ -157,6 +163,9 @@
     copy.printPreviousLogOnStartup = self.printPreviousLogOnStartup;
     copy.enableSwapCxaThrow = self.enableSwapCxaThrow;
     copy.enableSigTermMonitoring = self.enableSigTermMonitoring;
+    copy.preallocatedReportSize = self.preallocatedReportSize;
+    copy.symbolIndexPath = [self.symbolIndexPath copyWithZone:zone];
+    copy.consoleLogBufferSize = self.consoleLogBufferSize;
     return copy;
 }
 
@@ -75,6 +75,9 @@
 /** Default number of objects, subobjects, and ivars to record from a memory loc */
 #define kDefaultMemorySearchDepth 15
 
+/** How much of the most recent console log to put in a report when it's held in memory. */
+#define kConsoleLogReportSize (32 * 1024)
+
 /** How far to search the stack (in pointer sized jumps) for notable data. */
 #define kStackNotableSearchBackDistance 20
 #define kStackNotableSearchForwardDistance 10
@@ -120,6 +123,7 @@ static pthread_mutex_t g_userInfoMutex = PTHREAD_MUTEX_INITIALIZER;
 
 static TTSDKCrash_IntrospectionRules g_introspectionRules;
 static TTSDKReportWriteCallback g_userSectionWriteCallback;
+static TTSDKMappedRegion g_reportRegion;
 
 extern void * TikTokBusinessSDKFuncBeginAddress(void);
 extern void * TikTokBusinessSDKFuncEndAddress(void);
@@ -294,6 +298,22 @@ static void addTextLinesFromFile(const TTSDKCrashReportWriter *const writer, con
     ttsdkfu_closeBufferedReader(&reader);
 }
 
+static void addConsoleLogLine(const char *line, int length, void *userData)
+{
+    const TTSDKCrashReportWriter *const writer = userData;
+    ttsdkjson_addStringElement(getJsonContext(writer), NULL, line, length);
+}
+
+/** Add the tail of the in-memory console log, which is more up to date than the log file. */
+static void addConsoleLogLinesFromRing(const TTSDKCrashReportWriter *const writer, const char *const key)
+{
+    beginArray(writer, key);
+    {
+        ttsdklog_readRecentLines(kConsoleLogReportSize, addConsoleLogLine, (void *)writer);
+    }
+    endContainer(writer);
+}
+
 static int addJSONData(const char *restrict const data, const int length, void *restrict userData)
 {
     TTSDKBufferedWriter *writer = (TTSDKBufferedWriter *)userData;
@@ -1124,38 +1144,34 @@ static void writeAllThreads(const TTSDKCrashReportWriter *const writer, const ch
  *
  * @param key The object key, if needed.
  *
- * @param index Which image to write about.
+ * @param image The image to write about.
  */
-static void writeBinaryImage(const TTSDKCrashReportWriter *const writer, const char *const key, const int index)
+static void writeBinaryImage(const TTSDKCrashReportWriter *const writer, const char *const key,
+                             const TTSDKBinaryImage *const image)
 {
-    TTSDKBinaryImage image = { 0 };
-    if (!ttsdkdl_getBinaryImage(index, &image)) {
-        return;
-    }
-
     writer->beginObject(writer, key);
     {
-        writer->addUIntegerElement(writer, TTSDKCrashField_ImageAddress, image.address);
-        writer->addUIntegerElement(writer, TTSDKCrashField_ImageVmAddress, image.vmAddress);
-        writer->addUIntegerElement(writer, TTSDKCrashField_ImageSize, image.size);
-        writer->addStringElement(writer, TTSDKCrashField_Name, image.name);
-        writer->addUUIDElement(writer, TTSDKCrashField_UUID, image.uuid);
-        writer->addIntegerElement(writer, TTSDKCrashField_CPUType, image.cpuType);
-        writer->addIntegerElement(writer, TTSDKCrashField_CPUSubType, image.cpuSubType);
-        writer->addUIntegerElement(writer, TTSDKCrashField_ImageMajorVersion, image.majorVersion);
-        writer->addUIntegerElement(writer, TTSDKCrashField_ImageMinorVersion, image.minorVersion);
-        writer->addUIntegerElement(writer, TTSDKCrashField_ImageRevisionVersion, image.revisionVersion);
-        if (image.crashInfoMessage != NULL) {
-            writer->addStringElement(writer, TTSDKCrashField_ImageCrashInfoMessage, image.crashInfoMessage);
+        writer->addUIntegerElement(writer, TTSDKCrashField_ImageAddress, image->address);
+        writer->addUIntegerElement(writer, TTSDKCrashField_ImageVmAddress, image->vmAddress);
+        writer->addUIntegerElement(writer, TTSDKCrashField_ImageSize, image->size);
+        writer->addStringElement(writer, TTSDKCrashField_Name, image->name);
+        writer->addUUIDElement(writer, TTSDKCrashField_UUID, image->uuid);
+        writer->addIntegerElement(writer, TTSDKCrashField_CPUType, image->cpuType);
+        writer->addIntegerElement(writer, TTSDKCrashField_CPUSubType, image->cpuSubType);
+        writer->addUIntegerElement(writer, TTSDKCrashField_ImageMajorVersion, image->majorVersion);
+        writer->addUIntegerElement(writer, TTSDKCrashField_ImageMinorVersion, image->minorVersion);
+        writer->addUIntegerElement(writer, TTSDKCrashField_ImageRevisionVersion, image->revisionVersion);
+        if (image->crashInfoMessage != NULL) {
+            writer->addStringElement(writer, TTSDKCrashField_ImageCrashInfoMessage, image->crashInfoMessage);
         }
-        if (image.crashInfoMessage2 != NULL) {
-            writer->addStringElement(writer, TTSDKCrashField_ImageCrashInfoMessage2, image.crashInfoMessage2);
+        if (image->crashInfoMessage2 != NULL) {
+            writer->addStringElement(writer, TTSDKCrashField_ImageCrashInfoMessage2, image->crashInfoMessage2);
         }
-        if (image.crashInfoBacktrace != NULL) {
-            writer->addStringElement(writer, TTSDKCrashField_ImageCrashInfoBacktrace, image.crashInfoBacktrace);
+        if (image->crashInfoBacktrace != NULL) {
+            writer->addStringElement(writer, TTSDKCrashField_ImageCrashInfoBacktrace, image->crashInfoBacktrace);
         }
-        if (image.crashInfoSignature != NULL) {
-            writer->addStringElement(writer, TTSDKCrashField_ImageCrashInfoSignature, image.crashInfoSignature);
+        if (image->crashInfoSignature != NULL) {
+            writer->addStringElement(writer, TTSDKCrashField_ImageCrashInfoSignature, image->crashInfoSignature);
         }
     }
     writer->endContainer(writer);
@@ -1169,12 +1185,19 @@ static void writeBinaryImage(const TTSDKCrashReportWriter *const writer, const c
  */
 static void writeBinaryImages(const TTSDKCrashReportWriter *const writer, const char *const key)
 {
-    const int imageCount = ttsdkdl_imageCount();
+    // Prefer the records parsed at load time over parsing every image now.
+    const int cachedCount = ttsdkdl_cachedImageCount();
+    const bool useCache = cachedCount >= 0;
+    const int imageCount = useCache ? cachedCount : ttsdkdl_imageCount();
 
     writer->beginArray(writer, key);
     {
         for (int iImg = 0; iImg < imageCount; iImg++) {
-            writeBinaryImage(writer, NULL, iImg);
+            TTSDKBinaryImage image = { 0 };
+            bool found = useCache ? ttsdkdl_getCachedBinaryImage(iImg, &image) : ttsdkdl_getBinaryImage(iImg, &image);
+            if (found) {
+                writeBinaryImage(writer, NULL, &image);
+            }
         }
     }
     writer->endContainer(writer);
@@ -1443,6 +1466,7 @@ void ttsdkcrashreport_writeRecrashReport(const TTSDKCrash_MonitorContext *const
     strncpy(tempPath + strlen(tempPath) - 5, ".old", 5);
     TTSDKLOG_INFO("Writing recrash report to %s", path);
 
+    ttsdkfu_truncateMappedRegion(&g_reportRegion);
     if (rename(path, tempPath) < 0) {
         TTSDKLOG_ERROR("Could not rename %s to %s: %s", path, tempPath, strerror(errno));
     }
@@ -1555,7 +1579,11 @@ static void writeDebugInfo(const TTSDKCrashReportWriter *const writer, const cha
     writer->beginObject(writer, key);
     {
         if (monitorContext->consoleLogPath != NULL) {
-            addTextLinesFromFile(writer, TTSDKCrashField_ConsoleLog, monitorContext->consoleLogPath);
+            if (ttsdklog_isRingBufferEnabled()) {
+                addConsoleLogLinesFromRing(writer, TTSDKCrashField_ConsoleLog);
+            } else {
+                addTextLinesFromFile(writer, TTSDKCrashField_ConsoleLog, monitorContext->consoleLogPath);
+            }
         }
     }
     writer->endContainer(writer);
@@ -1567,7 +1595,8 @@ void ttsdkcrashreport_writeStandardReport(const TTSDKCrash_MonitorContext *const
     char writeBuffer[1024];
     TTSDKBufferedWriter bufferedWriter;
 
-    if (!ttsdkfu_openBufferedWriter(&bufferedWriter, path, writeBuffer, sizeof(writeBuffer))) {
+    if (!ttsdkfu_openMappedWriter(&bufferedWriter, &g_reportRegion, path, writeBuffer, sizeof(writeBuffer)) &&
+        !ttsdkfu_openBufferedWriter(&bufferedWriter, path, writeBuffer, sizeof(writeBuffer))) {
         return;
     }
 
@@ -1696,6 +1725,17 @@ void ttsdkcrashreport_setDoNotIntrospectClasses(const char **doNotIntrospectClas
     }
 }
 
+bool ttsdkcrashreport_reserveReportRegion(const char *const path, int size)
+{
+    TTSDKLOG_DEBUG("Reserving %d byte report region at %s", size, path);
+    if (g_reportRegion.isInUse) {
+        TTSDKLOG_ERROR("Cannot reserve a report region while a report is being written");
+        return false;
+    }
+    ttsdkfu_releaseMappedRegion(&g_reportRegion);
+    return ttsdkfu_reserveMappedRegion(&g_reportRegion, path, size);
+}
+
 void ttsdkcrashreport_setUserSectionWriteCallback(const TTSDKReportWriteCallback userSectionWriteCallback)
 {
     TTSDKLOG_TRACE("Set userSectionWriteCallback to %p", userSectionWriteCallback);
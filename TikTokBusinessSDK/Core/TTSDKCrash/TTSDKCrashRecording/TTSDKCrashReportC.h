@@ -79,6 +79,21 @@ void ttsdkcrashreport_setDoNotIntrospectClasses(const char **doNotIntrospectClas
  */
 void ttsdkcrashreport_setUserSectionWriteCallback(const TTSDKReportWriteCallback userSectionWriteCallback);
 
+/** Reserve and memory-map a file region for the next standard report.
+ *  The report writer will copy into the mapped memory instead of issuing write
+ *  calls, and truncate the file to its final size when done.
+ *  Only one report can be written into a reserved region. Any previously
+ *  reserved, unused region is released first.
+ *
+ * @param path The path of the region's backing file. It must be on the same
+ *             volume as the reports directory.
+ *
+ * @param size The size of the region in bytes.
+ *
+ * @return true if the region was reserved.
+ */
+bool ttsdkcrashreport_reserveReportRegion(const char *const path, int size);
+
 // ============================================================================
 #pragma mark - Main API -
 // ============================================================================
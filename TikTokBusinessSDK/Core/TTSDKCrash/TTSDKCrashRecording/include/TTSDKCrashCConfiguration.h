@@ -220,6 +220,37 @@ typedef struct {
      * **Default**: false
      */
     bool enableSigTermMonitoring;
+
+    /** Size in bytes of a report file to preallocate and memory-map at install time.
+     *
+     * When set, the crash-time report writer copies into the mapped file instead of
+     * making a `write` call every time its small stack buffer fills up, and truncates
+     * the file to its final size when done. Reports that outgrow the region continue
+     * with regular buffered writes. Set to 0 to disable this feature.
+     *
+     * **Default**: 0
+     */
+    int preallocatedReportSize;
+
+    /** Path to a symbol index for the main executable, as written by ttsdkdl_writeSymbolIndex().
+     *
+     * When set and built for this exact binary, the index is mapped at install time and
+     * used to name the executable's frames in reports, even if the binary is stripped.
+     *
+     * **Default**: NULL
+     */
+    const char *symbolIndexPath;
+
+    /** Size in bytes of an in-memory ring buffer for the console log.
+     *
+     * When set, log calls only copy into the ring and a background thread writes
+     * the console log file. Crash reports then take the tail of the console log
+     * straight from memory instead of re-reading the file, so they also include
+     * lines that hadn't reached the file yet. Set to 0 to disable this feature.
+     *
+     * **Default**: 0
+     */
+    int consoleLogBufferSize;
 } TTSDKCrashCConfiguration;
 
 static inline TTSDKCrashCConfiguration TTSDKCrashCConfiguration_Default(void)
@@ -238,6 +269,9 @@ static inline TTSDKCrashCConfiguration TTSDKCrashCConfiguration_Default(void)
         .printPreviousLogOnStartup = false,
         .enableSwapCxaThrow = true,
         .enableSigTermMonitoring = false,
+        .preallocatedReportSize = 0,
+        .symbolIndexPath = NULL,
+        .consoleLogBufferSize = 0,
     };
 }
 
@@ -245,6 +279,7 @@ static inline void TTSDKCrashCConfiguration_Release(TTSDKCrashCConfiguration *co
 {
     TTSDKCrashReportStoreCConfiguration_Release(&configuration->reportStoreConfiguration);
     free((void *)configuration->userInfoJSON);
+    free((void *)configuration->symbolIndexPath);
     for (int idx = 0; idx < configuration->doNotIntrospectClasses.length; ++idx) {
         free((void *)(configuration->doNotIntrospectClasses.strings[idx]));
     }
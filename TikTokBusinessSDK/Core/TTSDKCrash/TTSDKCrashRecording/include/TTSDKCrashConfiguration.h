@@ -163,6 +163,36 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property(nonatomic, assign) BOOL enableSigTermMonitoring;
 
+/** Size in bytes of a report file to preallocate and memory-map at install time.
+ *
+ * When set, the crash-time report writer copies into the mapped file instead of
+ * making a `write` call every time its small stack buffer fills up, and truncates
+ * the file to its final size when done. Reports that outgrow the region continue
+ * with regular buffered writes. Set to 0 to disable this feature.
+ *
+ * **Default**: 0
+ */
+@property(nonatomic, assign) NSInteger preallocatedReportSize;
+
+/** Path to a symbol index for the main executable.
+ *
+ * When set and built for this exact binary, the index is mapped at install time and
+ * used to name the executable's frames in reports, even if the binary is stripped.
+ *
+ * **Default**: nil
+ */
+@property(nonatomic, copy, nullable) NSString *symbolIndexPath;
+
+/** Size in bytes of an in-memory ring buffer for the console log.
+ *
+ * When set, log calls only copy into the ring and a background thread writes
+ * the console log file. Crash reports then take the tail of the console log
+ * straight from memory instead of re-reading the file. Set to 0 to disable this feature.
+ *
+ * **Default**: 0
+ */
+@property(nonatomic, assign) NSInteger consoleLogBufferSize;
+
 @end
 
 NS_SWIFT_NAME(CrashReportStoreConfiguration)
@@ -31,11 +31,17 @@
 #include <mach-o/getsect.h>
 #include <mach-o/nlist.h>
 #include <mach-o/stab.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
+#include "TTSDKImageRangeIndex.h"
 #include "TTSDKLogger.h"
 #include "TTSDKMemory.h"
 #include "TTSDKPlatformSpecificDefines.h"
+#include "TTSDKSymbolTable.h"
 
 #ifndef TTSDKDL_MaxCrashInfoStringLength
 #define TTSDKDL_MaxCrashInfoStringLength 4096
@@ -55,6 +61,40 @@ typedef struct {
 #pragma pack()
 #define TTSDKDL_SECT_CRASH_INFO "__crash_info"
 
+/** Most images map four segments (__TEXT, __DATA_CONST, __DATA, __LINKEDIT). */
+#define TTSDKDL_InitialImageRangeCapacity 2048
+#define TTSDKDL_MaxSegmentsPerImage 16
+
+/** Symbol tables are built once launch has settled, and stop at this much memory.
+ * System libraries export a lot of symbols, so they only get what the app's own images leave over.
+ */
+#define TTSDKDL_SymbolTableBuildDelayInSeconds 5
+#define TTSDKDL_SymbolTableMemoryBudget (16 * 1024 * 1024)
+
+#ifndef MH_DYLIB_IN_CACHE
+#define MH_DYLIB_IN_CACHE 0x80000000
+#endif
+
+/** Room for this many image loads over the life of the process. Unloads don't free a slot. */
+#define TTSDKDL_BinaryImageCacheCapacity 2048
+
+/** A binary image as parsed when it was loaded.
+ * The crash info messages can change at any time, so only the section is cached, not its contents.
+ */
+typedef struct {
+    TTSDKBinaryImage image;
+    const crash_info_t *crashInfo;
+    unsigned long crashInfoSize;
+    _Atomic(bool) isLoaded;
+} TTSDKCachedBinaryImage;
+
+static TTSDKImageRangeIndex *g_imageRangeIndex;
+
+static TTSDKCachedBinaryImage *g_binaryImages;
+static _Atomic(int) g_binaryImageCount;
+static _Atomic(bool) g_isBinaryImageCacheComplete;
+static pthread_mutex_t g_binaryImageMutex = PTHREAD_MUTEX_INITIALIZER;
+
 /** Get the address of the first command following a header (which will be of
  * type struct load_command).
  *
@@ -121,13 +161,11 @@ static uint32_t imageIndexContainingAddress(const uintptr_t address)
  *
  * This is required for any symtab command offsets.
  *
- * @param idx The image index.
+ * @param header The image header.
  * @return The image's base address, or 0 if none was found.
  */
-static uintptr_t segmentBaseOfImageIndex(const uint32_t idx)
+static uintptr_t segmentBaseOfImageHeader(const struct mach_header *const header)
 {
-    const struct mach_header *header = _dyld_get_image_header(idx);
-
     // Look for a segment command and return the file image address.
     uintptr_t cmdPtr = firstCmdAfterHeader(header);
     if (cmdPtr == 0) {
@@ -152,6 +190,368 @@ static uintptr_t segmentBaseOfImageIndex(const uint32_t idx)
     return 0;
 }
 
+/** Get the unslid address of an image's __TEXT segment, which symbol offsets are relative to.
+ *
+ * @param header The image header.
+ * @return The address, or UINT64_MAX if the image has no __TEXT segment.
+ */
+static uint64_t textAddressOfImageHeader(const struct mach_header *const header)
+{
+    uintptr_t cmdPtr = firstCmdAfterHeader(header);
+    if (cmdPtr == 0) {
+        return UINT64_MAX;
+    }
+    for (uint32_t i = 0; i < header->ncmds; i++) {
+        const struct load_command *loadCmd = (struct load_command *)cmdPtr;
+        if (loadCmd->cmd == LC_SEGMENT) {
+            const struct segment_command *segmentCmd = (struct segment_command *)cmdPtr;
+            if (strcmp(segmentCmd->segname, SEG_TEXT) == 0) {
+                return segmentCmd->vmaddr;
+            }
+        } else if (loadCmd->cmd == LC_SEGMENT_64) {
+            const struct segment_command_64 *segmentCmd = (struct segment_command_64 *)cmdPtr;
+            if (strcmp(segmentCmd->segname, SEG_TEXT) == 0) {
+                return segmentCmd->vmaddr;
+            }
+        }
+        cmdPtr += loadCmd->cmdsize;
+    }
+    return UINT64_MAX;
+}
+
+/** Get the symbol table command of an image.
+ *
+ * @param header The image header.
+ * @return The command, or NULL if the image has no symbol table.
+ */
+static const struct symtab_command *symtabOfImageHeader(const struct mach_header *const header)
+{
+    uintptr_t cmdPtr = firstCmdAfterHeader(header);
+    if (cmdPtr == 0) {
+        return NULL;
+    }
+    for (uint32_t iCmd = 0; iCmd < header->ncmds; iCmd++) {
+        const struct load_command *loadCmd = (struct load_command *)cmdPtr;
+        if (loadCmd->cmd == LC_SYMTAB) {
+            return (const struct symtab_command *)cmdPtr;
+        }
+        cmdPtr += loadCmd->cmdsize;
+    }
+    return NULL;
+}
+
+/** Get the UUID of an image.
+ *
+ * @param header The image header.
+ * @return The UUID, or NULL if the image has none.
+ */
+static const uint8_t *uuidOfImageHeader(const struct mach_header *const header)
+{
+    uintptr_t cmdPtr = firstCmdAfterHeader(header);
+    if (cmdPtr == 0) {
+        return NULL;
+    }
+    for (uint32_t iCmd = 0; iCmd < header->ncmds; iCmd++) {
+        const struct load_command *loadCmd = (struct load_command *)cmdPtr;
+        if (loadCmd->cmd == LC_UUID) {
+            struct uuid_command *uuidCmd = (struct uuid_command *)cmdPtr;
+            return uuidCmd->uuid;
+        }
+        cmdPtr += loadCmd->cmdsize;
+    }
+    return NULL;
+}
+
+/** Collect the mapped segments of an image into index ranges.
+ * Segments without any access rights (__PAGEZERO) are skipped since they overlap other images.
+ */
+static int rangesForImage(const struct mach_header *header, intptr_t slide, const char *name,
+                          TTSDKImageRange *ranges, int maxCount)
+{
+    uintptr_t cmdPtr = firstCmdAfterHeader(header);
+    if (cmdPtr == 0) {
+        return 0;
+    }
+    int count = 0;
+    for (uint32_t iCmd = 0; iCmd < header->ncmds && count < maxCount; iCmd++) {
+        const struct load_command *loadCmd = (struct load_command *)cmdPtr;
+        uint64_t vmaddr = 0;
+        uint64_t vmsize = 0;
+        vm_prot_t initprot = VM_PROT_NONE;
+        if (loadCmd->cmd == LC_SEGMENT) {
+            const struct segment_command *segCmd = (struct segment_command *)cmdPtr;
+            vmaddr = segCmd->vmaddr;
+            vmsize = segCmd->vmsize;
+            initprot = segCmd->initprot;
+        } else if (loadCmd->cmd == LC_SEGMENT_64) {
+            const struct segment_command_64 *segCmd = (struct segment_command_64 *)cmdPtr;
+            vmaddr = segCmd->vmaddr;
+            vmsize = segCmd->vmsize;
+            initprot = segCmd->initprot;
+        }
+        if (vmsize > 0 && initprot != VM_PROT_NONE) {
+            ranges[count++] = (TTSDKImageRange) {
+                .start = (uintptr_t)vmaddr + (uintptr_t)slide,
+                .end = (uintptr_t)(vmaddr + vmsize) + (uintptr_t)slide,
+                .header = header,
+                .slide = slide,
+                .name = name,
+            };
+        }
+        cmdPtr += loadCmd->cmdsize;
+    }
+    return count;
+}
+
+static const crash_info_t *findCrashInfo(const struct mach_header *header, unsigned long *size);
+static void readCrashInfo(const crash_info_t *crashInfo, unsigned long size, TTSDKBinaryImage *buffer);
+
+static void cacheBinaryImage(const struct mach_header *header, const char *name)
+{
+    pthread_mutex_lock(&g_binaryImageMutex);
+    int count = atomic_load(&g_binaryImageCount);
+    if (g_binaryImages == NULL || count >= TTSDKDL_BinaryImageCacheCapacity) {
+        if (atomic_exchange(&g_isBinaryImageCacheComplete, false)) {
+            TTSDKLOG_ERROR("Binary image cache is full. Reports will parse images at crash time.");
+        }
+    } else {
+        TTSDKCachedBinaryImage *record = &g_binaryImages[count];
+        if (ttsdkdl_getBinaryImageForHeader(header, name, &record->image)) {
+            // The cached record never carries messages; they are read fresh at crash time.
+            record->image.crashInfoMessage = NULL;
+            record->image.crashInfoMessage2 = NULL;
+            record->image.crashInfoBacktrace = NULL;
+            record->image.crashInfoSignature = NULL;
+            record->crashInfo = findCrashInfo(header, &record->crashInfoSize);
+            atomic_store(&record->isLoaded, true);
+            atomic_store(&g_binaryImageCount, count + 1);
+        } else if (atomic_exchange(&g_isBinaryImageCacheComplete, false)) {
+            // A cache missing this image would leave it out of reports
+            TTSDKLOG_ERROR("Could not cache binary image %s. Reports will parse images at crash time.", name);
+        }
+    }
+    pthread_mutex_unlock(&g_binaryImageMutex);
+}
+
+static void uncacheBinaryImage(const struct mach_header *header)
+{
+    pthread_mutex_lock(&g_binaryImageMutex);
+    int count = atomic_load(&g_binaryImageCount);
+    for (int i = count - 1; i >= 0; i--) {
+        if (g_binaryImages[i].image.address == (uintptr_t)header && atomic_load(&g_binaryImages[i].isLoaded)) {
+            atomic_store(&g_binaryImages[i].isLoaded, false);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&g_binaryImageMutex);
+}
+
+static void onImageAdded(const struct mach_header *header, intptr_t slide)
+{
+    Dl_info info = { 0 };
+    if (dladdr(header, &info) == 0) {
+        TTSDKLOG_DEBUG("Could not resolve name of image at %p", header);
+    }
+    TTSDKImageRange ranges[TTSDKDL_MaxSegmentsPerImage];
+    int count = rangesForImage(header, slide, info.dli_fname, ranges, TTSDKDL_MaxSegmentsPerImage);
+    if (!ttsdkiri_addImage(g_imageRangeIndex, ranges, count)) {
+        TTSDKLOG_ERROR("Could not index image %s", info.dli_fname);
+    }
+    cacheBinaryImage(header, info.dli_fname);
+}
+
+static void onImageRemoved(const struct mach_header *header, __unused intptr_t slide)
+{
+    ttsdkiri_removeImage(g_imageRangeIndex, header);
+    ttsdksym_retireTable(header);
+    uncacheBinaryImage(header);
+}
+
+/** Build a sorted table from an image's symbols, using the same filter as the linear scan in ttsdkdl_dladdr().
+ *
+ * @param header The image header.
+ * @param slide The image's VM address slide.
+ * @param maxSymbols Images with more symbols than this are skipped.
+ * @return The table, or NULL if the image has no usable symbols or is too big.
+ */
+static TTSDKSymbolTable *buildSymbolTable(const struct mach_header *header, intptr_t slide, uint32_t maxSymbols)
+{
+    const struct symtab_command *symtabCmd = symtabOfImageHeader(header);
+    const uint64_t textAddress = textAddressOfImageHeader(header);
+    const uintptr_t linkeditBase = segmentBaseOfImageHeader(header);
+    if (symtabCmd == NULL || symtabCmd->nsyms == 0 || symtabCmd->nsyms > maxSymbols ||
+        textAddress == UINT64_MAX || linkeditBase == 0) {
+        return NULL;
+    }
+    const uintptr_t segmentBase = linkeditBase + (uintptr_t)slide;
+    const nlist_t *symbolTable = (nlist_t *)(segmentBase + symtabCmd->symoff);
+    const char *stringTable = (const char *)(segmentBase + symtabCmd->stroff);
+
+    TTSDKSymbolEntry *entries = malloc(sizeof(*entries) * symtabCmd->nsyms);
+    if (entries == NULL) {
+        return NULL;
+    }
+    int count = 0;
+    for (uint32_t iSym = 0; iSym < symtabCmd->nsyms; iSym++) {
+        const nlist_t *symbol = &symbolTable[iSym];
+        if ((symbol->n_type & N_STAB) != 0 || symbol->n_value == 0) {
+            continue;
+        }
+        if (symbol->n_value < textAddress || symbol->n_value - textAddress > UINT32_MAX) {
+            continue;
+        }
+        bool hasName = symbol->n_desc != 16 && symbol->n_un.n_strx < symtabCmd->strsize;
+        entries[count++] = (TTSDKSymbolEntry) {
+            .offset = (uint32_t)(symbol->n_value - textAddress),
+            .nameOffset = hasName ? (uint32_t)symbol->n_un.n_strx : TTSDKSymbolNoName,
+        };
+    }
+    TTSDKSymbolTable *table =
+        count > 0 ? ttsdksym_createTable(header, textAddress, stringTable, symtabCmd->strsize, entries, count) : NULL;
+    free(entries);
+    return table;
+}
+
+static void *buildSymbolTables(__unused void *const userData)
+{
+    sleep(TTSDKDL_SymbolTableBuildDelayInSeconds);
+
+    size_t budget = TTSDKDL_SymbolTableMemoryBudget;
+    int builtCount = 0;
+    // The app's own images come first: they are the likeliest to crash and the
+    // likeliest to be missing from a system symbolicator.
+    for (int pass = 0; pass < 2; pass++) {
+        const bool wantCachedImages = pass == 1;
+        const uint32_t imageCount = _dyld_image_count();
+        for (uint32_t iImg = 0; iImg < imageCount; iImg++) {
+            const struct mach_header *header = _dyld_get_image_header(iImg);
+            if (header == NULL || ttsdksym_tableForImage(header) != NULL) {
+                continue;
+            }
+            if (((header->flags & MH_DYLIB_IN_CACHE) != 0) != wantCachedImages) {
+                continue;
+            }
+            TTSDKSymbolTable *table = buildSymbolTable(header, _dyld_get_image_vmaddr_slide(iImg),
+                                                       (uint32_t)(budget / sizeof(TTSDKSymbolEntry)));
+            if (table == NULL) {
+                continue;
+            }
+            size_t cost = (size_t)ttsdksym_symbolCount(table) * sizeof(TTSDKSymbolEntry);
+            if (!ttsdksym_publishTable(table)) {
+                ttsdksym_destroyTable(table);
+                continue;
+            }
+            budget -= cost;
+            builtCount++;
+        }
+    }
+    TTSDKLOG_DEBUG("Built %d symbol tables, %zu bytes of budget left", builtCount, budget);
+    return NULL;
+}
+
+static void startBuildingSymbolTables(void)
+{
+    pthread_t thread;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    pthread_attr_set_qos_class_np(&attr, QOS_CLASS_UTILITY, 0);
+    int error = pthread_create(&thread, &attr, &buildSymbolTables, NULL);
+    if (error != 0) {
+        TTSDKLOG_ERROR("pthread_create: %s", strerror(error));
+    }
+    pthread_attr_destroy(&attr);
+}
+
+/** Find the main executable.
+ *
+ * @param slide Receives the executable's VM address slide.
+ * @return The executable's header, or NULL if none was found.
+ */
+static const struct mach_header *mainExecutableHeader(intptr_t *slide)
+{
+    const uint32_t imageCount = _dyld_image_count();
+    for (uint32_t iImg = 0; iImg < imageCount; iImg++) {
+        const struct mach_header *header = _dyld_get_image_header(iImg);
+        if (header != NULL && header->filetype == MH_EXECUTE) {
+            *slide = _dyld_get_image_vmaddr_slide(iImg);
+            return header;
+        }
+    }
+    return NULL;
+}
+
+void ttsdkdl_init(void)
+{
+    static bool isInitialized = false;
+    if (isInitialized) {
+        return;
+    }
+    isInitialized = true;
+
+    g_imageRangeIndex = ttsdkiri_create(TTSDKDL_InitialImageRangeCapacity);
+    if (g_imageRangeIndex == NULL) {
+        TTSDKLOG_ERROR("Could not create image range index");
+        return;
+    }
+    g_binaryImages = calloc(TTSDKDL_BinaryImageCacheCapacity, sizeof(*g_binaryImages));
+    if (g_binaryImages == NULL) {
+        TTSDKLOG_ERROR("Could not allocate binary image cache");
+    } else {
+        atomic_store(&g_isBinaryImageCacheComplete, true);
+    }
+    // dyld calls the add handler for every image that's already loaded before returning.
+    _dyld_register_func_for_add_image(onImageAdded);
+    _dyld_register_func_for_remove_image(onImageRemoved);
+
+    startBuildingSymbolTables();
+}
+
+bool ttsdkdl_loadSymbolIndex(const char *path)
+{
+    intptr_t slide = 0;
+    const struct mach_header *header = mainExecutableHeader(&slide);
+    const uint8_t *uuid = header != NULL ? uuidOfImageHeader(header) : NULL;
+    if (uuid == NULL) {
+        TTSDKLOG_ERROR("Could not identify the main executable");
+        return false;
+    }
+    TTSDKSymbolTable *table = ttsdksym_openIndexFile(path, header, uuid);
+    if (table == NULL) {
+        return false;
+    }
+    if (ttsdksym_baseAddress(table) != textAddressOfImageHeader(header)) {
+        TTSDKLOG_ERROR("Symbol index %s has a different base address than the executable", path);
+        ttsdksym_destroyTable(table);
+        return false;
+    }
+    if (!ttsdksym_publishTable(table)) {
+        ttsdksym_destroyTable(table);
+        return false;
+    }
+    TTSDKLOG_DEBUG("Loaded %d symbols from %s", ttsdksym_symbolCount(table), path);
+    return true;
+}
+
+bool ttsdkdl_writeSymbolIndex(const char *path)
+{
+    intptr_t slide = 0;
+    const struct mach_header *header = mainExecutableHeader(&slide);
+    const uint8_t *uuid = header != NULL ? uuidOfImageHeader(header) : NULL;
+    if (uuid == NULL) {
+        TTSDKLOG_ERROR("Could not identify the main executable");
+        return false;
+    }
+    TTSDKSymbolTable *table = buildSymbolTable(header, slide, UINT32_MAX);
+    if (table == NULL) {
+        TTSDKLOG_ERROR("The main executable has no symbols to index");
+        return false;
+    }
+    bool success = ttsdksym_writeIndexFile(table, uuid, path);
+    ttsdksym_destroyTable(table);
+    return success;
+}
+
 uint32_t ttsdkdl_imageNamed(const char *const imageName, bool exactMatch)
 {
     if (imageName != NULL) {
@@ -180,17 +580,7 @@ const uint8_t *ttsdkdl_imageUUID(const char *const imageName, bool exactMatch)
         if (iImg != UINT32_MAX) {
             const struct mach_header *header = _dyld_get_image_header(iImg);
             if (header != NULL) {
-                uintptr_t cmdPtr = firstCmdAfterHeader(header);
-                if (cmdPtr != 0) {
-                    for (uint32_t iCmd = 0; iCmd < header->ncmds; iCmd++) {
-                        const struct load_command *loadCmd = (struct load_command *)cmdPtr;
-                        if (loadCmd->cmd == LC_UUID) {
-                            struct uuid_command *uuidCmd = (struct uuid_command *)cmdPtr;
-                            return uuidCmd->uuid;
-                        }
-                        cmdPtr += loadCmd->cmdsize;
-                    }
-                }
+                return uuidOfImageHeader(header);
             }
         }
     }
@@ -204,21 +594,52 @@ bool ttsdkdl_dladdr(const uintptr_t address, Dl_info *const info)
     info->dli_sname = NULL;
     info->dli_saddr = NULL;
 
-    const uint32_t idx = imageIndexContainingAddress(address);
-    if (idx == UINT_MAX) {
-        return false;
+    const struct mach_header *header = NULL;
+    uintptr_t imageVMAddrSlide = 0;
+    const char *imageName = NULL;
+    TTSDKImageRange range;
+    switch (ttsdkiri_find(g_imageRangeIndex, address, &range)) {
+        case TTSDKImageRangeLookupFound:
+            header = range.header;
+            imageVMAddrSlide = (uintptr_t)range.slide;
+            imageName = range.name;
+            break;
+        case TTSDKImageRangeLookupNotFound:
+            return false;
+        case TTSDKImageRangeLookupUnavailable: {
+            const uint32_t idx = imageIndexContainingAddress(address);
+            if (idx == UINT_MAX) {
+                return false;
+            }
+            header = _dyld_get_image_header(idx);
+            imageVMAddrSlide = (uintptr_t)_dyld_get_image_vmaddr_slide(idx);
+            imageName = _dyld_get_image_name(idx);
+            break;
+        }
     }
-    const struct mach_header *header = _dyld_get_image_header(idx);
-    const uintptr_t imageVMAddrSlide = (uintptr_t)_dyld_get_image_vmaddr_slide(idx);
     const uintptr_t addressWithSlide = address - imageVMAddrSlide;
-    const uintptr_t segmentBase = segmentBaseOfImageIndex(idx) + imageVMAddrSlide;
+    const uintptr_t segmentBase = segmentBaseOfImageHeader(header) + imageVMAddrSlide;
     if (segmentBase == 0) {
         return false;
     }
 
-    info->dli_fname = _dyld_get_image_name(idx);
+    info->dli_fname = imageName;
     info->dli_fbase = (void *)header;
 
+    const TTSDKSymbolTable *symbols = ttsdksym_tableForImage(header);
+    if (symbols != NULL) {
+        uint64_t symbolAddress = 0;
+        const char *symbolName = NULL;
+        if (ttsdksym_lookup(symbols, addressWithSlide, &symbolAddress, &symbolName)) {
+            info->dli_saddr = (void *)((uintptr_t)symbolAddress + imageVMAddrSlide);
+            info->dli_sname = symbolName;
+            if (symbolName != NULL && *symbolName == '_') {
+                info->dli_sname++;
+            }
+        }
+        return true;
+    }
+
     // Find symbol tables and get whichever symbol is closest to the address.
     const nlist_t *bestMatch = NULL;
     uintptr_t bestDistance = ULONG_MAX;
@@ -287,11 +708,14 @@ static bool isValidCrashInfoMessage(const char *str)
     return false;
 }
 
-static void getCrashInfo(const struct mach_header *header, TTSDKBinaryImage *buffer)
+static const crash_info_t *findCrashInfo(const struct mach_header *header, unsigned long *size)
+{
+    *size = 0;
+    return (const crash_info_t *)getsectiondata((mach_header_t *)header, SEG_DATA, TTSDKDL_SECT_CRASH_INFO, size);
+}
+
+static void readCrashInfo(const crash_info_t *crashInfo, unsigned long size, TTSDKBinaryImage *buffer)
 {
-    unsigned long size = 0;
-    crash_info_t *crashInfo =
-        (crash_info_t *)getsectiondata((mach_header_t *)header, SEG_DATA, TTSDKDL_SECT_CRASH_INFO, &size);
     if (crashInfo == NULL) {
         return;
     }
@@ -333,8 +757,37 @@ static void getCrashInfo(const struct mach_header *header, TTSDKBinaryImage *buf
     }
 }
 
+static void getCrashInfo(const struct mach_header *header, TTSDKBinaryImage *buffer)
+{
+    unsigned long size = 0;
+    const crash_info_t *crashInfo = findCrashInfo(header, &size);
+    readCrashInfo(crashInfo, size, buffer);
+}
+
 int ttsdkdl_imageCount(void) { return (int)_dyld_image_count(); }
 
+int ttsdkdl_cachedImageCount(void)
+{
+    if (!atomic_load(&g_isBinaryImageCacheComplete)) {
+        return -1;
+    }
+    return atomic_load(&g_binaryImageCount);
+}
+
+bool ttsdkdl_getCachedBinaryImage(int index, TTSDKBinaryImage *buffer)
+{
+    if (index < 0 || index >= atomic_load(&g_binaryImageCount)) {
+        return false;
+    }
+    const TTSDKCachedBinaryImage *record = &g_binaryImages[index];
+    if (!atomic_load(&record->isLoaded)) {
+        return false;
+    }
+    *buffer = record->image;
+    readCrashInfo(record->crashInfo, record->crashInfoSize, buffer);
+    return true;
+}
+
 bool ttsdkdl_getBinaryImage(int index, TTSDKBinaryImage *buffer)
 {
     const struct mach_header *header = _dyld_get_image_header((unsigned)index);
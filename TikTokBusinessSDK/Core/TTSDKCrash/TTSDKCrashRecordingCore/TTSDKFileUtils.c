@@ -395,6 +395,7 @@ bool ttsdkfu_openBufferedWriter(TTSDKBufferedWriter *writer, const char *const p
     writer->buffer = writeBuffer;
     writer->bufferLength = writeBufferLength;
     writer->position = 0;
+    writer->region = NULL;
     writer->fd = open(path, O_RDWR | O_CREAT | O_EXCL, 0644);
     if (writer->fd < 0) {
         TTSDKLOG_ERROR("Could not open crash report file %s: %s", path, strerror(errno));
@@ -403,8 +404,51 @@ bool ttsdkfu_openBufferedWriter(TTSDKBufferedWriter *writer, const char *const p
     return true;
 }
 
+bool ttsdkfu_openMappedWriter(TTSDKBufferedWriter *writer, TTSDKMappedRegion *region, const char *const path,
+                              char *writeBuffer, int writeBufferLength)
+{
+    if (region->memory == NULL || region->isInUse) {
+        return false;
+    }
+    if (rename(region->path, path) < 0) {
+        TTSDKLOG_ERROR("Could not rename %s to %s: %s", region->path, path, strerror(errno));
+        return false;
+    }
+    region->position = 0;
+    region->isInUse = true;
+    writer->buffer = writeBuffer;
+    writer->bufferLength = writeBufferLength;
+    writer->position = 0;
+    writer->fd = region->fd;
+    writer->region = region;
+    return true;
+}
+
+/** Detach a region from its writer, leaving the file sized to the bytes written so far
+ * and the file offset just past them.
+ */
+static bool detachMappedRegion(TTSDKBufferedWriter *writer)
+{
+    TTSDKMappedRegion *region = writer->region;
+    writer->region = NULL;
+    bool isSuccessful = true;
+    if (ftruncate(writer->fd, region->position) < 0 || lseek(writer->fd, region->position, SEEK_SET) < 0) {
+        TTSDKLOG_ERROR("Could not truncate mapped file: %s", strerror(errno));
+        isSuccessful = false;
+    }
+    munmap(region->memory, (size_t)region->length);
+    region->memory = NULL;
+    region->length = 0;
+    region->fd = -1;
+    region->isInUse = false;
+    return isSuccessful;
+}
+
 void ttsdkfu_closeBufferedWriter(TTSDKBufferedWriter *writer)
 {
+    if (writer->region != NULL) {
+        detachMappedRegion(writer);
+    }
     if (writer->fd > 0) {
         ttsdkfu_flushBufferedWriter(writer);
         close(writer->fd);
@@ -414,6 +458,18 @@ void ttsdkfu_closeBufferedWriter(TTSDKBufferedWriter *writer)
 
 bool ttsdkfu_writeBufferedWriter(TTSDKBufferedWriter *writer, const char *restrict const data, const int length)
 {
+    TTSDKMappedRegion *region = writer->region;
+    if (region != NULL) {
+        if (length <= region->length - region->position) {
+            memcpy(region->memory + region->position, data, length);
+            region->position += length;
+            return true;
+        }
+        TTSDKLOG_DEBUG("Mapped region of %d bytes is full. Falling back to buffered writes.", region->length);
+        if (!detachMappedRegion(writer)) {
+            return false;
+        }
+    }
     if (length > writer->bufferLength - writer->position) {
         if (!ttsdkfu_flushBufferedWriter(writer)) {
             return false;
@@ -429,7 +485,7 @@ bool ttsdkfu_writeBufferedWriter(TTSDKBufferedWriter *writer, const char *restri
 
 bool ttsdkfu_flushBufferedWriter(TTSDKBufferedWriter *writer)
 {
-    if (writer->fd > 0 && writer->position > 0) {
+    if (writer->fd > 0 && writer->position > 0 && writer->region == NULL) {
         if (!ttsdkfu_writeBytesToFD(writer->fd, writer->buffer, writer->position)) {
             return false;
         }
@@ -588,3 +644,79 @@ void *ttsdkfu_mmap(const char *path, int size)
     close(fd);
     return ptr;
 }
+
+static bool preallocateFile(int fd, int size)
+{
+#ifdef F_PREALLOCATE
+    // Allocate real blocks up front so that touching the mapping can't fail with SIGBUS on a full disk.
+    fstore_t store = { F_ALLOCATECONTIG, F_PEOFPOSMODE, 0, size, 0 };
+    if (fcntl(fd, F_PREALLOCATE, &store) < 0) {
+        store.fst_flags = F_ALLOCATEALL;
+        if (fcntl(fd, F_PREALLOCATE, &store) < 0) {
+            return false;
+        }
+    }
+#endif
+    return ftruncate(fd, size) == 0;
+}
+
+bool ttsdkfu_reserveMappedRegion(TTSDKMappedRegion *region, const char *path, int size)
+{
+    memset(region, 0, sizeof(*region));
+    region->fd = -1;
+    if (size <= 0 || strlen(path) >= sizeof(region->path)) {
+        TTSDKLOG_ERROR("Invalid mapped region %s of size %d", path, size);
+        return false;
+    }
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        TTSDKLOG_ERROR("Could not open file %s: %s", path, strerror(errno));
+        return false;
+    }
+
+    if (!preallocateFile(fd, size)) {
+        TTSDKLOG_ERROR("Could not allocate %d bytes for %s: %s", size, path, strerror(errno));
+        close(fd);
+        unlink(path);
+        return false;
+    }
+
+    void *ptr = mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (ptr == MAP_FAILED) {
+        TTSDKLOG_ERROR("Could not mmap file %s: %s", path, strerror(errno));
+        close(fd);
+        unlink(path);
+        return false;
+    }
+    // Fault every page in now rather than on the crash path.
+    memset(ptr, 0, (size_t)size);
+
+    region->memory = ptr;
+    region->length = size;
+    region->fd = fd;
+    strncpy(region->path, path, sizeof(region->path) - 1);
+    return true;
+}
+
+void ttsdkfu_releaseMappedRegion(TTSDKMappedRegion *region)
+{
+    if (region->memory == NULL || region->isInUse) {
+        return;
+    }
+    munmap(region->memory, (size_t)region->length);
+    close(region->fd);
+    unlink(region->path);
+    region->memory = NULL;
+    region->length = 0;
+    region->fd = -1;
+}
+
+void ttsdkfu_truncateMappedRegion(TTSDKMappedRegion *region)
+{
+    if (region->isInUse && region->fd >= 0) {
+        if (ftruncate(region->fd, region->position) < 0) {
+            TTSDKLOG_ERROR("Could not truncate mapped file: %s", strerror(errno));
+        }
+    }
+}
@@ -0,0 +1,271 @@
+//
+//  TTSDKImageRangeIndex.c
+//
+//  Created by TikTok on 2026-10-19.
+//
+//  Copyright (c) 2012 Karl Stenerud. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall remain in place
+// in this source code.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "TTSDKImageRangeIndex.h"
+
+// #define TTSDKLogger_LocalLevel TRACE
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "TTSDKLogger.h"
+
+/** How many times a reader retries when the table changes underneath it. */
+#define kMaxLookupAttempts 8
+
+typedef struct {
+    _Atomic(uint32_t) sequence;
+    int count;
+    int capacity;
+    TTSDKImageRange *ranges;
+} TTSDKImageRangeTable;
+
+struct TTSDKImageRangeIndex {
+    TTSDKImageRangeTable tables[2];
+    _Atomic(int) activeTable;
+    pthread_mutex_t mutex;
+};
+
+// ============================================================================
+#pragma mark - Writer -
+// ============================================================================
+
+/** Make sure a table can hold the given number of ranges.
+ *
+ * A table that is too small gets a new array. The old one is deliberately
+ * leaked: a reader that was interrupted mid-search may still be looking at it,
+ * and capacity grows geometrically so the total waste stays bounded.
+ */
+static bool ensureCapacity(TTSDKImageRangeTable *table, int count)
+{
+    if (count <= table->capacity) {
+        return true;
+    }
+    int newCapacity = table->capacity > 0 ? table->capacity : 64;
+    while (newCapacity < count) {
+        newCapacity *= 2;
+    }
+    TTSDKImageRange *ranges = calloc((size_t)newCapacity, sizeof(*ranges));
+    if (ranges == NULL) {
+        TTSDKLOG_ERROR("Could not allocate %d image ranges", newCapacity);
+        return false;
+    }
+    table->ranges = ranges;
+    table->capacity = newCapacity;
+    return true;
+}
+
+static void sortRanges(TTSDKImageRange *ranges, int count)
+{
+    // Images only have a handful of segments, so insertion sort is plenty.
+    for (int i = 1; i < count; i++) {
+        TTSDKImageRange range = ranges[i];
+        int j = i - 1;
+        while (j >= 0 && ranges[j].start > range.start) {
+            ranges[j + 1] = ranges[j];
+            j--;
+        }
+        ranges[j + 1] = range;
+    }
+}
+
+static inline TTSDKImageRangeTable *beginUpdate(TTSDKImageRangeIndex *index, TTSDKImageRangeTable **source)
+{
+    int active = atomic_load_explicit(&index->activeTable, memory_order_relaxed);
+    *source = &index->tables[active];
+    return &index->tables[1 - active];
+}
+
+static inline void markWriting(TTSDKImageRangeTable *table)
+{
+    atomic_fetch_add_explicit(&table->sequence, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+static inline void finishWriting(TTSDKImageRangeTable *table)
+{
+    atomic_fetch_add_explicit(&table->sequence, 1, memory_order_release);
+}
+
+static inline void publish(TTSDKImageRangeIndex *index, TTSDKImageRangeTable *table)
+{
+    finishWriting(table);
+    atomic_store_explicit(&index->activeTable, (int)(table - index->tables), memory_order_release);
+}
+
+TTSDKImageRangeIndex *ttsdkiri_create(int initialCapacity)
+{
+    TTSDKImageRangeIndex *index = calloc(1, sizeof(*index));
+    if (index == NULL) {
+        return NULL;
+    }
+    pthread_mutex_init(&index->mutex, NULL);
+    if (!ensureCapacity(&index->tables[0], initialCapacity) || !ensureCapacity(&index->tables[1], initialCapacity)) {
+        ttsdkiri_destroy(index);
+        return NULL;
+    }
+    return index;
+}
+
+void ttsdkiri_destroy(TTSDKImageRangeIndex *index)
+{
+    if (index == NULL) {
+        return;
+    }
+    free(index->tables[0].ranges);
+    free(index->tables[1].ranges);
+    pthread_mutex_destroy(&index->mutex);
+    free(index);
+}
+
+bool ttsdkiri_addImage(TTSDKImageRangeIndex *index, const TTSDKImageRange *ranges, int count)
+{
+    if (count <= 0) {
+        return true;
+    }
+    TTSDKImageRange *added = malloc((size_t)count * sizeof(*added));
+    if (added == NULL) {
+        return false;
+    }
+    memcpy(added, ranges, (size_t)count * sizeof(*added));
+    sortRanges(added, count);
+
+    pthread_mutex_lock(&index->mutex);
+    TTSDKImageRangeTable *source;
+    TTSDKImageRangeTable *target = beginUpdate(index, &source);
+    markWriting(target);
+    if (!ensureCapacity(target, source->count + count)) {
+        finishWriting(target);
+        pthread_mutex_unlock(&index->mutex);
+        free(added);
+        return false;
+    }
+
+    // Merge the two sorted lists into the inactive table.
+    int iSrc = 0;
+    int iAdd = 0;
+    int iDst = 0;
+    while (iSrc < source->count || iAdd < count) {
+        if (iAdd >= count || (iSrc < source->count && source->ranges[iSrc].start <= added[iAdd].start)) {
+            target->ranges[iDst++] = source->ranges[iSrc++];
+        } else {
+            target->ranges[iDst++] = added[iAdd++];
+        }
+    }
+    target->count = iDst;
+    publish(index, target);
+    pthread_mutex_unlock(&index->mutex);
+
+    free(added);
+    return true;
+}
+
+void ttsdkiri_removeImage(TTSDKImageRangeIndex *index, const void *header)
+{
+    pthread_mutex_lock(&index->mutex);
+    TTSDKImageRangeTable *source;
+    TTSDKImageRangeTable *target = beginUpdate(index, &source);
+    markWriting(target);
+    if (!ensureCapacity(target, source->count)) {
+        finishWriting(target);
+        pthread_mutex_unlock(&index->mutex);
+        return;
+    }
+    int iDst = 0;
+    for (int iSrc = 0; iSrc < source->count; iSrc++) {
+        if (source->ranges[iSrc].header != header) {
+            target->ranges[iDst++] = source->ranges[iSrc];
+        }
+    }
+    target->count = iDst;
+    publish(index, target);
+    pthread_mutex_unlock(&index->mutex);
+}
+
+// ============================================================================
+#pragma mark - Reader -
+// ============================================================================
+
+int ttsdkiri_rangeCount(TTSDKImageRangeIndex *index)
+{
+    if (index == NULL) {
+        return 0;
+    }
+    int active = atomic_load_explicit(&index->activeTable, memory_order_acquire);
+    return index->tables[active].count;
+}
+
+TTSDKImageRangeLookupResult ttsdkiri_find(TTSDKImageRangeIndex *index, uintptr_t address, TTSDKImageRange *range)
+{
+    if (index == NULL) {
+        return TTSDKImageRangeLookupUnavailable;
+    }
+    for (int attempt = 0; attempt < kMaxLookupAttempts; attempt++) {
+        int active = atomic_load_explicit(&index->activeTable, memory_order_acquire);
+        TTSDKImageRangeTable *table = &index->tables[active];
+        uint32_t sequence = atomic_load_explicit(&table->sequence, memory_order_acquire);
+        if ((sequence & 1) != 0) {
+            continue;
+        }
+
+        const TTSDKImageRange *ranges = table->ranges;
+        int count = table->count;
+        if (ranges == NULL || count <= 0) {
+            return TTSDKImageRangeLookupUnavailable;
+        }
+
+        // Find the last range starting at or before the address.
+        int low = 0;
+        int high = count - 1;
+        int match = -1;
+        while (low <= high) {
+            int mid = low + (high - low) / 2;
+            if (ranges[mid].start <= address) {
+                match = mid;
+                low = mid + 1;
+            } else {
+                high = mid - 1;
+            }
+        }
+        TTSDKImageRange candidate = { 0 };
+        bool isFound = match >= 0 && address < ranges[match].end;
+        if (isFound) {
+            candidate = ranges[match];
+        }
+
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&table->sequence, memory_order_relaxed) != sequence) {
+            continue;
+        }
+        if (!isFound) {
+            return TTSDKImageRangeLookupNotFound;
+        }
+        *range = candidate;
+        return TTSDKImageRangeLookupFound;
+    }
+    return TTSDKImageRangeLookupUnavailable;
+}
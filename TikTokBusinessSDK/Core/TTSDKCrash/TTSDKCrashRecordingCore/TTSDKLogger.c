@@ -34,6 +34,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
@@ -93,13 +94,29 @@ static inline void writeFmtToLog(const char *fmt, ...)
 
 #if TTSDKLOGGER_CBufferSize > 0
 
+#include <stdatomic.h>
+
+#include "TTSDKRingLog.h"
+
+/** How long the ring drainer sleeps if it can't wait on its wake pipe. */
+#define kRingDrainIntervalMicroseconds 200000
+
 /** The file descriptor where log entries get written. */
 static int g_fd = -1;
 
-static void writeToLog(const char *const str)
+/** When set, log entries go into this ring and a background thread writes them out. */
+static TTSDKRingLog *volatile g_ring = NULL;
+
+/** Writers wake the drainer with a byte on this pipe. write(2) is async-safe. */
+static int g_ringWakeFDs[2] = { -1, -1 };
+
+/** Set while a wake byte is pending, so a burst of entries costs one write. */
+static atomic_bool g_ringWakePending = false;
+
+static void writeToFD(const char *str, int length)
 {
     if (g_fd >= 0) {
-        int bytesToWrite = (int)strlen(str);
+        int bytesToWrite = length;
         const char *pos = str;
         while (bytesToWrite > 0) {
             int bytesWritten = (int)write(g_fd, pos, (unsigned)bytesToWrite);
@@ -108,9 +125,91 @@ static void writeToLog(const char *const str)
             pos += bytesWritten;
         }
     }
-    write(STDOUT_FILENO, str, strlen(str));
+    write(STDOUT_FILENO, str, (size_t)length);
+}
+
+static void writeToLog(const char *const str)
+{
+    TTSDKRingLog *ring = g_ring;
+    likely_if(ring != NULL)
+    {
+        ttsdkrl_append(ring, str, (int)strlen(str));
+        if (!atomic_exchange(&g_ringWakePending, true)) {
+            char token = 0;
+            write(g_ringWakeFDs[1], &token, 1);
+        }
+        return;
+    }
+    writeToFD(str, (int)strlen(str));
+}
+
+static void drainSink(const char *data, int length, __attribute__((unused)) void *context)
+{
+    writeToFD(data, length);
+}
+
+static void *ringDrainerThread(void *userData)
+{
+    TTSDKRingLog *ring = userData;
+    static char buffer[8192];
+    char tokens[64];
+    for (;;) {
+        ssize_t bytesRead = read(g_ringWakeFDs[0], tokens, sizeof(tokens));
+        unlikely_if(bytesRead <= 0 && errno != EINTR) { usleep(kRingDrainIntervalMicroseconds); }
+        // Cleared before draining, so an entry appended during the drain wakes us again
+        atomic_store(&g_ringWakePending, false);
+        while (ttsdkrl_drain(ring, buffer, sizeof(buffer), drainSink, NULL) > 0) {
+        }
+    }
+    return NULL;
 }
 
+bool ttsdklog_enableRingBuffer(int sizeInBytes)
+{
+    if (g_ring != NULL) {
+        return true;
+    }
+    TTSDKRingLog *ring = ttsdkrl_create(sizeInBytes);
+    unlikely_if(ring == NULL) { return false; }
+    unlikely_if(pipe(g_ringWakeFDs) != 0)
+    {
+        ttsdkrl_destroy(ring);
+        writeFmtToLog("TTSDKLogger: Could not create ring wake pipe: %s", strerror(errno));
+        return false;
+    }
+    // A full pipe already means a wake-up is pending, so writers never block on it
+    fcntl(g_ringWakeFDs[1], F_SETFL, fcntl(g_ringWakeFDs[1], F_GETFL) | O_NONBLOCK);
+    fcntl(g_ringWakeFDs[0], F_SETFD, FD_CLOEXEC);
+    fcntl(g_ringWakeFDs[1], F_SETFD, FD_CLOEXEC);
+
+    pthread_t thread;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    int error = pthread_create(&thread, &attr, ringDrainerThread, ring);
+    pthread_attr_destroy(&attr);
+    unlikely_if(error != 0)
+    {
+        ttsdkrl_destroy(ring);
+        close(g_ringWakeFDs[0]);
+        close(g_ringWakeFDs[1]);
+        g_ringWakeFDs[0] = g_ringWakeFDs[1] = -1;
+        writeFmtToLog("TTSDKLogger: Could not start ring drainer: %s", strerror(error));
+        return false;
+    }
+    g_ring = ring;
+    return true;
+}
+
+bool ttsdklog_isRingBufferEnabled(void) { return g_ring != NULL; }
+
+void ttsdklog_readRecentLines(int maxBytes, void (*onLine)(const char *line, int length, void *context), void *context)
+{
+    ttsdkrl_readRecentLines(g_ring, maxBytes, onLine, context);
+}
+
+static void markRingCleared(void) { ttsdkrl_markCleared(g_ring); }
+
 static inline void writeFmtArgsToLog(const char *fmt, va_list args)
 {
     unlikely_if(fmt == NULL) { writeToLog("(null)"); }
@@ -191,6 +290,18 @@ static inline void writeFmtArgsToLog(const char *fmt, va_list args)
 
 static inline void flushLog(void) { fflush(g_file); }
 
+bool ttsdklog_enableRingBuffer(__attribute__((unused)) int sizeInBytes) { return false; }
+
+bool ttsdklog_isRingBufferEnabled(void) { return false; }
+
+void ttsdklog_readRecentLines(__attribute__((unused)) int maxBytes,
+                              __attribute__((unused)) void (*onLine)(const char *line, int length, void *context),
+                              __attribute__((unused)) void *context)
+{
+}
+
+static void markRingCleared(void) {}
+
 bool ttsdklog_setLogFilename(const char *filename, bool overwrite)
 {
     static FILE *file = NULL;
@@ -217,7 +328,11 @@ bool ttsdklog_setLogFilename(const char *filename, bool overwrite)
 
 #endif
 
-bool ttsdklog_clearLogFile(void) { return ttsdklog_setLogFilename(g_logFilename, true); }
+bool ttsdklog_clearLogFile(void)
+{
+    markRingCleared();
+    return ttsdklog_setLogFilename(g_logFilename, true);
+}
 
 // ===========================================================================
 #pragma mark - C -
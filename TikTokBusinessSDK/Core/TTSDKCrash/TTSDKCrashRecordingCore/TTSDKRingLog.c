@@ -0,0 +1,224 @@
+//
+//  TTSDKRingLog.c
+//
+//  Created by TikTok on 2026-10-19.
+//
+//  Copyright (c) 2012 Karl Stenerud. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall remain in place
+// in this source code.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "TTSDKRingLog.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Nothing in here may log: the logger itself writes into the ring.
+
+#define kSlotTextSize (TTSDKRINGLOG_SLOT_SIZE - 16)
+#define kMaxLineLength 1024
+
+typedef struct {
+    /** Index + 1 of the slot once its contents are complete. */
+    _Atomic(uint64_t) sequence;
+    uint16_t length;
+    /** Position of this slot within its record. Records start at part 0. */
+    uint16_t part;
+    uint32_t reserved;
+    char text[kSlotTextSize];
+} TTSDKRingLogSlot;
+
+struct TTSDKRingLog {
+    TTSDKRingLogSlot *slots;
+    uint64_t slotMask;
+    uint64_t slotCount;
+    _Atomic(uint64_t) head;
+    /** Consumer-only drain position. */
+    uint64_t tail;
+    _Atomic(uint64_t) clearedPosition;
+    _Atomic(uint64_t) droppedSlotCount;
+};
+
+_Static_assert(sizeof(TTSDKRingLogSlot) == TTSDKRINGLOG_SLOT_SIZE, "Ring log slots must keep their size");
+
+TTSDKRingLog *ttsdkrl_create(int capacityInBytes)
+{
+    uint64_t slotCount = 16;
+    while (slotCount * TTSDKRINGLOG_SLOT_SIZE < (uint64_t)(capacityInBytes > 0 ? capacityInBytes : 0)) {
+        slotCount <<= 1;
+    }
+    TTSDKRingLog *ring = calloc(1, sizeof(*ring));
+    TTSDKRingLogSlot *slots = calloc(slotCount, sizeof(*slots));
+    if (ring == NULL || slots == NULL) {
+        free(ring);
+        free(slots);
+        return NULL;
+    }
+    ring->slots = slots;
+    ring->slotCount = slotCount;
+    ring->slotMask = slotCount - 1;
+    return ring;
+}
+
+void ttsdkrl_destroy(TTSDKRingLog *ring)
+{
+    if (ring != NULL) {
+        free(ring->slots);
+        free(ring);
+    }
+}
+
+void ttsdkrl_append(TTSDKRingLog *ring, const char *text, int length)
+{
+    if (ring == NULL || text == NULL || length <= 0) {
+        return;
+    }
+    uint64_t maxLength = (ring->slotCount / 2) * kSlotTextSize;
+    if ((uint64_t)length > maxLength) {
+        length = (int)maxLength;
+    }
+    uint64_t slotCount = ((uint64_t)length + kSlotTextSize - 1) / kSlotTextSize;
+    uint64_t first = atomic_fetch_add_explicit(&ring->head, slotCount, memory_order_relaxed);
+
+    for (uint64_t part = 0; part < slotCount; part++) {
+        TTSDKRingLogSlot *slot = &ring->slots[(first + part) & ring->slotMask];
+        int offset = (int)(part * kSlotTextSize);
+        int partLength = length - offset < kSlotTextSize ? length - offset : kSlotTextSize;
+        memcpy(slot->text, text + offset, (size_t)partLength);
+        slot->length = (uint16_t)partLength;
+        slot->part = (uint16_t)part;
+        atomic_store_explicit(&slot->sequence, first + part + 1, memory_order_release);
+    }
+}
+
+/** Whether the slots from a position onwards might have been overwritten by now. */
+static inline bool wasOverwritten(TTSDKRingLog *ring, uint64_t position)
+{
+    // Order the preceding reads of slot text before the check.
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&ring->head, memory_order_relaxed) > position + ring->slotCount;
+}
+
+int ttsdkrl_drain(TTSDKRingLog *ring, char *buffer, int bufferSize, TTSDKRingLogSink sink, void *context)
+{
+    if (ring == NULL || buffer == NULL || bufferSize < kSlotTextSize) {
+        return 0;
+    }
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    uint64_t position = ring->tail;
+    if (head - position > ring->slotCount) {
+        atomic_fetch_add_explicit(&ring->droppedSlotCount, head - ring->slotCount - position, memory_order_relaxed);
+        position = head - ring->slotCount;
+    }
+
+    int drained = 0;
+    int used = 0;
+    uint64_t batchStart = position;
+    for (; position < head; position++) {
+        TTSDKRingLogSlot *slot = &ring->slots[position & ring->slotMask];
+        if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != position + 1) {
+            // Still being written. Pick it up next time.
+            break;
+        }
+        if (used + slot->length > bufferSize) {
+            if (wasOverwritten(ring, batchStart)) {
+                atomic_fetch_add_explicit(&ring->droppedSlotCount, position - batchStart, memory_order_relaxed);
+            } else {
+                sink(buffer, used, context);
+                drained += used;
+            }
+            used = 0;
+            batchStart = position;
+        }
+        memcpy(buffer + used, slot->text, slot->length);
+        used += slot->length;
+    }
+    if (used > 0) {
+        if (wasOverwritten(ring, batchStart)) {
+            atomic_fetch_add_explicit(&ring->droppedSlotCount, position - batchStart, memory_order_relaxed);
+        } else {
+            sink(buffer, used, context);
+            drained += used;
+        }
+    }
+    ring->tail = position;
+    return drained;
+}
+
+void ttsdkrl_readRecentLines(TTSDKRingLog *ring, int maxBytes, TTSDKRingLogSink onLine, void *context)
+{
+    if (ring == NULL || onLine == NULL || maxBytes <= 0) {
+        return;
+    }
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    uint64_t wantedSlots = ((uint64_t)maxBytes + kSlotTextSize - 1) / kSlotTextSize;
+    uint64_t start = head > wantedSlots ? head - wantedSlots : 0;
+    if (head > ring->slotCount && start < head - ring->slotCount) {
+        start = head - ring->slotCount;
+    }
+    uint64_t cleared = atomic_load_explicit(&ring->clearedPosition, memory_order_relaxed);
+    if (start < cleared) {
+        start = cleared;
+    }
+
+    char line[kMaxLineLength];
+    int lineLength = 0;
+    bool isInRecord = false;
+    for (uint64_t position = start; position < head; position++) {
+        const TTSDKRingLogSlot *slot = &ring->slots[position & ring->slotMask];
+        if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != position + 1) {
+            isInRecord = false;
+            continue;
+        }
+        // Don't start in the middle of a record whose beginning is out of range.
+        if (slot->part == 0) {
+            isInRecord = true;
+        }
+        if (!isInRecord) {
+            continue;
+        }
+        for (int i = 0; i < slot->length; i++) {
+            char ch = slot->text[i];
+            if (ch == '\n' || lineLength == (int)sizeof(line)) {
+                onLine(line, lineLength, context);
+                lineLength = 0;
+                if (ch == '\n') {
+                    continue;
+                }
+            }
+            line[lineLength++] = ch;
+        }
+    }
+    if (lineLength > 0) {
+        onLine(line, lineLength, context);
+    }
+}
+
+void ttsdkrl_markCleared(TTSDKRingLog *ring)
+{
+    if (ring != NULL) {
+        atomic_store(&ring->clearedPosition, atomic_load(&ring->head));
+    }
+}
+
+uint64_t ttsdkrl_droppedSlotCount(TTSDKRingLog *ring)
+{
+    return ring != NULL ? atomic_load(&ring->droppedSlotCount) : 0;
+}
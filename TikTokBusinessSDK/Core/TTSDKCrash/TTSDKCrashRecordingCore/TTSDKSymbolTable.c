@@ -0,0 +1,409 @@
+//
+//  TTSDKSymbolTable.c
+//
+//  Created by TikTok on 2026-10-19.
+//
+//  Copyright (c) 2012 Karl Stenerud. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall remain in place
+// in this source code.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "TTSDKSymbolTable.h"
+
+// #define TTSDKLogger_LocalLevel TRACE
+#include <errno.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "TTSDKFileUtils.h"
+#include "TTSDKLogger.h"
+
+/** Must be a power of 2, and comfortably above the number of images a process loads. */
+#define kRegistrySlotCount 4096
+
+struct TTSDKSymbolTable {
+    const void *header;
+    uint64_t baseAddress;
+    const char *strings;
+    uint32_t stringsSize;
+    int count;
+    const TTSDKSymbolEntry *entries;
+    /** Set when the table lives in a mapped index file. */
+    void *mapping;
+    size_t mappingSize;
+};
+
+typedef struct {
+    _Atomic(uintptr_t) header;
+    _Atomic(TTSDKSymbolTable *) table;
+} TTSDKSymbolTableSlot;
+
+static TTSDKSymbolTableSlot g_registry[kRegistrySlotCount];
+
+// ============================================================================
+#pragma mark - Tables -
+// ============================================================================
+
+/** Stable bottom-up merge sort by offset. Returns whichever buffer ends up holding the result. */
+static TTSDKSymbolEntry *sortEntries(TTSDKSymbolEntry *entries, TTSDKSymbolEntry *scratch, int count)
+{
+    TTSDKSymbolEntry *src = entries;
+    TTSDKSymbolEntry *dst = scratch;
+    for (int width = 1; width < count; width *= 2) {
+        for (int start = 0; start < count; start += 2 * width) {
+            int left = start;
+            int mid = start + width < count ? start + width : count;
+            int right = mid;
+            int end = start + 2 * width < count ? start + 2 * width : count;
+            int out = start;
+            while (left < mid && right < end) {
+                dst[out++] = src[right].offset < src[left].offset ? src[right++] : src[left++];
+            }
+            while (left < mid) {
+                dst[out++] = src[left++];
+            }
+            while (right < end) {
+                dst[out++] = src[right++];
+            }
+        }
+        TTSDKSymbolEntry *temp = src;
+        src = dst;
+        dst = temp;
+    }
+    return src;
+}
+
+TTSDKSymbolTable *ttsdksym_createTable(const void *header, uint64_t baseAddress, const char *strings,
+                                       uint32_t stringsSize, const TTSDKSymbolEntry *symbols, int count)
+{
+    if (count < 0 || (count > 0 && symbols == NULL)) {
+        return NULL;
+    }
+    TTSDKSymbolTable *table = calloc(1, sizeof(*table));
+    TTSDKSymbolEntry *entries = malloc(sizeof(*entries) * (size_t)(count > 0 ? count : 1));
+    TTSDKSymbolEntry *scratch = malloc(sizeof(*scratch) * (size_t)(count > 0 ? count : 1));
+    if (table == NULL || entries == NULL || scratch == NULL) {
+        TTSDKLOG_ERROR("Could not allocate a symbol table of %d symbols", count);
+        free(table);
+        free(entries);
+        free(scratch);
+        return NULL;
+    }
+    if (count > 0) {
+        memcpy(entries, symbols, sizeof(*entries) * (size_t)count);
+    }
+    TTSDKSymbolEntry *sorted = sortEntries(entries, scratch, count);
+    TTSDKSymbolEntry *result = sorted == entries ? entries : scratch;
+    free(sorted == entries ? scratch : entries);
+
+    // Keep only the last of each run of equal offsets. That's the one a linear
+    // nearest-match scan would settle on.
+    int distinct = 0;
+    for (int i = 0; i < count; i++) {
+        if (i + 1 < count && result[i + 1].offset == result[i].offset) {
+            continue;
+        }
+        result[distinct++] = result[i];
+    }
+
+    table->header = header;
+    table->baseAddress = baseAddress;
+    table->strings = strings;
+    table->stringsSize = stringsSize;
+    table->count = distinct;
+    table->entries = result;
+    return table;
+}
+
+void ttsdksym_destroyTable(TTSDKSymbolTable *table)
+{
+    if (table == NULL) {
+        return;
+    }
+    if (table->mapping != NULL) {
+        munmap(table->mapping, table->mappingSize);
+    } else {
+        free((void *)table->entries);
+    }
+    free(table);
+}
+
+int ttsdksym_symbolCount(const TTSDKSymbolTable *table) { return table != NULL ? table->count : 0; }
+
+uint64_t ttsdksym_baseAddress(const TTSDKSymbolTable *table) { return table != NULL ? table->baseAddress : 0; }
+
+bool ttsdksym_lookup(const TTSDKSymbolTable *table, uint64_t address, uint64_t *symbolAddress,
+                     const char **symbolName)
+{
+    if (table == NULL || table->count == 0 || address < table->baseAddress) {
+        return false;
+    }
+    uint64_t relative = address - table->baseAddress;
+    uint32_t offset = relative > UINT32_MAX ? UINT32_MAX : (uint32_t)relative;
+
+    // Find the first entry past the offset. The one before it is the nearest preceding symbol.
+    int low = 0;
+    int high = table->count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (table->entries[mid].offset <= offset) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low == 0) {
+        return false;
+    }
+    const TTSDKSymbolEntry *entry = &table->entries[low - 1];
+    *symbolAddress = table->baseAddress + entry->offset;
+    if (entry->nameOffset == TTSDKSymbolNoName || entry->nameOffset >= table->stringsSize) {
+        *symbolName = NULL;
+    } else {
+        *symbolName = table->strings + entry->nameOffset;
+    }
+    return true;
+}
+
+// ============================================================================
+#pragma mark - Index Files -
+// ============================================================================
+
+bool ttsdksym_writeIndexFile(const TTSDKSymbolTable *table, const uint8_t *uuid, const char *path)
+{
+    if (table == NULL || uuid == NULL || path == NULL) {
+        return false;
+    }
+
+    // Rebuild a string table holding only the referenced names.
+    size_t stringsSize = 1;
+    for (int i = 0; i < table->count; i++) {
+        uint32_t nameOffset = table->entries[i].nameOffset;
+        if (nameOffset != TTSDKSymbolNoName && nameOffset < table->stringsSize) {
+            stringsSize += strnlen(table->strings + nameOffset, table->stringsSize - nameOffset) + 1;
+        }
+    }
+    if (stringsSize >= UINT32_MAX) {
+        TTSDKLOG_ERROR("Too many symbol names to index: %zu bytes", stringsSize);
+        return false;
+    }
+    char *strings = malloc(stringsSize);
+    TTSDKSymbolEntry *entries = malloc(sizeof(*entries) * (size_t)(table->count > 0 ? table->count : 1));
+    if (strings == NULL || entries == NULL) {
+        TTSDKLOG_ERROR("Could not allocate symbol index of %d symbols", table->count);
+        free(strings);
+        free(entries);
+        return false;
+    }
+    // Offset 0 is the empty name, which also guarantees the table ends with a NUL.
+    strings[0] = '\0';
+    size_t position = 1;
+    for (int i = 0; i < table->count; i++) {
+        entries[i] = table->entries[i];
+        uint32_t nameOffset = entries[i].nameOffset;
+        if (nameOffset == TTSDKSymbolNoName || nameOffset >= table->stringsSize) {
+            entries[i].nameOffset = TTSDKSymbolNoName;
+            continue;
+        }
+        size_t length = strnlen(table->strings + nameOffset, table->stringsSize - nameOffset);
+        memcpy(strings + position, table->strings + nameOffset, length);
+        strings[position + length] = '\0';
+        entries[i].nameOffset = (uint32_t)position;
+        position += length + 1;
+    }
+
+    TTSDKSymbolIndexFileHeader fileHeader = {
+        .magic = TTSDKSYMBOLINDEX_MAGIC,
+        .version = TTSDKSYMBOLINDEX_VERSION,
+        .baseAddress = table->baseAddress,
+        .symbolCount = (uint32_t)table->count,
+        .stringsSize = (uint32_t)stringsSize,
+    };
+    memcpy(fileHeader.uuid, uuid, sizeof(fileHeader.uuid));
+
+    bool success = false;
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        TTSDKLOG_ERROR("Could not open %s: %s", path, strerror(errno));
+    } else {
+        success = ttsdkfu_writeBytesToFD(fd, (const char *)&fileHeader, (int)sizeof(fileHeader)) &&
+                  ttsdkfu_writeBytesToFD(fd, (const char *)entries, (int)(sizeof(*entries) * (size_t)table->count)) &&
+                  ttsdkfu_writeBytesToFD(fd, strings, (int)stringsSize);
+        close(fd);
+        if (!success) {
+            TTSDKLOG_ERROR("Could not write symbol index %s", path);
+            unlink(path);
+        }
+    }
+    free(strings);
+    free(entries);
+    return success;
+}
+
+static bool isValidIndex(const TTSDKSymbolIndexFileHeader *fileHeader, size_t fileSize, const uint8_t *uuid)
+{
+    if (fileSize < sizeof(*fileHeader) || fileHeader->magic != TTSDKSYMBOLINDEX_MAGIC) {
+        TTSDKLOG_ERROR("Not a symbol index");
+        return false;
+    }
+    if (fileHeader->version != TTSDKSYMBOLINDEX_VERSION) {
+        TTSDKLOG_ERROR("Unsupported symbol index version %u", fileHeader->version);
+        return false;
+    }
+    if (uuid != NULL && memcmp(fileHeader->uuid, uuid, sizeof(fileHeader->uuid)) != 0) {
+        TTSDKLOG_DEBUG("Symbol index belongs to another binary");
+        return false;
+    }
+    uint64_t expectedSize = (uint64_t)sizeof(*fileHeader) +
+                            (uint64_t)fileHeader->symbolCount * sizeof(TTSDKSymbolEntry) + fileHeader->stringsSize;
+    if (fileHeader->symbolCount > INT32_MAX || fileHeader->stringsSize == 0 || expectedSize != fileSize) {
+        TTSDKLOG_ERROR("Symbol index is truncated or corrupt");
+        return false;
+    }
+    const TTSDKSymbolEntry *entries = (const TTSDKSymbolEntry *)(fileHeader + 1);
+    const char *strings = (const char *)(entries + fileHeader->symbolCount);
+    if (strings[fileHeader->stringsSize - 1] != '\0') {
+        TTSDKLOG_ERROR("Symbol index strings are not terminated");
+        return false;
+    }
+    for (uint32_t i = 0; i < fileHeader->symbolCount; i++) {
+        if ((i > 0 && entries[i].offset <= entries[i - 1].offset) ||
+            (entries[i].nameOffset != TTSDKSymbolNoName && entries[i].nameOffset >= fileHeader->stringsSize)) {
+            TTSDKLOG_ERROR("Symbol index entry %u is invalid", i);
+            return false;
+        }
+    }
+    return true;
+}
+
+TTSDKSymbolTable *ttsdksym_openIndexFile(const char *path, const void *header, const uint8_t *uuid)
+{
+    if (path == NULL) {
+        return NULL;
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        TTSDKLOG_DEBUG("Could not open %s: %s", path, strerror(errno));
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        TTSDKLOG_ERROR("Could not stat %s", path);
+        close(fd);
+        return NULL;
+    }
+    size_t mappingSize = (size_t)st.st_size;
+    void *mapping = mmap(NULL, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        TTSDKLOG_ERROR("Could not map %s: %s", path, strerror(errno));
+        return NULL;
+    }
+
+    const TTSDKSymbolIndexFileHeader *fileHeader = mapping;
+    TTSDKSymbolTable *table = NULL;
+    if (isValidIndex(fileHeader, mappingSize, uuid)) {
+        table = calloc(1, sizeof(*table));
+    }
+    if (table == NULL) {
+        munmap(mapping, mappingSize);
+        return NULL;
+    }
+    table->header = header;
+    table->baseAddress = fileHeader->baseAddress;
+    table->entries = (const TTSDKSymbolEntry *)(fileHeader + 1);
+    table->count = (int)fileHeader->symbolCount;
+    table->strings = (const char *)(table->entries + table->count);
+    table->stringsSize = fileHeader->stringsSize;
+    table->mapping = mapping;
+    table->mappingSize = mappingSize;
+    return table;
+}
+
+// ============================================================================
+#pragma mark - Registry -
+// ============================================================================
+
+static inline uint32_t slotForHeader(const void *header)
+{
+    // Headers are page aligned, so the low bits carry no information.
+    uint64_t hash = ((uint64_t)(uintptr_t)header >> 12) * 0x9E3779B97F4A7C15ULL;
+    return (uint32_t)(hash >> 32) & (kRegistrySlotCount - 1);
+}
+
+bool ttsdksym_publishTable(TTSDKSymbolTable *table)
+{
+    if (table == NULL || table->header == NULL) {
+        return false;
+    }
+    uintptr_t header = (uintptr_t)table->header;
+    uint32_t slot = slotForHeader(table->header);
+    for (int probe = 0; probe < kRegistrySlotCount; probe++) {
+        TTSDKSymbolTableSlot *entry = &g_registry[(slot + (uint32_t)probe) & (kRegistrySlotCount - 1)];
+        uintptr_t expected = 0;
+        if (atomic_compare_exchange_strong(&entry->header, &expected, header) || expected == header) {
+            TTSDKSymbolTable *empty = NULL;
+            return atomic_compare_exchange_strong(&entry->table, &empty, table);
+        }
+    }
+    TTSDKLOG_ERROR("Symbol table registry is full");
+    return false;
+}
+
+static TTSDKSymbolTableSlot *findSlot(const void *header)
+{
+    uint32_t slot = slotForHeader(header);
+    for (int probe = 0; probe < kRegistrySlotCount; probe++) {
+        TTSDKSymbolTableSlot *entry = &g_registry[(slot + (uint32_t)probe) & (kRegistrySlotCount - 1)];
+        uintptr_t current = atomic_load(&entry->header);
+        if (current == (uintptr_t)header) {
+            return entry;
+        }
+        if (current == 0) {
+            return NULL;
+        }
+    }
+    return NULL;
+}
+
+const TTSDKSymbolTable *ttsdksym_tableForImage(const void *header)
+{
+    if (header == NULL) {
+        return NULL;
+    }
+    TTSDKSymbolTableSlot *entry = findSlot(header);
+    return entry != NULL ? atomic_load(&entry->table) : NULL;
+}
+
+void ttsdksym_retireTable(const void *header)
+{
+    if (header == NULL) {
+        return;
+    }
+    TTSDKSymbolTableSlot *entry = findSlot(header);
+    if (entry != NULL) {
+        // The slot keeps its header so that later probes still pass through it.
+        atomic_store(&entry->table, NULL);
+    }
+}
@@ -0,0 +1,301 @@
+//
+//  TTSDKThreadRegistry.c
+//
+//  Created by TikTok on 2026-10-19.
+//
+//  Copyright (c) 2012 Karl Stenerud. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall remain in place
+// in this source code.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "TTSDKThreadRegistry.h"
+
+// #define TTSDKLogger_LocalLevel TRACE
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "TTSDKLogger.h"
+
+#define kNoName UINT32_MAX
+#define kInitialArenaCapacity 4096
+
+typedef struct {
+    int count;
+    int capacity;
+    TTSDKThread *machThreads;
+    TTSDKThread *pthreads;
+    uint32_t *threadNames;
+    uint32_t *queueNames;
+    /** Thread index + 1, or 0 for an empty slot. */
+    int32_t *slots;
+    uint32_t slotMask;
+    char *arena;
+    uint32_t arenaSize;
+    uint32_t arenaCapacity;
+} TTSDKThreadSnapshot;
+
+struct TTSDKThreadRegistry {
+    TTSDKThreadSnapshot snapshots[2];
+    _Atomic(int) activeSnapshot;
+    _Atomic(int) generation;
+    /** Writer-only state for the update in progress. */
+    int building;
+    bool hasChanges;
+};
+
+// ============================================================================
+#pragma mark - Snapshots -
+// ============================================================================
+
+static inline uint32_t slotForThread(const TTSDKThreadSnapshot *snapshot, TTSDKThread thread)
+{
+    uint64_t hash = (uint64_t)thread * 0x9E3779B97F4A7C15ULL;
+    return (uint32_t)(hash >> 32) & snapshot->slotMask;
+}
+
+static int indexOfThread(const TTSDKThreadSnapshot *snapshot, TTSDKThread thread)
+{
+    if (snapshot->slots == NULL) {
+        return -1;
+    }
+    uint32_t slot = slotForThread(snapshot, thread);
+    for (uint32_t probe = 0; probe <= snapshot->slotMask; probe++) {
+        int32_t entry = snapshot->slots[(slot + probe) & snapshot->slotMask];
+        if (entry == 0) {
+            return -1;
+        }
+        if (snapshot->machThreads[entry - 1] == thread) {
+            return entry - 1;
+        }
+    }
+    return -1;
+}
+
+static const char *nameAt(const TTSDKThreadSnapshot *snapshot, uint32_t offset)
+{
+    return offset == kNoName ? NULL : snapshot->arena + offset;
+}
+
+static void freeSnapshot(TTSDKThreadSnapshot *snapshot)
+{
+    free(snapshot->machThreads);
+    free(snapshot->pthreads);
+    free(snapshot->threadNames);
+    free(snapshot->queueNames);
+    free(snapshot->slots);
+    free(snapshot->arena);
+    memset(snapshot, 0, sizeof(*snapshot));
+}
+
+/** Make room for a number of threads. Existing contents are discarded. */
+static bool ensureCapacity(TTSDKThreadSnapshot *snapshot, int threadCount)
+{
+    if (threadCount <= snapshot->capacity && snapshot->arena != NULL) {
+        return true;
+    }
+    int capacity = snapshot->capacity > 0 ? snapshot->capacity : 64;
+    while (capacity < threadCount) {
+        capacity *= 2;
+    }
+    uint32_t slotCount = 1;
+    while (slotCount < (uint32_t)capacity * 2) {
+        slotCount <<= 1;
+    }
+    uint32_t arenaCapacity = snapshot->arenaCapacity > 0 ? snapshot->arenaCapacity : kInitialArenaCapacity;
+    freeSnapshot(snapshot);
+    snapshot->machThreads = calloc((size_t)capacity, sizeof(*snapshot->machThreads));
+    snapshot->pthreads = calloc((size_t)capacity, sizeof(*snapshot->pthreads));
+    snapshot->threadNames = calloc((size_t)capacity, sizeof(*snapshot->threadNames));
+    snapshot->queueNames = calloc((size_t)capacity, sizeof(*snapshot->queueNames));
+    snapshot->slots = calloc(slotCount, sizeof(*snapshot->slots));
+    snapshot->arena = malloc(arenaCapacity);
+    if (snapshot->machThreads == NULL || snapshot->pthreads == NULL || snapshot->threadNames == NULL ||
+        snapshot->queueNames == NULL || snapshot->slots == NULL || snapshot->arena == NULL) {
+        TTSDKLOG_ERROR("Could not allocate thread snapshot for %d threads", capacity);
+        freeSnapshot(snapshot);
+        return false;
+    }
+    snapshot->capacity = capacity;
+    snapshot->slotMask = slotCount - 1;
+    snapshot->arenaCapacity = arenaCapacity;
+    return true;
+}
+
+/** Copy a name into the snapshot's arena, growing it if needed. */
+static uint32_t storeName(TTSDKThreadSnapshot *snapshot, const char *name)
+{
+    if (name == NULL) {
+        return kNoName;
+    }
+    size_t length = strlen(name) + 1;
+    if (snapshot->arenaSize + length > snapshot->arenaCapacity) {
+        uint32_t newCapacity = snapshot->arenaCapacity;
+        while (snapshot->arenaSize + length > newCapacity) {
+            newCapacity *= 2;
+        }
+        char *arena = realloc(snapshot->arena, newCapacity);
+        if (arena == NULL) {
+            TTSDKLOG_ERROR("Could not grow thread name arena to %u bytes", newCapacity);
+            return kNoName;
+        }
+        snapshot->arena = arena;
+        snapshot->arenaCapacity = newCapacity;
+    }
+    uint32_t offset = snapshot->arenaSize;
+    memcpy(snapshot->arena + offset, name, length);
+    snapshot->arenaSize += (uint32_t)length;
+    return offset;
+}
+
+static bool namesDiffer(const char *a, const char *b)
+{
+    if (a == NULL || b == NULL) {
+        return a != b;
+    }
+    return strcmp(a, b) != 0;
+}
+
+// ============================================================================
+#pragma mark - API -
+// ============================================================================
+
+TTSDKThreadRegistry *ttsdktr_create(int initialCapacity)
+{
+    TTSDKThreadRegistry *registry = calloc(1, sizeof(*registry));
+    if (registry == NULL) {
+        TTSDKLOG_ERROR("Could not allocate thread registry");
+        return NULL;
+    }
+    if (!ensureCapacity(&registry->snapshots[0], initialCapacity) ||
+        !ensureCapacity(&registry->snapshots[1], initialCapacity)) {
+        ttsdktr_destroy(registry);
+        return NULL;
+    }
+    return registry;
+}
+
+void ttsdktr_destroy(TTSDKThreadRegistry *registry)
+{
+    if (registry != NULL) {
+        freeSnapshot(&registry->snapshots[0]);
+        freeSnapshot(&registry->snapshots[1]);
+        free(registry);
+    }
+}
+
+bool ttsdktr_beginUpdate(TTSDKThreadRegistry *registry, int threadCount)
+{
+    if (registry == NULL || threadCount < 0) {
+        return false;
+    }
+    int active = atomic_load(&registry->activeSnapshot);
+    registry->building = 1 - active;
+    TTSDKThreadSnapshot *snapshot = &registry->snapshots[registry->building];
+    if (!ensureCapacity(snapshot, threadCount)) {
+        return false;
+    }
+    snapshot->count = 0;
+    snapshot->arenaSize = 0;
+    memset(snapshot->slots, 0, sizeof(*snapshot->slots) * (snapshot->slotMask + 1));
+    registry->hasChanges = atomic_load(&registry->generation) == 0 ||
+                           registry->snapshots[active].count != threadCount;
+    return true;
+}
+
+void ttsdktr_addThread(TTSDKThreadRegistry *registry, TTSDKThread machThread, TTSDKThread pthread,
+                       const char *threadName, const char *queueName)
+{
+    TTSDKThreadSnapshot *snapshot = &registry->snapshots[registry->building];
+    if (snapshot->count >= snapshot->capacity) {
+        TTSDKLOG_ERROR("More threads added than announced. Dropping thread %lu", (unsigned long)machThread);
+        registry->hasChanges = true;
+        return;
+    }
+
+    int index = snapshot->count++;
+    snapshot->machThreads[index] = machThread;
+    snapshot->pthreads[index] = pthread;
+    snapshot->threadNames[index] = storeName(snapshot, threadName);
+    snapshot->queueNames[index] = storeName(snapshot, queueName);
+    uint32_t slot = slotForThread(snapshot, machThread);
+    while (snapshot->slots[slot] != 0) {
+        slot = (slot + 1) & snapshot->slotMask;
+    }
+    snapshot->slots[slot] = index + 1;
+
+    if (!registry->hasChanges) {
+        const TTSDKThreadSnapshot *published = &registry->snapshots[1 - registry->building];
+        int publishedIndex = indexOfThread(published, machThread);
+        registry->hasChanges = publishedIndex < 0 || published->pthreads[publishedIndex] != pthread ||
+                               namesDiffer(nameAt(published, published->threadNames[publishedIndex]), threadName) ||
+                               namesDiffer(nameAt(published, published->queueNames[publishedIndex]), queueName);
+    }
+}
+
+bool ttsdktr_commitUpdate(TTSDKThreadRegistry *registry)
+{
+    if (registry == NULL || !registry->hasChanges) {
+        return false;
+    }
+    atomic_store(&registry->activeSnapshot, registry->building);
+    atomic_fetch_add(&registry->generation, 1);
+    return true;
+}
+
+TTSDKThread *ttsdktr_getAllThreads(TTSDKThreadRegistry *registry, int *threadCount)
+{
+    if (registry == NULL || atomic_load(&registry->generation) == 0) {
+        if (threadCount != NULL) {
+            *threadCount = 0;
+        }
+        return NULL;
+    }
+    TTSDKThreadSnapshot *snapshot = &registry->snapshots[atomic_load(&registry->activeSnapshot)];
+    if (threadCount != NULL) {
+        *threadCount = snapshot->count;
+    }
+    return snapshot->machThreads;
+}
+
+const char *ttsdktr_getThreadName(TTSDKThreadRegistry *registry, TTSDKThread thread)
+{
+    if (registry == NULL) {
+        return NULL;
+    }
+    const TTSDKThreadSnapshot *snapshot = &registry->snapshots[atomic_load(&registry->activeSnapshot)];
+    int index = indexOfThread(snapshot, thread);
+    return index < 0 ? NULL : nameAt(snapshot, snapshot->threadNames[index]);
+}
+
+const char *ttsdktr_getQueueName(TTSDKThreadRegistry *registry, TTSDKThread thread)
+{
+    if (registry == NULL) {
+        return NULL;
+    }
+    const TTSDKThreadSnapshot *snapshot = &registry->snapshots[atomic_load(&registry->activeSnapshot)];
+    int index = indexOfThread(snapshot, thread);
+    return index < 0 ? NULL : nameAt(snapshot, snapshot->queueNames[index]);
+}
+
+int ttsdktr_generation(TTSDKThreadRegistry *registry)
+{
+    return registry != NULL ? atomic_load(&registry->generation) : 0;
+}
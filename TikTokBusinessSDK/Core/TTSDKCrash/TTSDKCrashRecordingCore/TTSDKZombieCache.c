@@ -0,0 +1,231 @@
+//
+//  TTSDKZombieCache.c
+//
+//  Created by TikTok on 2026-10-19.
+//
+//  Copyright (c) 2012 Karl Stenerud. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall remain in place
+// in this source code.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "TTSDKZombieCache.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "TTSDKLogger.h"
+
+/** How far a class lookup probes before giving up. */
+#define kMaxClassProbes 8
+
+#define WAY_BIT(WAY) ((uint8_t)(1u << (WAY)))
+
+typedef struct {
+    _Atomic(const void *) objects[TTSDKZOMBIECACHE_WAYS];
+    _Atomic(const char *) classNames[TTSDKZOMBIECACHE_WAYS];
+    _Atomic(uint8_t) referenced;
+    _Atomic(uint8_t) hand;
+} TTSDKZombieSet;
+
+struct TTSDKZombieCache {
+    TTSDKZombieSet *sets;
+    uint32_t setMask;
+};
+
+struct TTSDKClassFlagCache {
+    /** Class pointer with the flag in bit 0, or 0 if empty. */
+    _Atomic(uintptr_t) *slots;
+    uint32_t slotMask;
+};
+
+/** Fibonacci hashing: spreads out addresses that only differ in a few middle bits. */
+static inline uint32_t mixPointer(uintptr_t pointer, unsigned alignmentBits)
+{
+    uint64_t hash = ((uint64_t)pointer >> alignmentBits) * 0x9E3779B97F4A7C15ULL;
+    return (uint32_t)(hash >> 32);
+}
+
+static uint32_t roundUpToPowerOf2(int value)
+{
+    uint32_t result = 1;
+    while (result < (uint32_t)value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+// ============================================================================
+#pragma mark - Zombie Cache -
+// ============================================================================
+
+TTSDKZombieCache *ttsdkzc_create(int entryCount)
+{
+    if (entryCount <= 0) {
+        return NULL;
+    }
+    uint32_t setCount = roundUpToPowerOf2((entryCount + TTSDKZOMBIECACHE_WAYS - 1) / TTSDKZOMBIECACHE_WAYS);
+    TTSDKZombieCache *cache = calloc(1, sizeof(*cache));
+    TTSDKZombieSet *sets = calloc(setCount, sizeof(*sets));
+    if (cache == NULL || sets == NULL) {
+        TTSDKLOG_ERROR("Could not allocate a zombie cache of %u sets", setCount);
+        free(cache);
+        free(sets);
+        return NULL;
+    }
+    cache->sets = sets;
+    cache->setMask = setCount - 1;
+    return cache;
+}
+
+void ttsdkzc_destroy(TTSDKZombieCache *cache)
+{
+    if (cache != NULL) {
+        free(cache->sets);
+        free(cache);
+    }
+}
+
+int ttsdkzc_entryCount(const TTSDKZombieCache *cache)
+{
+    return cache != NULL ? (int)(cache->setMask + 1) * TTSDKZOMBIECACHE_WAYS : 0;
+}
+
+static inline TTSDKZombieSet *setForObject(TTSDKZombieCache *cache, const void *object)
+{
+    // Allocations are at least 16-byte aligned.
+    return &cache->sets[mixPointer((uintptr_t)object, 4) & cache->setMask];
+}
+
+void ttsdkzc_add(TTSDKZombieCache *cache, const void *object, const char *className)
+{
+    TTSDKZombieSet *set = setForObject(cache, object);
+
+    // The allocator reuses addresses quickly. Refresh the existing entry instead of taking another way.
+    for (int way = 0; way < TTSDKZOMBIECACHE_WAYS; way++) {
+        if (atomic_load_explicit(&set->objects[way], memory_order_relaxed) == object) {
+            atomic_store_explicit(&set->classNames[way], className, memory_order_release);
+            atomic_fetch_or_explicit(&set->referenced, WAY_BIT(way), memory_order_relaxed);
+            return;
+        }
+    }
+
+    // Clock: sweep past referenced ways, clearing their bit, until an unreferenced one turns up.
+    uint8_t referenced = atomic_load_explicit(&set->referenced, memory_order_relaxed);
+    unsigned hand = atomic_load_explicit(&set->hand, memory_order_relaxed);
+    unsigned victim = hand % TTSDKZOMBIECACHE_WAYS;
+    for (int step = 0; step < TTSDKZOMBIECACHE_WAYS; step++) {
+        victim = (hand + (unsigned)step) % TTSDKZOMBIECACHE_WAYS;
+        if ((referenced & WAY_BIT(victim)) == 0) {
+            break;
+        }
+        referenced &= (uint8_t)~WAY_BIT(victim);
+    }
+    atomic_store_explicit(&set->referenced, (uint8_t)(referenced & ~WAY_BIT(victim)), memory_order_relaxed);
+    atomic_store_explicit(&set->hand, (uint8_t)((victim + 1) % TTSDKZOMBIECACHE_WAYS), memory_order_relaxed);
+
+    // Publish the name before the address so that a reader matching the address sees the right name.
+    atomic_store_explicit(&set->objects[victim], NULL, memory_order_relaxed);
+    atomic_store_explicit(&set->classNames[victim], className, memory_order_release);
+    atomic_store_explicit(&set->objects[victim], object, memory_order_release);
+}
+
+const char *ttsdkzc_className(TTSDKZombieCache *cache, const void *object)
+{
+    if (cache == NULL || object == NULL) {
+        return NULL;
+    }
+    TTSDKZombieSet *set = setForObject(cache, object);
+    for (int way = 0; way < TTSDKZOMBIECACHE_WAYS; way++) {
+        if (atomic_load_explicit(&set->objects[way], memory_order_acquire) == object) {
+            atomic_fetch_or_explicit(&set->referenced, WAY_BIT(way), memory_order_relaxed);
+            return atomic_load_explicit(&set->classNames[way], memory_order_acquire);
+        }
+    }
+    return NULL;
+}
+
+// ============================================================================
+#pragma mark - Class Flag Cache -
+// ============================================================================
+
+TTSDKClassFlagCache *ttsdkzc_createClassFlags(int slotCount)
+{
+    if (slotCount <= 0) {
+        return NULL;
+    }
+    uint32_t count = roundUpToPowerOf2(slotCount);
+    TTSDKClassFlagCache *cache = calloc(1, sizeof(*cache));
+    _Atomic(uintptr_t) *slots = calloc(count, sizeof(*slots));
+    if (cache == NULL || slots == NULL) {
+        TTSDKLOG_ERROR("Could not allocate a class flag cache of %u slots", count);
+        free(cache);
+        free(slots);
+        return NULL;
+    }
+    cache->slots = slots;
+    cache->slotMask = count - 1;
+    return cache;
+}
+
+void ttsdkzc_destroyClassFlags(TTSDKClassFlagCache *cache)
+{
+    if (cache != NULL) {
+        free(cache->slots);
+        free(cache);
+    }
+}
+
+TTSDKClassFlag ttsdkzc_classFlag(const TTSDKClassFlagCache *cache, const void *cls)
+{
+    if (cache == NULL || cls == NULL) {
+        return TTSDKClassFlagUnknown;
+    }
+    uint32_t slot = mixPointer((uintptr_t)cls, 3);
+    for (int probe = 0; probe < kMaxClassProbes; probe++) {
+        uintptr_t entry = atomic_load_explicit(&cache->slots[(slot + (uint32_t)probe) & cache->slotMask],
+                                               memory_order_relaxed);
+        if (entry == 0) {
+            break;
+        }
+        if ((entry & ~(uintptr_t)1) == (uintptr_t)cls) {
+            return (entry & 1) != 0 ? TTSDKClassFlagSet : TTSDKClassFlagClear;
+        }
+    }
+    return TTSDKClassFlagUnknown;
+}
+
+void ttsdkzc_setClassFlag(TTSDKClassFlagCache *cache, const void *cls, bool flag)
+{
+    if (cache == NULL || cls == NULL || ((uintptr_t)cls & 1) != 0) {
+        return;
+    }
+    uintptr_t newEntry = (uintptr_t)cls | (flag ? 1 : 0);
+    uint32_t slot = mixPointer((uintptr_t)cls, 3);
+    for (int probe = 0; probe < kMaxClassProbes; probe++) {
+        _Atomic(uintptr_t) *entry = &cache->slots[(slot + (uint32_t)probe) & cache->slotMask];
+        uintptr_t expected = 0;
+        if (atomic_compare_exchange_strong(entry, &expected, newEntry)) {
+            return;
+        }
+        if ((expected & ~(uintptr_t)1) == (uintptr_t)cls) {
+            // Another thread got here first. A class's ancestry never changes, so it stored the same bit.
+            return;
+        }
+    }
+}
@@ -52,10 +52,60 @@ typedef struct {
     const char *crashInfoSignature;
 } TTSDKBinaryImage;
 
+/** Start tracking image loads and unloads so that address lookups can use a
+ * sorted index instead of walking every image's load commands.
+ * Shortly after, sorted symbol tables get built on a background thread so that
+ * ttsdkdl_dladdr() doesn't have to scan every symbol of an image either.
+ * Call this once, outside of any crash handler.
+ */
+void ttsdkdl_init(void);
+
+/** Use a bundled symbol index for the main executable instead of building its
+ * symbol table at runtime. This lets a stripped release binary still resolve
+ * its own symbol names. The index is ignored if it was built for another binary.
+ * Not async-safe.
+ *
+ * @param path The index file, as written by ttsdkdl_writeSymbolIndex().
+ *
+ * @return true if the index was loaded.
+ */
+bool ttsdkdl_loadSymbolIndex(const char *path);
+
+/** Write a symbol index for the main executable from its symbol table.
+ * Run this against an unstripped build of the exact binary that will ship.
+ * Not async-safe.
+ *
+ * @param path The file to write.
+ *
+ * @return true if the index was written.
+ */
+bool ttsdkdl_writeSymbolIndex(const char *path);
+
 /** Get the number of loaded binary images.
  */
 int ttsdkdl_imageCount(void);
 
+/** Get the number of records in the binary image cache, which is filled in from
+ * dyld callbacks once ttsdkdl_init() has been called. Records of unloaded images
+ * stay counted but can't be fetched. This function is async-safe.
+ *
+ * @return The number of records, or -1 if the cache isn't available or missed an
+ *         image. Use ttsdkdl_imageCount() and ttsdkdl_getBinaryImage() in that case.
+ */
+int ttsdkdl_cachedImageCount(void);
+
+/** Get a binary image from the cache. Everything except the crash info messages was
+ * parsed when the image was loaded; the messages are read from the image as it is now.
+ * This function is async-safe.
+ *
+ * @param index The record index, in load order.
+ *
+ * @param buffer A structure to hold the information.
+ *
+ * @return True if the record exists and its image is still loaded.
+ */
+bool ttsdkdl_getCachedBinaryImage(int index, TTSDKBinaryImage *buffer);
+
 /** Get information about a binary image.
  *
  * @param index The binary index.
@@ -157,12 +157,23 @@ bool ttsdkfu_removeFile(const char *path, bool mustExist);
  */
 bool ttsdkfu_deleteContentsOfPath(const char *path);
 
+/** Preallocated, memory-mapped file region. Everything inside should be considered internal use only. */
+typedef struct {
+    char *memory;
+    int length;
+    int position;
+    int fd;
+    bool isInUse;
+    char path[TTSDKFU_MAX_PATH_LENGTH];
+} TTSDKMappedRegion;
+
 /** Buffered writer structure. Everything inside should be considered internal use only. */
 typedef struct {
     char *buffer;
     int bufferLength;
     int position;
     int fd;
+    TTSDKMappedRegion *region;
 } TTSDKBufferedWriter;
 
 /** Open a file for buffered writing.
@@ -180,6 +191,30 @@ typedef struct {
 bool ttsdkfu_openBufferedWriter(TTSDKBufferedWriter *writer, const char *const path, char *writeBuffer,
                              int writeBufferLength);
 
+/** Open a buffered writer on top of a region reserved with ttsdkfu_reserveMappedRegion().
+ *
+ * The region's backing file is renamed to path, and writes are copied straight
+ * into the mapped memory. If the region fills up, the file is truncated to the
+ * bytes written so far and the writer falls back to regular buffered writes.
+ * Closing the writer truncates the file to its final size.
+ * The region can only be used once; reserve it again to write another file.
+ * This function is async-safe.
+ *
+ * @param writer The writer to initialize.
+ *
+ * @param region The reserved region to write into.
+ *
+ * @param path The final path of the file.
+ *
+ * @param writeBuffer Memory to use as the write buffer after the region overflows.
+ *
+ * @param writeBufferLength Length of the memory to use as the write buffer.
+ *
+ * @return True if the writer was opened. If false, the region is left untouched.
+ */
+bool ttsdkfu_openMappedWriter(TTSDKBufferedWriter *writer, TTSDKMappedRegion *region, const char *const path,
+                              char *writeBuffer, int writeBufferLength);
+
 /** Close a buffered writer.
  *
  * @param writer The writer to close.
@@ -276,6 +311,33 @@ bool ttsdkfu_readBufferedReaderUntilChar(TTSDKBufferedReader *reader, int ch, ch
  */
 void *ttsdkfu_mmap(const char *path, int size);
 
+/** Create a file of the given size, allocate its blocks and map it into memory,
+ * so that it can later be written without any write syscalls.
+ *
+ * @param region The region to initialize.
+ *
+ * @param path The path of the backing file. Any existing file is replaced.
+ *
+ * @param size The size of the region.
+ *
+ * @return True if the region was successfully reserved.
+ */
+bool ttsdkfu_reserveMappedRegion(TTSDKMappedRegion *region, const char *path, int size);
+
+/** Unmap a reserved region and delete its backing file if it was never written.
+ *
+ * @param region The region to release.
+ */
+void ttsdkfu_releaseMappedRegion(TTSDKMappedRegion *region);
+
+/** Truncate the file of a region that is being written to the bytes written so far.
+ * Use this when a writer using the region can no longer be closed normally.
+ * This function is async-safe.
+ *
+ * @param region The region to truncate.
+ */
+void ttsdkfu_truncateMappedRegion(TTSDKMappedRegion *region);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,123 @@
+//
+//  TTSDKImageRangeIndex.h
+//
+//  Created by TikTok on 2026-10-19.
+//
+//  Copyright (c) 2012 Karl Stenerud. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall remain in place
+// in this source code.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/* Sorted, async-safe index of the address ranges covered by loaded images.
+ *
+ * Writers (dyld add/remove-image callbacks) are serialized by a mutex and
+ * rebuild the inactive half of a double-buffered table before publishing it.
+ * Readers never lock: they binary search the published table and validate it
+ * with a per-table sequence counter, so they can be used from a crash handler.
+ * Nothing in here depends on Mach-O, so it can be exercised with synthetic
+ * layouts on any platform.
+ */
+
+#ifndef HDR_TTSDKImageRangeIndex_h
+#define HDR_TTSDKImageRangeIndex_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** An address range belonging to a loaded image (typically one segment). */
+typedef struct {
+    uintptr_t start;
+    uintptr_t end;
+    const void *header;
+    intptr_t slide;
+    const char *name;
+} TTSDKImageRange;
+
+/** Image range index. Everything inside should be considered internal use only. */
+typedef struct TTSDKImageRangeIndex TTSDKImageRangeIndex;
+
+typedef enum {
+    TTSDKImageRangeLookupFound,
+    TTSDKImageRangeLookupNotFound,
+    /** The index isn't ready or kept changing during the lookup. Fall back to a linear search. */
+    TTSDKImageRangeLookupUnavailable,
+} TTSDKImageRangeLookupResult;
+
+/** Create an index.
+ *
+ * @param initialCapacity The number of ranges to preallocate room for.
+ *
+ * @return The new index, or NULL if out of memory.
+ */
+TTSDKImageRangeIndex *ttsdkiri_create(int initialCapacity);
+
+/** Destroy an index. Only call this when no reader can be using it.
+ *
+ * @param index The index to destroy.
+ */
+void ttsdkiri_destroy(TTSDKImageRangeIndex *index);
+
+/** Add the ranges of an image. Not async-safe.
+ *
+ * @param index The index.
+ *
+ * @param ranges The ranges of the image. They don't need to be sorted.
+ *
+ * @param count The number of ranges.
+ *
+ * @return true if the ranges were added.
+ */
+bool ttsdkiri_addImage(TTSDKImageRangeIndex *index, const TTSDKImageRange *ranges, int count);
+
+/** Remove all ranges belonging to an image. Not async-safe.
+ *
+ * @param index The index.
+ *
+ * @param header The header of the image to remove.
+ */
+void ttsdkiri_removeImage(TTSDKImageRangeIndex *index, const void *header);
+
+/** Get the number of ranges currently published.
+ *
+ * @param index The index.
+ */
+int ttsdkiri_rangeCount(TTSDKImageRangeIndex *index);
+
+/** Find the range containing an address.
+ * This function is async-safe and lock-free.
+ *
+ * @param index The index.
+ *
+ * @param address The address to look up.
+ *
+ * @param range Receives a copy of the matching range.
+ *
+ * @return The outcome of the lookup. range is only filled in when found.
+ */
+TTSDKImageRangeLookupResult ttsdkiri_find(TTSDKImageRangeIndex *index, uintptr_t address, TTSDKImageRange *range);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // HDR_TTSDKImageRangeIndex_h
@@ -239,6 +239,31 @@ bool ttsdklog_setLogFilename(const char *filename, bool overwrite);
 /** Clear the log file. */
 bool ttsdklog_clearLogFile(void);
 
+/** Route log entries through an in-memory ring buffer.
+ * Logging then costs a copy into the ring; a background thread writes the
+ * entries out to the log file and stdout. Has no effect if
+ * TTSDKLOGGER_CBufferSize is 0. Once enabled, the ring stays enabled.
+ *
+ * @param sizeInBytes How much memory the ring may use.
+ *
+ * @return true if the ring is enabled.
+ */
+bool ttsdklog_enableRingBuffer(int sizeInBytes);
+
+/** Check if log entries are going through the ring buffer. */
+bool ttsdklog_isRingBufferEnabled(void);
+
+/** Read back the most recent lines from the ring buffer, without touching the log file.
+ * This function is async-safe. Does nothing if the ring buffer isn't enabled.
+ *
+ * @param maxBytes Roughly how much of the most recent log to read.
+ *
+ * @param onLine Called for each line, without its trailing newline.
+ *
+ * @param context Passed to onLine.
+ */
+void ttsdklog_readRecentLines(int maxBytes, void (*onLine)(const char *line, int length, void *context), void *context);
+
 /** Tests if the logger would print at the specified level.
  *
  * @param LEVEL The level to test for. One of:
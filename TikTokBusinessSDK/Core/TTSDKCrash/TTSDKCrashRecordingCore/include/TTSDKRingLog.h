@@ -0,0 +1,136 @@
+//
+//  TTSDKRingLog.h
+//
+//  Created by TikTok on 2026-10-19.
+//
+//  Copyright (c) 2012 Karl Stenerud. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall remain in place
+// in this source code.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/* Lock-free, in-memory ring of log text.
+ *
+ * The ring is an array of fixed-size slots. A producer reserves as many slots as
+ * its text needs with a single atomic add, copies the text in, and commits each
+ * slot by storing its sequence number. Producers never wait: when the ring is
+ * full, the oldest slots are overwritten.
+ *
+ * A single consumer drains committed text in batches (typically to the console
+ * log file), and a crash handler can read back the most recent lines without
+ * going through a file. Both notice slots that were overwritten under them and
+ * skip them.
+ */
+
+#ifndef HDR_TTSDKRingLog_h
+#define HDR_TTSDKRingLog_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TTSDKRINGLOG_SLOT_SIZE 128
+
+/** Ring log. Everything inside should be considered internal use only. */
+typedef struct TTSDKRingLog TTSDKRingLog;
+
+/** Receives text read out of the ring.
+ *
+ * @param data The text. Not NUL terminated.
+ *
+ * @param length The length of the text.
+ *
+ * @param context The context passed to the read function.
+ */
+typedef void (*TTSDKRingLogSink)(const char *data, int length, void *context);
+
+/** Create a ring log.
+ *
+ * @param capacityInBytes The amount of memory to use. Rounded up to a power of 2 number of slots.
+ *
+ * @return The new ring, or NULL if out of memory.
+ */
+TTSDKRingLog *ttsdkrl_create(int capacityInBytes);
+
+/** Destroy a ring log. Only call this when nothing else can be using it.
+ *
+ * @param ring The ring to destroy.
+ */
+void ttsdkrl_destroy(TTSDKRingLog *ring);
+
+/** Append text to the ring.
+ * This function is async-safe and lock-free.
+ *
+ * @param ring The ring.
+ *
+ * @param text The text to append.
+ *
+ * @param length The length of the text. Text that wouldn't fit into half the ring is truncated.
+ */
+void ttsdkrl_append(TTSDKRingLog *ring, const char *text, int length);
+
+/** Pass all committed text that hasn't been drained yet to a sink.
+ * Only one thread may drain a ring.
+ *
+ * @param ring The ring.
+ *
+ * @param buffer Scratch space used to batch up text. Must hold at least one slot's worth.
+ *
+ * @param bufferSize The size of the buffer.
+ *
+ * @param sink Receives the text, one batch at a time.
+ *
+ * @param context Passed to the sink.
+ *
+ * @return The number of bytes passed to the sink.
+ */
+int ttsdkrl_drain(TTSDKRingLog *ring, char *buffer, int bufferSize, TTSDKRingLogSink sink, void *context);
+
+/** Pass the most recent lines to a sink, one line at a time without the trailing newline.
+ * This function is async-safe. It doesn't consume anything.
+ *
+ * @param ring The ring.
+ *
+ * @param maxBytes Roughly how much of the most recent text to read.
+ *
+ * @param onLine Receives each line.
+ *
+ * @param context Passed to onLine.
+ */
+void ttsdkrl_readRecentLines(TTSDKRingLog *ring, int maxBytes, TTSDKRingLogSink onLine, void *context);
+
+/** Make ttsdkrl_readRecentLines() ignore everything appended so far.
+ *
+ * @param ring The ring.
+ */
+void ttsdkrl_markCleared(TTSDKRingLog *ring);
+
+/** Get the number of slots that were overwritten before they could be drained.
+ *
+ * @param ring The ring.
+ */
+uint64_t ttsdkrl_droppedSlotCount(TTSDKRingLog *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // HDR_TTSDKRingLog_h
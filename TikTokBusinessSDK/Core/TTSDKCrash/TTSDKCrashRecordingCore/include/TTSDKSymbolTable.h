@@ -0,0 +1,188 @@
+//
+//  TTSDKSymbolTable.h
+//
+//  Created by TikTok on 2026-10-19.
+//
+//  Copyright (c) 2012 Karl Stenerud. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall remain in place
+// in this source code.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/* Sorted per-image symbol tables, so that symbol lookups don't have to scan
+ * every nlist entry of an image.
+ *
+ * Tables are built outside of any crash handler (from the image's live symbol
+ * table, or by mapping a bundled index file) and then published into a small
+ * registry keyed by image header. Lookups and registry reads are async-safe.
+ *
+ * Symbol index file layout (host byte order, every field naturally aligned):
+ *
+ *     TTSDKSymbolIndexFileHeader   magic, version, image UUID, base address, counts
+ *     TTSDKSymbolEntry[count]      sorted by offset, one entry per distinct offset
+ *     char[stringsSize]            NUL terminated names, ending with a NUL
+ *
+ * Nothing in here depends on Mach-O, so it can be exercised with synthetic
+ * symbols on any platform.
+ */
+
+#ifndef HDR_TTSDKSymbolTable_h
+#define HDR_TTSDKSymbolTable_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TTSDKSYMBOLINDEX_MAGIC 0x49535454  // "TTSI"
+#define TTSDKSYMBOLINDEX_VERSION 1
+
+/** Name offset of a symbol whose name is meaningless (e.g. in a stripped image). */
+#define TTSDKSymbolNoName UINT32_MAX
+
+/** A symbol, addressed relative to its table's base address. */
+typedef struct {
+    uint32_t offset;
+    uint32_t nameOffset;
+} TTSDKSymbolEntry;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint8_t uuid[16];
+    uint64_t baseAddress;
+    uint32_t symbolCount;
+    uint32_t stringsSize;
+} TTSDKSymbolIndexFileHeader;
+
+/** Symbol table of one image. Everything inside should be considered internal use only. */
+typedef struct TTSDKSymbolTable TTSDKSymbolTable;
+
+/** Create a table from unsorted symbols. Not async-safe.
+ *
+ * When several symbols share an offset, the one that comes last in the input wins.
+ *
+ * @param header The header of the image the symbols belong to.
+ *
+ * @param baseAddress The unslid address that symbol offsets are relative to.
+ *
+ * @param strings The string table that name offsets point into. It is not copied
+ *                and must outlive the table.
+ *
+ * @param stringsSize The size of the string table.
+ *
+ * @param symbols The symbols.
+ *
+ * @param count The number of symbols.
+ *
+ * @return The new table, or NULL if out of memory.
+ */
+TTSDKSymbolTable *ttsdksym_createTable(const void *header, uint64_t baseAddress, const char *strings,
+                                       uint32_t stringsSize, const TTSDKSymbolEntry *symbols, int count);
+
+/** Open a symbol index file by mapping it into memory. Not async-safe.
+ *
+ * @param path The index file.
+ *
+ * @param header The header of the image the index describes.
+ *
+ * @param uuid The UUID of that image. The index is rejected if it was built for another binary.
+ *
+ * @return The table, or NULL if the file is missing, malformed or for another binary.
+ */
+TTSDKSymbolTable *ttsdksym_openIndexFile(const char *path, const void *header, const uint8_t *uuid);
+
+/** Write a table out as a symbol index file. Not async-safe.
+ *
+ * Only the names that are actually referenced get written.
+ *
+ * @param table The table.
+ *
+ * @param uuid The UUID of the image the table belongs to.
+ *
+ * @param path The file to write.
+ *
+ * @return true if the file was written.
+ */
+bool ttsdksym_writeIndexFile(const TTSDKSymbolTable *table, const uint8_t *uuid, const char *path);
+
+/** Destroy a table. Only call this when it isn't published and no reader can be using it.
+ *
+ * @param table The table to destroy.
+ */
+void ttsdksym_destroyTable(TTSDKSymbolTable *table);
+
+/** Get the number of distinct symbols in a table.
+ *
+ * @param table The table.
+ */
+int ttsdksym_symbolCount(const TTSDKSymbolTable *table);
+
+/** Get the unslid base address of a table.
+ *
+ * @param table The table.
+ */
+uint64_t ttsdksym_baseAddress(const TTSDKSymbolTable *table);
+
+/** Find the nearest symbol at or before an address.
+ * This function is async-safe.
+ *
+ * @param table The table.
+ *
+ * @param address The unslid address to look up.
+ *
+ * @param symbolAddress Receives the unslid address of the symbol.
+ *
+ * @param symbolName Receives the raw name of the symbol, or NULL if it has none.
+ *
+ * @return true if a symbol was found.
+ */
+bool ttsdksym_lookup(const TTSDKSymbolTable *table, uint64_t address, uint64_t *symbolAddress,
+                     const char **symbolName);
+
+/** Publish a table so that ttsdksym_tableForImage() finds it. Not async-safe.
+ *
+ * @param table The table. Ownership passes to the registry.
+ *
+ * @return false if the registry is full or the image already has a table.
+ */
+bool ttsdksym_publishTable(TTSDKSymbolTable *table);
+
+/** Get the published table of an image.
+ * This function is async-safe and lock-free.
+ *
+ * @param header The header of the image.
+ *
+ * @return The table, or NULL if none has been published yet.
+ */
+const TTSDKSymbolTable *ttsdksym_tableForImage(const void *header);
+
+/** Withdraw the table of an unloaded image. Not async-safe.
+ * The table itself is kept alive since a reader could still be using it.
+ *
+ * @param header The header of the image.
+ */
+void ttsdksym_retireTable(const void *header);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // HDR_TTSDKSymbolTable_h
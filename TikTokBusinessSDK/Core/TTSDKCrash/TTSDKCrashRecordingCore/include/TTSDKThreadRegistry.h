@@ -0,0 +1,147 @@
+//
+//  TTSDKThreadRegistry.h
+//
+//  Created by TikTok on 2026-10-19.
+//
+//  Copyright (c) 2012 Karl Stenerud. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall remain in place
+// in this source code.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/* Registry of the process's threads and their names, kept up to date by a
+ * background updater and read from crash handlers.
+ *
+ * The registry holds two snapshots. An update fills in the one that isn't
+ * published, reusing its arrays, hash table and name arena from the previous
+ * time around, and compares each thread against the published snapshot as it
+ * goes. Only if something changed does it publish the new snapshot, with a
+ * single atomic store. In a steady state an update allocates nothing and
+ * publishes nothing.
+ *
+ * Readers never lock. Thread lookups go through an open-addressing hash, so
+ * they are O(1). Nothing in here calls into Mach, so it can be exercised with
+ * synthetic threads on any platform.
+ */
+
+#ifndef HDR_TTSDKThreadRegistry_h
+#define HDR_TTSDKThreadRegistry_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "TTSDKThread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Thread registry. Everything inside should be considered internal use only. */
+typedef struct TTSDKThreadRegistry TTSDKThreadRegistry;
+
+/** Create a registry.
+ *
+ * @param initialCapacity The number of threads to preallocate room for.
+ *
+ * @return The new registry, or NULL if out of memory.
+ */
+TTSDKThreadRegistry *ttsdktr_create(int initialCapacity);
+
+/** Destroy a registry. Only call this when nothing else can be using it.
+ *
+ * @param registry The registry to destroy.
+ */
+void ttsdktr_destroy(TTSDKThreadRegistry *registry);
+
+/** Start an update. Updates must not overlap. Not async-safe.
+ *
+ * @param registry The registry.
+ *
+ * @param threadCount The number of threads that will be added.
+ *
+ * @return true if the update can go ahead.
+ */
+bool ttsdktr_beginUpdate(TTSDKThreadRegistry *registry, int threadCount);
+
+/** Add a thread to the update in progress. Not async-safe.
+ *
+ * @param registry The registry.
+ *
+ * @param machThread The thread.
+ *
+ * @param pthread The thread's pthread.
+ *
+ * @param threadName The thread's name, or NULL if it has none. Copied.
+ *
+ * @param queueName The name of the thread's dispatch queue, or NULL. Copied.
+ */
+void ttsdktr_addThread(TTSDKThreadRegistry *registry, TTSDKThread machThread, TTSDKThread pthread,
+                       const char *threadName, const char *queueName);
+
+/** Finish an update, publishing it if anything changed. Not async-safe.
+ *
+ * @param registry The registry.
+ *
+ * @return true if a new snapshot was published.
+ */
+bool ttsdktr_commitUpdate(TTSDKThreadRegistry *registry);
+
+/** Get all threads of the published snapshot.
+ * This function is async-safe.
+ *
+ * @param registry The registry.
+ *
+ * @param threadCount Receives the number of threads.
+ *
+ * @return The threads, or NULL if nothing has been published.
+ */
+TTSDKThread *ttsdktr_getAllThreads(TTSDKThreadRegistry *registry, int *threadCount);
+
+/** Get the name of a thread in the published snapshot.
+ * This function is async-safe.
+ *
+ * @param registry The registry.
+ *
+ * @param thread The thread.
+ *
+ * @return The name, or NULL if the thread is unknown or unnamed.
+ */
+const char *ttsdktr_getThreadName(TTSDKThreadRegistry *registry, TTSDKThread thread);
+
+/** Get the dispatch queue name of a thread in the published snapshot.
+ * This function is async-safe.
+ *
+ * @param registry The registry.
+ *
+ * @param thread The thread.
+ *
+ * @return The name, or NULL if the thread is unknown or has no queue name.
+ */
+const char *ttsdktr_getQueueName(TTSDKThreadRegistry *registry, TTSDKThread thread);
+
+/** Get the number of snapshots published so far.
+ *
+ * @param registry The registry.
+ */
+int ttsdktr_generation(TTSDKThreadRegistry *registry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // HDR_TTSDKThreadRegistry_h
@@ -0,0 +1,147 @@
+//
+//  TTSDKZombieCache.h
+//
+//  Created by TikTok on 2026-10-19.
+//
+//  Copyright (c) 2012 Karl Stenerud. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall remain in place
+// in this source code.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/* Caches used by the zombie monitor.
+ *
+ * The zombie cache remembers the class names of recently deallocated objects.
+ * It is set-associative: an object hashes to a set of a few ways, and a per-set
+ * clock hand picks the victim when the set is full. Entries that get looked up,
+ * or whose address gets deallocated again, are given a second chance.
+ *
+ * The class flag cache remembers one bit per class (whether it is an NSException),
+ * so that the dealloc hook doesn't have to walk the superclass chain every time.
+ *
+ * Both are written from dealloc on any thread without locking. Like before,
+ * a racing reader can see a stale entry; this is only a debugging aid.
+ * Nothing in here depends on the Objective-C runtime, so it can be exercised
+ * with synthetic pointers on any platform.
+ */
+
+#ifndef HDR_TTSDKZombieCache_h
+#define HDR_TTSDKZombieCache_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TTSDKZOMBIECACHE_WAYS 4
+
+/** Zombie cache. Everything inside should be considered internal use only. */
+typedef struct TTSDKZombieCache TTSDKZombieCache;
+
+/** Class flag cache. Everything inside should be considered internal use only. */
+typedef struct TTSDKClassFlagCache TTSDKClassFlagCache;
+
+typedef enum {
+    TTSDKClassFlagUnknown = -1,
+    TTSDKClassFlagClear = 0,
+    TTSDKClassFlagSet = 1,
+} TTSDKClassFlag;
+
+/** Create a zombie cache.
+ *
+ * @param entryCount The total number of entries. Rounded up to a power of 2 number of sets.
+ *
+ * @return The new cache, or NULL if out of memory.
+ */
+TTSDKZombieCache *ttsdkzc_create(int entryCount);
+
+/** Destroy a zombie cache. Only call this when nothing else can be using it.
+ *
+ * @param cache The cache to destroy.
+ */
+void ttsdkzc_destroy(TTSDKZombieCache *cache);
+
+/** Get the total number of entries of a zombie cache.
+ *
+ * @param cache The cache.
+ */
+int ttsdkzc_entryCount(const TTSDKZombieCache *cache);
+
+/** Record a deallocated object.
+ *
+ * @param cache The cache.
+ *
+ * @param object The object's address.
+ *
+ * @param className The object's class name. Must stay valid for the life of the process.
+ */
+void ttsdkzc_add(TTSDKZombieCache *cache, const void *object, const char *className);
+
+/** Get the class name of a deallocated object.
+ * This function is async-safe.
+ *
+ * @param cache The cache.
+ *
+ * @param object The address to look up.
+ *
+ * @return The class name, or NULL if the object isn't cached.
+ */
+const char *ttsdkzc_className(TTSDKZombieCache *cache, const void *object);
+
+/** Create a class flag cache.
+ *
+ * @param slotCount The number of classes to make room for. Rounded up to a power of 2.
+ *
+ * @return The new cache, or NULL if out of memory.
+ */
+TTSDKClassFlagCache *ttsdkzc_createClassFlags(int slotCount);
+
+/** Destroy a class flag cache. Only call this when nothing else can be using it.
+ *
+ * @param cache The cache to destroy.
+ */
+void ttsdkzc_destroyClassFlags(TTSDKClassFlagCache *cache);
+
+/** Get the cached flag of a class.
+ *
+ * @param cache The cache.
+ *
+ * @param cls The class.
+ *
+ * @return The flag, or TTSDKClassFlagUnknown if it hasn't been stored.
+ */
+TTSDKClassFlag ttsdkzc_classFlag(const TTSDKClassFlagCache *cache, const void *cls);
+
+/** Store the flag of a class. When the cache has no room near the class's slot,
+ * nothing is stored and callers keep computing the flag themselves.
+ *
+ * @param cache The cache.
+ *
+ * @param cls The class. Must be at least 2-byte aligned.
+ *
+ * @param flag Whether the flag is set.
+ */
+void ttsdkzc_setClassFlag(TTSDKClassFlagCache *cache, const void *cls, bool flag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // HDR_TTSDKZombieCache_h
@@ -16,6 +16,7 @@
 #import "TikTokAppEventUtility.h"
 #import "TikTokAppEvent.h"
 #import "TikTokEDPConfig.h"
+#import "TikTokKeyValueStore.h"
 
 @implementation NSObject (TikTokAdditions)
 
@@ -43,10 +44,9 @@
 }
 
 - (BOOL)hook_application:(UIApplication *)application openURL:(NSURL *)url options:(NSDictionary<UIApplicationOpenURLOptionsKey, id> *)options {
-    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+    TikTokKeyValueStore *defaults = [TikTokKeyValueStore sharedStore];
     [defaults setObject:TTSafeString(url.absoluteString) forKey:@"source_url"];
     [defaults setObject:TTSafeString([options objectForKey:UIApplicationOpenURLOptionsSourceApplicationKey]) forKey:@"refer"];
-    [defaults synchronize];
     return [self hook_application:application openURL:url options:options];
 }
 
@@ -70,10 +70,9 @@
         refer = @"";
     }
     
-    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+    TikTokKeyValueStore *defaults = [TikTokKeyValueStore sharedStore];
     [defaults setObject:TTSafeString(launchURL.absoluteString) forKey:@"source_url"];
     [defaults setObject:TTSafeString(refer) forKey:@"refer"];
-    [defaults synchronize];
 }
 
 @end
@@ -9,6 +9,7 @@
 #import <Foundation/Foundation.h>
 #import "TikTokBusiness.h"
 #import "TikTokEventLogger.h"
+#import "TikTokRequestHandler.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -18,6 +19,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, assign) double exchangeErrReportRate;
 
+@property (nonatomic, strong, nullable) TikTokRequestHandler *requestHandler;
+
 /**
  * @brief This method is used internally to keep track of event logger state
  *        The event persistence is populated by several tracked events and then
@@ -25,6 +28,23 @@ NS_ASSUME_NONNULL_BEGIN
 */
 + (TikTokEventLogger *)getEventLogger;
 
+/**
+ * @brief Track several events at once, as the engine bridges do. Events of a lane are
+ *        persisted together and a single eager flush covers any purchases.
+ *
+ * @return Indexes of the events accepted, known before any screenshot is attached.
+ *         Nil if events aren't tracked, e.g. the remote switch is off.
+ */
+- (nullable NSIndexSet *)trackEvents:(NSArray<TikTokAppEvent *> *)events;
+
+/**
+ * @brief Apply the cached global config if there is one, then fetch and apply the current one
+ */
+- (void)getGlobalConfig:(TikTokConfig *)tiktokConfig
+  isFirstInitialization:(BOOL)isFirstInitialization;
+
+- (void)loadUserAgent;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -17,6 +17,7 @@
 #import "TikTokBusiness+private.h"
 #import "TikTokConfig.h"
 #import "TikTokLogger.h"
+#import "TikTokLogger+private.h"
 #import "TikTokAppEvent.h"
 #import "TikTokPaymentObserver.h"
 #import "TikTokFactory.h"
@@ -37,6 +38,14 @@
 #import "TikTokBaseEventPersistence.h"
 #import "TikTokSKANEventPersistence.h"
 #import "TikTokDebugInfo.h"
+#import "TikTokRequestContext.h"
+#import "TikTokEventAdmissionController.h"
+#import "TikTokKeyValueStore.h"
+#import "TikTokStartupTrace.h"
+#import "TikTokStartupScheduler.h"
+#import "TikTokResourceGovernor.h"
+#import "TikTokUploadGate.h"
+#import "TikTokProductCache.h"
 
 // This header file is missing when integrating in Swift Package Manager.
 #ifndef TikTokBusinessSDK_SPM
@@ -60,8 +69,10 @@
 @property (nonatomic) BOOL retentionTrackingEnabled;
 @property (nonatomic) BOOL paymentTrackingEnabled;
 @property (nonatomic) BOOL SKAdNetworkSupportEnabled;
-@property (nonatomic, strong, nullable) TikTokRequestHandler *requestHandler;
 @property (nonatomic, strong, readwrite) dispatch_queue_t isolationQueue;
+// Startup work that doesn't have to finish before initializeSdk returns
+@property (nonatomic, strong) TikTokStartupScheduler *startupScheduler;
+@property (nonatomic, strong) dispatch_queue_t SKANQueue;
 @property (nonatomic, assign, readwrite) BOOL isDebugMode;
 @property (nonatomic, copy) NSString *testEventCode;
 @property (nonatomic, assign, readwrite) BOOL isLDUMode;
@@ -72,6 +83,7 @@
 @property (nonatomic, assign) BOOL isStoreKit2ObserveEnabled;
 @property (nonatomic, assign, readwrite) UInt64 storeKit2ObserveInterval;
 @property (nonatomic, assign, readwrite) BOOL isStoreKit2ReportConsumableStateEnabled;
+@property (nonatomic, strong, nullable) TikTokSKAdNetworkRuleIndex *matchedSKANRuleIndex;
 
 @end
 
@@ -156,6 +168,8 @@ static dispatch_once_t onceToken = 0;
     }
     
     self.isolationQueue = dispatch_queue_create([@"tiktokIsolationQueue" UTF8String], DISPATCH_QUEUE_SERIAL);
+    self.startupScheduler = [[TikTokStartupScheduler alloc] initWithTrace:[TikTokStartupTrace sharedTrace]];
+    self.SKANQueue = dispatch_queue_create("com.TikTokBusiness.SKAN", DISPATCH_QUEUE_SERIAL);
     self.requestHandler = nil;
     self.logger = [TikTokFactory getLogger];
     self.enabled = YES;
@@ -286,6 +300,7 @@ withType:(NSString *)type
     if (@available(iOS 14, *)) {
         if (trackingDesc) {
             [ATTrackingManager requestTrackingAuthorizationWithCompletionHandler:^(ATTrackingManagerAuthorizationStatus status) {
+                [[TikTokRequestContextCache sharedCache] invalidate];
                 if(completion) {
                     completion(status);
                 }
@@ -362,36 +377,66 @@ withType:(NSString *)type
         return;
     }
     
-    self.config = tiktokConfig;
-    self.trackingEnabled = tiktokConfig.trackingEnabled;
-    self.automaticTrackingEnabled = tiktokConfig.automaticTrackingEnabled;
-    self.installTrackingEnabled = tiktokConfig.installTrackingEnabled;
-    self.launchTrackingEnabled = tiktokConfig.launchTrackingEnabled;
-    self.retentionTrackingEnabled = tiktokConfig.retentionTrackingEnabled;
-    self.paymentTrackingEnabled = tiktokConfig.paymentTrackingStatus == TikTokPaymentTrackStatus_disabled ? NO : YES;
-    self.SKAdNetworkSupportEnabled = tiktokConfig.SKAdNetworkSupportEnabled;
-    self.accessToken = tiktokConfig.accessToken;
-    NSString *anonymousID = [[TikTokIdentifyUtility sharedInstance] getOrGenerateAnonymousID];
-    self.anonymousID = anonymousID;
-    self.isDebugMode = tiktokConfig.debugModeEnabled;
-    self.testEventCode = self.isDebugMode ? [self generateTestEventCodeWithConfig:tiktokConfig] : nil;
-    self.isLDUMode = tiktokConfig.LDUModeEnabled;
-
-    self.requestHandler = [TikTokFactory getRequestHandler];
-    self.eventLogger = [[TikTokEventLogger alloc] initWithConfig:tiktokConfig];
-    self.initialized = NO;
-    [self startTimer];
-    
-    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
-    [defaults setObject:@"true" forKey:@"AreTimersOn"];
-    [defaults setObject:initStartTimestamp forKey:@"monitorInitStartTime"];
-    [defaults synchronize];
-    
-    [self getGlobalConfig:tiktokConfig isFirstInitialization:YES];
-    
-    NSNotificationCenter *defaultCenter = [NSNotificationCenter defaultCenter];
-    [defaultCenter addObserver:self selector:@selector(applicationDidEnterBackground:) name:UIApplicationDidEnterBackgroundNotification object:nil];
-    [defaultCenter addObserver:self selector:@selector(applicationDidBecomeActive:) name:UIApplicationDidBecomeActiveNotification object:nil];
+    // Only config capture, the ingestion queue and the config request run here. The rest
+    // of startup is handed to the startup scheduler, and each step is a startup span.
+    TikTokStartupTrace *trace = [TikTokStartupTrace sharedTrace];
+    [trace traceSpan:@"config_capture" block:^{
+        self.config = tiktokConfig;
+        self.trackingEnabled = tiktokConfig.trackingEnabled;
+        self.automaticTrackingEnabled = tiktokConfig.automaticTrackingEnabled;
+        self.installTrackingEnabled = tiktokConfig.installTrackingEnabled;
+        self.launchTrackingEnabled = tiktokConfig.launchTrackingEnabled;
+        self.retentionTrackingEnabled = tiktokConfig.retentionTrackingEnabled;
+        self.paymentTrackingEnabled = tiktokConfig.paymentTrackingStatus == TikTokPaymentTrackStatus_disabled ? NO : YES;
+        self.SKAdNetworkSupportEnabled = tiktokConfig.SKAdNetworkSupportEnabled;
+        self.accessToken = tiktokConfig.accessToken;
+        self.isDebugMode = tiktokConfig.debugModeEnabled;
+        self.testEventCode = self.isDebugMode ? [self generateTestEventCodeWithConfig:tiktokConfig] : nil;
+        self.isLDUMode = tiktokConfig.LDUModeEnabled;
+    }];
+    [trace traceSpan:@"anonymous_id" block:^{
+        self.anonymousID = [[TikTokIdentifyUtility sharedInstance] getOrGenerateAnonymousID];
+    }];
+
+    // Events persisted before this runs land in the default store and are moved over by it
+    [self.startupScheduler scheduleStage:@"persistence_open" priority:TikTokStartupPriorityHigh block:^{
+        [[TikTokAppEventPersistence persistence] useStorageBackend:tiktokConfig.eventStorageBackend];
+        [[TikTokMonitorEventPersistence persistence] useStorageBackend:tiktokConfig.eventStorageBackend];
+    }];
+    [trace traceSpan:@"event_queue" block:^{
+        self.requestHandler = [TikTokFactory getRequestHandler];
+        TikTokEventLogger *eventLogger = [[TikTokEventLogger alloc] initWithConfig:tiktokConfig];
+        // persistence_open may swap the event store, so nothing is written or flushed until it has run
+        [eventLogger suspendQueues];
+        [self.startupScheduler notifyWhenStageFinished:@"persistence_open" queue:dispatch_get_global_queue(QOS_CLASS_UTILITY, 0) block:^{
+            [eventLogger resumeQueues];
+        }];
+        self.eventLogger = eventLogger;
+        self.initialized = NO;
+        [self startTimer];
+
+        TikTokKeyValueStore *defaults = [TikTokKeyValueStore sharedStore];
+        [defaults setObject:@"true" forKey:@"AreTimersOn"];
+        [defaults setObject:initStartTimestamp forKey:@"monitorInitStartTime"];
+    }];
+
+    [self.startupScheduler scheduleStage:@"memory_governor" priority:TikTokStartupPriorityDefault block:^{
+        [self startResourceGovernor];
+    }];
+    // flushes hold back while the network is unreachable and drain the backlog once it's back
+    [self.startupScheduler scheduleStage:@"upload_gate" priority:TikTokStartupPriorityDefault block:^{
+        [[TikTokUploadGate sharedGate] start];
+    }];
+
+    [trace traceSpan:@"global_config" block:^{
+        [self getGlobalConfig:tiktokConfig isFirstInitialization:YES];
+    }];
+
+    [trace traceSpan:@"notifications" block:^{
+        NSNotificationCenter *defaultCenter = [NSNotificationCenter defaultCenter];
+        [defaultCenter addObserver:self selector:@selector(applicationDidEnterBackground:) name:UIApplicationDidEnterBackgroundNotification object:nil];
+        [defaultCenter addObserver:self selector:@selector(applicationDidBecomeActive:) name:UIApplicationDidBecomeActiveNotification object:nil];
+    }];
     
     NSError *error = nil;
     if (!tiktokConfig.trackingEnabled) {
@@ -412,12 +457,33 @@ withType:(NSString *)type
     [self monitorInitMethodWithStart:initStartTimestamp error:error];
 }
 
+// Lets go of what the SDK can rebuild or write to disk when the app runs short of memory
+- (void)startResourceGovernor
+{
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        TikTokResourceGovernor *governor = [TikTokResourceGovernor sharedGovernor];
+        [governor addPressureHandler:^(TikTokMemoryMode mode) {
+            [[TikTokProductCache sharedCache] removeAllProducts];
+        } forAction:@"shrink_product_cache"];
+        [governor addPressureHandler:^(TikTokMemoryMode mode) {
+            [[TikTokRequestContextCache sharedCache] invalidate];
+        } forAction:@"shrink_request_context"];
+        [governor addPressureHandler:^(TikTokMemoryMode mode) {
+            [[[TikTokBusiness getInstance] eventLogger] persistMonitorWindow];
+        } forAction:@"spill_monitor_metrics"];
+        [governor start];
+    });
+}
+
 - (void)monitorInitMethodWithStart:(NSNumber *)initStartTime error:(NSError *)error{
     NSNumber *initMethodEndTimestamp = [TikTokAppEventUtility getCurrentTimestampAsNumber];
     NSMutableDictionary *initMethodEndMeta = @{
         @"ts": initMethodEndTimestamp,
         @"latency": [NSNumber numberWithLongLong:([initMethodEndTimestamp longLongValue] - [initStartTime longLongValue])]
     }.mutableCopy;
+    // time initializeSdk kept the caller waiting, without the deferred stages
+    [TikTokTypeUtility dictionary:initMethodEndMeta setObject:@([[TikTokStartupTrace sharedTrace] synchronousDuration]) forKey:@"sync_us"];
     if (error) {
         [TikTokTypeUtility dictionary:initMethodEndMeta setObject:@(error.code) forKey:@"err_code"];
         [TikTokTypeUtility dictionary:initMethodEndMeta setObject:TTSafeString(error.localizedDescription) forKey:@"err_msg"];
@@ -428,7 +494,9 @@ withType:(NSString *)type
         @"meta": initMethodEndMeta
     };
     TikTokAppEvent *initMethodEndEvent = [[TikTokAppEvent alloc] initWithEventName:@"MonitorEvent" withProperties:initMethodEndProperties withType:@"monitor"];
-    [[TikTokMonitorEventPersistence persistence] persistEvents:@[initMethodEndEvent]];
+    [self.startupScheduler scheduleStage:@"init_monitor" priority:TikTokStartupPriorityLow block:^{
+        [[TikTokMonitorEventPersistence persistence] persistEvents:@[initMethodEndEvent]];
+    }];
 }
 
 - (void)setUpCrashMonitor {
@@ -459,7 +527,20 @@ withType:(NSString *)type
     Class configClass = NSClassFromString(@"TTSDKCrashConfiguration");
     id config = [[configClass alloc] init];
     if (!config) return;
-    
+    // Map the report file ahead of time so the crash-time writer only copies into memory.
+    if ([config respondsToSelector:NSSelectorFromString(@"setPreallocatedReportSize:")]) {
+        [config setValue:@(256 * 1024) forKey:@"preallocatedReportSize"];
+    }
+    // Apps that bundle a symbol index get their own frames named even when the binary is stripped.
+    NSString *symbolIndexPath = [[NSBundle mainBundle] pathForResource:@"TTSDKSymbolIndex" ofType:@"bin"];
+    if (symbolIndexPath && [config respondsToSelector:NSSelectorFromString(@"setSymbolIndexPath:")]) {
+        [config setValue:symbolIndexPath forKey:@"symbolIndexPath"];
+    }
+    // Keep logging off the file system on the calling thread; reports read the log tail from memory.
+    if ([config respondsToSelector:NSSelectorFromString(@"setConsoleLogBufferSize:")]) {
+        [config setValue:@(64 * 1024) forKey:@"consoleLogBufferSize"];
+    }
+
     NSError __autoreleasing *installError = nil;
     SEL installSel = NSSelectorFromString(@"installWithConfiguration:error:");
     NSMethodSignature *signature = [installation methodSignatureForSelector:installSel];
@@ -488,21 +569,25 @@ withType:(NSString *)type
         }
     };
     
+    // Reading and sending the reports left by earlier runs can wait for the rest of startup
     SEL sendSel = NSSelectorFromString(@"sendAllReportsWithCompletion:");
     if ([installation respondsToSelector:sendSel]) {
-        NSMethodSignature *sig = [installation methodSignatureForSelector:sendSel];
-        NSInvocation *invocation = [NSInvocation invocationWithMethodSignature:sig];
-        invocation.target = installation;
-        invocation.selector = sendSel;
-        [invocation setArgument:&completion atIndex:2];
-        [invocation invoke];
+        [self.startupScheduler scheduleStage:@"crash_report_upload" priority:TikTokStartupPriorityLow block:^{
+            NSMethodSignature *sig = [installation methodSignatureForSelector:sendSel];
+            NSInvocation *invocation = [NSInvocation invocationWithMethodSignature:sig];
+            invocation.target = installation;
+            invocation.selector = sendSel;
+            void (^reportsCompletion)(NSArray *, NSError *) = completion;
+            [invocation setArgument:&reportsCompletion atIndex:2];
+            [invocation invoke];
+        }];
     }
     signal(SIGPIPE, SIG_IGN);
 }
 
 - (void)sendCrashReport:(NSString *)report {
     if (![TikTokErrorHandler isSDKCrashReport:report]) {
-        [self.logger verbose:@"Crash report does not belong to SDK"];
+        TTLogVerbose(self.logger, @"Crash report does not belong to SDK");
         return;
     }
     NSDictionary *meta = @{
@@ -547,7 +632,7 @@ withType:(NSString *)type
 // Internally used method for 2D-Retention
 - (void)track2DRetention
 {
-    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+    TikTokKeyValueStore *defaults = [TikTokKeyValueStore sharedStore];
     NSDate *installDate = (NSDate *)[defaults objectForKey:@"tiktokInstallDate"];
     BOOL logged2DRetention = [defaults boolForKey:@"tiktokLogged2DRetention"];
     // Setting this variable to limit recomputations for 2DRetention past second day
@@ -560,12 +645,10 @@ withType:(NSString *)type
         if ([[NSCalendar currentCalendar] isDate:oneDayAgo inSameDayAsDate:installDate] && !logged2DRetention) {
             [self trackEvent:@"2Dretention" withProperties:@{@"type":@"auto"} withId:@""];
             [defaults setBool:YES forKey:@"tiktokLogged2DRetention"];
-            [defaults synchronize];
         }
         
         if (numberOfDays > 2) {
             [defaults setBool:YES forKey:@"tiktokPast2DLimit"];
-            [defaults synchronize];
         }
     }
 }
@@ -580,17 +663,7 @@ withType:(NSString *)type
             withId: (NSString *)eventId
 {
     if(self.SKAdNetworkSupportEnabled) {
-        id value = [properties objectForKey:@"value"];
-        NSString *valueString;
-        if ([value isKindOfClass:[NSString class]]) {
-            valueString = value;
-        } else if ([value isKindOfClass:[NSNumber class]]) {
-            valueString = [value stringValue];
-        } else {
-            valueString = @"0";
-        }
-        NSString *currency = [properties objectForKey:@"currency"];
-        [[TikTokSKAdNetworkSupport sharedInstance] matchEventToSKANConfig:eventName withValue:valueString currency:TTSafeString(currency)];
+        [self matchEventToSKANConfig:eventName properties:properties];
     }
     
     TikTokAppEvent *appEvent = [[TikTokAppEvent alloc] initWithEventName:eventName withProperties:properties withEventID:eventId];
@@ -605,6 +678,66 @@ withType:(NSString *)type
     }
 }
 
+- (NSIndexSet *)trackEvents:(NSArray<TikTokAppEvent *> *)events
+{
+    if (self.eventLogger == nil) {
+        return nil;
+    }
+    if(self.SKAdNetworkSupportEnabled) {
+        for (TikTokAppEvent *event in events) {
+            [self matchEventToSKANConfig:event.eventName properties:event.properties];
+        }
+    }
+    // Admitted now, so the result is known before the screenshot is taken
+    NSIndexSet *admitted = [self.eventLogger admitEvents:events];
+    if (admitted.count == 0) {
+        return admitted;
+    }
+    NSArray<TikTokAppEvent *> *admittedEvents = [events objectsAtIndexes:admitted];
+    if (self.screenshotEnabled) {
+        // One screenshot on the main queue covers the batch
+        dispatch_async(dispatch_get_main_queue(), ^{
+            NSString *screenshot = [self screenShot];
+            for (TikTokAppEvent *event in admittedEvents) {
+                event.screenshot = screenshot;
+            }
+            [self persistAdmittedEvents:admittedEvents];
+        });
+    } else {
+        [self persistAdmittedEvents:admittedEvents];
+    }
+    return admitted;
+}
+
+- (void)persistAdmittedEvents:(NSArray<TikTokAppEvent *> *)events
+{
+    [self.eventLogger persistAdmittedEvents:events];
+    NSUInteger purchase = [events indexOfObjectPassingTest:^BOOL(TikTokAppEvent *event, NSUInteger index, BOOL *stop) {
+        return [event.eventName isEqualToString:@"Purchase"];
+    }];
+    if (purchase != NSNotFound) {
+        [self.eventLogger flush:TikTokAppEventsFlushReasonEagerlyFlushingEvent];
+    }
+}
+
+- (void)matchEventToSKANConfig:(NSString *)eventName properties:(NSDictionary *)properties
+{
+    id value = [properties objectForKey:@"value"];
+    NSString *valueString;
+    if ([value isKindOfClass:[NSString class]]) {
+        valueString = value;
+    } else if ([value isKindOfClass:[NSNumber class]]) {
+        valueString = [value stringValue];
+    } else {
+        valueString = @"0";
+    }
+    NSString *currency = [properties objectForKey:@"currency"];
+    // events are matched after the persisted ones skan_window replays, in the order they were tracked
+    [self.startupScheduler notifyWhenStageFinished:@"skan_window" queue:self.SKANQueue block:^{
+        [[TikTokSKAdNetworkSupport sharedInstance] matchEventToSKANConfig:eventName withValue:valueString currency:TTSafeString(currency)];
+    }];
+}
+
 - (void)addEvent:(TikTokAppEvent *)appEvent {
     [self.eventLogger addEvent:appEvent];
     if([appEvent.eventName isEqualToString:@"Purchase"]) {
@@ -653,7 +786,7 @@ withType:(NSString *)type
 - (void)applicationDidEnterBackground:(NSNotification *)notification
 {
     NSNumber *backgroundMonitorTime = [TikTokAppEventUtility getCurrentTimestampAsNumber];
-    NSUserDefaults *preferences = [NSUserDefaults standardUserDefaults];
+    TikTokKeyValueStore *preferences = [TikTokKeyValueStore sharedStore];
     
     if(self.config.initialFlushDelay && ![[preferences objectForKey:@"HasFirstFlushOccurred"]  isEqual: @"true"]) {
         // pause timer when entering background when first flush has not happened
@@ -669,7 +802,7 @@ withType:(NSString *)type
     // Install Date: Available
     // 2D Limit has not been passed
     NSNumber *foregroundMonitorTime = [TikTokAppEventUtility getCurrentTimestampAsNumber];
-    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+    TikTokKeyValueStore *defaults = [TikTokKeyValueStore sharedStore];
     NSDate *installDate = (NSDate *)[defaults objectForKey:@"tiktokInstallDate"];
     
     [self checkAttStatus];
@@ -685,7 +818,6 @@ withType:(NSString *)type
     if(self.config.initialFlushDelay && ![[defaults objectForKey:@"HasFirstFlushOccurred"]  isEqual: @"true"]) {
         // if first flush has not occurred, resume timer without flushing
         [defaults setObject:@"true" forKey:@"AreTimersOn"];
-        [defaults synchronize];
     } else {
         // else flush when entering foreground
         [self.eventLogger flush:TikTokAppEventsFlushReasonAppBecameActive];
@@ -737,7 +869,6 @@ withType:(NSString *)type
     }
     [defaults setObject:foregroundMonitorTime forKey:@"foregroundMonitorTime"];
     [defaults removeObjectForKey:@"backgroundMonitorTime"];
-    [defaults synchronize];
 }
 
 - (nullable NSString *)idfa
@@ -785,6 +916,7 @@ withType:(NSString *)type
 - (void)updateAccessToken:(nonnull NSString *)accessToken
 {
     self.accessToken = accessToken;
+    [[TikTokRequestContextCache sharedCache] invalidate];
     if(!self.isGlobalConfigFetched) {
         [self getGlobalConfig:self.config isFirstInitialization:NO];
     }
@@ -826,12 +958,12 @@ withType:(NSString *)type
 {
     NSNumber *logoutMonitorStartTime = [TikTokAppEventUtility getCurrentTimestampAsNumber];
     
-    // clear old anonymousID and userInfo from NSUserDefaults
+    // clear old anonymousID and userInfo from storage
     [[TikTokIdentifyUtility sharedInstance] resetUserInfo];
        
     NSString *anonymousID = [[TikTokIdentifyUtility sharedInstance] getOrGenerateAnonymousID];
     [[TikTokBusiness getInstance] setAnonymousID:anonymousID];
-    [self.logger verbose:@"AnonymousID on logout: %@", self.anonymousID];
+    TTLogVerbose(self.logger, @"AnonymousID on logout: %@", self.anonymousID);
     [self.eventLogger flush:TikTokAppEventsFlushReasonLogout];
     NSNumber *logoutMonitorEndTime = [TikTokAppEventUtility getCurrentTimestampAsNumber];
     NSDictionary *meta = @{
@@ -869,188 +1001,271 @@ withType:(NSString *)type
 - (void)getGlobalConfig:(TikTokConfig *)tiktokConfig
   isFirstInitialization: (BOOL)isFirstInitialization
 {
+    // Serve the last good config straight away so flushing doesn't wait for the round trip,
+    // then revalidate it below
+    __block BOOL cachedConfigApplied = NO;
+    __block BOOL cachedRemoteSwitch = NO;
+    __block NSDictionary *cachedGlobalConfig = nil;
+    if (!self.isGlobalConfigFetched) {
+        cachedConfigApplied = [self.requestHandler applyCachedGlobalConfig:tiktokConfig withCompletionHandler:^(BOOL isRemoteSwitchOn, NSDictionary *globalConfig) {
+            cachedRemoteSwitch = isRemoteSwitchOn;
+            cachedGlobalConfig = globalConfig;
+            [self applyGlobalConfig:globalConfig remoteSwitch:isRemoteSwitchOn tiktokConfig:tiktokConfig isFirstInitialization:isFirstInitialization];
+        }];
+    }
     [self.requestHandler getRemoteSwitch:tiktokConfig
                                  isRetry:NO
                    withCompletionHandler:^(BOOL isRemoteSwitchOn, NSDictionary *globalConfig) {
-        self.isRemoteSwitchOn = isRemoteSwitchOn;
-        self.isGlobalConfigFetched = TTCheckValidDictionary(globalConfig);
-        
-        NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
-
-        if (!self.isRemoteSwitchOn) {
-            [self.logger info:@"Remote switch is off"];
-            [defaults setObject:@"false" forKey:@"AreTimersOn"];
-            [defaults synchronize];
-            return;
-        }
-        [self loadUserAgent];
-        [self.logger info:@"Remote switch is on"];
-        
-        // restart timers if they are off
-        if ([[defaults objectForKey:@"AreTimersOn"]  isEqual: @"false"]) {
-            [defaults setObject:@"true" forKey:@"AreTimersOn"];
-            [defaults synchronize];
-        }
-        if (self.isGlobalConfigFetched) {
-            self.exchangeErrReportRate = 1;
-            NSNumber *exchangeErrReportRate = [globalConfig objectForKey:@"skan4_exchange_err_report_rate"];
-            if (TTCheckValidNumber(exchangeErrReportRate)) {
-                self.exchangeErrReportRate = [exchangeErrReportRate doubleValue];
+        if (cachedConfigApplied) {
+            if (!TTCheckValidDictionary(globalConfig)) {
+                // keep running on the cached config until a fetch succeeds
+                return;
             }
-            if (self.SKAdNetworkSupportEnabled) {
-                NSInteger currentWindow = [[TikTokSKAdNetworkSupport sharedInstance] getConversionWindowForTimestamp:[TikTokAppEventUtility getCurrentTimestamp]];
-                if ([[defaults objectForKey:TTSKANTimeWindowKey] integerValue] != currentWindow) {
-                    [defaults setObject:@(currentWindow) forKey:TTSKANTimeWindowKey];
-                    [defaults removeObjectForKey:TTLatestFineValueKey];
-                    [defaults removeObjectForKey:TTLatestCoarseValueKey];
-                    [defaults removeObjectForKey:TTAccumulatedSKANValuesKey];
-                    [defaults synchronize];
-                    [[TikTokSKANEventPersistence persistence] clearEvents];
-                }
-                // match historical events and flag "matched"
-                for (TikTokSKAdNetworkWindow *window in [TikTokSKAdNetworkConversionConfiguration sharedInstance].conversionValueWindows) {
-                    if (window.postbackIndex == currentWindow) {
-                        [[TikTokSKAdNetworkSupport sharedInstance] matchPersistedSKANEventsInWindow:window];
-                        break;
-                    }
-                }
-                
+            if (isRemoteSwitchOn == cachedRemoteSwitch && [globalConfig isEqual:cachedGlobalConfig]) {
+                return;
             }
-            
-            NSDictionary *EDPConfigDict = [globalConfig objectForKey:@"enhanced_data_postback_native_config"];
-            [TikTokEDPConfig sharedConfig].enable_from_ttconfig = tiktokConfig.autoEDPEventEnabled;
-            if (TTCheckValidDictionary(EDPConfigDict)) {
-                [[TikTokEDPConfig sharedConfig] configWithDict:EDPConfigDict];
-                
-                if ([TikTokEDPConfig sharedConfig].enable_sdk && [TikTokEDPConfig sharedConfig].enable_from_ttconfig) {
-                    dispatch_async(dispatch_get_main_queue(), ^{
-                        [UIViewController TT_StartUIViewControllerEDPMonitoring];
-                        [UIApplication TT_StartUIApplicationEDPMonitoring];
-                    });
-                } else {
-                    [self.eventLogger clearEDPEvents];
-                }
-                
-                NSString *sourceURLString = [defaults objectForKey:@"source_url"];
-                NSString *referString = [defaults objectForKey:@"refer"];
-                if ((TTCheckValidString(referString) || isFirstInitialization) && [TikTokEDPConfig sharedConfig].enable_sdk && [TikTokEDPConfig sharedConfig].enable_from_ttconfig && [TikTokEDPConfig sharedConfig].enable_app_launch_track) {
-                    NSDictionary *launchOptionProperties = @{
-                        @"source_url": TTSafeString(sourceURLString),
-                        @"refer": TTSafeString(referString),
-                        @"monitor_type": @"enhanced_data_postback"
-                    };
-                    [TikTokBusiness trackEvent:@"app_launch" withProperties:launchOptionProperties];
-                }
+            if (isRemoteSwitchOn && cachedRemoteSwitch) {
+                // launch work already ran on the cached config, only pick up what changed
+                [self applyChangedGlobalConfig:globalConfig previousConfig:cachedGlobalConfig tiktokConfig:tiktokConfig];
+                return;
             }
-         }
+        }
+        [self applyGlobalConfig:globalConfig remoteSwitch:isRemoteSwitchOn tiktokConfig:tiktokConfig isFirstInitialization:isFirstInitialization && !(cachedConfigApplied && cachedRemoteSwitch)];
+    }];
+    
+    [self.requestHandler getDebugMode:tiktokConfig withCompletionHandler:^(NSDictionary *businessSDKConfig, NSError * _Nonnull error) {
+        if (!error && TTCheckValidDictionary(businessSDKConfig)) {
+            self.remoteDebugEnabled = [[businessSDKConfig objectForKey:@"enable_debug_mode"] boolValue];
+            self.screenshotEnabled = [[businessSDKConfig objectForKey:@"enable_screenshot"] boolValue];
+        }
+    }];
+}
+
+- (void)applyGlobalConfig:(NSDictionary *)globalConfig
+             remoteSwitch:(BOOL)isRemoteSwitchOn
+             tiktokConfig:(TikTokConfig *)tiktokConfig
+    isFirstInitialization:(BOOL)isFirstInitialization
+{
+    self.isRemoteSwitchOn = isRemoteSwitchOn;
+    self.isGlobalConfigFetched = TTCheckValidDictionary(globalConfig);
+    
+    TikTokKeyValueStore *defaults = [TikTokKeyValueStore sharedStore];
+
+    if (!self.isRemoteSwitchOn) {
+        [self.logger info:@"Remote switch is off"];
+        [defaults setObject:@"false" forKey:@"AreTimersOn"];
+        return;
+    }
+    [self loadUserAgent];
+    [self.logger info:@"Remote switch is on"];
+    
+    // restart timers if they are off
+    if ([[defaults objectForKey:@"AreTimersOn"]  isEqual: @"false"]) {
+        [defaults setObject:@"true" forKey:@"AreTimersOn"];
+    }
+    if (self.isGlobalConfigFetched) {
+        [self applyRemoteSettings:globalConfig previousConfig:nil tiktokConfig:tiktokConfig];
         
-        // if SDK has not been initialized, we initialize it
-        if (isFirstInitialization || ![[defaults objectForKey:@"HasBeenInitialized"]  isEqual: @"true"]) {
-            BOOL crashMonitorEnabled = [[globalConfig objectForKey:@"crash_monitor_enable"] boolValue];
-            if (crashMonitorEnabled) {
-                [self setUpCrashMonitor];
+        NSDictionary *EDPConfigDict = [globalConfig objectForKey:@"enhanced_data_postback_native_config"];
+        if (TTCheckValidDictionary(EDPConfigDict)) {
+            NSString *sourceURLString = [defaults objectForKey:@"source_url"];
+            NSString *referString = [defaults objectForKey:@"refer"];
+            if ((TTCheckValidString(referString) || isFirstInitialization) && [TikTokEDPConfig sharedConfig].enable_sdk && [TikTokEDPConfig sharedConfig].enable_from_ttconfig && [TikTokEDPConfig sharedConfig].enable_app_launch_track) {
+                NSDictionary *launchOptionProperties = @{
+                    @"source_url": TTSafeString(sourceURLString),
+                    @"refer": TTSafeString(referString),
+                    @"monitor_type": @"enhanced_data_postback"
+                };
+                [TikTokBusiness trackEvent:@"app_launch" withProperties:launchOptionProperties];
             }
-            
-            [self.logger info:@"TikTok SDK Initialized Successfully!"];
-            [defaults setObject:@"true" forKey:@"HasBeenInitialized"];
-            [defaults setObject:@([TikTokAppEventUtility getCurrentTimestamp]) forKey:TTUserDefaultsKey_firstLaunchTime];
-            [defaults synchronize];
-            BOOL launchedBefore = [defaults boolForKey:@"tiktokLaunchedBefore"];
-            NSDate *installDate = (NSDate *)[defaults objectForKey:@"tiktokInstallDate"];
-            
-            // SKAdNetwork 3.0 Support (works on iOS 14.0+)
-            if (self.SKAdNetworkSupportEnabled) {
+        }
+     }
+    
+    // if SDK has not been initialized, we initialize it
+    if (isFirstInitialization || ![[defaults objectForKey:@"HasBeenInitialized"]  isEqual: @"true"]) {
+        BOOL crashMonitorEnabled = [[globalConfig objectForKey:@"crash_monitor_enable"] boolValue];
+        if (crashMonitorEnabled) {
+            [self.startupScheduler scheduleStage:@"crash_install" priority:TikTokStartupPriorityDefault block:^{
+                [self setUpCrashMonitor];
+            }];
+        }
+        
+        [self.logger info:@"TikTok SDK Initialized Successfully!"];
+        [defaults setObject:@"true" forKey:@"HasBeenInitialized"];
+        [defaults setObject:@([TikTokAppEventUtility getCurrentTimestamp]) forKey:TTUserDefaultsKey_firstLaunchTime];
+        BOOL launchedBefore = [defaults boolForKey:@"tiktokLaunchedBefore"];
+        NSDate *installDate = (NSDate *)[defaults objectForKey:@"tiktokInstallDate"];
+        
+        // SKAdNetwork 3.0 Support (works on iOS 14.0+)
+        if (self.SKAdNetworkSupportEnabled) {
+            [self.startupScheduler scheduleStage:@"skan_register" priority:TikTokStartupPriorityDefault block:^{
                 [[TikTokSKAdNetworkSupport sharedInstance] registerAppForAdNetworkAttribution];
-            }
+            }];
+        }
+        
+        BOOL globalConfigRetentionTrackingEnabled = [globalConfig objectForKey:@"auto_track_Retention_enable"]!=nil ? [[globalConfig objectForKey:@"auto_track_Retention_enable"] boolValue] : YES;
+        self.retentionTrackingEnabled = self.retentionTrackingEnabled && globalConfigRetentionTrackingEnabled;
+        BOOL globalConfigPaymentTrackingEnabled = [globalConfig objectForKey:@"auto_track_Payment_enable"]!=nil ? [[globalConfig objectForKey:@"auto_track_Payment_enable"] boolValue] : YES;
+        self.paymentTrackingEnabled = globalConfigPaymentTrackingEnabled;
+        NSNumber *isStoreKit2ObserveEnabled = [globalConfig objectForKey:@"enable_ios_sk2_observe"];
+        if (isStoreKit2ObserveEnabled && [isStoreKit2ObserveEnabled isKindOfClass:NSNumber.class]) {
+            self.isStoreKit2ObserveEnabled = [isStoreKit2ObserveEnabled boolValue];
+        } else {
+            self.isStoreKit2ObserveEnabled = YES;
+        }
+        NSNumber *storeKit2ObserveInterval = [globalConfig objectForKey:@"ios_sk2_observe_timeinterval"];
+        if (storeKit2ObserveInterval && [storeKit2ObserveInterval isKindOfClass:NSNumber.class]) {
+            self.storeKit2ObserveInterval = storeKit2ObserveInterval.unsignedLongLongValue;
+        } else {
+            self.storeKit2ObserveInterval = 0;
+        }
+        NSNumber *isStoreKit2ReportConsumableStateEnabled = [globalConfig objectForKey:@"enable_ios_report_consumable_include_state"];
+        if (isStoreKit2ReportConsumableStateEnabled && [isStoreKit2ReportConsumableStateEnabled isKindOfClass:NSNumber.class]) {
+            self.isStoreKit2ReportConsumableStateEnabled = [isStoreKit2ReportConsumableStateEnabled boolValue];
+        } else {
+            self.isStoreKit2ReportConsumableStateEnabled = YES;
+        }
+        // Enabled: Tracking, Auto Tracking, Install Tracking
+        // Launched Before: False
+        if (self.automaticTrackingEnabled && !launchedBefore){
             
-            BOOL globalConfigRetentionTrackingEnabled = [globalConfig objectForKey:@"auto_track_Retention_enable"]!=nil ? [[globalConfig objectForKey:@"auto_track_Retention_enable"] boolValue] : YES;
-            self.retentionTrackingEnabled = self.retentionTrackingEnabled && globalConfigRetentionTrackingEnabled;
-            BOOL globalConfigPaymentTrackingEnabled = [globalConfig objectForKey:@"auto_track_Payment_enable"]!=nil ? [[globalConfig objectForKey:@"auto_track_Payment_enable"] boolValue] : YES;
-            self.paymentTrackingEnabled = globalConfigPaymentTrackingEnabled;
-            NSNumber *isStoreKit2ObserveEnabled = [globalConfig objectForKey:@"enable_ios_sk2_observe"];
-            if (isStoreKit2ObserveEnabled && [isStoreKit2ObserveEnabled isKindOfClass:NSNumber.class]) {
-                self.isStoreKit2ObserveEnabled = [isStoreKit2ObserveEnabled boolValue];
-            } else {
-                self.isStoreKit2ObserveEnabled = YES;
-            }
-            NSNumber *storeKit2ObserveInterval = [globalConfig objectForKey:@"ios_sk2_observe_timeinterval"];
-            if (storeKit2ObserveInterval && [storeKit2ObserveInterval isKindOfClass:NSNumber.class]) {
-                self.storeKit2ObserveInterval = storeKit2ObserveInterval.unsignedLongLongValue;
-            } else {
-                self.storeKit2ObserveInterval = 0;
-            }
-            NSNumber *isStoreKit2ReportConsumableStateEnabled = [globalConfig objectForKey:@"enable_ios_report_consumable_include_state"];
-            if (isStoreKit2ReportConsumableStateEnabled && [isStoreKit2ReportConsumableStateEnabled isKindOfClass:NSNumber.class]) {
-                self.isStoreKit2ReportConsumableStateEnabled = [isStoreKit2ReportConsumableStateEnabled boolValue];
-            } else {
-                self.isStoreKit2ReportConsumableStateEnabled = YES;
-            }
-            // Enabled: Tracking, Auto Tracking, Install Tracking
-            // Launched Before: False
-            if (self.automaticTrackingEnabled && !launchedBefore){
-                
-                if (self.installTrackingEnabled) {
-                    [self trackEvent:@"InstallApp" withProperties:@{@"type":@"auto"} withId:@""];
-                    if (self.isGlobalConfigFetched) {
-                        [defaults setBool:YES forKey:@"tiktokMatchedInstall"];
-                    }
+            if (self.installTrackingEnabled) {
+                [self trackEvent:@"InstallApp" withProperties:@{@"type":@"auto"} withId:@""];
+                if (self.isGlobalConfigFetched) {
+                    [defaults setBool:YES forKey:@"tiktokMatchedInstall"];
                 }
-                NSDate *currentLaunch = [NSDate date];
-                [defaults setBool:YES forKey:@"tiktokLaunchedBefore"];
-                [defaults setObject:currentLaunch forKey:@"tiktokInstallDate"];
-                [defaults synchronize];
             }
+            NSDate *currentLaunch = [NSDate date];
+            [defaults setBool:YES forKey:@"tiktokLaunchedBefore"];
+            [defaults setObject:currentLaunch forKey:@"tiktokInstallDate"];
+        }
 
-            // Enabled: Tracking, Auto Tracking, Launch Logging
-            if (self.automaticTrackingEnabled && self.launchTrackingEnabled){
-                [self trackEvent:@"LaunchAPP" withProperties:@{@"type":@"auto"} withId:@""];
-            }
-            
-            BOOL debugInfoEnabled = [[globalConfig objectForKey:@"enable_debug_info"] boolValue];
-            if (debugInfoEnabled) {
-                NSDictionary *monitorDebugInfoProperties = @{
-                    @"monitor_type": @"metric",
-                    @"monitor_name": @"debug_info",
-                    @"meta": [TikTokDebugInfo debugInfo]
-                };
-                TikTokAppEvent *monitorDebugInfoEvent = [[TikTokAppEvent alloc] initWithEventName:@"MonitorEvent" withProperties:monitorDebugInfoProperties withType:@"monitor"];
-                [self.eventLogger addEvent:monitorDebugInfoEvent];
-                [self.eventLogger flushMonitorEvents];
-            }
+        // Enabled: Tracking, Auto Tracking, Launch Logging
+        if (self.automaticTrackingEnabled && self.launchTrackingEnabled){
+            [self trackEvent:@"LaunchAPP" withProperties:@{@"type":@"auto"} withId:@""];
+        }
+        
+        BOOL debugInfoEnabled = [[globalConfig objectForKey:@"enable_debug_info"] boolValue];
+        if (debugInfoEnabled) {
+            NSDictionary *monitorDebugInfoProperties = @{
+                @"monitor_type": @"metric",
+                @"monitor_name": @"debug_info",
+                @"meta": [TikTokDebugInfo debugInfo]
+            };
+            TikTokAppEvent *monitorDebugInfoEvent = [[TikTokAppEvent alloc] initWithEventName:@"MonitorEvent" withProperties:monitorDebugInfoProperties withType:@"monitor"];
+            [self.eventLogger addEvent:monitorDebugInfoEvent];
+            [self.eventLogger flushMonitorEvents];
+        }
 
-            // Enabled: Auto Tracking, 2DRetention Tracking
-            // Install Date: Available
-            // 2D Limit has not been passed
-            if (self.automaticTrackingEnabled && installDate && self.retentionTrackingEnabled) {
-                [self track2DRetention];
-            }
+        // Enabled: Auto Tracking, 2DRetention Tracking
+        // Install Date: Available
+        // 2D Limit has not been passed
+        if (self.automaticTrackingEnabled && installDate && self.retentionTrackingEnabled) {
+            [self track2DRetention];
+        }
 
-            if (self.automaticTrackingEnabled && self.paymentTrackingEnabled) {
+        BOOL observeStoreKit = self.automaticTrackingEnabled && self.paymentTrackingEnabled;
+        [self.startupScheduler scheduleStage:@"storekit_observers" priority:TikTokStartupPriorityDefault block:^{
+            if (observeStoreKit) {
                 [self startStoreKitObserve];
             } else {
                 [self stopStoreKitObserve];
             }
-            
-            NSNumber *initStartTimestamp = [defaults objectForKey:@"monitorInitStartTime"];
-            NSNumber *initEndTimestamp = [TikTokAppEventUtility getCurrentTimestampAsNumber];
-            [self monitorInitialization:initStartTimestamp andEndTime:initEndTimestamp];
+        }];
+        
+        NSNumber *initStartTimestamp = [defaults objectForKey:@"monitorInitStartTime"];
+        NSNumber *initEndTimestamp = [TikTokAppEventUtility getCurrentTimestampAsNumber];
+        [self monitorInitialization:initStartTimestamp andEndTime:initEndTimestamp];
+    }
+    if (self.isGlobalConfigFetched && self.automaticTrackingEnabled && self.installTrackingEnabled) {
+        BOOL matchedInstall = [defaults boolForKey:@"tiktokMatchedInstall"];
+        if (!matchedInstall) {
+            [self matchEventToSKANConfig:@"InstallApp" properties:@{@"value": @"0"}];
+            [defaults setBool:YES forKey:@"tiktokMatchedInstall"];
         }
-        if (self.isGlobalConfigFetched && self.automaticTrackingEnabled && self.installTrackingEnabled) {
-            BOOL matchedInstall = [defaults boolForKey:@"tiktokMatchedInstall"];
-            if (!matchedInstall) {
-                [[TikTokSKAdNetworkSupport sharedInstance] matchEventToSKANConfig:@"InstallApp" withValue:@"0" currency:@""];
-                [defaults setBool:YES forKey:@"tiktokMatchedInstall"];
-                [defaults synchronize];
-            }
+    }
+}
+
+/// Applies a fetched config that differs from the cached one this launch started on. The
+/// user agent, app_launch and initialization work already ran on the cached config.
+- (void)applyChangedGlobalConfig:(NSDictionary *)globalConfig
+                  previousConfig:(NSDictionary *)previousConfig
+                    tiktokConfig:(TikTokConfig *)tiktokConfig
+{
+    self.isRemoteSwitchOn = YES;
+    self.isGlobalConfigFetched = YES;
+    [self.logger info:@"Global config changed since it was cached"];
+    [self applyRemoteSettings:globalConfig previousConfig:previousConfig tiktokConfig:tiktokConfig];
+}
+
+/// Settings a config refresh may change. Sections equal to those in previousConfig are
+/// skipped; a nil previousConfig applies all of them.
+- (void)applyRemoteSettings:(NSDictionary *)globalConfig
+             previousConfig:(nullable NSDictionary *)previousConfig
+               tiktokConfig:(TikTokConfig *)tiktokConfig
+{
+    BOOL (^sectionChanged)(NSString *) = ^BOOL(NSString *key) {
+        id section = [globalConfig objectForKey:key];
+        id previousSection = [previousConfig objectForKey:key];
+        return !previousConfig || (section != previousSection && ![section isEqual:previousSection]);
+    };
+    TikTokKeyValueStore *defaults = [TikTokKeyValueStore sharedStore];
+    
+    self.exchangeErrReportRate = 1;
+    NSNumber *exchangeErrReportRate = [globalConfig objectForKey:@"skan4_exchange_err_report_rate"];
+    if (TTCheckValidNumber(exchangeErrReportRate)) {
+        self.exchangeErrReportRate = [exchangeErrReportRate doubleValue];
+    }
+    if (self.SKAdNetworkSupportEnabled) {
+        NSInteger currentWindow = [[TikTokSKAdNetworkSupport sharedInstance] getConversionWindowForTimestamp:[TikTokAppEventUtility getCurrentTimestamp]];
+        if ([[defaults objectForKey:TTSKANTimeWindowKey] integerValue] != currentWindow) {
+            [defaults setObject:@(currentWindow) forKey:TTSKANTimeWindowKey];
+            [[TikTokSKAdNetworkSupport sharedInstance] resetConversionValues];
+            [[TikTokSKANEventPersistence persistence] clearEvents];
         }
-    }];
+        // the request handler only rebuilds the SKAN rules when they changed
+        TikTokSKAdNetworkRuleIndex *ruleIndex = [TikTokSKAdNetworkConversionConfiguration sharedInstance].ruleIndex;
+        if (!previousConfig || ruleIndex != self.matchedSKANRuleIndex) {
+            self.matchedSKANRuleIndex = ruleIndex;
+            // replaying reads every persisted event, so it runs off the launch path
+            [self.startupScheduler scheduleStage:@"skan_window" priority:TikTokStartupPriorityDefault block:^{
+                // match historical events and flag "matched"
+                for (TikTokSKAdNetworkWindow *window in [TikTokSKAdNetworkConversionConfiguration sharedInstance].conversionValueWindows) {
+                    if (window.postbackIndex == currentWindow) {
+                        [[TikTokSKAdNetworkSupport sharedInstance] matchPersistedSKANEventsInWindow:window];
+                        break;
+                    }
+                }
+            }];
+        }
+    }
     
-    [self.requestHandler getDebugMode:tiktokConfig withCompletionHandler:^(NSDictionary *businessSDKConfig, NSError * _Nonnull error) {
-        if (!error && TTCheckValidDictionary(businessSDKConfig)) {
-            self.remoteDebugEnabled = [[businessSDKConfig objectForKey:@"enable_debug_mode"] boolValue];
-            self.screenshotEnabled = [[businessSDKConfig objectForKey:@"enable_screenshot"] boolValue];
+    if (sectionChanged(@"event_admission_control")) {
+        NSDictionary *admissionConfigDict = [globalConfig objectForKey:@"event_admission_control"];
+        if (TTCheckValidDictionary(admissionConfigDict)) {
+            [[TikTokEventAdmissionController sharedController] configWithDict:admissionConfigDict];
         }
-    }];
+    }
+    
+    if (sectionChanged(@"event_deduplication")) {
+        NSDictionary *deduplicationConfigDict = [globalConfig objectForKey:@"event_deduplication"];
+        [self.eventLogger setDeduplicationEnabled:TTCheckValidDictionary(deduplicationConfigDict) && [[deduplicationConfigDict objectForKey:@"enable"] boolValue]];
+    }
+    
+    NSDictionary *EDPConfigDict = [globalConfig objectForKey:@"enhanced_data_postback_native_config"];
+    [TikTokEDPConfig sharedConfig].enable_from_ttconfig = tiktokConfig.autoEDPEventEnabled;
+    if (TTCheckValidDictionary(EDPConfigDict) && sectionChanged(@"enhanced_data_postback_native_config")) {
+        [[TikTokEDPConfig sharedConfig] configWithDict:EDPConfigDict];
+        
+        if ([TikTokEDPConfig sharedConfig].enable_sdk && [TikTokEDPConfig sharedConfig].enable_from_ttconfig) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [UIViewController TT_StartUIViewControllerEDPMonitoring];
+                [UIApplication TT_StartUIApplicationEDPMonitoring];
+            });
+        } else {
+            [self.eventLogger clearEDPEvents];
+        }
+    }
 }
 
 - (void)loadUserAgent {
@@ -22,3 +22,5 @@ FOUNDATION_EXPORT const unsigned char TikTokBusinessSDKVersionString[];
 #import <TikTokBusinessSDK/TikTokDeviceInfo.h>
 #import <TikTokBusinessSDK/TikTokConstants.h>
 #import <TikTokBusinessSDK/TikTokBusinessSDKAddress.h>
+#import <TikTokBusinessSDK/TikTokPipelineMetrics.h>
+#import <TikTokBusinessSDK/TikTokStartupTrace.h>
@@ -15,6 +15,12 @@ typedef NS_ENUM(NSInteger, TikTokPaymentTrackStatus)
     TikTokPaymentTrackStatus_disabled = 2
 };
 
+typedef NS_ENUM(NSInteger, TikTokEventStorageBackend)
+{
+    TikTokEventStorageBackendSQLite  = 0,
+    TikTokEventStorageBackendJournal = 1
+};
+
 NS_ASSUME_NONNULL_BEGIN
 
 @interface TikTokConfig : NSObject
@@ -35,6 +41,10 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, assign) BOOL autoEDPEventEnabled;
 @property (nonatomic, assign) BOOL isLowPerf;
 @property (nonatomic) long initialFlushDelay;
+@property (nonatomic, assign) NSTimeInterval pipelineMetricsExportInterval;
+@property (nonatomic, assign) NSTimeInterval eventDeduplicationWindow;
+@property (nonatomic, assign) double eventDeduplicationFalsePositiveRate;
+@property (nonatomic, assign) TikTokEventStorageBackend eventStorageBackend;
 
 + (nullable TikTokConfig *)configWithAccessToken:(nonnull NSString *)accessToken
                                            appId:(nonnull NSString *)appId
@@ -56,6 +66,23 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)enableDebugMode;
 - (void)enableLDUMode;
 - (void)setIsLowPerformanceDevice:(BOOL)isLow;
+/**
+ * @brief Add the event pipeline metrics to the aggregated monitor event, which is then
+ *        persisted once per interval instead of once a minute
+ */
+- (void)enablePipelineMetricsExportWithInterval:(NSTimeInterval)seconds;
+/**
+ * @brief Drop events whose event ID, or StoreKit order ID, was already tracked within
+ *        the window, once the server enables deduplication. Revenue events are never
+ *        dropped. Defaults to 24 hours with a false-positive rate of 0.0001.
+ */
+- (void)setEventDeduplicationWindow:(NSTimeInterval)seconds falsePositiveRate:(double)falsePositiveRate;
+- (void)disableEventDeduplication;
+/**
+ * @brief Keep pending events in an append-only journal of memory-mapped files instead
+ *        of SQLite, for apps tracking many events. Pending events are moved over on launch.
+ */
+- (void)enableEventJournal;
 
 - (nullable id)initWithAppId:(nonnull NSString *)appId
                        tiktokAppId:(nonnull NSString *)tiktokAppId DEPRECATED_MSG_ATTRIBUTE("Deprecated. Use configWithAccessToken:appId:tiktokAppId: instead");
@@ -12,6 +12,9 @@
 #import "TikTokUserAgentCollector.h"
 #import "TikTokTypeUtility.h"
 
+#define DEFAULT_EVENT_DEDUPLICATION_WINDOW (24 * 60 * 60)
+#define DEFAULT_EVENT_DEDUPLICATION_FALSE_POSITIVE_RATE 0.0001
+
 @interface TikTokConfig()
 
 @property (nonatomic, strong) TikTokLogger *logger;
@@ -125,6 +128,29 @@
     [self.logger info:@"[TikTokConfig] Device is set to low performance device"];
 }
 
+- (void)enablePipelineMetricsExportWithInterval:(NSTimeInterval)seconds {
+    self.pipelineMetricsExportInterval = MAX(seconds, 0);
+    [self.logger info:@"[TikTokConfig] Pipeline metrics export interval set to: %.0f", self.pipelineMetricsExportInterval];
+}
+
+- (void)setEventDeduplicationWindow:(NSTimeInterval)seconds falsePositiveRate:(double)falsePositiveRate {
+    self.eventDeduplicationWindow = MAX(seconds, 0);
+    if (falsePositiveRate > 0 && falsePositiveRate < 1) {
+        self.eventDeduplicationFalsePositiveRate = falsePositiveRate;
+    }
+    [self.logger info:@"[TikTokConfig] Event deduplication window set to: %.0f, false-positive rate: %g", self.eventDeduplicationWindow, self.eventDeduplicationFalsePositiveRate];
+}
+
+- (void)disableEventDeduplication {
+    self.eventDeduplicationWindow = 0;
+    [self.logger info:@"[TikTokConfig] Event deduplication: NO"];
+}
+
+- (void)enableEventJournal {
+    self.eventStorageBackend = TikTokEventStorageBackendJournal;
+    [self.logger info:@"[TikTokConfig] Event journal: YES"];
+}
+
 - (id)initWithAccessToken:(nonnull NSString *)accessToken appId:(nonnull NSString *)appId tiktokAppId:(nonnull NSString *)tiktokAppId
 {
     self = [super init];
@@ -147,6 +173,8 @@
     _SKAdNetworkSupportEnabled = YES;
     _debugModeEnabled = NO;
     _autoEDPEventEnabled = YES;
+    _eventDeduplicationWindow = DEFAULT_EVENT_DEDUPLICATION_WINDOW;
+    _eventDeduplicationFalsePositiveRate = DEFAULT_EVENT_DEDUPLICATION_FALSE_POSITIVE_RATE;
     
     self.logger = [TikTokFactory getLogger];
     return self;
@@ -174,6 +202,8 @@
     _SKAdNetworkSupportEnabled = YES;
     _debugModeEnabled = NO;
     _autoEDPEventEnabled = YES;
+    _eventDeduplicationWindow = DEFAULT_EVENT_DEDUPLICATION_WINDOW;
+    _eventDeduplicationFalsePositiveRate = DEFAULT_EVENT_DEDUPLICATION_FALSE_POSITIVE_RATE;
     
     self.logger = [TikTokFactory getLogger];
     return self;
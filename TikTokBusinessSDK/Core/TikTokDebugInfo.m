@@ -12,6 +12,7 @@
 #import "TikTokAppEventUtility.h"
 #import <UIKit/UIKit.h>
 #import "TikTokBusinessSDKMacros.h"
+#import "TikTokKeyValueStore.h"
 
 #define MAX_BT_ARRAY_SIZE 3
 
@@ -20,7 +21,7 @@
 + (NSDictionary *)debugInfo {
     NSMutableDictionary *debugInfo = [NSMutableDictionary dictionary];
     NSString *bootTime = [self tt_bootTime];
-    NSUserDefaults *userDefaults = [NSUserDefaults standardUserDefaults];
+    TikTokKeyValueStore *userDefaults = [TikTokKeyValueStore sharedStore];
     NSDictionary *btSDict = [userDefaults objectForKey:TTBTSDictKey];
     NSArray *bootTimeSArray = TTCheckValidDictionary(btSDict) ? btSDict.allKeys : @[];
     NSDictionary *btMsDict = [userDefaults objectForKey:TTBTMsDictKey];
@@ -69,7 +70,7 @@
 + (void)updateBootTimeWithValue:(long long)bootTime
                          forKey:(NSString *)key
                    maxArraySize:(NSInteger)maxArraySize {
-    NSUserDefaults *userDefaults = [NSUserDefaults standardUserDefaults];
+    TikTokKeyValueStore *userDefaults = [TikTokKeyValueStore sharedStore];
     NSMutableDictionary *dict = [userDefaults objectForKey:key];
     long long currentTimestamp = [TikTokAppEventUtility getCurrentTimestamp];
     if (TTCheckValidDictionary([userDefaults objectForKey:key])) {
@@ -108,7 +109,6 @@
         [dict setObject:@(currentTimestamp) forKey:updateValue];
     }
     [userDefaults setObject:dict.copy forKey:key];
-    [userDefaults synchronize];
 }
 
 + (NSString *)tt_screenResolutionString {
@@ -8,6 +8,7 @@
 #import "TikTokErrorHandler.h"
 #import "TikTokBusiness.h"
 #import "TikTokBusiness+private.h"
+#import "TikTokLogger+private.h"
 #import "TikTokFactory.h"
 #import "TikTokTypeUtility.h"
 #import "TikTokRequestHandler.h"
@@ -197,7 +198,7 @@ NSString *const kTTSDKVersion = @"TikTok SDK Version";
         }
         int64_t address = [TikTokErrorHandler addressInLine:TTSafeString(line)];
         if (address > beginAddress && address < endAddress) {
-            [[TikTokFactory getLogger] verbose:@"Found stack related to SDK: %@", line];
+            TTLogVerbose([TikTokFactory getLogger], @"Found stack related to SDK: %@", line);
             return YES;
         }
     }
@@ -0,0 +1,69 @@
+//
+//  TikTokEventAdmissionController.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class TikTokAppEvent;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief Decides whether an event is recorded at all, so a code path that tracks
+ *        events in a tight loop cannot flood the database and the network.
+ *
+ *        Off until the "event_admission_control" global config enables it; until then
+ *        every event is admitted, as before.
+ *
+ *        Each event name has a token bucket. Event names can also be sampled through
+ *        the "event_admission_control" global config; sampling hashes the anonymous
+ *        ID with the event name, so a device keeps or drops an event name consistently.
+ *        Revenue events and monitor events are always admitted.
+ *
+ *        Dropped events are counted as the "event_dropped" monitor metric, keyed by
+ *        "<reason>:<event name>".
+ */
+@interface TikTokEventAdmissionController : NSObject
+
++ (instancetype)sharedController;
+
+/// Whether events are rate limited and sampled at all. Default NO.
+@property (atomic, assign, readonly, getter=isEnabled) BOOL enabled;
+/// Tokens added to each event name's bucket per second. Default 10.
+@property (atomic, assign, readonly) double ratePerSecond;
+/// Capacity of each bucket, i.e. how many events of one name may arrive at once. Default 100.
+@property (atomic, assign, readonly) double burst;
+/// Sampling rate applied to event names without their own rate. Default 1.
+@property (atomic, assign, readonly) double defaultSamplingRate;
+/// Events dropped since launch
+@property (atomic, assign, readonly) NSUInteger droppedEventCount;
+
+/**
+ * @brief Apply the "event_admission_control" dictionary of the global config.
+ *        Recognized keys: enable, rate_per_second, burst, default_sampling_rate,
+ *        sampling_rates (event name to rate) and exempt_events.
+ */
+- (void)configWithDict:(NSDictionary *)dict;
+
+/**
+ * @brief YES if the event should be recorded. Safe to call from any thread.
+ */
+- (BOOL)admitEvent:(TikTokAppEvent *)event;
+
+/**
+ * @brief Same as admitEvent:, at a given TikTokPipelineMetricsNow() time. For testing.
+ */
+- (BOOL)admitEvent:(TikTokAppEvent *)event now:(uint64_t)now;
+
+/**
+ * @brief Restore the defaults and drop all buckets. For testing.
+ */
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,231 @@
+//
+//  TikTokEventAdmissionController.m
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokEventAdmissionController.h"
+#import "TikTokAppEvent.h"
+#import "TikTokTypeUtility.h"
+#import "TikTokPipelineMetrics+private.h"
+#import "TikTokMonitorAggregator.h"
+#import "TikTokLaneScheduler.h"
+#import <pthread.h>
+#import <stdatomic.h>
+
+#define DEFAULT_RATE_PER_SECOND 10
+#define DEFAULT_BURST 100
+// Event names beyond this share one bucket, so random names cannot grow the table.
+#define MAX_BUCKETS 256
+
+static NSString * const kOverflowBucketName = @"";
+// Drop metrics of event names beyond MAX_BUCKETS are reported under this name
+static NSString * const kOverflowMetricName = @"_overflow";
+
+// Position of the anonymous ID and event name in [0, 1), from a 64-bit FNV-1a hash.
+static double samplingFraction(NSString *anonymousID, NSString *eventName)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (NSString *part in @[TTSafeString(anonymousID), eventName]) {
+        const char *bytes = part.UTF8String;
+        for (; bytes && *bytes; bytes++) {
+            hash ^= (uint8_t)*bytes;
+            hash *= 1099511628211ULL;
+        }
+        // Separator, so ("ab", "c") and ("a", "bc") differ
+        hash ^= 0xff;
+        hash *= 1099511628211ULL;
+    }
+    return (double)(hash >> 11) / (double)(1ULL << 53);
+}
+
+@interface TikTokTokenBucket : NSObject
+
+@property (nonatomic, assign) double tokens;
+@property (nonatomic, assign) uint64_t lastRefillTime;
+
+@end
+
+@implementation TikTokTokenBucket
+
+@end
+
+@interface TikTokEventAdmissionController ()
+{
+    pthread_mutex_t _mutex;
+    _Atomic(NSUInteger) _droppedEventCount;
+}
+
+@property (atomic, assign, readwrite) double ratePerSecond;
+@property (atomic, assign, readwrite, getter=isEnabled) BOOL enabled;
+@property (atomic, assign, readwrite) double burst;
+@property (atomic, assign, readwrite) double defaultSamplingRate;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, TikTokTokenBucket *> *buckets;
+// Event names drops have been reported under, at most MAX_BUCKETS
+@property (nonatomic, strong) NSMutableSet<NSString *> *droppedEventNames;
+@property (atomic, copy) NSDictionary<NSString *, NSNumber *> *samplingRates;
+@property (atomic, copy) NSSet<NSString *> *exemptEvents;
+
+@end
+
+@implementation TikTokEventAdmissionController
+
++ (instancetype)sharedController
+{
+    static TikTokEventAdmissionController *controller = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        controller = [[TikTokEventAdmissionController alloc] init];
+    });
+    return controller;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_mutex, NULL);
+        _buckets = [NSMutableDictionary dictionary];
+        _droppedEventNames = [NSMutableSet set];
+        [self reset];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_mutex);
+}
+
+- (void)reset
+{
+    self.enabled = NO;
+    self.ratePerSecond = DEFAULT_RATE_PER_SECOND;
+    self.burst = DEFAULT_BURST;
+    self.defaultSamplingRate = 1;
+    self.samplingRates = @{};
+    self.exemptEvents = [NSSet set];
+    atomic_store(&_droppedEventCount, 0);
+    pthread_mutex_lock(&_mutex);
+    [self.buckets removeAllObjects];
+    [self.droppedEventNames removeAllObjects];
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (void)configWithDict:(NSDictionary *)dict
+{
+    self.enabled = [[dict objectForKey:@"enable"] boolValue];
+    NSNumber *ratePerSecond = [dict objectForKey:@"rate_per_second"];
+    if (TTCheckValidNumber(ratePerSecond) && [ratePerSecond doubleValue] > 0) {
+        self.ratePerSecond = [ratePerSecond doubleValue];
+    }
+    NSNumber *burst = [dict objectForKey:@"burst"];
+    if (TTCheckValidNumber(burst) && [burst doubleValue] >= 1) {
+        self.burst = [burst doubleValue];
+    }
+    NSNumber *defaultSamplingRate = [dict objectForKey:@"default_sampling_rate"];
+    if (TTCheckValidNumber(defaultSamplingRate)) {
+        self.defaultSamplingRate = MIN(MAX([defaultSamplingRate doubleValue], 0), 1);
+    }
+    NSDictionary *samplingRates = [dict objectForKey:@"sampling_rates"];
+    if (TTCheckValidDictionary(samplingRates)) {
+        NSMutableDictionary *rates = [NSMutableDictionary dictionary];
+        [samplingRates enumerateKeysAndObjectsUsingBlock:^(id key, id rate, BOOL *stop) {
+            if ([key isKindOfClass:[NSString class]] && TTCheckValidNumber(rate)) {
+                rates[key] = @(MIN(MAX([rate doubleValue], 0), 1));
+            }
+        }];
+        self.samplingRates = rates;
+    }
+    NSArray *exemptEvents = [dict objectForKey:@"exempt_events"];
+    if (TTCheckValidArray(exemptEvents)) {
+        self.exemptEvents = [NSSet setWithArray:exemptEvents];
+    }
+}
+
+- (NSUInteger)droppedEventCount
+{
+    return atomic_load_explicit(&_droppedEventCount, memory_order_relaxed);
+}
+
+- (BOOL)admitEvent:(TikTokAppEvent *)event
+{
+    return [self admitEvent:event now:TikTokPipelineMetricsNow()];
+}
+
+- (BOOL)admitEvent:(TikTokAppEvent *)event now:(uint64_t)now
+{
+    if (!self.isEnabled) {
+        return YES;
+    }
+    NSString *eventName = TTSafeString(event.eventName);
+    if (TikTokEventLaneForEvent(event) != TikTokEventLaneStandard
+        || [self.exemptEvents containsObject:eventName]) {
+        return YES;
+    }
+
+    NSNumber *samplingRate = self.samplingRates[eventName];
+    double rate = samplingRate ? [samplingRate doubleValue] : self.defaultSamplingRate;
+    if (rate < 1 && samplingFraction(event.anonymousID, eventName) >= rate) {
+        [self recordDropOfEvent:eventName reason:@"sampled"];
+        return NO;
+    }
+
+    if (![self takeTokenForEvent:eventName now:now]) {
+        [self recordDropOfEvent:eventName reason:@"rate_limited"];
+        return NO;
+    }
+    return YES;
+}
+
+- (BOOL)takeTokenForEvent:(NSString *)eventName now:(uint64_t)now
+{
+    double ratePerSecond = self.ratePerSecond;
+    double burst = self.burst;
+    BOOL admitted = NO;
+    pthread_mutex_lock(&_mutex);
+    TikTokTokenBucket *bucket = self.buckets[eventName];
+    if (bucket == nil) {
+        if (self.buckets.count >= MAX_BUCKETS) {
+            eventName = kOverflowBucketName;
+            bucket = self.buckets[eventName];
+        }
+        if (bucket == nil) {
+            bucket = [[TikTokTokenBucket alloc] init];
+            bucket.tokens = burst;
+            bucket.lastRefillTime = now;
+            self.buckets[eventName] = bucket;
+        }
+    }
+    if (now > bucket.lastRefillTime) {
+        double elapsed = (double)(now - bucket.lastRefillTime) / USEC_PER_SEC;
+        bucket.tokens = MIN(burst, bucket.tokens + elapsed * ratePerSecond);
+        bucket.lastRefillTime = now;
+    }
+    if (bucket.tokens >= 1) {
+        bucket.tokens -= 1;
+        admitted = YES;
+    }
+    pthread_mutex_unlock(&_mutex);
+    return admitted;
+}
+
+- (void)recordDropOfEvent:(NSString *)eventName reason:(NSString *)reason
+{
+    atomic_fetch_add_explicit(&_droppedEventCount, 1, memory_order_relaxed);
+    pthread_mutex_lock(&_mutex);
+    if (![self.droppedEventNames containsObject:eventName]) {
+        if (self.droppedEventNames.count < MAX_BUCKETS) {
+            [self.droppedEventNames addObject:eventName];
+        } else {
+            eventName = kOverflowMetricName;
+        }
+    }
+    pthread_mutex_unlock(&_mutex);
+    NSString *key = [NSString stringWithFormat:@"%@:%@", reason, eventName];
+    [[TikTokMonitorAggregator sharedAggregator] recordMetric:@"event_dropped" key:key value:1 errorCode:nil];
+}
+
+@end
@@ -0,0 +1,275 @@
+//
+//  TikTokEventBatchParser.c
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#include "TikTokEventBatchParser.h"
+
+#include <string.h>
+
+// Deeper properties are rejected rather than risking the stack
+#define TT_BATCH_MAX_DEPTH 32
+
+typedef struct {
+    const char *position;
+    const char *end;
+} TTCursor;
+
+static bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static void skipSpace(TTCursor *cursor)
+{
+    while (cursor->position < cursor->end && isSpace(*cursor->position)) {
+        cursor->position++;
+    }
+}
+
+static bool peek(TTCursor *cursor, char c)
+{
+    return cursor->position < cursor->end && *cursor->position == c;
+}
+
+static bool scanString(TTCursor *cursor, TikTokEventBatchString *string)
+{
+    if (!peek(cursor, '"')) {
+        return false;
+    }
+    const char *start = ++cursor->position;
+    bool escaped = false;
+    while (cursor->position < cursor->end) {
+        unsigned char c = (unsigned char)*cursor->position;
+        if (c == '"') {
+            string->bytes = start;
+            string->length = (size_t)(cursor->position - start);
+            string->escaped = escaped;
+            cursor->position++;
+            return true;
+        }
+        if (c < 0x20) {
+            return false;
+        }
+        if (c == '\\') {
+            escaped = true;
+            cursor->position++;
+            if (cursor->position >= cursor->end) {
+                return false;
+            }
+        }
+        cursor->position++;
+    }
+    return false;
+}
+
+static bool scanLiteral(TTCursor *cursor, const char *literal)
+{
+    size_t length = strlen(literal);
+    if ((size_t)(cursor->end - cursor->position) < length || memcmp(cursor->position, literal, length) != 0) {
+        return false;
+    }
+    cursor->position += length;
+    return true;
+}
+
+static bool scanNumber(TTCursor *cursor)
+{
+    const char *start = cursor->position;
+    while (cursor->position < cursor->end) {
+        char c = *cursor->position;
+        if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+            cursor->position++;
+        } else {
+            break;
+        }
+    }
+    return cursor->position > start;
+}
+
+static bool skipValue(TTCursor *cursor, int depth);
+
+// Objects and arrays share the loop; only objects have keys
+static bool skipContainer(TTCursor *cursor, int depth, char close)
+{
+    if (depth >= TT_BATCH_MAX_DEPTH) {
+        return false;
+    }
+    cursor->position++;
+    skipSpace(cursor);
+    if (peek(cursor, close)) {
+        cursor->position++;
+        return true;
+    }
+    while (cursor->position < cursor->end) {
+        if (close == '}') {
+            TikTokEventBatchString key;
+            if (!scanString(cursor, &key)) {
+                return false;
+            }
+            skipSpace(cursor);
+            if (!peek(cursor, ':')) {
+                return false;
+            }
+            cursor->position++;
+            skipSpace(cursor);
+        }
+        if (!skipValue(cursor, depth + 1)) {
+            return false;
+        }
+        skipSpace(cursor);
+        if (peek(cursor, ',')) {
+            cursor->position++;
+            skipSpace(cursor);
+        } else if (peek(cursor, close)) {
+            cursor->position++;
+            return true;
+        } else {
+            return false;
+        }
+    }
+    return false;
+}
+
+static bool skipValue(TTCursor *cursor, int depth)
+{
+    if (cursor->position >= cursor->end) {
+        return false;
+    }
+    TikTokEventBatchString string;
+    switch (*cursor->position) {
+        case '"':
+            return scanString(cursor, &string);
+        case '{':
+            return skipContainer(cursor, depth, '}');
+        case '[':
+            return skipContainer(cursor, depth, ']');
+        case 't':
+            return scanLiteral(cursor, "true");
+        case 'f':
+            return scanLiteral(cursor, "false");
+        case 'n':
+            return scanLiteral(cursor, "null");
+        default:
+            return scanNumber(cursor);
+    }
+}
+
+static bool keyEquals(const TikTokEventBatchString *key, const char *name)
+{
+    size_t length = strlen(name);
+    return !key->escaped && key->length == length && memcmp(key->bytes, name, length) == 0;
+}
+
+static TikTokEventBatchStatus parseLine(const char *line, size_t length, TikTokEventBatchEvent *event)
+{
+    TTCursor cursor = { line, line + length };
+    memset(event, 0, sizeof(*event));
+    bool hasName = false;
+    bool invalidField = false;
+
+    skipSpace(&cursor);
+    if (!peek(&cursor, '{')) {
+        return TikTokEventBatchStatusMalformed;
+    }
+    cursor.position++;
+    skipSpace(&cursor);
+    bool closed = false;
+    if (peek(&cursor, '}')) {
+        cursor.position++;
+        closed = true;
+    }
+    while (!closed) {
+        TikTokEventBatchString key;
+        if (!scanString(&cursor, &key)) {
+            return TikTokEventBatchStatusMalformed;
+        }
+        skipSpace(&cursor);
+        if (!peek(&cursor, ':')) {
+            return TikTokEventBatchStatusMalformed;
+        }
+        cursor.position++;
+        skipSpace(&cursor);
+
+        const char *valueStart = cursor.position;
+        bool isString = peek(&cursor, '"');
+        bool isObject = peek(&cursor, '{');
+        if (!skipValue(&cursor, 1)) {
+            return TikTokEventBatchStatusMalformed;
+        }
+        if (keyEquals(&key, "event")) {
+            TTCursor value = { valueStart, cursor.position };
+            hasName = isString && scanString(&value, &event->name) && event->name.length > 0;
+        } else if (keyEquals(&key, "event_id")) {
+            TTCursor value = { valueStart, cursor.position };
+            if (isString) {
+                scanString(&value, &event->eventId);
+            } else if (!scanLiteral(&value, "null")) {
+                invalidField = true;
+            }
+        } else if (keyEquals(&key, "properties")) {
+            TTCursor value = { valueStart, cursor.position };
+            if (isObject) {
+                event->properties = valueStart;
+                event->propertiesLength = (size_t)(cursor.position - valueStart);
+            } else if (!scanLiteral(&value, "null")) {
+                invalidField = true;
+            }
+        }
+
+        skipSpace(&cursor);
+        if (peek(&cursor, ',')) {
+            cursor.position++;
+            skipSpace(&cursor);
+        } else if (peek(&cursor, '}')) {
+            cursor.position++;
+            closed = true;
+        } else {
+            return TikTokEventBatchStatusMalformed;
+        }
+    }
+    skipSpace(&cursor);
+    if (cursor.position != cursor.end) {
+        return TikTokEventBatchStatusMalformed;
+    }
+    if (!hasName) {
+        return TikTokEventBatchStatusMissingName;
+    }
+    return invalidField ? TikTokEventBatchStatusInvalidField : TikTokEventBatchStatusAccepted;
+}
+
+static bool isBlank(const char *line, size_t length)
+{
+    for (size_t i = 0; i < length; i++) {
+        if (!isSpace(line[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t TikTokEventBatchParse(const char *buffer, size_t length, TikTokEventBatchVisitor visitor, void *context)
+{
+    if (buffer == NULL || visitor == NULL) {
+        return 0;
+    }
+    size_t count = 0;
+    const char *position = buffer;
+    const char *end = buffer + length;
+    while (position < end) {
+        const char *newline = memchr(position, '\n', (size_t)(end - position));
+        const char *lineEnd = newline ? newline : end;
+        size_t lineLength = (size_t)(lineEnd - position);
+        if (!isBlank(position, lineLength)) {
+            TikTokEventBatchEvent event;
+            TikTokEventBatchStatus status = parseLine(position, lineLength, &event);
+            visitor(count, status, status == TikTokEventBatchStatusAccepted ? &event : NULL, context);
+            count++;
+        }
+        position = newline ? newline + 1 : end;
+    }
+    return count;
+}
@@ -0,0 +1,79 @@
+//
+//  TikTokEventBatchParser.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#ifndef TikTokEventBatchParser_h
+#define TikTokEventBatchParser_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Reads a batch of events packed as UTF-8 JSON lines, one object per line:
+ *
+ *     {"event":"Purchase","event_id":"abc","properties":{"value":1.5,"currency":"USD"}}
+ *
+ * "event" is required; "event_id" and "properties" are optional and other keys are
+ * ignored. Blank lines are skipped. Nothing is copied or allocated: each event is handed
+ * to the visitor as spans of the buffer, valid only for the duration of the call.
+ */
+
+/** Status of each event. Values are part of the bridge ABI and must not change. */
+typedef enum {
+    TikTokEventBatchStatusAccepted = 0,
+    /** The line isn't a JSON object */
+    TikTokEventBatchStatusMalformed = 1,
+    /** "event" is missing, empty or not a string */
+    TikTokEventBatchStatusMissingName = 2,
+    /** "properties" isn't an object, or "event_id" isn't a string */
+    TikTokEventBatchStatusInvalidField = 3,
+    /** Parsed, but dropped by the SDK, e.g. by admission control or as a duplicate */
+    TikTokEventBatchStatusDropped = 4,
+    /** The SDK isn't initialized or tracking is disabled */
+    TikTokEventBatchStatusNotTracking = 5,
+} TikTokEventBatchStatus;
+
+/** A string value, without its quotes. If escaped, it still has to be unescaped. */
+typedef struct {
+    const char *bytes;
+    size_t length;
+    bool escaped;
+} TikTokEventBatchString;
+
+typedef struct {
+    TikTokEventBatchString name;
+    /** length 0 if absent */
+    TikTokEventBatchString eventId;
+    /** The properties object including its braces, or NULL if absent */
+    const char *properties;
+    size_t propertiesLength;
+} TikTokEventBatchEvent;
+
+/**
+ * @param index Position of the event among the non-blank lines
+ * @param event The parsed fields, or NULL unless status is TikTokEventBatchStatusAccepted
+ */
+typedef void (*TikTokEventBatchVisitor)(size_t index, TikTokEventBatchStatus status,
+                                        const TikTokEventBatchEvent *event, void *context);
+
+/**
+ * Visit every event in buffer in order.
+ *
+ * @return Number of events visited
+ */
+size_t TikTokEventBatchParse(const char *buffer, size_t length, TikTokEventBatchVisitor visitor, void *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TikTokEventBatchParser_h */
@@ -41,6 +41,43 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)addEvent:(TikTokAppEvent *)event;
 
+/**
+ * @brief Drop events already tracked within the config's deduplication window.
+ *        Off until the "event_deduplication" global config enables it. Revenue events
+ *        are always checked, exactly, against the last 1000 order and event IDs.
+ */
+- (void)setDeduplicationEnabled:(BOOL)enabled;
+
+/**
+ * @brief Add events to queue, persisting those of a lane together
+ *
+ * @return Indexes of the events added, i.e. not dropped by admission control or as duplicates.
+ *         Nil if events aren't tracked because the remote switch is off.
+ */
+- (nullable NSIndexSet *)addEvents:(NSArray<TikTokAppEvent *> *)events;
+
+/**
+ * @brief The admission and deduplication checks of addEvents:, without persisting the events.
+ *        Admitted events must be passed to persistAdmittedEvents:, e.g. once a screenshot is
+ *        attached, or their revenue IDs stay claimed.
+ *
+ * @return Indexes of the events admitted, or nil if the remote switch is off
+ */
+- (nullable NSIndexSet *)admitEvents:(NSArray<TikTokAppEvent *> *)events;
+
+/**
+ * @brief Persist events returned by admitEvents:, those of a lane together
+ */
+- (void)persistAdmittedEvents:(NSArray<TikTokAppEvent *> *)events;
+
+/**
+ * @brief Hold back persisting and flushing, e.g. while the event store is being opened.
+ *        Each call must be balanced by a call to resumeQueues.
+ */
+- (void)suspendQueues;
+
+- (void)resumeQueues;
+
 /**
  * @brief Flush logic
  */
@@ -48,6 +85,12 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (void)flushMonitorEvents;
 
+/**
+ * @brief Write the metrics aggregated in memory so far to disk as a monitor event,
+ *        without waiting for the aggregation window to end
+ */
+- (void)persistMonitorWindow;
+
 /**
  * @brief Initialize flush timer with number of seconds
  */
@@ -11,21 +11,43 @@
 #import "TikTokBusiness.h"
 #import "TikTokConfig.h"
 #import "TikTokLogger.h"
+#import "TikTokLogger+private.h"
 #import "TikTokFactory.h"
 #import "TikTokErrorHandler.h"
 #import "TikTokTypeUtility.h"
 #import "TikTokBaseEventPersistence.h"
 #import "TikTokBusinessSDKMacros.h"
+#import "TikTokPipelineMetrics+private.h"
+#import "TikTokMonitorAggregator.h"
+#import "TikTokEventAdmissionController.h"
+#import "TikTokEventDeduplicator.h"
+#import "TikTokLaneScheduler.h"
+#import "TikTokKeyValueStore.h"
+#import "TikTokResourceGovernor.h"
+#import "TikTokUploadGate.h"
+#import <stdatomic.h>
 
 #define EVENT_FLUSH_LIMIT 100
-#define API_LIMIT 50
 #define FLUSH_PERIOD_IN_SECONDS 15
+#define MONITOR_AGGREGATION_WINDOW_IN_SECONDS 60
+#define EVENT_DEDUPLICATION_CAPACITY 10000
+#define REVENUE_DEDUPLICATION_CAPACITY 1000
 
 @interface TikTokEventLogger()
+{
+    // Events handed to a lane queue that aren't persisted yet
+    atomic_long _pendingPersistCount;
+}
 
 @property (nonatomic, strong) TikTokLogger *logger;
 @property (nonatomic, strong, nullable) TikTokRequestHandler *requestHandler;
 @property (nonatomic, strong) dispatch_queue_t loggerQueue;
+@property (nonatomic, strong) dispatch_queue_t revenueQueue;
+@property (nonatomic, strong) dispatch_queue_t monitorQueue;
+@property (nonatomic, assign) uint64_t monitorWindowStartTime;
+@property (atomic, strong, nullable) TikTokEventDeduplicator *deduplicator;
+// Exact keys of recent revenue events, oldest first. Guarded by @synchronized on itself.
+@property (nonatomic, strong) NSMutableOrderedSet<NSString *> *revenueEventKeys;
 
 @end
 
@@ -53,7 +75,7 @@
         return nil;
     }
             
-    NSUserDefaults *preferences = [NSUserDefaults standardUserDefaults];
+    TikTokKeyValueStore *preferences = [TikTokKeyValueStore sharedStore];
     
     // flush timer logic
     if(config.initialFlushDelay && ![[preferences objectForKey:@"HasFirstFlushOccurred"]  isEqual: @"true"]) {
@@ -69,13 +91,28 @@
     self.requestHandler = [TikTokFactory getRequestHandler];
     
     self.loggerQueue = dispatch_queue_create("com.TikTokBusiness.TikTokEventLogger", DISPATCH_QUEUE_SERIAL);
+    self.revenueQueue = dispatch_queue_create("com.TikTokBusiness.TikTokEventLogger.revenue", DISPATCH_QUEUE_SERIAL);
+    self.monitorQueue = dispatch_queue_create("com.TikTokBusiness.TikTokEventLogger.monitor", DISPATCH_QUEUE_SERIAL);
+    
+    NSArray *revenueEventKeys = [preferences objectForKey:@"RevenueEventKeys"];
+    self.revenueEventKeys = [NSMutableOrderedSet orderedSetWithArray:TTCheckValidArray(revenueEventKeys) ? revenueEventKeys : @[]];
+    
+    tt_weakify(self)
+    [TikTokUploadGate sharedGate].backlogDrain = ^(dispatch_block_t done) {
+        tt_strongify(self)
+        if (self == nil) {
+            done();
+            return;
+        }
+        [self drainBacklogWithCompletion:done];
+    };
 
     return self;
 }
 
 - (void)initializeFlushTimerWithSeconds:(long)seconds
 {
-    NSUserDefaults *preferences = [NSUserDefaults standardUserDefaults];
+    TikTokKeyValueStore *preferences = [TikTokKeyValueStore sharedStore];
     tt_weakify(self)
     self.flushTimer = [NSTimer scheduledTimerWithTimeInterval:seconds
         repeats:NO block:^(NSTimer *timer) {
@@ -95,7 +132,7 @@
 
 - (void)initializeFlushTimer
 {
-    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+    TikTokKeyValueStore *defaults = [TikTokKeyValueStore sharedStore];
     tt_weakify(self)
     self.flushTimer = [NSTimer scheduledTimerWithTimeInterval:FLUSH_PERIOD_IN_SECONDS
         repeats:YES block:^(NSTimer *timer) {
@@ -110,19 +147,220 @@
 - (void)addEvent:(TikTokAppEvent *)event
 {
     if([[TikTokBusiness getInstance] isRemoteSwitchOn] == NO) {
-        [self.logger verbose:@"[TikTokAppEventQueue] Remote switch is off, no event added"];
+        TTLogVerbose(self.logger, @"[TikTokAppEventQueue] Remote switch is off, no event added");
         return;
     }
-    if ([event.type isEqualToString:@"monitor"]) {
-        dispatch_async(self.loggerQueue, ^{
-            [[TikTokMonitorEventPersistence persistence] persistEvents:@[event]];
-        });
-    } else {
-        dispatch_async(self.loggerQueue, ^{
-            [[TikTokAppEventPersistence persistence] persistEvents:@[event]];
+    if ([self admitEvent:event]) {
+        [self persistEvents:@[event] inLane:TikTokEventLaneForEvent(event)];
+    }
+}
+
+- (NSIndexSet *)addEvents:(NSArray<TikTokAppEvent *> *)events
+{
+    NSIndexSet *added = [self admitEvents:events];
+    if (added.count > 0) {
+        [self persistAdmittedEvents:[events objectsAtIndexes:added]];
+    }
+    return added;
+}
+
+- (NSIndexSet *)admitEvents:(NSArray<TikTokAppEvent *> *)events
+{
+    if([[TikTokBusiness getInstance] isRemoteSwitchOn] == NO) {
+        TTLogVerbose(self.logger, @"[TikTokAppEventQueue] Remote switch is off, no events added");
+        return nil;
+    }
+    NSMutableIndexSet *admitted = [NSMutableIndexSet indexSet];
+    [events enumerateObjectsUsingBlock:^(TikTokAppEvent *event, NSUInteger index, BOOL *stop) {
+        if ([self admitEvent:event]) {
+            [admitted addIndex:index];
+        }
+    }];
+    return admitted;
+}
+
+- (void)persistAdmittedEvents:(NSArray<TikTokAppEvent *> *)events
+{
+    NSMutableArray<TikTokAppEvent *> *laneEvents[TikTokEventLaneCount] = {nil};
+    for (TikTokAppEvent *event in events) {
+        TikTokEventLane lane = TikTokEventLaneForEvent(event);
+        if (laneEvents[lane] == nil) {
+            laneEvents[lane] = [NSMutableArray array];
+        }
+        [laneEvents[lane] addObject:event];
+    }
+    for (TikTokEventLane lane = 0; lane < TikTokEventLaneCount; lane++) {
+        if (laneEvents[lane].count > 0) {
+            [self persistEvents:laneEvents[lane] inLane:lane];
+        }
+    }
+}
+
+- (void)setDeduplicationEnabled:(BOOL)enabled
+{
+    @synchronized (self) {
+        TikTokConfig *config = self.config;
+        if (!enabled || config.eventDeduplicationWindow <= 0) {
+            self.deduplicator = nil;
+            return;
+        }
+        if (self.deduplicator) {
+            return;
+        }
+        NSString *libraryDirectory = [NSSearchPathForDirectoriesInDomains(NSLibraryDirectory, NSUserDomainMask, YES) firstObject];
+        self.deduplicator = [[TikTokEventDeduplicator alloc] initWithPath:[libraryDirectory stringByAppendingPathComponent:@"tiktok_event_ids.bloom"]
+                                                                   window:config.eventDeduplicationWindow
+                                                        falsePositiveRate:config.eventDeduplicationFalsePositiveRate
+                                                                 capacity:EVENT_DEDUPLICATION_CAPACITY];
+    }
+}
+
+/// Key the deduplicator checks the event against. Revenue events are checked against
+/// revenueEventKeys instead: a Bloom false positive would silently drop a purchase.
+- (NSString *)deduplicationKeyForEvent:(TikTokAppEvent *)event
+{
+    if (TikTokEventLaneForEvent(event) == TikTokEventLaneRevenue) {
+        return nil;
+    }
+    return [TikTokEventDeduplicator deduplicationKeyForEvent:event];
+}
+
+/// Claim the revenue event's order ID or event ID. Returns NO if a recent revenue event
+/// already holds it, e.g. the same purchase seen by both StoreKit observers.
+/// Events with neither ID are always admitted.
+- (BOOL)claimRevenueEvent:(TikTokAppEvent *)event
+{
+    NSString *key = [TikTokEventDeduplicator deduplicationKeyForEvent:event];
+    if (key == nil) {
+        return YES;
+    }
+    @synchronized (self.revenueEventKeys) {
+        if ([self.revenueEventKeys containsObject:key]) {
+            return NO;
+        }
+        [self.revenueEventKeys addObject:key];
+        if (self.revenueEventKeys.count > REVENUE_DEDUPLICATION_CAPACITY) {
+            [self.revenueEventKeys removeObjectAtIndex:0];
+        }
+    }
+    return YES;
+}
+
+/// Release the claims of revenue events that failed to persist, so they can be retried,
+/// or save the claims once they are stored.
+- (void)settleRevenueEvents:(NSArray<TikTokAppEvent *> *)events persisted:(BOOL)persisted
+{
+    NSArray *keys = nil;
+    @synchronized (self.revenueEventKeys) {
+        if (!persisted) {
+            for (TikTokAppEvent *event in events) {
+                NSString *key = [TikTokEventDeduplicator deduplicationKeyForEvent:event];
+                if (key) {
+                    [self.revenueEventKeys removeObject:key];
+                }
+            }
+            return;
+        }
+        keys = self.revenueEventKeys.array;
+    }
+    [[TikTokKeyValueStore sharedStore] setObject:keys forKey:@"RevenueEventKeys"];
+}
+
+/// Remember persisted events, so later copies are dropped. Done only once they are stored,
+/// so an event that failed to persist can still be retried.
+- (void)rememberEvents:(NSArray<TikTokAppEvent *> *)events
+{
+    TikTokEventDeduplicator *deduplicator = self.deduplicator;
+    if (deduplicator == nil) {
+        return;
+    }
+    for (TikTokAppEvent *event in events) {
+        NSString *deduplicationKey = [self deduplicationKeyForEvent:event];
+        if (deduplicationKey) {
+            [deduplicator insertKey:deduplicationKey];
+        }
+    }
+}
+
+/// Admission control and deduplication. Returns NO if event is dropped.
+- (BOOL)admitEvent:(TikTokAppEvent *)event
+{
+    if (![[TikTokEventAdmissionController sharedController] admitEvent:event]) {
+        TTLogDebug(self.logger, @"[TikTokAppEventQueue] Event %@ dropped by admission control", event.eventName);
+        return NO;
+    }
+    if (TikTokEventLaneForEvent(event) == TikTokEventLaneRevenue) {
+        if (![self claimRevenueEvent:event]) {
+            TTLogDebug(self.logger, @"[TikTokAppEventQueue] Duplicate event %@ dropped", event.eventName);
+            [[TikTokMonitorAggregator sharedAggregator] recordMetric:@"event_dropped" key:[NSString stringWithFormat:@"duplicate:%@", event.eventName] value:1 errorCode:nil];
+            return NO;
+        }
+        return YES;
+    }
+    TikTokEventDeduplicator *deduplicator = self.deduplicator;
+    NSString *deduplicationKey = deduplicator ? [self deduplicationKeyForEvent:event] : nil;
+    if (deduplicationKey && [deduplicator containsKey:deduplicationKey]) {
+        TTLogDebug(self.logger, @"[TikTokAppEventQueue] Duplicate event %@ dropped", event.eventName);
+        [[TikTokMonitorAggregator sharedAggregator] recordMetric:@"event_dropped" key:[NSString stringWithFormat:@"duplicate:%@", event.eventName] value:1 errorCode:nil];
+        return NO;
+    }
+    return YES;
+}
+
+/// Persist events of one lane on the lane's queue, in a single write
+- (void)persistEvents:(NSArray<TikTokAppEvent *> *)events inLane:(TikTokEventLane)lane
+{
+    if (lane == TikTokEventLaneMonitor) {
+        dispatch_async(self.monitorQueue, ^{
+            [[TikTokMonitorEventPersistence persistence] persistEvents:events];
         });
+        return;
     }
-    
+    TikTokPipelineMetrics *metrics = [TikTokPipelineMetrics sharedMetrics];
+    uint64_t enqueueTime = TikTokPipelineMetricsNow();
+    long count = (long)events.count;
+    long depth = atomic_fetch_add(&_pendingPersistCount, count) + count;
+    [metrics incrementCounter:TikTokPipelineCounterEventsEnqueued by:(uint64_t)count];
+    [metrics recordValue:(uint64_t)depth forHistogram:TikTokPipelineHistogramQueueDepth];
+    dispatch_async([self queueForLane:lane], ^{
+        uint64_t persistStart = TikTokPipelineMetricsNow();
+        BOOL persisted = [[TikTokAppEventPersistence persistence] persistEvents:events];
+        [metrics recordDurationSince:persistStart forHistogram:TikTokPipelineHistogramPersistTime];
+        [metrics recordDurationSince:enqueueTime forHistogram:TikTokPipelineHistogramEnqueueToPersistLatency];
+        [metrics incrementCounter:(persisted ? TikTokPipelineCounterEventsPersisted : TikTokPipelineCounterPersistFailures) by:(uint64_t)count];
+        if (lane == TikTokEventLaneRevenue) {
+            [self settleRevenueEvents:events persisted:persisted];
+        } else if (persisted) {
+            [self rememberEvents:events];
+        }
+        atomic_fetch_sub(&self->_pendingPersistCount, count);
+    });
+}
+
+- (dispatch_queue_t)queueForLane:(TikTokEventLane)lane
+{
+    switch (lane) {
+        case TikTokEventLaneRevenue:
+            return self.revenueQueue;
+        case TikTokEventLaneMonitor:
+            return self.monitorQueue;
+        default:
+            return self.loggerQueue;
+    }
+}
+
+- (void)suspendQueues
+{
+    dispatch_suspend(self.loggerQueue);
+    dispatch_suspend(self.revenueQueue);
+    dispatch_suspend(self.monitorQueue);
+}
+
+- (void)resumeQueues
+{
+    dispatch_resume(self.loggerQueue);
+    dispatch_resume(self.revenueQueue);
+    dispatch_resume(self.monitorQueue);
 }
 
 - (void)clearEDPEvents {
@@ -134,6 +372,12 @@
 }
 
 - (void)flush:(TikTokAppEventsFlushReason)flushReason
+{
+    [self flush:flushReason group:nil];
+}
+
+/// Flush every lane. With a group, it is entered until each lane's events are handed to the lane scheduler.
+- (void)flush:(TikTokAppEventsFlushReason)flushReason group:(nullable dispatch_group_t)group
 {
     if (!TTCheckValidString(self.config.appId)) {
         [self.logger info:@"[TikTokAppEventQueue] Invalid App ID, no flush logic invoked"];
@@ -150,7 +394,12 @@
         return;
     }
     
-    NSUserDefaults *preferences = [NSUserDefaults standardUserDefaults];
+    if (![[TikTokUploadGate sharedGate] shouldUpload]) {
+        [self.logger info:@"[TikTokAppEventQueue] Network unreachable, no flush logic invoked"];
+        return;
+    }
+    
+    TikTokKeyValueStore *preferences = [TikTokKeyValueStore sharedStore];
     
     // if there is initialFlushDelay, flush reason is not due to timer and first flush has not occurred, we don't flush
     if(self.config.initialFlushDelay && flushReason != TikTokAppEventsFlushReasonTimer && ![[preferences objectForKey:@"HasFirstFlushOccurred"]  isEqual: @"true"]) {
@@ -161,82 +410,190 @@
     if(![[preferences objectForKey:@"HasFirstFlushOccurred"]  isEqual: @"true"]) {
         [preferences setObject:@"true" forKey:@"HasFirstFlushOccurred"];
     }
-    tt_weakify(self)
-    dispatch_async(self.loggerQueue, ^{
-        tt_strongify(self)
-        @try {
-            NSInteger flushSize = 0;
-            [self.logger info:@"[TikTokAppEventQueue] Start flush, with flush reason: %lu", flushReason];
-            NSArray *eventsFromDisk = [[TikTokAppEventPersistence persistence] retrievePersistedEvents];
-            [self.logger info:@"[TikTokAppEventQueue] Number events from disk: %lu", eventsFromDisk.count];
-            NSMutableArray *eventsToBeFlushed = [NSMutableArray arrayWithArray:eventsFromDisk];
-            flushSize = eventsToBeFlushed.count;
-            [self realFlushEvents:eventsToBeFlushed forReason:flushReason isMonitor:NO];
-            
-            if (flushSize > 0) {
-                NSNumber *flushEndTime = [TikTokAppEventUtility getCurrentTimestampAsNumber];
-                NSDictionary *flushMeta = @{
-                    @"ts": flushEndTime,
-                    @"latency": [NSNumber numberWithLongLong:[flushEndTime longLongValue] - [flushStartTime longLongValue]],
-                    @"type": [self stringForReason:flushReason],
-                    @"interval": @(self.config.initialFlushDelay ?: FLUSH_PERIOD_IN_SECONDS),
-                    @"size":@(flushSize)
-                };
-                NSDictionary *monitorFlushProperties = @{
-                    @"monitor_type": @"metric",
-                    @"monitor_name": @"flush",
-                    @"meta": flushMeta
-                };
-                TikTokAppEvent *monitorFlushEvent = [[TikTokAppEvent alloc] initWithEventName:@"MonitorEvent" withProperties:monitorFlushProperties withType:@"monitor"];
-                [self addEvent:monitorFlushEvent];
-            }
-        } @catch (NSException *exception) {
-            [TikTokErrorHandler handleErrorWithOrigin:NSStringFromClass([self class]) message:@"Failure on flush" exception:exception];
+    // revenue events are retrieved and queued for sending on their own queue,
+    // so a large standard backlog doesn't hold them up
+    for (TikTokEventLane lane = TikTokEventLaneStandard; lane <= TikTokEventLaneRevenue; lane++) {
+        if (group) {
+            dispatch_group_enter(group);
         }
+        tt_weakify(self)
+        dispatch_async([self queueForLane:lane], ^{
+            tt_strongify(self)
+            [self flushLane:lane forReason:flushReason startTime:flushStartTime];
+            if (group) {
+                dispatch_group_leave(group);
+            }
+        });
+    }
+}
+
+/// Send what piled up on disk while the network was unreachable, then call completion
+/// once the lane scheduler has no more requests to send.
+- (void)drainBacklogWithCompletion:(dispatch_block_t)completion
+{
+    [self.logger info:@"[TikTokAppEventQueue] Network reachable again, draining backlog"];
+    dispatch_group_t group = dispatch_group_create();
+    [self flush:TikTokAppEventsFlushReasonReconnect group:group];
+    [self flushMonitorEventsInGroup:group];
+    dispatch_group_notify(group, self.monitorQueue, ^{
+        [[TikTokLaneScheduler sharedScheduler] notifyWhenIdle:completion];
     });
 }
 
+- (void)flushLane:(TikTokEventLane)lane
+        forReason:(TikTokAppEventsFlushReason)flushReason
+        startTime:(NSNumber *)flushStartTime
+{
+    @try {
+        NSInteger flushSize = 0;
+        [self.logger info:@"[TikTokAppEventQueue] Start flush of lane %ld, with flush reason: %lu", (long)lane, flushReason];
+        uint64_t retrievalStart = TikTokPipelineMetricsNow();
+        // while memory is short only part of the backlog is read, the rest waits for the next flush
+        NSUInteger retrievalLimit = [[TikTokResourceGovernor sharedGovernor] retrievalLimit];
+        NSArray *eventsFromDisk = [[TikTokAppEventPersistence persistence] retrievePersistedEventsInLane:lane limit:retrievalLimit];
+        [[TikTokPipelineMetrics sharedMetrics] recordDurationSince:retrievalStart forHistogram:TikTokPipelineHistogramRetrievalTime];
+        [[TikTokPipelineMetrics sharedMetrics] incrementCounter:TikTokPipelineCounterEventsRetrieved by:eventsFromDisk.count];
+        [self.logger info:@"[TikTokAppEventQueue] Number events from disk: %lu", eventsFromDisk.count];
+        NSMutableArray *eventsToBeFlushed = [NSMutableArray arrayWithArray:eventsFromDisk];
+        flushSize = eventsToBeFlushed.count;
+        [self realFlushEvents:eventsToBeFlushed inLane:lane forReason:flushReason];
+        
+        if (flushSize > 0) {
+            NSNumber *flushEndTime = [TikTokAppEventUtility getCurrentTimestampAsNumber];
+            NSString *flushType = [self stringForReason:flushReason];
+            TikTokMonitorAggregator *aggregator = [TikTokMonitorAggregator sharedAggregator];
+            [aggregator recordMetric:@"flush" key:flushType value:[flushEndTime longLongValue] - [flushStartTime longLongValue] errorCode:nil];
+            [aggregator recordMetric:@"flush_size" key:flushType value:flushSize errorCode:nil];
+        }
+    } @catch (NSException *exception) {
+        [TikTokErrorHandler handleErrorWithOrigin:NSStringFromClass([self class]) message:@"Failure on flush" exception:exception];
+    }
+}
 
 - (void)flushMonitorEvents {
-    dispatch_async(self.loggerQueue, ^{
+    [self flushMonitorEventsInGroup:nil];
+}
+
+- (void)flushMonitorEventsInGroup:(nullable dispatch_group_t)group {
+    if (group) {
+        dispatch_group_enter(group);
+    }
+    dispatch_async(self.monitorQueue, ^{
         @try {
+            [self persistMonitorWindowIfNeeded];
+            if (![[TikTokUploadGate sharedGate] shouldUpload]) {
+                return;
+            }
+            if ([[TikTokResourceGovernor sharedGovernor] shouldDeferMonitorUploads]) {
+                [[TikTokMonitorAggregator sharedAggregator] recordMetric:@"memory_action" key:@"defer_monitor_upload" value:1 errorCode:nil];
+                return;
+            }
             NSArray *eventsFromDisk =
             [[TikTokMonitorEventPersistence persistence] retrievePersistedEvents];
             NSMutableArray *eventsToBeFlushed = [NSMutableArray arrayWithArray:eventsFromDisk];
-            [self realFlushEvents:eventsToBeFlushed forReason:TikTokAppEventsFlushReasonExplicitlyFlush isMonitor:YES];
+            [self realFlushEvents:eventsToBeFlushed inLane:TikTokEventLaneMonitor forReason:TikTokAppEventsFlushReasonExplicitlyFlush];
         } @catch (NSException *exception) {
             [TikTokErrorHandler handleErrorWithOrigin:NSStringFromClass([self class]) message:@"Failure on flush" exception:exception];
+        } @finally {
+            if (group) {
+                dispatch_group_leave(group);
+            }
+        }
+    });
+}
+
+- (void)persistMonitorWindow
+{
+    dispatch_async(self.monitorQueue, ^{
+        @try {
+            [self persistMonitorWindowEarly:YES];
+        } @catch (NSException *exception) {
+            [TikTokErrorHandler handleErrorWithOrigin:NSStringFromClass([self class]) message:@"Failure on persisting monitor window" exception:exception];
         }
     });
 }
 
+- (void)persistMonitorWindowIfNeeded
+{
+    [self persistMonitorWindowEarly:NO];
+}
+
+/// Persist at most one monitor event per window, summarizing the aggregated metrics and,
+/// when exporting is enabled, the pipeline metrics of that window. With early, the current
+/// window is closed now. Runs on monitorQueue.
+- (void)persistMonitorWindowEarly:(BOOL)early
+{
+    NSTimeInterval pipelineInterval = self.config.pipelineMetricsExportInterval;
+    NSTimeInterval window = pipelineInterval > 0 ? pipelineInterval : MONITOR_AGGREGATION_WINDOW_IN_SECONDS;
+    uint64_t now = TikTokPipelineMetricsNow();
+    if (self.monitorWindowStartTime == 0) {
+        self.monitorWindowStartTime = now;
+        // Pipeline windows start here rather than at launch.
+        [[TikTokPipelineMetrics sharedMetrics] takeIntervalSummary];
+        return;
+    }
+    if (!early && now - self.monitorWindowStartTime < (uint64_t)(window * USEC_PER_SEC)) {
+        return;
+    }
+    uint64_t windowStartTime = self.monitorWindowStartTime;
+    self.monitorWindowStartTime = now;
+
+    NSMutableDictionary *meta = [NSMutableDictionary dictionary];
+    NSArray *summaries = [[TikTokMonitorAggregator sharedAggregator] takeSummaries];
+    if (summaries != nil) {
+        meta[@"metrics"] = summaries;
+    }
+    NSDictionary *pipelineSummary = [[TikTokPipelineMetrics sharedMetrics] takeIntervalSummary];
+    if (pipelineInterval > 0 && pipelineSummary != nil) {
+        meta[@"pipeline"] = pipelineSummary;
+    }
+    if (meta.count == 0) {
+        return;
+    }
+    meta[@"ts"] = [TikTokAppEventUtility getCurrentTimestampAsNumber];
+    meta[@"window_ms"] = @((now - windowStartTime) / 1000);
+    NSDictionary *properties = @{
+        @"monitor_type": @"metric",
+        @"monitor_name": @"aggregated_metrics",
+        @"meta": meta
+    };
+    TikTokAppEvent *event = [[TikTokAppEvent alloc] initWithEventName:@"MonitorEvent" withProperties:properties withType:@"monitor"];
+    [[TikTokMonitorEventPersistence persistence] persistEvents:@[event]];
+}
+
 - (void)realFlushEvents:(NSMutableArray *)eventsToBeFlushed
+                 inLane:(TikTokEventLane)lane
               forReason:(TikTokAppEventsFlushReason)flushReason
-              isMonitor:(BOOL)isMonitor
 {
     @try {
         [self.logger info:@"[TikTokAppEventQueue] Total number events to be flushed: %lu", eventsToBeFlushed.count];
         if(eventsToBeFlushed.count > 0) {
             if([TikTokBusiness isTrackingEnabled] && [[TikTokBusiness getInstance] accessToken] != nil && self.config.appId != nil) {
-                // chunk eventsToBeFlushed into subarrays of API_LIMIT length or less and send requests for each
+                // chunk eventsToBeFlushed into subarrays of the lane's batch size or less and send requests for each
+                NSUInteger batchSize = [[TikTokResourceGovernor sharedGovernor] batchSizeForSize:TikTokEventLaneBatchSize(lane)];
                 NSMutableArray *eventChunks = [[NSMutableArray alloc] init];
                 NSUInteger eventsRemaining = eventsToBeFlushed.count;
                 int minIndex = 0;
                 
                 while(eventsRemaining > 0) {
-                    NSRange range = NSMakeRange(minIndex, MIN(API_LIMIT, eventsRemaining));
+                    NSRange range = NSMakeRange(minIndex, MIN(batchSize, eventsRemaining));
                     NSArray *eventChunk = [eventsToBeFlushed subarrayWithRange:range];
                     [eventChunks addObject:eventChunk];
                     eventsRemaining -= range.length;
                     minIndex += range.length;
                 }
                 
+                // the scheduler bounds requests in flight and sends queued revenue chunks first
+                TikTokRequestHandler *requestHandler = self.requestHandler;
+                TikTokConfig *config = self.config;
                 for (NSArray *eventChunk in eventChunks) {
-                    if (isMonitor) {
-                        [self.requestHandler sendMonitorRequest:eventChunk withConfig:self.config];
-                    } else {
-                        [self.requestHandler sendBatchRequest:eventChunk withConfig:self.config];
-                    }
+                    [[TikTokLaneScheduler sharedScheduler] enqueueSend:^(dispatch_block_t done) {
+                        if (lane == TikTokEventLaneMonitor) {
+                            [requestHandler sendMonitorRequest:eventChunk withConfig:config completion:done];
+                        } else {
+                            [requestHandler sendBatchRequest:eventChunk withConfig:config completion:done];
+                        }
+                    } inLane:lane];
                 }
             }
         }
@@ -265,6 +622,9 @@
         case TikTokAppEventsFlushReasonLogout:
             return @"LOGOUT";
             break;
+        case TikTokAppEventsFlushReasonReconnect:
+            return @"RECONNECT";
+            break;
         default:
             return @"";
             break;
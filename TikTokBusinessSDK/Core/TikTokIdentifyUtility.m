@@ -8,6 +8,7 @@
 #import "TikTokIdentifyUtility.h"
 #import "TikTokTypeUtility.h"
 #import "TikTokAppEventUtility.h"
+#import "TikTokKeyValueStore.h"
 
 #define TT_last_session_id_key        @"last_session_id_key"
 #define TT_last_session_time_key      @"last_session_time_key"
@@ -44,7 +45,7 @@
 
 - (NSString *)getOrGenerateAnonymousID
 {
-    NSUserDefaults *preferences = [NSUserDefaults standardUserDefaults];
+    TikTokKeyValueStore *preferences = [TikTokKeyValueStore sharedStore];
     NSString *anonymousIDkey = @"AnonymousID";
     NSString *anonymousID = nil;
     
@@ -52,7 +53,6 @@
     {
         anonymousID = [self generateNewAnonymousID];
         [preferences setObject:anonymousID forKey:anonymousIDkey];
-        [preferences synchronize];
     }   else {
         anonymousID = [preferences stringForKey:anonymousIDkey];
     }
@@ -111,10 +111,9 @@
 
 - (void)resetUserInfo
 {
-    NSUserDefaults *preferences = [NSUserDefaults standardUserDefaults];
+    TikTokKeyValueStore *preferences = [TikTokKeyValueStore sharedStore];
     NSString *anonymousIDkey = @"AnonymousID";
     [preferences setObject:nil forKey:anonymousIDkey];
-    [preferences synchronize];
     
     _email = nil;
     _externalID = nil;
@@ -126,7 +125,7 @@
 - (void)_createSessionInfo {
     self.currentAppSessionID = [[NSUUID UUID] UUIDString];
     self.currentSessionStartTime = [TikTokAppEventUtility getCurrentTimestampInISO8601];
-    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+    TikTokKeyValueStore *defaults = [TikTokKeyValueStore sharedStore];
     NSString *sessionIdFromDisk = [defaults objectForKey:TT_last_session_id_key];
     if (TTCheckValidString(sessionIdFromDisk)) {
         self.lastAppSessionID = sessionIdFromDisk;
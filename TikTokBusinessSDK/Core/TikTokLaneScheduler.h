@@ -0,0 +1,77 @@
+//
+//  TikTokLaneScheduler.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class TikTokAppEvent;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief Traffic classes with their own queue, persistence budget and batch size.
+ *        Values are stored with persisted events, so existing rows read as standard.
+ */
+typedef NS_ENUM(NSInteger, TikTokEventLane) {
+    TikTokEventLaneStandard = 0,
+    /// Purchase, AddPaymentInfo, subscription and ad revenue events
+    TikTokEventLaneRevenue = 1,
+    TikTokEventLaneMonitor = 2,
+    TikTokEventLaneCount
+};
+
+FOUNDATION_EXPORT TikTokEventLane TikTokEventLaneForEvent(TikTokAppEvent *event);
+
+/**
+ * @brief Events sent per request in a lane. Revenue batches are small to keep their latency low.
+ */
+FOUNDATION_EXPORT NSUInteger TikTokEventLaneBatchSize(TikTokEventLane lane);
+
+/**
+ * @brief Sends a chunk and calls done when its request has finished, successfully or not.
+ */
+typedef void (^TikTokLaneSend)(dispatch_block_t done);
+
+/**
+ * @brief Orders uploads across lanes with a bounded number in flight. Queued revenue
+ *        sends always go first; standard and monitor sends share the rest by weight.
+ */
+@interface TikTokLaneScheduler : NSObject
+
++ (instancetype)sharedScheduler;
+
+/**
+ * @param maxConcurrentSends Requests allowed in flight at once
+ * @param queue Queue the send blocks run on
+ */
+- (instancetype)initWithMaxConcurrentSends:(NSUInteger)maxConcurrentSends queue:(dispatch_queue_t)queue;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Share of the non-revenue sends given to a lane. Defaults: standard 4, monitor 1.
+- (void)setWeight:(NSUInteger)weight forLane:(TikTokEventLane)lane;
+
+/**
+ * @brief Queue a send. Safe to call from any thread.
+ */
+- (void)enqueueSend:(TikTokLaneSend)send inLane:(TikTokEventLane)lane;
+
+- (NSUInteger)pendingSendCountInLane:(TikTokEventLane)lane;
+
+@property (nonatomic, assign, readonly) NSUInteger inFlightCount;
+
+/// Requests allowed in flight at once. Raising it starts queued sends right away.
+@property (nonatomic, assign) NSUInteger maxConcurrentSends;
+
+/**
+ * @brief Call block on the scheduler's queue once no sends are queued or in flight.
+ */
+- (void)notifyWhenIdle:(dispatch_block_t)block;
+
+@end
+
+NS_ASSUME_NONNULL_END
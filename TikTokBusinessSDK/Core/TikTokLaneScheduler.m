@@ -0,0 +1,266 @@
+//
+//  TikTokLaneScheduler.m
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokLaneScheduler.h"
+#import "TikTokAppEvent.h"
+#import "TikTokConstants.h"
+#import "TikTokErrorHandler.h"
+#import <pthread.h>
+
+#define MAX_CONCURRENT_SENDS 2
+#define REVENUE_BATCH_SIZE 10
+#define API_LIMIT 50
+
+TikTokEventLane TikTokEventLaneForEvent(TikTokAppEvent *event)
+{
+    static NSSet<NSString *> *revenueEvents = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        revenueEvents = [NSSet setWithArray:@[
+            @"Purchase",
+            TTEventNameAddPaymentInfo,
+            TTEventNameSubscribe,
+            TTEventNameStartTrial,
+            TTEventNameImpressionLevelAdRevenue,
+        ]];
+    });
+    if ([event.type isEqualToString:@"monitor"]) {
+        return TikTokEventLaneMonitor;
+    }
+    if (event.eventName && [revenueEvents containsObject:event.eventName]) {
+        return TikTokEventLaneRevenue;
+    }
+    return TikTokEventLaneStandard;
+}
+
+NSUInteger TikTokEventLaneBatchSize(TikTokEventLane lane)
+{
+    return lane == TikTokEventLaneRevenue ? REVENUE_BATCH_SIZE : API_LIMIT;
+}
+
+@interface TikTokLaneSendToken : NSObject
+
+@property (nonatomic, assign) BOOL finished;
+
+@end
+
+@implementation TikTokLaneSendToken
+
+@end
+
+@interface TikTokLaneScheduler ()
+{
+    pthread_mutex_t _mutex;
+    NSMutableArray<TikTokLaneSend> *_pending[TikTokEventLaneCount];
+    NSInteger _weights[TikTokEventLaneCount];
+    NSInteger _credits[TikTokEventLaneCount];
+    NSUInteger _inFlightCount;
+    NSUInteger _maxConcurrentSends;
+    NSMutableArray<dispatch_block_t> *_idleBlocks;
+}
+
+@property (nonatomic, strong) dispatch_queue_t queue;
+
+@end
+
+@implementation TikTokLaneScheduler
+
++ (instancetype)sharedScheduler
+{
+    static TikTokLaneScheduler *scheduler = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        dispatch_queue_t queue = dispatch_queue_create("com.TikTokBusiness.TikTokLaneScheduler", DISPATCH_QUEUE_SERIAL);
+        scheduler = [[TikTokLaneScheduler alloc] initWithMaxConcurrentSends:MAX_CONCURRENT_SENDS queue:queue];
+    });
+    return scheduler;
+}
+
+- (instancetype)initWithMaxConcurrentSends:(NSUInteger)maxConcurrentSends queue:(dispatch_queue_t)queue
+{
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_mutex, NULL);
+        _maxConcurrentSends = MAX(maxConcurrentSends, 1);
+        _queue = queue;
+        _idleBlocks = [NSMutableArray array];
+        for (NSInteger lane = 0; lane < TikTokEventLaneCount; lane++) {
+            _pending[lane] = [NSMutableArray array];
+        }
+        _weights[TikTokEventLaneStandard] = 4;
+        _weights[TikTokEventLaneMonitor] = 1;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_mutex);
+}
+
+- (void)setWeight:(NSUInteger)weight forLane:(TikTokEventLane)lane
+{
+    if (lane < 0 || lane >= TikTokEventLaneCount) {
+        return;
+    }
+    pthread_mutex_lock(&_mutex);
+    _weights[lane] = (NSInteger)MAX(weight, 1);
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (void)enqueueSend:(TikTokLaneSend)send inLane:(TikTokEventLane)lane
+{
+    if (send == nil || lane < 0 || lane >= TikTokEventLaneCount) {
+        return;
+    }
+    pthread_mutex_lock(&_mutex);
+    [_pending[lane] addObject:[send copy]];
+    pthread_mutex_unlock(&_mutex);
+    [self pump];
+}
+
+- (NSUInteger)pendingSendCountInLane:(TikTokEventLane)lane
+{
+    if (lane < 0 || lane >= TikTokEventLaneCount) {
+        return 0;
+    }
+    pthread_mutex_lock(&_mutex);
+    NSUInteger count = _pending[lane].count;
+    pthread_mutex_unlock(&_mutex);
+    return count;
+}
+
+- (NSUInteger)inFlightCount
+{
+    pthread_mutex_lock(&_mutex);
+    NSUInteger count = _inFlightCount;
+    pthread_mutex_unlock(&_mutex);
+    return count;
+}
+
+- (NSUInteger)maxConcurrentSends
+{
+    pthread_mutex_lock(&_mutex);
+    NSUInteger maxConcurrentSends = _maxConcurrentSends;
+    pthread_mutex_unlock(&_mutex);
+    return maxConcurrentSends;
+}
+
+- (void)setMaxConcurrentSends:(NSUInteger)maxConcurrentSends
+{
+    pthread_mutex_lock(&_mutex);
+    _maxConcurrentSends = MAX(maxConcurrentSends, 1);
+    pthread_mutex_unlock(&_mutex);
+    [self pump];
+}
+
+- (void)notifyWhenIdle:(dispatch_block_t)block
+{
+    if (block == nil) {
+        return;
+    }
+    pthread_mutex_lock(&_mutex);
+    [_idleBlocks addObject:[block copy]];
+    pthread_mutex_unlock(&_mutex);
+    [self pump];
+}
+
+// Called with _mutex held
+- (BOOL)isIdle
+{
+    if (_inFlightCount > 0) {
+        return NO;
+    }
+    for (NSInteger lane = 0; lane < TikTokEventLaneCount; lane++) {
+        if (_pending[lane].count > 0) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+// Called with _mutex held. Revenue first; otherwise smooth weighted round robin.
+- (NSInteger)nextLane
+{
+    if (_pending[TikTokEventLaneRevenue].count > 0) {
+        return TikTokEventLaneRevenue;
+    }
+    NSInteger chosen = -1;
+    NSInteger totalWeight = 0;
+    for (NSInteger lane = 0; lane < TikTokEventLaneCount; lane++) {
+        if (lane == TikTokEventLaneRevenue || _pending[lane].count == 0) {
+            continue;
+        }
+        _credits[lane] += _weights[lane];
+        totalWeight += _weights[lane];
+        if (chosen < 0 || _credits[lane] > _credits[chosen]) {
+            chosen = lane;
+        }
+    }
+    if (chosen >= 0) {
+        _credits[chosen] -= totalWeight;
+    }
+    return chosen;
+}
+
+- (void)pump
+{
+    NSMutableArray *ready = [NSMutableArray array];
+    pthread_mutex_lock(&_mutex);
+    while (_inFlightCount < _maxConcurrentSends) {
+        NSInteger lane = [self nextLane];
+        if (lane < 0) {
+            break;
+        }
+        [ready addObject:_pending[lane].firstObject];
+        [_pending[lane] removeObjectAtIndex:0];
+        _inFlightCount++;
+    }
+    NSArray<dispatch_block_t> *idleBlocks = nil;
+    if (_idleBlocks.count > 0 && [self isIdle]) {
+        idleBlocks = [_idleBlocks copy];
+        [_idleBlocks removeAllObjects];
+    }
+    pthread_mutex_unlock(&_mutex);
+
+    for (dispatch_block_t block in idleBlocks) {
+        dispatch_async(self.queue, block);
+    }
+
+    for (TikTokLaneSend send in ready) {
+        TikTokLaneSendToken *token = [[TikTokLaneSendToken alloc] init];
+        __weak typeof(self) weakSelf = self;
+        dispatch_block_t done = ^{
+            [weakSelf sendFinished:token];
+        };
+        dispatch_async(self.queue, ^{
+            @try {
+                send(done);
+            } @catch (NSException *exception) {
+                [TikTokErrorHandler handleErrorWithOrigin:NSStringFromClass([self class]) message:@"Failure on send" exception:exception];
+                done();
+            }
+        });
+    }
+}
+
+- (void)sendFinished:(TikTokLaneSendToken *)token
+{
+    pthread_mutex_lock(&_mutex);
+    BOOL first = !token.finished;
+    if (first) {
+        token.finished = YES;
+        _inFlightCount--;
+    }
+    pthread_mutex_unlock(&_mutex);
+    if (first) {
+        [self pump];
+    }
+}
+
+@end
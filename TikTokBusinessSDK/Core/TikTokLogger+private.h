@@ -0,0 +1,96 @@
+//
+//  TikTokLogger+private.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokLogger.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface TikTokLogger()
+
+/**
+ * @brief Serial queue the messages are written on
+ */
+@property (nonatomic, strong, readonly) dispatch_queue_t logQueue;
+
+/**
+ * @brief Whether messages at this level are currently logged. Cheap enough to call before building arguments.
+ */
+- (BOOL)isLevelEnabled:(TikTokLogLevel)level;
+
+/**
+ * @brief Log a message already built by the caller. Only the write happens on the logging queue.
+ *        Prefer the TTLog macros, which skip building the message if the level is disabled.
+ */
+- (void)logMessage:(NSString *)message atLevel:(TikTokLogLevel)level;
+
+/**
+ * @brief Number of messages dropped because the logging queue was full. Only levels below warn are dropped.
+ */
+- (NSUInteger)droppedMessageCount;
+
+/**
+ * @brief Wait until every message logged so far has been written.
+ */
+- (void)flush;
+
+@end
+
+/**
+ * @brief Lowest level the TTLog macros compile in. Calls below it are removed from the build.
+ *        Defaults to verbose in debug builds and info otherwise.
+ */
+#ifndef TT_LOG_MIN_LEVEL
+#if DEBUG
+#define TT_LOG_MIN_LEVEL 1
+#else
+#define TT_LOG_MIN_LEVEL 3
+#endif
+#endif
+
+/**
+ * @brief Log through a TikTokLogger. The level is checked before the arguments are evaluated.
+ *        The message is formatted on the calling thread, and only written on the logging queue.
+ */
+#define TTLogAtLevel(LOGGER, LEVEL, FMT, ...)                                                  \
+    do {                                                                                       \
+        TikTokLogger *tt_logger = (LOGGER);                                                    \
+        if ([tt_logger isLevelEnabled:(LEVEL)]) {                                              \
+            [tt_logger logMessage:[NSString stringWithFormat:(FMT), ##__VA_ARGS__]             \
+                          atLevel:(LEVEL)];                                                    \
+        }                                                                                      \
+    } while (0)
+
+#define TTLogDisabled(LOGGER, FMT, ...) do { } while (0)
+
+#if TT_LOG_MIN_LEVEL <= 1
+#define TTLogVerbose(LOGGER, FMT, ...) TTLogAtLevel(LOGGER, TikTokLogLevelVerbose, FMT, ##__VA_ARGS__)
+#else
+#define TTLogVerbose TTLogDisabled
+#endif
+
+#if TT_LOG_MIN_LEVEL <= 2
+#define TTLogDebug(LOGGER, FMT, ...) TTLogAtLevel(LOGGER, TikTokLogLevelDebug, FMT, ##__VA_ARGS__)
+#else
+#define TTLogDebug TTLogDisabled
+#endif
+
+#if TT_LOG_MIN_LEVEL <= 3
+#define TTLogInfo(LOGGER, FMT, ...) TTLogAtLevel(LOGGER, TikTokLogLevelInfo, FMT, ##__VA_ARGS__)
+#else
+#define TTLogInfo TTLogDisabled
+#endif
+
+#if TT_LOG_MIN_LEVEL <= 4
+#define TTLogWarn(LOGGER, FMT, ...) TTLogAtLevel(LOGGER, TikTokLogLevelWarn, FMT, ##__VA_ARGS__)
+#else
+#define TTLogWarn TTLogDisabled
+#endif
+
+#define TTLogError(LOGGER, FMT, ...) TTLogAtLevel(LOGGER, TikTokLogLevelError, FMT, ##__VA_ARGS__)
+
+NS_ASSUME_NONNULL_END
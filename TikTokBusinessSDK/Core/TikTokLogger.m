@@ -6,13 +6,37 @@
 //
 
 #import "TikTokLogger.h"
+#import "TikTokLogger+private.h"
+#import <stdatomic.h>
 
 static NSString * const kLogTag = @"TikTok";
 
+// Messages below warn waiting for the logging queue beyond this are dropped rather than piling up.
+static const NSInteger kMaxPendingMessages = 512;
+
+static NSString *TikTokLogLevelTag(TikTokLogLevel level)
+{
+    switch (level) {
+        case TikTokLogLevelVerbose: return @"v";
+        case TikTokLogLevelDebug: return @"d";
+        case TikTokLogLevelInfo: return @"i";
+        case TikTokLogLevelWarn: return @"w";
+        case TikTokLogLevelError: return @"e";
+        default: return @"a";
+    }
+}
+
 @interface TikTokLogger()
+{
+    atomic_long _pendingMessageCount;
+    atomic_ulong _droppedMessageCount;
+    // Only touched on the logging queue.
+    NSUInteger _reportedDroppedMessageCount;
+}
 
 @property (nonatomic, assign) TikTokLogLevel logLevel;
 @property (nonatomic, assign) BOOL logLevelLocked;
+@property (nonatomic, strong) dispatch_queue_t logQueue;
 
 @end
 
@@ -27,6 +51,7 @@ static NSString * const kLogTag = @"TikTok";
     // default values
     _logLevel = TikTokLogLevelInfo;
     self.logLevelLocked = NO;
+    self.logQueue = dispatch_queue_create("com.TikTokBusinessSDK.logger", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0));
     
     return self;
 }
@@ -49,94 +74,128 @@ static NSString * const kLogTag = @"TikTok";
 {
     if(self.logLevel > TikTokLogLevelVerbose) return;
     va_list parameters; va_start(parameters, message);
-    [self logLevel: @"v" format: message parameters: parameters];
+    [self logLevel:TikTokLogLevelVerbose format:message parameters:parameters];
 }
 
 - (void)verboseMessage:(NSString *)message {
     if(self.logLevel > TikTokLogLevelVerbose) return;
-    [self logMessage:message level:@"v"];
+    [self logMessage:message atLevel:TikTokLogLevelVerbose];
 }
 
 - (void)debug:(NSString *)message, ...
 {
     if(self.logLevel > TikTokLogLevelDebug) return;
     va_list parameters; va_start(parameters, message);
-    [self logLevel: @"d" format: message parameters: parameters];
+    [self logLevel:TikTokLogLevelDebug format:message parameters:parameters];
 }
 
 - (void)debugMessage:(NSString *)message {
     if(self.logLevel > TikTokLogLevelDebug) return;
-    [self logMessage:message level:@"d"];
+    [self logMessage:message atLevel:TikTokLogLevelDebug];
 }
 
 - (void)info:(NSString *)message, ...
 {
     if(self.logLevel > TikTokLogLevelInfo) return;
     va_list parameters; va_start(parameters, message);
-    [self logLevel: @"i" format: message parameters: parameters];
+    [self logLevel:TikTokLogLevelInfo format:message parameters:parameters];
 }
 
 - (void)infoMessage:(NSString *)message {
     if(self.logLevel > TikTokLogLevelInfo) return;
-    [self logMessage:message level:@"i"];
+    [self logMessage:message atLevel:TikTokLogLevelInfo];
 }
 
 - (void)warn:(NSString *)message, ...
 {
     if(self.logLevel > TikTokLogLevelWarn) return;
     va_list parameters; va_start(parameters, message);
-    [self logLevel: @"w" format: message parameters: parameters];
+    [self logLevel:TikTokLogLevelWarn format:message parameters:parameters];
 }
 
 - (void)warnMessage:(NSString *)message {
     if(self.logLevel > TikTokLogLevelWarn) return;
-    [self logMessage:message level:@"w"];
+    [self logMessage:message atLevel:TikTokLogLevelWarn];
 }
 
 - (void)warnInProduction:(NSString *)message, ...
 {
     if(self.logLevel > TikTokLogLevelWarn ) return;
     va_list parameters; va_start(parameters, message);
-    [self logLevel: @"w" format: message parameters: parameters];
+    [self logLevel:TikTokLogLevelWarn format:message parameters:parameters];
 }
 
 - (void)error:(NSString *)message, ...
 {
     if(self.logLevel > TikTokLogLevelError) return;
     va_list parameters; va_start(parameters, message);
-    [self logLevel: @"e" format: message parameters: parameters];
+    [self logLevel:TikTokLogLevelError format:message parameters:parameters];
 }
 
 - (void)errorMessage:(NSString *)message {
     if(self.logLevel > TikTokLogLevelError) return;
-    [self logMessage:message level:@"e"];
+    [self logMessage:message atLevel:TikTokLogLevelError];
 }
 
 - (void)assert:(NSString *)message, ...
 {
     if(self.logLevel > TikTokLogLevelAssert) return;
     va_list parameters; va_start(parameters, message);
-    [self logLevel: @"a" format: message parameters: parameters];
+    [self logLevel:TikTokLogLevelAssert format:message parameters:parameters];
 }
 
 - (void)assertMessage:(NSString *)message {
     if(self.logLevel > TikTokLogLevelAssert) return;
-    [self logMessage:message level:@"a"];
+    [self logMessage:message atLevel:TikTokLogLevelAssert];
+}
+
+- (BOOL)isLevelEnabled:(TikTokLogLevel)level
+{
+    return level >= _logLevel;
+}
+
+- (void)logMessage:(NSString *)message atLevel:(TikTokLogLevel)level
+{
+    if(![self isLevelEnabled:level] || message == nil) return;
+    // Warnings and errors are never dropped
+    BOOL droppable = level < TikTokLogLevelWarn;
+    if (atomic_fetch_add(&_pendingMessageCount, 1) >= kMaxPendingMessages && droppable) {
+        atomic_fetch_sub(&_pendingMessageCount, 1);
+        atomic_fetch_add(&_droppedMessageCount, 1);
+        return;
+    }
+    NSString *tag = TikTokLogLevelTag(level);
+    dispatch_async(self.logQueue, ^{
+        [self writeMessage:message level:tag];
+        atomic_fetch_sub(&self->_pendingMessageCount, 1);
+    });
+}
+
+- (NSUInteger)droppedMessageCount
+{
+    return (NSUInteger)atomic_load(&_droppedMessageCount);
+}
+
+- (void)flush
+{
+    dispatch_sync(self.logQueue, ^{});
 }
 
-- (void)logLevel: (NSString *)logLevel format: (NSString *)format parameters:(va_list)parameters
+- (void)logLevel:(TikTokLogLevel)level format:(NSString *)format parameters:(va_list)parameters
 {
+    // The arguments don't outlive this call, so only the output is deferred.
     NSString *string = [[NSString alloc] initWithFormat:format arguments:parameters];
     va_end(parameters);
-    
-    NSArray *lines = [string componentsSeparatedByString:@"\n"];
-    for(NSString *line in lines)
-    {
-        NSLog(@"\t[%@]%@: %@", kLogTag, logLevel, line);
-    }
+    [self logMessage:string atLevel:level];
 }
 
-- (void)logMessage:(NSString *)message level:(NSString *)logLevel {
+- (void)writeMessage:(NSString *)message level:(NSString *)logLevel
+{
+    NSUInteger droppedCount = self.droppedMessageCount;
+    if (droppedCount != _reportedDroppedMessageCount) {
+        NSLog(@"\t[%@]w: %lu log messages dropped", kLogTag, (unsigned long)(droppedCount - _reportedDroppedMessageCount));
+        _reportedDroppedMessageCount = droppedCount;
+    }
     NSArray *lines = [message componentsSeparatedByString:@"\n"];
     for(NSString *line in lines)
     {
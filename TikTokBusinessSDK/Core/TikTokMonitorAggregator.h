@@ -0,0 +1,43 @@
+//
+//  TikTokMonitorAggregator.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief Folds high-frequency monitor metrics into in-memory summaries, so that a
+ *        window of activity costs one monitor event instead of one per occurrence.
+ */
+@interface TikTokMonitorAggregator : NSObject
+
++ (instancetype)sharedAggregator;
+
+/**
+ * @brief Record one occurrence of a metric. Safe to call from any thread.
+ *
+ * @param name The monitor name, e.g. "network_req"
+ * @param key Splits a metric into separate summaries, e.g. by request path. Once a window
+ *            holds 512 summaries, new keys are counted under "_overflow" instead.
+ * @param value The measured value, e.g. a duration in milliseconds
+ * @param errorCode The error the occurrence ended with, if any
+ */
+- (void)recordMetric:(NSString *)name
+                 key:(nullable NSString *)key
+               value:(double)value
+           errorCode:(nullable NSNumber *)errorCode;
+
+/**
+ * @brief Summaries of everything recorded since the previous call, or nil if nothing was.
+ *        Each summary has name, key, count, sum, min, max, p50, p90, p99 and err_codes.
+ */
+- (nullable NSArray<NSDictionary *> *)takeSummaries;
+
+@end
+
+NS_ASSUME_NONNULL_END
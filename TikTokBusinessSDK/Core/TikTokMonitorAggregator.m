@@ -0,0 +1,163 @@
+//
+//  TikTokMonitorAggregator.m
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokMonitorAggregator.h"
+#import <pthread.h>
+
+// Values kept per summary for percentiles. Beyond this, reservoir sampling keeps a uniform sample.
+static const NSUInteger kMaxSamplesPerSummary = 256;
+// Summaries kept per window. Beyond this, keys not seen yet in the window share one
+// overflow summary per metric name, so generated keys cannot grow the table.
+static const NSUInteger kMaxSummariesPerWindow = 512;
+static NSString * const kOverflowKey = @"_overflow";
+
+@interface TikTokMetricSummary : NSObject
+
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, copy) NSString *key;
+@property (nonatomic, assign) NSUInteger count;
+@property (nonatomic, assign) double sum;
+@property (nonatomic, assign) double min;
+@property (nonatomic, assign) double max;
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *samples;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *errorCodes;
+
+@end
+
+@implementation TikTokMetricSummary
+
+- (void)addValue:(double)value errorCode:(NSNumber *)errorCode
+{
+    if (self.count == 0 || value < self.min) {
+        self.min = value;
+    }
+    if (self.count == 0 || value > self.max) {
+        self.max = value;
+    }
+    self.count++;
+    self.sum += value;
+    if (self.samples.count < kMaxSamplesPerSummary) {
+        [self.samples addObject:@(value)];
+    } else {
+        NSUInteger slot = arc4random_uniform((uint32_t)self.count);
+        if (slot < kMaxSamplesPerSummary) {
+            self.samples[slot] = @(value);
+        }
+    }
+    if (errorCode != nil) {
+        NSString *code = errorCode.stringValue;
+        self.errorCodes[code] = @(self.errorCodes[code].unsignedIntegerValue + 1);
+    }
+}
+
+- (NSDictionary *)dictionaryRepresentation
+{
+    NSArray<NSNumber *> *sorted = [self.samples sortedArrayUsingSelector:@selector(compare:)];
+    NSNumber * (^percentile)(double) = ^NSNumber *(double p) {
+        NSUInteger index = (NSUInteger)ceil(p / 100.0 * sorted.count);
+        return sorted[MIN(MAX(index, (NSUInteger)1), sorted.count) - 1];
+    };
+    NSMutableDictionary *dictionary = @{
+        @"name": self.name,
+        @"key": self.key,
+        @"count": @(self.count),
+        @"sum": @(self.sum),
+        @"min": @(self.min),
+        @"max": @(self.max),
+        @"p50": percentile(50),
+        @"p90": percentile(90),
+        @"p99": percentile(99),
+    }.mutableCopy;
+    if (self.errorCodes.count > 0) {
+        dictionary[@"err_codes"] = self.errorCodes.copy;
+    }
+    return dictionary.copy;
+}
+
+@end
+
+@interface TikTokMonitorAggregator ()
+{
+    pthread_mutex_t _mutex;
+}
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, TikTokMetricSummary *> *summaries;
+
+@end
+
+@implementation TikTokMonitorAggregator
+
++ (instancetype)sharedAggregator
+{
+    static TikTokMonitorAggregator *aggregator = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        aggregator = [[TikTokMonitorAggregator alloc] init];
+    });
+    return aggregator;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_mutex, NULL);
+        _summaries = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_mutex);
+}
+
+- (void)recordMetric:(NSString *)name key:(NSString *)key value:(double)value errorCode:(NSNumber *)errorCode
+{
+    if (name.length == 0) {
+        return;
+    }
+    NSString *safeKey = key ?: @"";
+    NSString *summaryKey = [NSString stringWithFormat:@"%@|%@", name, safeKey];
+    pthread_mutex_lock(&_mutex);
+    TikTokMetricSummary *summary = self.summaries[summaryKey];
+    if (summary == nil && self.summaries.count >= kMaxSummariesPerWindow) {
+        safeKey = kOverflowKey;
+        summaryKey = [NSString stringWithFormat:@"%@|%@", name, safeKey];
+        summary = self.summaries[summaryKey];
+    }
+    if (summary == nil) {
+        summary = [[TikTokMetricSummary alloc] init];
+        summary.name = name;
+        summary.key = safeKey;
+        summary.samples = [NSMutableArray array];
+        summary.errorCodes = [NSMutableDictionary dictionary];
+        self.summaries[summaryKey] = summary;
+    }
+    [summary addValue:value errorCode:errorCode];
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (NSArray<NSDictionary *> *)takeSummaries
+{
+    pthread_mutex_lock(&_mutex);
+    NSDictionary<NSString *, TikTokMetricSummary *> *summaries = self.summaries;
+    self.summaries = [NSMutableDictionary dictionary];
+    pthread_mutex_unlock(&_mutex);
+
+    if (summaries.count == 0) {
+        return nil;
+    }
+    NSMutableArray *result = [NSMutableArray arrayWithCapacity:summaries.count];
+    for (NSString *summaryKey in [summaries.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        [result addObject:[summaries[summaryKey] dictionaryRepresentation]];
+    }
+    return result.copy;
+}
+
+@end
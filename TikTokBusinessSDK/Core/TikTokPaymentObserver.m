@@ -19,10 +19,9 @@
 #import "TikTokTypeUtility.h"
 #import "TikTokEDPConfig.h"
 #import "TikTokAppEventUtility.h"
+#import "TikTokProductCache.h"
 
-static NSMutableArray *g_pendingRequestors;
-
-@interface TikTokPaymentProductRequestor : NSObject <SKProductsRequestDelegate>
+@interface TikTokPaymentProductRequestor : NSObject
 
 @property (nonatomic, retain) SKPaymentTransaction *transaction;
 
@@ -126,23 +125,12 @@ static NSMutableArray *g_pendingRequestors;
 
 @end
 
-@interface TikTokPaymentProductRequestor ()
-@property (nonatomic, retain) SKProductsRequest *productRequest;
-@end
-
 @implementation TikTokPaymentProductRequestor
 {
     NSMutableSet<NSString *> *_originalTransactionSet;
     NSSet<NSString *> *_eventsWithReceipt;
 }
 
-+ (void)initialize
-{
-    if([self class] == [TikTokPaymentProductRequestor class]) {
-        g_pendingRequestors = [[NSMutableArray alloc] init];
-    }
-}
-
 - (instancetype)initWithTransaction:(SKPaymentTransaction *)transaction
 {
     self = [super init];
@@ -160,26 +148,12 @@ static NSMutableArray *g_pendingRequestors;
     return self;
 }
 
-- (void)setProductRequest:(SKProductsRequest *)productRequest
-{
-    if(productRequest != _productRequest) {
-        if(_productRequest){
-            _productRequest.delegate = nil;
-        }
-        _productRequest = productRequest;
-    }
-}
-
 - (void)resolveProducts
 {
-    NSString *productId = self.transaction.payment.productIdentifier;
-    NSSet *productIdentifiers = [NSSet setWithObjects:productId, nil];
-    self.productRequest = [[SKProductsRequest alloc] initWithProductIdentifiers:productIdentifiers];
-    self.productRequest.delegate = self;
-    @synchronized (g_pendingRequestors) {
-        [g_pendingRequestors addObject:self];
-    }
-    [self.productRequest start];
+    // The cache holds on to the requestor until the product is resolved
+    [[TikTokProductCache sharedCache] productForIdentifier:self.transaction.payment.productIdentifier completion:^(SKProduct * _Nullable product) {
+        [self logTransactionEvent:product];
+    }];
 }
 
 - (void)logTransactionEvent: (SKProduct *)product
@@ -289,38 +263,6 @@ static NSMutableArray *g_pendingRequestors;
     return discountInfo.copy;
 }
 
-- (void)productsRequest:(SKProductsRequest *)request didReceiveResponse:(SKProductsResponse *)response
-{
-    NSArray *products = response.products;
-    NSArray *invalidProductIdentifiers = response.invalidProductIdentifiers;
-    if (products.count + invalidProductIdentifiers.count != 1) {
-        [[TikTokFactory getLogger] info:@"TikTokPaymentObserver: Expect to resolve one product per request"];
-    }
-    SKProduct *product = nil;
-    if (products.count) {
-        product = [products objectAtIndex:0];
-    }
-    [self logTransactionEvent:product];
-}
-
-- (void)requestDidFinish:(SKRequest *)request
-{
-    [self cleanUp];
-}
-
-- (void)request:(SKRequest *)request didFailWithError:(NSError *)error
-{
-    [self logTransactionEvent:nil];
-    [self cleanUp];
-}
-
-- (void)cleanUp
-{
-    @synchronized (g_pendingRequestors) {
-        [g_pendingRequestors removeObject:self];
-    }
-}
-
 - (void)trackAutomaticPurchaseEvent:(SKPaymentTransaction *)transaction ofProduct:(SKProduct *)product
 {
     NSString *eventName = nil;
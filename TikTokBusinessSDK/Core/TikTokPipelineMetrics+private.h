@@ -0,0 +1,46 @@
+//
+//  TikTokPipelineMetrics+private.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "TikTokPipelineMetrics.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief Monotonic clock in microseconds, for timing pipeline stages
+ */
+FOUNDATION_EXPORT uint64_t TikTokPipelineMetricsNow(void);
+
+@interface TikTokPipelineMetrics ()
+
+/**
+ * @brief Record a value. Lock-free and safe to call from any thread.
+ */
+- (void)recordValue:(uint64_t)value forHistogram:(TikTokPipelineHistogram)histogram;
+
+/**
+ * @brief Record the time elapsed since a TikTokPipelineMetricsNow() reading
+ */
+- (void)recordDurationSince:(uint64_t)start forHistogram:(TikTokPipelineHistogram)histogram;
+
+- (void)incrementCounter:(TikTokPipelineCounter)counter by:(uint64_t)amount;
+
+/**
+ * @brief Summaries of everything recorded since the previous call, or nil if nothing was.
+ *        Used to export one aggregated monitor event per interval.
+ */
+- (nullable NSDictionary *)takeIntervalSummary;
+
+/**
+ * @brief Clear all metrics. For testing.
+ */
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,92 @@
+//
+//  TikTokPipelineMetrics.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief Latency and size distributions recorded along the event pipeline.
+ *        Durations are in microseconds.
+ */
+typedef NS_ENUM(NSInteger, TikTokPipelineHistogram) {
+    /// Time from addEvent: until the event is in the database
+    TikTokPipelineHistogramEnqueueToPersistLatency = 0,
+    /// Time spent writing events to the database
+    TikTokPipelineHistogramPersistTime,
+    /// Events waiting to be persisted, sampled on every addEvent:
+    TikTokPipelineHistogramQueueDepth,
+    /// Time spent reading events back out of the database for a flush
+    TikTokPipelineHistogramRetrievalTime,
+    /// Time spent building the JSON body of a request
+    TikTokPipelineHistogramSerializationTime,
+    /// Time spent compressing the body of a request
+    TikTokPipelineHistogramCompressionTime,
+    /// Body size of each request, in bytes
+    TikTokPipelineHistogramRequestBytes,
+    /// Time from sending a request until its response arrives
+    TikTokPipelineHistogramRequestLatency,
+    TikTokPipelineHistogramCount
+};
+
+/**
+ * @brief Totals counted along the event pipeline.
+ */
+typedef NS_ENUM(NSInteger, TikTokPipelineCounter) {
+    TikTokPipelineCounterEventsEnqueued = 0,
+    TikTokPipelineCounterEventsPersisted,
+    TikTokPipelineCounterPersistFailures,
+    TikTokPipelineCounterEventsRetrieved,
+    TikTokPipelineCounterRequestsSent,
+    TikTokPipelineCounterRequestFailures,
+    TikTokPipelineCounterBytesSent,
+    TikTokPipelineCounterCount
+};
+
+/**
+ * @brief A point-in-time copy of one histogram
+ */
+@interface TikTokHistogramSnapshot : NSObject
+
+@property (nonatomic, assign, readonly) uint64_t count;
+@property (nonatomic, assign, readonly) uint64_t sum;
+@property (nonatomic, assign, readonly) uint64_t min;
+@property (nonatomic, assign, readonly) uint64_t max;
+@property (nonatomic, assign, readonly) double mean;
+
+/**
+ * @brief Value at or below which the given percentage of recorded values fall.
+ *        Accurate to within about 6% of the value.
+ */
+- (uint64_t)valueAtPercentile:(double)percentile;
+
+@end
+
+/**
+ * @brief Counters and histograms describing the event pipeline since launch
+ */
+@interface TikTokPipelineMetrics : NSObject
+
++ (instancetype)sharedMetrics;
+
+- (uint64_t)valueForCounter:(TikTokPipelineCounter)counter;
+
+- (TikTokHistogramSnapshot *)snapshotForHistogram:(TikTokPipelineHistogram)histogram;
+
+/**
+ * @brief All counters and histogram summaries, keyed by metric name
+ */
+- (NSDictionary *)dictionaryRepresentation;
+
++ (NSString *)nameForCounter:(TikTokPipelineCounter)counter;
+
++ (NSString *)nameForHistogram:(TikTokPipelineHistogram)histogram;
+
+@end
+
+NS_ASSUME_NONNULL_END
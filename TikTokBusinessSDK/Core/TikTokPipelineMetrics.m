@@ -0,0 +1,327 @@
+//
+//  TikTokPipelineMetrics.m
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokPipelineMetrics.h"
+#import "TikTokPipelineMetrics+private.h"
+#import <stdatomic.h>
+#import <time.h>
+
+// Log-linear buckets in the style of HdrHistogram: values below 16 get a bucket each,
+// and every power of two above that is split into 16 sub-buckets.
+#define TT_HISTOGRAM_SUB_BUCKET_BITS 4
+#define TT_HISTOGRAM_SUB_BUCKETS (1 << TT_HISTOGRAM_SUB_BUCKET_BITS)
+#define TT_HISTOGRAM_BUCKET_COUNT ((64 - TT_HISTOGRAM_SUB_BUCKET_BITS + 1) * TT_HISTOGRAM_SUB_BUCKETS)
+
+typedef struct {
+    atomic_ullong counts[TT_HISTOGRAM_BUCKET_COUNT];
+    atomic_ullong count;
+    atomic_ullong sum;
+    atomic_ullong min;
+    atomic_ullong max;
+} TTHistogram;
+
+typedef struct {
+    uint64_t counts[TT_HISTOGRAM_BUCKET_COUNT];
+    uint64_t count;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+} TTHistogramCopy;
+
+static inline int TTHistogramBucketIndex(uint64_t value)
+{
+    if (value < TT_HISTOGRAM_SUB_BUCKETS) {
+        return (int)value;
+    }
+    int shift = (63 - __builtin_clzll(value)) - TT_HISTOGRAM_SUB_BUCKET_BITS;
+    return (shift + 1) * TT_HISTOGRAM_SUB_BUCKETS + (int)((value >> shift) & (TT_HISTOGRAM_SUB_BUCKETS - 1));
+}
+
+/// Largest value that lands in a bucket
+static inline uint64_t TTHistogramBucketHighestValue(int index)
+{
+    if (index < TT_HISTOGRAM_SUB_BUCKETS) {
+        return (uint64_t)index;
+    }
+    int shift = index / TT_HISTOGRAM_SUB_BUCKETS - 1;
+    uint64_t subBucket = (uint64_t)(index % TT_HISTOGRAM_SUB_BUCKETS) + TT_HISTOGRAM_SUB_BUCKETS;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+static void TTHistogramReset(TTHistogram *histogram)
+{
+    for (int i = 0; i < TT_HISTOGRAM_BUCKET_COUNT; i++) {
+        atomic_store_explicit(&histogram->counts[i], 0, memory_order_relaxed);
+    }
+    atomic_store(&histogram->count, 0);
+    atomic_store(&histogram->sum, 0);
+    atomic_store(&histogram->min, UINT64_MAX);
+    atomic_store(&histogram->max, 0);
+}
+
+static void TTHistogramRecord(TTHistogram *histogram, uint64_t value)
+{
+    atomic_fetch_add_explicit(&histogram->counts[TTHistogramBucketIndex(value)], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&histogram->count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&histogram->sum, value, memory_order_relaxed);
+    unsigned long long current = atomic_load_explicit(&histogram->min, memory_order_relaxed);
+    while (value < current && !atomic_compare_exchange_weak(&histogram->min, &current, value)) {
+    }
+    current = atomic_load_explicit(&histogram->max, memory_order_relaxed);
+    while (value > current && !atomic_compare_exchange_weak(&histogram->max, &current, value)) {
+    }
+}
+
+/// Copy a histogram, optionally clearing it as we go so nothing recorded concurrently is lost.
+static void TTHistogramCopyOut(TTHistogram *histogram, TTHistogramCopy *copy, BOOL clear)
+{
+    uint64_t count = 0;
+    for (int i = 0; i < TT_HISTOGRAM_BUCKET_COUNT; i++) {
+        copy->counts[i] = clear ? atomic_exchange_explicit(&histogram->counts[i], 0, memory_order_relaxed)
+                                : atomic_load_explicit(&histogram->counts[i], memory_order_relaxed);
+        count += copy->counts[i];
+    }
+    // Bucket counts are authoritative; the other fields may be a few records apart under contention.
+    copy->count = count;
+    copy->sum = clear ? atomic_exchange(&histogram->sum, 0) : atomic_load(&histogram->sum);
+    copy->min = clear ? atomic_exchange(&histogram->min, UINT64_MAX) : atomic_load(&histogram->min);
+    copy->max = clear ? atomic_exchange(&histogram->max, 0) : atomic_load(&histogram->max);
+    if (clear) {
+        atomic_store(&histogram->count, 0);
+    }
+    if (count == 0) {
+        copy->min = 0;
+        copy->max = 0;
+        copy->sum = 0;
+    }
+}
+
+uint64_t TikTokPipelineMetricsNow(void)
+{
+    return clock_gettime_nsec_np(CLOCK_UPTIME_RAW) / NSEC_PER_USEC;
+}
+
+@interface TikTokHistogramSnapshot ()
+{
+    TTHistogramCopy _data;
+}
+
+@end
+
+@implementation TikTokHistogramSnapshot
+
+- (instancetype)initWithHistogram:(TTHistogram *)histogram clear:(BOOL)clear
+{
+    self = [super init];
+    if (self) {
+        TTHistogramCopyOut(histogram, &_data, clear);
+    }
+    return self;
+}
+
+- (uint64_t)count { return _data.count; }
+- (uint64_t)sum { return _data.sum; }
+- (uint64_t)min { return _data.min; }
+- (uint64_t)max { return _data.max; }
+
+- (double)mean
+{
+    return _data.count == 0 ? 0 : (double)_data.sum / (double)_data.count;
+}
+
+- (uint64_t)valueAtPercentile:(double)percentile
+{
+    if (_data.count == 0) {
+        return 0;
+    }
+    double clamped = MAX(0.0, MIN(100.0, percentile));
+    uint64_t target = MAX((uint64_t)1, (uint64_t)ceil(clamped / 100.0 * (double)_data.count));
+    uint64_t seen = 0;
+    for (int i = 0; i < TT_HISTOGRAM_BUCKET_COUNT; i++) {
+        seen += _data.counts[i];
+        if (seen >= target) {
+            return MAX(MIN(TTHistogramBucketHighestValue(i), _data.max), _data.min);
+        }
+    }
+    return _data.max;
+}
+
+- (NSDictionary *)dictionaryRepresentation
+{
+    return @{
+        @"count": @(self.count),
+        @"min": @(self.min),
+        @"max": @(self.max),
+        @"mean": @(round(self.mean)),
+        @"p50": @([self valueAtPercentile:50]),
+        @"p90": @([self valueAtPercentile:90]),
+        @"p99": @([self valueAtPercentile:99]),
+    };
+}
+
+@end
+
+@interface TikTokPipelineMetrics ()
+{
+    TTHistogram _histograms[TikTokPipelineHistogramCount];
+    TTHistogram _intervalHistograms[TikTokPipelineHistogramCount];
+    atomic_ullong _counters[TikTokPipelineCounterCount];
+    atomic_ullong _intervalCounters[TikTokPipelineCounterCount];
+    atomic_ullong _intervalStart;
+}
+
+@end
+
+@implementation TikTokPipelineMetrics
+
++ (instancetype)sharedMetrics
+{
+    static TikTokPipelineMetrics *metrics = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        metrics = [[TikTokPipelineMetrics alloc] init];
+    });
+    return metrics;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        [self reset];
+    }
+    return self;
+}
+
++ (NSString *)nameForCounter:(TikTokPipelineCounter)counter
+{
+    switch (counter) {
+        case TikTokPipelineCounterEventsEnqueued: return @"events_enqueued";
+        case TikTokPipelineCounterEventsPersisted: return @"events_persisted";
+        case TikTokPipelineCounterPersistFailures: return @"persist_failures";
+        case TikTokPipelineCounterEventsRetrieved: return @"events_retrieved";
+        case TikTokPipelineCounterRequestsSent: return @"requests_sent";
+        case TikTokPipelineCounterRequestFailures: return @"request_failures";
+        case TikTokPipelineCounterBytesSent: return @"bytes_sent";
+        default: return @"";
+    }
+}
+
++ (NSString *)nameForHistogram:(TikTokPipelineHistogram)histogram
+{
+    switch (histogram) {
+        case TikTokPipelineHistogramEnqueueToPersistLatency: return @"enqueue_to_persist_us";
+        case TikTokPipelineHistogramPersistTime: return @"persist_us";
+        case TikTokPipelineHistogramQueueDepth: return @"queue_depth";
+        case TikTokPipelineHistogramRetrievalTime: return @"retrieval_us";
+        case TikTokPipelineHistogramSerializationTime: return @"serialization_us";
+        case TikTokPipelineHistogramCompressionTime: return @"compression_us";
+        case TikTokPipelineHistogramRequestBytes: return @"request_bytes";
+        case TikTokPipelineHistogramRequestLatency: return @"request_latency_us";
+        default: return @"";
+    }
+}
+
+- (void)recordValue:(uint64_t)value forHistogram:(TikTokPipelineHistogram)histogram
+{
+    if (histogram < 0 || histogram >= TikTokPipelineHistogramCount) {
+        return;
+    }
+    TTHistogramRecord(&_histograms[histogram], value);
+    TTHistogramRecord(&_intervalHistograms[histogram], value);
+}
+
+- (void)recordDurationSince:(uint64_t)start forHistogram:(TikTokPipelineHistogram)histogram
+{
+    uint64_t now = TikTokPipelineMetricsNow();
+    [self recordValue:(now > start ? now - start : 0) forHistogram:histogram];
+}
+
+- (void)incrementCounter:(TikTokPipelineCounter)counter by:(uint64_t)amount
+{
+    if (counter < 0 || counter >= TikTokPipelineCounterCount) {
+        return;
+    }
+    atomic_fetch_add_explicit(&_counters[counter], amount, memory_order_relaxed);
+    atomic_fetch_add_explicit(&_intervalCounters[counter], amount, memory_order_relaxed);
+}
+
+- (uint64_t)valueForCounter:(TikTokPipelineCounter)counter
+{
+    if (counter < 0 || counter >= TikTokPipelineCounterCount) {
+        return 0;
+    }
+    return atomic_load_explicit(&_counters[counter], memory_order_relaxed);
+}
+
+- (TikTokHistogramSnapshot *)snapshotForHistogram:(TikTokPipelineHistogram)histogram
+{
+    if (histogram < 0 || histogram >= TikTokPipelineHistogramCount) {
+        return [[TikTokHistogramSnapshot alloc] init];
+    }
+    return [[TikTokHistogramSnapshot alloc] initWithHistogram:&_histograms[histogram] clear:NO];
+}
+
+- (NSDictionary *)dictionaryRepresentation
+{
+    NSMutableDictionary *counters = [NSMutableDictionary dictionary];
+    for (NSInteger i = 0; i < TikTokPipelineCounterCount; i++) {
+        counters[[[self class] nameForCounter:i]] = @([self valueForCounter:i]);
+    }
+    NSMutableDictionary *histograms = [NSMutableDictionary dictionary];
+    for (NSInteger i = 0; i < TikTokPipelineHistogramCount; i++) {
+        histograms[[[self class] nameForHistogram:i]] = [[self snapshotForHistogram:i] dictionaryRepresentation];
+    }
+    return @{@"counters": counters, @"histograms": histograms};
+}
+
+- (NSDictionary *)takeIntervalSummary
+{
+    uint64_t now = TikTokPipelineMetricsNow();
+    uint64_t start = atomic_exchange(&_intervalStart, now);
+    BOOL isEmpty = YES;
+    NSMutableDictionary *counters = [NSMutableDictionary dictionary];
+    for (NSInteger i = 0; i < TikTokPipelineCounterCount; i++) {
+        uint64_t value = atomic_exchange_explicit(&_intervalCounters[i], 0, memory_order_relaxed);
+        if (value > 0) {
+            counters[[[self class] nameForCounter:i]] = @(value);
+            isEmpty = NO;
+        }
+    }
+    NSMutableDictionary *histograms = [NSMutableDictionary dictionary];
+    for (NSInteger i = 0; i < TikTokPipelineHistogramCount; i++) {
+        TikTokHistogramSnapshot *snapshot = [[TikTokHistogramSnapshot alloc] initWithHistogram:&_intervalHistograms[i] clear:YES];
+        if (snapshot.count > 0) {
+            histograms[[[self class] nameForHistogram:i]] = [snapshot dictionaryRepresentation];
+            isEmpty = NO;
+        }
+    }
+    if (isEmpty) {
+        return nil;
+    }
+    return @{
+        @"window_ms": @((now - start) / 1000),
+        @"counters": counters,
+        @"histograms": histograms,
+    };
+}
+
+- (void)reset
+{
+    for (NSInteger i = 0; i < TikTokPipelineHistogramCount; i++) {
+        TTHistogramReset(&_histograms[i]);
+        TTHistogramReset(&_intervalHistograms[i]);
+    }
+    for (NSInteger i = 0; i < TikTokPipelineCounterCount; i++) {
+        atomic_store(&_counters[i], 0);
+        atomic_store(&_intervalCounters[i], 0);
+    }
+    atomic_store(&_intervalStart, TikTokPipelineMetricsNow());
+}
+
+@end
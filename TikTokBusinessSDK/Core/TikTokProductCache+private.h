@@ -0,0 +1,30 @@
+//
+//  TikTokProductCache+private.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "TikTokProductCache.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface TikTokProductCache ()
+
+/**
+ * @brief Fetch a batch of identifiers from StoreKit. Called on the cache's queue, and
+ *        overridden in tests.
+ */
+- (void)requestProductsWithIdentifiers:(NSSet<NSString *> *)productIdentifiers;
+
+/**
+ * @brief Cache what a request resolved and answer everyone waiting for its identifiers.
+ *        products is nil if the request failed, in which case nothing is cached.
+ */
+- (void)finishRequestForIdentifiers:(NSSet<NSString *> *)productIdentifiers products:(nullable NSArray<SKProduct *> *)products;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,47 @@
+//
+//  TikTokProductCache.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <StoreKit/StoreKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief Completion of a product lookup. Called on the cache's queue; product is nil if
+ *        the identifier is invalid or StoreKit couldn't be reached.
+ */
+typedef void (^TikTokProductCacheCompletion)(SKProduct * _Nullable product);
+
+/**
+ * @brief StoreKit 1 products by identifier, shared by the payment observer and the
+ *        StoreKit observers.
+ *
+ *        Resolved products are kept for a while, so a restore or a burst of renewals
+ *        doesn't fetch the same product again. Lookups of an identifier already being
+ *        fetched wait for that request, and lookups made within a short window are
+ *        fetched with a single SKProductsRequest.
+ */
+@interface TikTokProductCache : NSObject
+
++ (instancetype)sharedCache NS_SWIFT_NAME(shared());
+
+/**
+ * @param timeToLive How long a resolved product is served from the cache
+ * @param batchWindow How long a lookup waits for others to share its request
+ */
+- (instancetype)initWithTimeToLive:(NSTimeInterval)timeToLive batchWindow:(NSTimeInterval)batchWindow NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (void)productForIdentifier:(NSString *)productIdentifier completion:(TikTokProductCacheCompletion)completion;
+
+- (void)removeAllProducts;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,173 @@
+//
+//  TikTokProductCache.m
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokProductCache.h"
+#import "TikTokProductCache+private.h"
+#import "TikTokFactory.h"
+#import "TikTokLogger.h"
+#import "TikTokTypeUtility.h"
+
+// Prices and offers can change, but not within a restore or a renewal burst
+static const NSTimeInterval kProductTimeToLive = 60 * 60;
+static const NSTimeInterval kProductBatchWindow = 0.05;
+
+@interface TikTokProductCacheEntry : NSObject
+
+@property (nonatomic, strong) SKProduct *product;
+@property (nonatomic, assign) NSTimeInterval expiry;
+
+@end
+
+@implementation TikTokProductCacheEntry
+@end
+
+@interface TikTokProductCache () <SKProductsRequestDelegate>
+
+@property (nonatomic, assign) NSTimeInterval timeToLive;
+@property (nonatomic, assign) NSTimeInterval batchWindow;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, TikTokProductCacheEntry *> *entries;
+// Completions waiting for each identifier being fetched
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<TikTokProductCacheCompletion> *> *waiters;
+// Identifiers for the batch about to be requested
+@property (nonatomic, strong) NSMutableSet<NSString *> *pendingIdentifiers;
+// Requests in flight, with the identifiers each was made for
+@property (nonatomic, strong) NSMapTable<SKProductsRequest *, NSSet<NSString *> *> *requests;
+
+@end
+
+@implementation TikTokProductCache
+
++ (instancetype)sharedCache
+{
+    static TikTokProductCache *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [[TikTokProductCache alloc] initWithTimeToLive:kProductTimeToLive batchWindow:kProductBatchWindow];
+    });
+    return cache;
+}
+
+- (instancetype)initWithTimeToLive:(NSTimeInterval)timeToLive batchWindow:(NSTimeInterval)batchWindow
+{
+    self = [super init];
+    if (self) {
+        _timeToLive = timeToLive;
+        _batchWindow = batchWindow;
+        _queue = dispatch_queue_create("com.TikTokBusiness.productCache", DISPATCH_QUEUE_SERIAL);
+        _entries = [NSMutableDictionary dictionary];
+        _waiters = [NSMutableDictionary dictionary];
+        _pendingIdentifiers = [NSMutableSet set];
+        _requests = [NSMapTable strongToStrongObjectsMapTable];
+    }
+    return self;
+}
+
+- (void)productForIdentifier:(NSString *)productIdentifier completion:(TikTokProductCacheCompletion)completion
+{
+    if (!completion) {
+        return;
+    }
+    dispatch_async(self.queue, ^{
+        if (!TTCheckValidString(productIdentifier)) {
+            completion(nil);
+            return;
+        }
+        TikTokProductCacheEntry *entry = [self.entries objectForKey:productIdentifier];
+        if (entry && entry.expiry > [NSDate date].timeIntervalSince1970) {
+            completion(entry.product);
+            return;
+        }
+        NSMutableArray *waiters = [self.waiters objectForKey:productIdentifier];
+        if (waiters) {
+            // already pending or in flight
+            [waiters addObject:[completion copy]];
+            return;
+        }
+        [self.waiters setObject:[NSMutableArray arrayWithObject:[completion copy]] forKey:productIdentifier];
+        BOOL batchScheduled = self.pendingIdentifiers.count > 0;
+        [self.pendingIdentifiers addObject:productIdentifier];
+        if (!batchScheduled) {
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.batchWindow * NSEC_PER_SEC)), self.queue, ^{
+                NSSet *identifiers = [self.pendingIdentifiers copy];
+                [self.pendingIdentifiers removeAllObjects];
+                [self requestProductsWithIdentifiers:identifiers];
+            });
+        }
+    });
+}
+
+- (void)removeAllProducts
+{
+    dispatch_async(self.queue, ^{
+        [self.entries removeAllObjects];
+    });
+}
+
+#pragma mark - Requests
+
+- (void)requestProductsWithIdentifiers:(NSSet<NSString *> *)productIdentifiers
+{
+    SKProductsRequest *request = [[SKProductsRequest alloc] initWithProductIdentifiers:productIdentifiers];
+    request.delegate = self;
+    [self.requests setObject:productIdentifiers forKey:request];
+    [request start];
+}
+
+- (void)finishRequestForIdentifiers:(NSSet<NSString *> *)productIdentifiers products:(NSArray<SKProduct *> *)products
+{
+    NSMutableDictionary<NSString *, SKProduct *> *resolved = [NSMutableDictionary dictionary];
+    NSTimeInterval expiry = [NSDate date].timeIntervalSince1970 + self.timeToLive;
+    for (SKProduct *product in products) {
+        NSString *identifier = product.productIdentifier;
+        if (!TTCheckValidString(identifier)) {
+            continue;
+        }
+        TikTokProductCacheEntry *entry = [TikTokProductCacheEntry new];
+        entry.product = product;
+        entry.expiry = expiry;
+        [self.entries setObject:entry forKey:identifier];
+        [resolved setObject:product forKey:identifier];
+    }
+    for (NSString *identifier in productIdentifiers) {
+        NSArray<TikTokProductCacheCompletion> *waiters = [self.waiters objectForKey:identifier];
+        [self.waiters removeObjectForKey:identifier];
+        SKProduct *product = [resolved objectForKey:identifier];
+        for (TikTokProductCacheCompletion completion in waiters) {
+            completion(product);
+        }
+    }
+}
+
+#pragma mark - SKProductsRequestDelegate
+
+- (void)productsRequest:(SKProductsRequest *)request didReceiveResponse:(SKProductsResponse *)response
+{
+    NSArray<SKProduct *> *products = response.products ?: @[];
+    dispatch_async(self.queue, ^{
+        NSSet *identifiers = [self.requests objectForKey:request];
+        if (identifiers) {
+            [self.requests removeObjectForKey:request];
+            [self finishRequestForIdentifiers:identifiers products:products];
+        }
+    });
+}
+
+- (void)request:(SKRequest *)request didFailWithError:(NSError *)error
+{
+    [[TikTokFactory getLogger] info:@"TikTokProductCache: products request failed: %@", error.localizedDescription];
+    dispatch_async(self.queue, ^{
+        NSSet *identifiers = [self.requests objectForKey:(SKProductsRequest *)request];
+        if (identifiers) {
+            [self.requests removeObjectForKey:(SKProductsRequest *)request];
+            [self finishRequestForIdentifiers:identifiers products:nil];
+        }
+    });
+}
+
+@end
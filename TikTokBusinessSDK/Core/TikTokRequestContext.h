@@ -0,0 +1,78 @@
+//
+//  TikTokRequestContext.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class TikTokConfig;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief The app, device and library parts of a request, shared by every event in it.
+ *        Instances are immutable and safe to use from any thread.
+ */
+@interface TikTokRequestContext : NSObject
+
+/// Cache version this context was built at
+@property (nonatomic, assign, readonly) NSUInteger version;
+@property (nonatomic, copy, readonly) NSDictionary *app;
+@property (nonatomic, copy, readonly) NSDictionary *device;
+@property (nonatomic, copy, readonly) NSDictionary *library;
+@property (nonatomic, copy, readonly) NSString *userAgent;
+@property (nonatomic, copy, readonly) NSString *locale;
+@property (nonatomic, copy, readonly) NSString *ip;
+
+- (instancetype)initWithVersion:(NSUInteger)version
+                            app:(NSDictionary *)app
+                         device:(NSDictionary *)device
+                        library:(NSDictionary *)library
+                      userAgent:(NSString *)userAgent
+                         locale:(NSString *)locale
+                             ip:(NSString *)ip;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * @brief The app dictionary with anonymous_id set. Memoized, so events of one
+ *        user share a single dictionary.
+ */
+- (NSDictionary *)appWithAnonymousID:(nullable NSString *)anonymousID;
+
+@end
+
+/**
+ * @brief Keeps the last request context for each of the event and monitor endpoints.
+ *        A context is reused until the version is bumped by one of the events it
+ *        depends on (ATT status, IDFA, locale, user agent, access token, a network
+ *        change for the IP) or the config it was built with changes.
+ */
+@interface TikTokRequestContextCache : NSObject
+
++ (instancetype)sharedCache;
+
+@property (nonatomic, assign, readonly) NSUInteger version;
+
+/**
+ * @brief The cached context, or nil if it has to be rebuilt.
+ */
+- (nullable TikTokRequestContext *)contextForConfig:(TikTokConfig *)config isMonitor:(BOOL)isMonitor;
+
+/**
+ * @brief Keep a freshly built context. Ignored if the cache was invalidated
+ *        after the context's version was read.
+ */
+- (void)storeContext:(TikTokRequestContext *)context forConfig:(TikTokConfig *)config isMonitor:(BOOL)isMonitor;
+
+/**
+ * @brief Drop all cached contexts. Safe to call from any thread.
+ */
+- (void)invalidate;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,177 @@
+//
+//  TikTokRequestContext.m
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokRequestContext.h"
+#import "TikTokConfig.h"
+#import "TikTokTypeUtility.h"
+#import <AppTrackingTransparency/AppTrackingTransparency.h>
+#import <UIKit/UIKit.h>
+#import <pthread.h>
+#import <stdatomic.h>
+
+// Anonymous IDs only change on logout, so a handful per context version is plenty.
+static const NSUInteger kMaxAppsPerContext = 8;
+
+@interface TikTokRequestContext ()
+{
+    pthread_mutex_t _appsMutex;
+}
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSDictionary *> *appsByAnonymousID;
+
+@end
+
+@implementation TikTokRequestContext
+
+- (instancetype)initWithVersion:(NSUInteger)version
+                            app:(NSDictionary *)app
+                         device:(NSDictionary *)device
+                        library:(NSDictionary *)library
+                      userAgent:(NSString *)userAgent
+                         locale:(NSString *)locale
+                             ip:(NSString *)ip
+{
+    self = [super init];
+    if (self) {
+        _version = version;
+        _app = [app copy];
+        _device = [device copy];
+        _library = [library copy];
+        _userAgent = [userAgent copy];
+        _locale = [locale copy];
+        _ip = [ip copy];
+        _appsByAnonymousID = [NSMutableDictionary dictionary];
+        pthread_mutex_init(&_appsMutex, NULL);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_appsMutex);
+}
+
+- (NSDictionary *)appWithAnonymousID:(NSString *)anonymousID
+{
+    if (!TTCheckValidString(anonymousID)) {
+        return self.app;
+    }
+    pthread_mutex_lock(&_appsMutex);
+    NSDictionary *app = self.appsByAnonymousID[anonymousID];
+    if (app == nil) {
+        NSMutableDictionary *tempApp = [self.app mutableCopy];
+        [TikTokTypeUtility dictionary:tempApp setObject:anonymousID forKey:@"anonymous_id"];
+        app = [tempApp copy];
+        if (self.appsByAnonymousID.count >= kMaxAppsPerContext) {
+            [self.appsByAnonymousID removeAllObjects];
+        }
+        self.appsByAnonymousID[anonymousID] = app;
+    }
+    pthread_mutex_unlock(&_appsMutex);
+    return app;
+}
+
+@end
+
+@interface TikTokRequestContextCache ()
+{
+    pthread_mutex_t _mutex;
+    _Atomic(NSUInteger) _version;
+}
+
+@property (nonatomic, strong, nullable) TikTokRequestContext *eventContext;
+@property (nonatomic, strong, nullable) TikTokRequestContext *monitorContext;
+@property (nonatomic, weak, nullable) TikTokConfig *config;
+@property (nonatomic, assign) NSInteger trackingStatus;
+
+@end
+
+@implementation TikTokRequestContextCache
+
++ (instancetype)sharedCache
+{
+    static TikTokRequestContextCache *cache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [[TikTokRequestContextCache alloc] init];
+    });
+    return cache;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_mutex, NULL);
+        atomic_init(&_version, 1);
+        // ATT status and the IDFA can change in Settings while the app is in the background
+        NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+        [center addObserver:self selector:@selector(invalidate) name:NSCurrentLocaleDidChangeNotification object:nil];
+        [center addObserver:self selector:@selector(invalidate) name:UIApplicationWillEnterForegroundNotification object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    pthread_mutex_destroy(&_mutex);
+}
+
+- (NSUInteger)version
+{
+    return atomic_load_explicit(&_version, memory_order_acquire);
+}
+
+- (void)invalidate
+{
+    atomic_fetch_add_explicit(&_version, 1, memory_order_acq_rel);
+}
+
+static NSInteger currentTrackingStatus(void)
+{
+    if (@available(iOS 14, *)) {
+        return ATTrackingManager.trackingAuthorizationStatus;
+    }
+    return -1;
+}
+
+- (TikTokRequestContext *)contextForConfig:(TikTokConfig *)config isMonitor:(BOOL)isMonitor
+{
+    NSUInteger version = self.version;
+    NSInteger trackingStatus = currentTrackingStatus();
+    pthread_mutex_lock(&_mutex);
+    TikTokRequestContext *context = isMonitor ? self.monitorContext : self.eventContext;
+    if (context.version != version || self.config != config || self.trackingStatus != trackingStatus) {
+        context = nil;
+    }
+    pthread_mutex_unlock(&_mutex);
+    return context;
+}
+
+- (void)storeContext:(TikTokRequestContext *)context forConfig:(TikTokConfig *)config isMonitor:(BOOL)isMonitor
+{
+    NSInteger trackingStatus = currentTrackingStatus();
+    pthread_mutex_lock(&_mutex);
+    if (context.version == self.version) {
+        if (self.config != config || self.trackingStatus != trackingStatus) {
+            self.eventContext = nil;
+            self.monitorContext = nil;
+            self.config = config;
+            self.trackingStatus = trackingStatus;
+        }
+        if (isMonitor) {
+            self.monitorContext = context;
+        } else {
+            self.eventContext = context;
+        }
+    }
+    pthread_mutex_unlock(&_mutex);
+}
+
+@end
@@ -24,6 +24,14 @@ NS_ASSUME_NONNULL_BEGIN
                 isRetry:(BOOL)isRetry
   withCompletionHandler:(void (^)(BOOL isRemoteSwitchOn, NSDictionary *globalConfig))completionHandler;
 
+/**
+ * @brief Apply the last good global config stored by getRemoteSwitch:, calling the completion
+ *        handler synchronously with it as getRemoteSwitch: would
+ * @return NO if there is no usable cached config, in which case the handler is not called
+ */
+- (BOOL)applyCachedGlobalConfig:(TikTokConfig *)config
+          withCompletionHandler:(void (^)(BOOL isRemoteSwitchOn, NSDictionary *globalConfig))completionHandler;
+
 
 /**
  * @brief Method to obtain remote debug mode switch with completion handler
@@ -37,12 +45,26 @@ withCompletionHandler:(void (^)(NSDictionary * _Nullable businessSDKConfig, NSEr
 - (void)sendBatchRequest:(NSArray *)eventsToBeFlushed
               withConfig:(TikTokConfig *)config;
 
+/**
+ * @brief Same as sendBatchRequest:withConfig:, calling completion once the request has finished or nothing was sent
+ */
+- (void)sendBatchRequest:(NSArray *)eventsToBeFlushed
+              withConfig:(TikTokConfig *)config
+              completion:(nullable dispatch_block_t)completion;
+
 /**
  * @brief Method to interact with '/app/monitor' endpoint
  */
 - (void)sendMonitorRequest:(NSArray *)eventsToBeFlushed
                 withConfig:(TikTokConfig *)config;
 
+/**
+ * @brief Same as sendMonitorRequest:withConfig:, calling completion once the request has finished or nothing was sent
+ */
+- (void)sendMonitorRequest:(NSArray *)eventsToBeFlushed
+                withConfig:(TikTokConfig *)config
+                completion:(nullable dispatch_block_t)completion;
+
 /**
  * @brief Method to obtain deferred deeplink with completion handler
  */
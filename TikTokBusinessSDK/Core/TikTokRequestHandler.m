@@ -10,6 +10,7 @@
 #import "TikTokConfig.h"
 #import "TikTokBusiness.h"
 #import "TikTokLogger.h"
+#import "TikTokLogger+private.h"
 #import "TikTokFactory.h"
 #import "TikTokTypeUtility.h"
 #import "TikTokIdentifyUtility.h"
@@ -17,17 +18,23 @@
 #import "TikTokAppEventUtility.h"
 #import "TikTokSKAdNetworkConversionConfiguration.h"
 #import "TikTokBusinessSDKMacros.h"
+#import "TikTokPipelineMetrics+private.h"
+#import "TikTokMonitorAggregator.h"
 #import "TikTokBusiness+private.h"
 #import "TikTokCurrencyUtility.h"
 #import "TikTokUnityBridge.h"
 #import "TikTokCypher.h"
 #import "TikTokBaseEventPersistence.h"
+#import "TikTokRequestContext.h"
+#import "TikTokGlobalConfigCache.h"
 
 @interface TikTokRequestHandler()
 
 @property (nonatomic, strong) TikTokLogger *logger;
 @property (nonatomic, assign) NSTimeInterval configTimeoutInterval;
 @property (nonatomic, assign) NSTimeInterval eventTimeoutInterval;
+// 'data' object of the global config response applied last
+@property (atomic, copy, nullable) NSDictionary *appliedGlobalConfigData;
 
 @end
 
@@ -70,8 +77,7 @@
     }
     
     NSString *postLength = [NSString stringWithFormat:@"%lu", [dataToPost length]];
-    NSString *paramDataJSONString = [[NSString alloc] initWithData:paramData encoding:NSUTF8StringEncoding];
-    [self.logger verbose:@"[TikTokRequestHandler] postDataJSON: %@", paramDataJSONString];
+    TTLogVerbose(self.logger, @"[TikTokRequestHandler] postDataJSON: %@", [[NSString alloc] initWithData:paramData encoding:NSUTF8StringEncoding]);
     
     NSMutableURLRequest *request = [[NSMutableURLRequest alloc] init];
     
@@ -99,6 +105,10 @@
     [request setValue:postLength forHTTPHeaderField:@"Content-Length"];
     [request setHTTPBody:dataToPost];
     [request setTimeoutInterval:self.configTimeoutInterval?:2];
+    NSString *ETag = [[TikTokGlobalConfigCache sharedCache] ETagForAppId:[self globalConfigCacheKeyForConfig:config]];
+    if (TTCheckValidString(ETag)) {
+        [request setValue:ETag forHTTPHeaderField:@"If-None-Match"];
+    }
 
     __block NSNumber *networkStartTime = [TikTokAppEventUtility getCurrentTimestampAsNumber];
     tt_weakify(self)
@@ -120,6 +130,20 @@
         if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
             NSInteger statusCode = [(NSHTTPURLResponse *)response statusCode];
             
+            if (statusCode == 304) {
+                // the cached config is still current
+                TikTokGlobalConfigCache *cache = [TikTokGlobalConfigCache sharedCache];
+                NSString *cacheKey = [self globalConfigCacheKeyForConfig:config];
+                NSDictionary *dataValue = [cache configDataForAppId:cacheKey];
+                if (TTCheckValidDictionary(dataValue)) {
+                    [cache markRevalidatedForAppId:cacheKey];
+                    [self reportNetworkReqforPath:[self urlType:url] duration:duration reqID:@"" error:nil];
+                    NSDictionary *businessSDKConfig = [self applyGlobalConfigData:dataValue config:config isRemoteSwitchOn:&isSwitchOn];
+                    completionHandler(isSwitchOn, businessSDKConfig);
+                    return;
+                }
+            }
+            
             if (statusCode != 200) {
                 [self.logger error:@"[TikTokRequestHandler] HTTP error status code: %lu", statusCode];
                 // leave switch to on if error on request
@@ -196,54 +220,11 @@
                                     error:nil];
             
             NSDictionary *dataValue = [dataDictionary objectForKey:@"data"];
-            NSDictionary *businessSDKConfig = [dataValue objectForKey:@"business_sdk_config"];
-            isSwitchOn = [[businessSDKConfig objectForKey:@"enable_sdk"] boolValue];
-            NSString *apiVersion = [businessSDKConfig objectForKey:@"available_version"];
-            if(TTCheckValidString(apiVersion)) {
-                self.apiVersion = apiVersion;
-            }
-            NSString *apiDomain = [businessSDKConfig objectForKey:@"domain"];
-            if(TTCheckValidString(apiDomain)){
-                self.apiDomain = apiDomain;
-            }
-            NSNumber *configTimeoutInterval = [businessSDKConfig objectForKey:@"network_timeout_config_interval"];
-            if (TTCheckValidNumber(configTimeoutInterval)) {
-                self.configTimeoutInterval = [configTimeoutInterval doubleValue];
-            }
-            NSNumber *eventTimeoutInterval = [businessSDKConfig objectForKey:@"network_timeout_event_interval"];
-            if (TTCheckValidNumber(eventTimeoutInterval)) {
-                self.eventTimeoutInterval = [eventTimeoutInterval doubleValue];
-            }
-            if (config.SKAdNetworkSupportEnabled) {
-                NSDictionary *skanConfig = [dataValue objectForKey:@"skan4_event_config"];
-                [[TikTokSKAdNetworkConversionConfiguration sharedInstance] configWithDict:skanConfig];
-            }
-            NSDictionary *currencyMap = [dataValue objectForKey:@"currency_exchange_info"];
-            [[TikTokCurrencyUtility sharedInstance] configWithDict:currencyMap];
-            
-            if (config.isLowPerf) {
-                NSMutableDictionary *tmpConfigDict = businessSDKConfig.mutableCopy;
-                NSDictionary *tmpUnityConfigDict = [tmpConfigDict objectForKey:@"enhanced_data_postback_unity_config"];
-                NSDictionary *tmpNativeConfigDict = [tmpConfigDict objectForKey:@"enhanced_data_postback_native_config"];
-                if (TTCheckValidDictionary(tmpUnityConfigDict)) {
-                    NSMutableDictionary *mcopyDict = tmpUnityConfigDict.mutableCopy;
-                    [mcopyDict setObject:@(NO) forKey:@"enable_sdk"];
-                    [tmpConfigDict setObject:mcopyDict.copy forKey:@"enhanced_data_postback_unity_config"];
-                }
-                if (TTCheckValidDictionary(tmpNativeConfigDict)) {
-                    NSMutableDictionary *mcopyDict = tmpNativeConfigDict.mutableCopy;
-                    [mcopyDict setObject:@(NO) forKey:@"enable_sdk"];
-                    [tmpConfigDict setObject:mcopyDict.copy forKey:@"enhanced_data_postback_native_config"];
-                }
-                businessSDKConfig = tmpConfigDict.copy;
-            }
-            [TikTokUnityBridge sendConfigCallback:@{@"business_sdk_config": TTSafeDictionary(businessSDKConfig)}];
-            
+            [[TikTokGlobalConfigCache sharedCache] storeConfigData:dataValue ETag:[self ETagFromResponse:response] appId:[self globalConfigCacheKeyForConfig:config]];
+            NSDictionary *businessSDKConfig = [self applyGlobalConfigData:dataValue config:config isRemoteSwitchOn:&isSwitchOn];
             completionHandler(isSwitchOn, businessSDKConfig);
             
-            NSString *requestResponse = [[NSString alloc] initWithData:data encoding:NSASCIIStringEncoding];
-            
-            [self.logger verbose:@"[TikTokRequestHandler] Request global config response: %@", requestResponse];
+            TTLogVerbose(self.logger, @"[TikTokRequestHandler] Request global config response: %@", [[NSString alloc] initWithData:data encoding:NSASCIIStringEncoding]);
             return;
         }
 
@@ -252,6 +233,99 @@
    
 }
 
+- (BOOL)applyCachedGlobalConfig:(TikTokConfig *)config
+          withCompletionHandler:(void (^)(BOOL isRemoteSwitchOn, NSDictionary *globalConfig))completionHandler
+{
+    NSDictionary *dataValue = [[TikTokGlobalConfigCache sharedCache] configDataForAppId:[self globalConfigCacheKeyForConfig:config]];
+    if (!TTCheckValidDictionary(dataValue)) {
+        return NO;
+    }
+    TTLogDebug(self.logger, @"[TikTokRequestHandler] Applying cached global config");
+    BOOL isSwitchOn = NO;
+    NSDictionary *businessSDKConfig = [self applyGlobalConfigData:dataValue config:config isRemoteSwitchOn:&isSwitchOn];
+    completionHandler(isSwitchOn, businessSDKConfig);
+    return YES;
+}
+
+- (NSDictionary *)applyGlobalConfigData:(NSDictionary *)dataValue
+                                 config:(TikTokConfig *)config
+                       isRemoteSwitchOn:(BOOL *)isRemoteSwitchOn
+{
+    NSDictionary *previousDataValue = self.appliedGlobalConfigData;
+    self.appliedGlobalConfigData = dataValue;
+    NSDictionary *businessSDKConfig = [dataValue objectForKey:@"business_sdk_config"];
+    *isRemoteSwitchOn = [[businessSDKConfig objectForKey:@"enable_sdk"] boolValue];
+    NSString *apiVersion = [businessSDKConfig objectForKey:@"available_version"];
+    if(TTCheckValidString(apiVersion)) {
+        self.apiVersion = apiVersion;
+    }
+    NSString *apiDomain = [businessSDKConfig objectForKey:@"domain"];
+    if(TTCheckValidString(apiDomain)){
+        self.apiDomain = apiDomain;
+    }
+    NSNumber *configTimeoutInterval = [businessSDKConfig objectForKey:@"network_timeout_config_interval"];
+    if (TTCheckValidNumber(configTimeoutInterval)) {
+        self.configTimeoutInterval = [configTimeoutInterval doubleValue];
+    }
+    NSNumber *eventTimeoutInterval = [businessSDKConfig objectForKey:@"network_timeout_event_interval"];
+    if (TTCheckValidNumber(eventTimeoutInterval)) {
+        self.eventTimeoutInterval = [eventTimeoutInterval doubleValue];
+    }
+    // rebuilding the SKAN rules drops their matched state, so only do it when they changed
+    if (config.SKAdNetworkSupportEnabled) {
+        NSDictionary *skanConfig = [dataValue objectForKey:@"skan4_event_config"];
+        if (!previousDataValue || ![skanConfig isEqual:[previousDataValue objectForKey:@"skan4_event_config"]]) {
+            [[TikTokSKAdNetworkConversionConfiguration sharedInstance] configWithDict:skanConfig];
+        }
+    }
+    NSDictionary *currencyMap = [dataValue objectForKey:@"currency_exchange_info"];
+    if (!previousDataValue || ![currencyMap isEqual:[previousDataValue objectForKey:@"currency_exchange_info"]]) {
+        [[TikTokCurrencyUtility sharedInstance] configWithDict:currencyMap];
+    }
+    
+    if (config.isLowPerf) {
+        NSMutableDictionary *tmpConfigDict = businessSDKConfig.mutableCopy;
+        NSDictionary *tmpUnityConfigDict = [tmpConfigDict objectForKey:@"enhanced_data_postback_unity_config"];
+        NSDictionary *tmpNativeConfigDict = [tmpConfigDict objectForKey:@"enhanced_data_postback_native_config"];
+        if (TTCheckValidDictionary(tmpUnityConfigDict)) {
+            NSMutableDictionary *mcopyDict = tmpUnityConfigDict.mutableCopy;
+            [mcopyDict setObject:@(NO) forKey:@"enable_sdk"];
+            [tmpConfigDict setObject:mcopyDict.copy forKey:@"enhanced_data_postback_unity_config"];
+        }
+        if (TTCheckValidDictionary(tmpNativeConfigDict)) {
+            NSMutableDictionary *mcopyDict = tmpNativeConfigDict.mutableCopy;
+            [mcopyDict setObject:@(NO) forKey:@"enable_sdk"];
+            [tmpConfigDict setObject:mcopyDict.copy forKey:@"enhanced_data_postback_native_config"];
+        }
+        businessSDKConfig = tmpConfigDict.copy;
+    }
+    // the engine bridge only needs to hear about a config it hasn't seen, e.g. not on a 304
+    NSDictionary *previousBusinessSDKConfig = [previousDataValue objectForKey:@"business_sdk_config"];
+    if (!previousDataValue || ![[dataValue objectForKey:@"business_sdk_config"] isEqual:previousBusinessSDKConfig]) {
+        [TikTokUnityBridge sendConfigCallback:@{@"business_sdk_config": TTSafeDictionary(businessSDKConfig)}];
+    }
+    return businessSDKConfig;
+}
+
+- (NSString *)globalConfigCacheKeyForConfig:(TikTokConfig *)config
+{
+    return [NSString stringWithFormat:@"%@|%@", TTSafeString(config.appId), TTSafeString(config.tiktokAppId)];
+}
+
+- (nullable NSString *)ETagFromResponse:(NSURLResponse *)response
+{
+    if (![response isKindOfClass:[NSHTTPURLResponse class]]) {
+        return nil;
+    }
+    NSDictionary *headers = [(NSHTTPURLResponse *)response allHeaderFields];
+    for (NSString *field in headers) {
+        if ([field caseInsensitiveCompare:@"ETag"] == NSOrderedSame) {
+            return [headers objectForKey:field];
+        }
+    }
+    return nil;
+}
+
 
 - (void)getDebugMode:(TikTokConfig *)config
 withCompletionHandler:(void (^)(NSDictionary *businessSDKConfig, NSError *error))completionHandler
@@ -270,8 +344,7 @@ withCompletionHandler:(void (^)(NSDictionary *businessSDKConfig, NSError *error)
     }
     
     NSString *postLength = [NSString stringWithFormat:@"%lu", [dataToPost length]];
-    NSString *paramDataJSONString = [[NSString alloc] initWithData:paramData encoding:NSUTF8StringEncoding];
-    [self.logger verbose:@"[TikTokRequestHandler] postDataJSON: %@", paramDataJSONString];
+    TTLogVerbose(self.logger, @"[TikTokRequestHandler] postDataJSON: %@", [[NSString alloc] initWithData:paramData encoding:NSUTF8StringEncoding]);
     
     NSMutableURLRequest *request = [[NSMutableURLRequest alloc] init];
     
@@ -328,8 +401,7 @@ withCompletionHandler:(void (^)(NSDictionary *businessSDKConfig, NSError *error)
                 }
             }
             
-            NSString *requestResponse = [[NSString alloc] initWithData:data encoding:NSASCIIStringEncoding];
-            [self.logger verbose:@"[TikTokRequestHandler] Request debug mode config response: %@", requestResponse];
+            TTLogVerbose(self.logger, @"[TikTokRequestHandler] Request debug mode config response: %@", [[NSString alloc] initWithData:data encoding:NSASCIIStringEncoding]);
             return;
         }
 
@@ -342,40 +414,40 @@ withCompletionHandler:(void (^)(NSDictionary *businessSDKConfig, NSError *error)
 - (void)sendBatchRequest:(NSArray *)eventsToBeFlushed
               withConfig:(TikTokConfig *)config
 {
-    TikTokDeviceInfo *deviceInfo = [TikTokDeviceInfo deviceInfo];
+    [self sendBatchRequest:eventsToBeFlushed withConfig:config completion:nil];
+}
 
-    // APP Info
-    NSDictionary *app = [self getAPPWithDeviceInfo:deviceInfo config:config];
+- (void)sendBatchRequest:(NSArray *)eventsToBeFlushed
+              withConfig:(TikTokConfig *)config
+              completion:(dispatch_block_t)completion
+{
+    // APP, Device and Library Info
+    TikTokRequestContext *requestContext = [self requestContextWithConfig:config isMonitor:NO];
     NSArray *ttAppIds = [self splitTTAppIDs:config.tiktokAppId];
-
-    // Device Info
-    NSDictionary *device = [self getDeviceInfo:deviceInfo withConfig:config isMonitor:NO];
-
-    // Library Info
-    NSDictionary *library = [self getLibraryWithConfig:config];
+    
+    // events of the same user share one context dictionary
+    NSMutableDictionary<NSArray *, NSDictionary *> *contextsByUser = [NSMutableDictionary dictionary];
     
     // format events into object[]
     NSMutableArray *batch = [[NSMutableArray alloc] init];
     for (TikTokAppEvent* event in eventsToBeFlushed) {
         if(![event.type isEqual:@"monitor"]){
-            NSMutableDictionary *user = [NSMutableDictionary new];
-            if(event.userInfo != nil) {
-                [user addEntriesFromDictionary:event.userInfo];
+            NSDictionary *user = event.userInfo ?: @{};
+            NSArray *userKey = @[TTSafeString(event.anonymousID), user];
+            NSDictionary *context = contextsByUser[userKey];
+            if (context == nil) {
+                context = @{
+                    @"app": [requestContext appWithAnonymousID:event.anonymousID],
+                    @"device": requestContext.device,
+                    @"library": requestContext.library,
+                    @"locale": requestContext.locale,
+                    @"ip": requestContext.ip,
+                    @"user_agent": requestContext.userAgent,
+                    @"user": [user copy],
+                };
+                contextsByUser[userKey] = context;
             }
             
-            NSMutableDictionary *tempAppDict = [app mutableCopy];
-            [TikTokTypeUtility dictionary:tempAppDict setObject:event.anonymousID forKey:@"anonymous_id"];
-            
-            NSDictionary *context = @{
-                @"app": tempAppDict.copy,
-                @"device": device,
-                @"library": library,
-                @"locale": TTSafeString(deviceInfo.localeInfo),
-                @"ip": TTSafeString(deviceInfo.ipInfo),
-                @"user_agent": [self getUserAgentWithDeviceInfo:deviceInfo],
-                @"user": user,
-            };
-            
             NSMutableDictionary *eventDict = @{
                 @"type" : TTSafeString(event.type),
                 @"event": TTSafeString(event.eventName),
@@ -397,7 +469,7 @@ withCompletionHandler:(void (^)(NSDictionary *businessSDKConfig, NSError *error)
     }
     
     if(batch.count > 0){
-        [self.logger verbose:@"Batch count was greater than 0!"];
+        TTLogVerbose(self.logger, @"Batch count was greater than 0!");
         // API version compatibility b/w 1.0 and 2.0
         NSDictionary *tempParametersDict = @{
             @"batch": batch,
@@ -420,10 +492,15 @@ withCompletionHandler:(void (^)(NSDictionary *businessSDKConfig, NSError *error)
             [TikTokTypeUtility dictionary:parametersDict setObject:[TikTokBusiness getTestEventCode] forKey:@"test_event_code"];
         }
         
+        TikTokPipelineMetrics *metrics = [TikTokPipelineMetrics sharedMetrics];
+        uint64_t serializationStart = TikTokPipelineMetricsNow();
         NSData *paramData = [TikTokTypeUtility dataWithJSONObject:parametersDict options:NSJSONWritingPrettyPrinted error:nil origin:NSStringFromClass([self class])];
+        [metrics recordDurationSince:serializationStart forHistogram:TikTokPipelineHistogramSerializationTime];
         
         TikTokCypherResultErrorCode gzipErr = TikTokCypherResultNone;
+        uint64_t compressionStart = TikTokPipelineMetricsNow();
         NSData *dataToPost = [TikTokCypher gzipCompressData:paramData error:&gzipErr];
+        [metrics recordDurationSince:compressionStart forHistogram:TikTokPipelineHistogramCompressionTime];
         if (!TTCheckValidData(dataToPost)) {
             if (gzipErr) {
                 [self reportGzipErrorCode:gzipErr path:@"batch"];
@@ -437,7 +514,7 @@ withCompletionHandler:(void (^)(NSDictionary *businessSDKConfig, NSError *error)
         NSString *token = [[TikTokBusiness getInstance] accessToken];
         NSString *signature = [TikTokCypher hmacSHA256WithSecret:token content:paramDataJSONString];
         
-        [self.logger verbose:@"[TikTokRequestHandler] postDataJSON: %@", paramDataJSONString];
+        TTLogVerbose(self.logger, @"[TikTokRequestHandler] postDataJSON: %@", paramDataJSONString);
         
         NSMutableURLRequest *request = [[NSMutableURLRequest alloc] init];
         
@@ -453,128 +530,139 @@ withCompletionHandler:(void (^)(NSDictionary *businessSDKConfig, NSError *error)
         [request setHTTPBody:dataToPost];
         [request setTimeoutInterval:self.eventTimeoutInterval ?: 10];
         
+        [metrics recordValue:dataToPost.length forHistogram:TikTokPipelineHistogramRequestBytes];
+        [metrics incrementCounter:TikTokPipelineCounterBytesSent by:dataToPost.length];
+        [metrics incrementCounter:TikTokPipelineCounterRequestsSent by:1];
+        uint64_t requestStart = TikTokPipelineMetricsNow();
         __block NSNumber *networkStartTime = [TikTokAppEventUtility getCurrentTimestampAsNumber];
         tt_weakify(self)
         [[self.session dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
             tt_strongify(self)
-            // handle basic connectivity issues
-            if(error) {
-                [self.logger error:@"[TikTokRequestHandler] error in connection: %@", error];
-                [[TikTokAppEventPersistence persistence] handleSentResult:NO events:eventsToBeFlushed];
-                return;
-            }
-            NSNumber *networkEndTime = [TikTokAppEventUtility getCurrentTimestampAsNumber];
-            long long duration = [networkEndTime longLongValue] - [networkStartTime longLongValue];
-            id dataDictionary = [TikTokTypeUtility JSONObjectWithData:data options:0 error:nil origin:NSStringFromClass([self class])];
-            // handle HTTP errors
-            if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
-                NSInteger statusCode = [(NSHTTPURLResponse *)response statusCode];
-                if (statusCode != 200) {
-                    [self.logger error:@"[TikTokRequestHandler] HTTP error status code: %lu", statusCode];
-                    NSString *log_id = @"";
-                    if([dataDictionary isKindOfClass:[NSDictionary class]]) {
-                        log_id = [dataDictionary objectForKey:@"request_id"];
-                    }
-                    NSDictionary *apiErrorMeta = @{
-                        @"ts": networkEndTime,
-                        @"latency": [NSNumber numberWithLongLong:duration],
-                        @"api_type": TTSafeString([self urlType:url]),
-                        @"status_code": @(statusCode),
-                        @"log_id":TTSafeString(log_id)
-                    };
-                    [self reportApiErrWithMeta:apiErrorMeta];
-                    [self reportNetworkReqforPath:[self urlType:url]
-                                         duration:duration
-                                            reqID:log_id
-                                            error:[NSError errorWithDomain:@"com.TikTokBusinessSDK.error"
-                                                                      code:statusCode
-                                                                  userInfo:@{
-                        NSLocalizedDescriptionKey : @"http error",
-                    }]];
-                    [[TikTokAppEventPersistence persistence] handleSentResult:NO events:eventsToBeFlushed];
+            @try {
+                [metrics recordDurationSince:requestStart forHistogram:TikTokPipelineHistogramRequestLatency];
+                // handle basic connectivity issues
+                if(error) {
+                    [metrics incrementCounter:TikTokPipelineCounterRequestFailures by:1];
+                    [self.logger error:@"[TikTokRequestHandler] error in connection: %@", error];
+                    // the server never saw these events, so this isn't a retry of them
+                    [[TikTokAppEventPersistence persistence] handleUnsentEvents:eventsToBeFlushed];
                     return;
                 }
+                NSNumber *networkEndTime = [TikTokAppEventUtility getCurrentTimestampAsNumber];
+                long long duration = [networkEndTime longLongValue] - [networkStartTime longLongValue];
+                id dataDictionary = [TikTokTypeUtility JSONObjectWithData:data options:0 error:nil origin:NSStringFromClass([self class])];
+                // handle HTTP errors
+                if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+                    NSInteger statusCode = [(NSHTTPURLResponse *)response statusCode];
+                    if (statusCode != 200) {
+                        [metrics incrementCounter:TikTokPipelineCounterRequestFailures by:1];
+                        [self.logger error:@"[TikTokRequestHandler] HTTP error status code: %lu", statusCode];
+                        NSString *log_id = @"";
+                        if([dataDictionary isKindOfClass:[NSDictionary class]]) {
+                            log_id = [dataDictionary objectForKey:@"request_id"];
+                        }
+                        NSDictionary *apiErrorMeta = @{
+                            @"ts": networkEndTime,
+                            @"latency": [NSNumber numberWithLongLong:duration],
+                            @"api_type": TTSafeString([self urlType:url]),
+                            @"status_code": @(statusCode),
+                            @"log_id":TTSafeString(log_id)
+                        };
+                        [self reportApiErrWithMeta:apiErrorMeta];
+                        [self reportNetworkReqforPath:[self urlType:url]
+                                             duration:duration
+                                                reqID:log_id
+                                                error:[NSError errorWithDomain:@"com.TikTokBusinessSDK.error"
+                                                                          code:statusCode
+                                                                      userInfo:@{
+                            NSLocalizedDescriptionKey : @"http error",
+                        }]];
+                        [[TikTokAppEventPersistence persistence] handleSentResult:NO events:eventsToBeFlushed];
+                        return;
+                    }
                 
-            }
+                }
             
-            if([dataDictionary isKindOfClass:[NSDictionary class]]) {
-                NSNumber *code = [dataDictionary objectForKey:@"code"];
-                NSString *message = [dataDictionary objectForKey:@"message"];
-                NSString *log_id = @"";
                 if([dataDictionary isKindOfClass:[NSDictionary class]]) {
-                    log_id = [dataDictionary objectForKey:@"request_id"];
-                }
+                    NSNumber *code = [dataDictionary objectForKey:@"code"];
+                    NSString *message = [dataDictionary objectForKey:@"message"];
+                    NSString *log_id = @"";
+                    if([dataDictionary isKindOfClass:[NSDictionary class]]) {
+                        log_id = [dataDictionary objectForKey:@"request_id"];
+                    }
+                
+                    if ([code intValue] != 0) {
+                        [metrics incrementCounter:TikTokPipelineCounterRequestFailures by:1];
+                        NSDictionary *apiErrorMeta = @{
+                            @"ts": networkEndTime,
+                            @"latency": @(duration),
+                            @"api_type": [self urlType:url],
+                            @"status_code": @([code intValue]),
+                            @"log_id": TTSafeString(log_id),
+                            @"message": TTSafeString(message)
+                        };
+                        [self reportApiErrWithMeta:apiErrorMeta];
+                        [self reportNetworkReqforPath:[self urlType:url]
+                                             duration:duration
+                                                reqID:log_id
+                                                error:[NSError errorWithDomain:@"com.TikTokBusinessSDK.error"
+                                                                          code:[code integerValue]
+                                                                      userInfo:@{
+                            NSLocalizedDescriptionKey : TTSafeString(message),
+                        }]];
+                    }
+                    if ([code intValue] == 0) {
+                        [self reportNetworkReqforPath:[self urlType:url]
+                                             duration:duration
+                                                reqID:log_id
+                                                error:nil];
+                        [[TikTokAppEventPersistence persistence] handleSentResult:YES events:eventsToBeFlushed];
+                    } else if([code intValue] == 40000) {
+                        // code == 40000 indicates error from API call
+                        // meaning all events have unhashed values or deprecated field is used
+                        // we do not persist events in the scenario
+                        [self.logger error:@"[TikTokRequestHandler] data error: %@, message: %@", code, message];
+                        [[TikTokAppEventPersistence persistence] handleSentResult:YES events:eventsToBeFlushed];
+                    } else { // code != 0 indicates error from API call
+                        [self.logger error:@"[TikTokRequestHandler] code error: %@, message: %@", code, message];
+                        [[TikTokAppEventPersistence persistence] handleSentResult:NO events:eventsToBeFlushed];
+                        return;
+                    }
                 
-                if ([code intValue] != 0) {
-                    NSDictionary *apiErrorMeta = @{
-                        @"ts": networkEndTime,
-                        @"latency": @(duration),
-                        @"api_type": [self urlType:url],
-                        @"status_code": @([code intValue]),
-                        @"log_id": TTSafeString(log_id),
-                        @"message": TTSafeString(message)
-                    };
-                    [self reportApiErrWithMeta:apiErrorMeta];
-                    [self reportNetworkReqforPath:[self urlType:url]
-                                         duration:duration
-                                            reqID:log_id
-                                            error:[NSError errorWithDomain:@"com.TikTokBusinessSDK.error"
-                                                                      code:[code integerValue]
-                                                                  userInfo:@{
-                        NSLocalizedDescriptionKey : TTSafeString(message),
-                    }]];
                 }
-                if ([code intValue] == 0) {
-                    [self reportNetworkReqforPath:[self urlType:url]
-                                         duration:duration
-                                            reqID:log_id
-                                            error:nil];
-                    [[TikTokAppEventPersistence persistence] handleSentResult:YES events:eventsToBeFlushed];
-                } else if([code intValue] == 40000) {
-                    // code == 40000 indicates error from API call
-                    // meaning all events have unhashed values or deprecated field is used
-                    // we do not persist events in the scenario
-                    [self.logger error:@"[TikTokRequestHandler] data error: %@, message: %@", code, message];
-                    [[TikTokAppEventPersistence persistence] handleSentResult:YES events:eventsToBeFlushed];
-                } else { // code != 0 indicates error from API call
-                    [self.logger error:@"[TikTokRequestHandler] code error: %@, message: %@", code, message];
-                    [[TikTokAppEventPersistence persistence] handleSentResult:NO events:eventsToBeFlushed];
-                    return;
+            
+                NSString *requestResponse = [[NSString alloc] initWithData:data encoding:NSASCIIStringEncoding];
+                [self.logger info:@"[TikTokRequestHandler] Request response: %@", requestResponse];
+            } @finally {
+                if (completion) {
+                    completion();
                 }
-                
             }
-            
-            NSString *requestResponse = [[NSString alloc] initWithData:data encoding:NSASCIIStringEncoding];
-            [self.logger info:@"[TikTokRequestHandler] Request response: %@", requestResponse];
         }] resume];
+    } else if (completion) {
+        completion();
     }
 }
 
 - (void)sendMonitorRequest:(NSArray *)eventsToBeFlushed
-              withConfig:(TikTokConfig *)config {
-    TikTokDeviceInfo *deviceInfo = [TikTokDeviceInfo deviceInfo];
-    // APP Info
-    NSDictionary *app = [self getAPPWithDeviceInfo:deviceInfo config:config];
-
-    // Device Info
-    NSDictionary *device = [self getDeviceInfo:deviceInfo withConfig:config isMonitor:YES];
+              withConfig:(TikTokConfig *)config
+{
+    [self sendMonitorRequest:eventsToBeFlushed withConfig:config completion:nil];
+}
 
-    // Library Info
-    NSDictionary *library = [self getLibraryWithConfig:config];
+- (void)sendMonitorRequest:(NSArray *)eventsToBeFlushed
+              withConfig:(TikTokConfig *)config
+              completion:(dispatch_block_t)completion
+{
+    // APP, Device and Library Info
+    TikTokRequestContext *requestContext = [self requestContextWithConfig:config isMonitor:YES];
     
     // format events into object[]
     NSMutableArray *monitorBatch = [[NSMutableArray alloc] init];
     for (TikTokAppEvent* event in eventsToBeFlushed) {
-        [self.logger verbose:@"Event is of type: %@", event.type];
+        TTLogVerbose(self.logger, @"Event is of type: %@", event.type);
         if([event.type isEqualToString:@"monitor"]) {
             
-            NSMutableDictionary *tempAppDict = [app mutableCopy];
-            NSString *appNamespace = [tempAppDict objectForKey:@"namespace"];
-            [tempAppDict removeObjectForKey:@"namespace"];
-            [TikTokTypeUtility dictionary:tempAppDict setObject:appNamespace forKey:@"app_namespace"];
-            [TikTokTypeUtility dictionary:tempAppDict setObject:config.tiktokAppId forKey:@"tiktok_app_id"];
-            [TikTokTypeUtility dictionary:tempAppDict setObject:event.anonymousID forKey:@"anonymous_id"];
-            
             NSDictionary *tempMonitorDict = @{
                 @"type": [event.properties objectForKey:@"monitor_type"] == nil ? @"metric" : [event.properties objectForKey:@"monitor_type"],
                 @"name": [event.properties objectForKey:@"monitor_name"] == nil ? @"" : [event.properties objectForKey:@"monitor_name"],
@@ -584,9 +672,9 @@ withCompletionHandler:(void (^)(NSDictionary *businessSDKConfig, NSError *error)
             
             NSMutableDictionary *monitorDict = @{
                 @"monitor": tempMonitorDict,
-                @"app": tempAppDict.copy,
-                @"library": library,
-                @"device": device,
+                @"app": [requestContext appWithAnonymousID:event.anonymousID],
+                @"library": requestContext.library,
+                @"device": requestContext.device,
                 @"timestamp":TTSafeString(event.timestamp),
                 @"log_extra": @{}
             }.mutableCopy;
@@ -600,7 +688,7 @@ withCompletionHandler:(void (^)(NSDictionary *businessSDKConfig, NSError *error)
     }
     
     if(monitorBatch.count > 0){
-        [self.logger verbose:@"MonitorBatchCount count was greater than 0!"];
+        TTLogVerbose(self.logger, @"MonitorBatchCount count was greater than 0!");
         // API version compatibility b/w 1.0 and 2.0
         NSDictionary *tempParametersDict = @{
             @"batch": monitorBatch,
@@ -640,7 +728,7 @@ withCompletionHandler:(void (^)(NSDictionary *businessSDKConfig, NSError *error)
         NSString *signature = [TikTokCypher hmacSHA256WithSecret:token content:paramDataJSONString];
         
 
-        [self.logger verbose:@"[TikTokRequestHandler] MonitorDataJSON: %@", paramDataJSONString];
+        TTLogVerbose(self.logger, @"[TikTokRequestHandler] MonitorDataJSON: %@", paramDataJSONString);
         
         NSMutableURLRequest *request = [[NSMutableURLRequest alloc] init];
         
@@ -659,48 +747,55 @@ withCompletionHandler:(void (^)(NSDictionary *businessSDKConfig, NSError *error)
         tt_weakify(self)
         [[self.session dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
             tt_strongify(self)
-            // handle basic connectivity issues
-            if(error) {
-                [self.logger error:@"[TikTokRequestHandler] error in connection: %@", error];
-                [[TikTokMonitorEventPersistence persistence] handleSentResult:NO events:eventsToBeFlushed];
-                return;
-            }
-            
-            // handle HTTP errors
-            if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
-                NSInteger statusCode = [(NSHTTPURLResponse *)response statusCode];
-                if (statusCode != 200) {
-                    [self.logger error:@"[TikTokRequestHandler] HTTP error status code: %lu", statusCode];
-                    [[TikTokMonitorEventPersistence persistence] handleSentResult:NO events:eventsToBeFlushed];
+            @try {
+                // handle basic connectivity issues
+                if(error) {
+                    [self.logger error:@"[TikTokRequestHandler] error in connection: %@", error];
+                    [[TikTokMonitorEventPersistence persistence] handleUnsentEvents:eventsToBeFlushed];
                     return;
                 }
-            }
-            id dataDictionary = [TikTokTypeUtility JSONObjectWithData:data options:0 error:nil origin:NSStringFromClass([self class])];
             
-            if([dataDictionary isKindOfClass:[NSDictionary class]]) {
-                NSNumber *code = [dataDictionary objectForKey:@"code"];
-                NSString *message = [dataDictionary objectForKey:@"message"];
+                // handle HTTP errors
+                if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+                    NSInteger statusCode = [(NSHTTPURLResponse *)response statusCode];
+                    if (statusCode != 200) {
+                        [self.logger error:@"[TikTokRequestHandler] HTTP error status code: %lu", statusCode];
+                        [[TikTokMonitorEventPersistence persistence] handleSentResult:NO events:eventsToBeFlushed];
+                        return;
+                    }
+                }
+                id dataDictionary = [TikTokTypeUtility JSONObjectWithData:data options:0 error:nil origin:NSStringFromClass([self class])];
+            
+                if([dataDictionary isKindOfClass:[NSDictionary class]]) {
+                    NSNumber *code = [dataDictionary objectForKey:@"code"];
+                    NSString *message = [dataDictionary objectForKey:@"message"];
                 
-                if ([code intValue] == 0) {
-                    [[TikTokMonitorEventPersistence persistence] handleSentResult:YES events:eventsToBeFlushed];
+                    if ([code intValue] == 0) {
+                        [[TikTokMonitorEventPersistence persistence] handleSentResult:YES events:eventsToBeFlushed];
                     
-                } else if([code intValue] == 40000) {
-                    // code == 40000 indicates error from API call
-                    // meaning all events have unhashed values or deprecated field is used
-                    // we do not persist events in the scenario
-                    [self.logger error:@"[TikTokRequestHandler] data error: %@, message: %@", code, message];
-                    [[TikTokMonitorEventPersistence persistence] handleSentResult:YES events:eventsToBeFlushed];
-                } else { // code != 0 indicates error from API call
-                    [self.logger error:@"[TikTokRequestHandler] code error: %@, message: %@", code, message];
-                    [[TikTokMonitorEventPersistence persistence] handleSentResult:NO events:eventsToBeFlushed];
-                    return;
-                }
+                    } else if([code intValue] == 40000) {
+                        // code == 40000 indicates error from API call
+                        // meaning all events have unhashed values or deprecated field is used
+                        // we do not persist events in the scenario
+                        [self.logger error:@"[TikTokRequestHandler] data error: %@, message: %@", code, message];
+                        [[TikTokMonitorEventPersistence persistence] handleSentResult:YES events:eventsToBeFlushed];
+                    } else { // code != 0 indicates error from API call
+                        [self.logger error:@"[TikTokRequestHandler] code error: %@, message: %@", code, message];
+                        [[TikTokMonitorEventPersistence persistence] handleSentResult:NO events:eventsToBeFlushed];
+                        return;
+                    }
                 
-            }
+                }
             
-            NSString *requestResponse = [[NSString alloc] initWithData:data encoding:NSASCIIStringEncoding];
-            [self.logger verbose:@"[TikTokRequestHandler] Request response from monitor: %@", requestResponse];
+                TTLogVerbose(self.logger, @"[TikTokRequestHandler] Request response from monitor: %@", [[NSString alloc] initWithData:data encoding:NSASCIIStringEncoding]);
+            } @finally {
+                if (completion) {
+                    completion();
+                }
+            }
         }] resume];
+    } else if (completion) {
+        completion();
     }
 }
 
@@ -742,8 +837,7 @@ withCompletionHandler:(void (^)(NSDictionary *businessSDKConfig, NSError *error)
     
     NSData *paramData = [TikTokTypeUtility dataWithJSONObject:parametersDict options:NSJSONWritingPrettyPrinted error:nil origin:NSStringFromClass([self class])];
     NSString *postLength = [NSString stringWithFormat:@"%lu", [paramData length]];
-    NSString *paramDataJSONString = [[NSString alloc] initWithData:paramData encoding:NSUTF8StringEncoding];
-    [self.logger verbose:@"[TikTokRequestHandler] FetchDeferredDeeplinkString: %@", paramDataJSONString];
+    TTLogVerbose(self.logger, @"[TikTokRequestHandler] FetchDeferredDeeplinkString: %@", [[NSString alloc] initWithData:paramData encoding:NSUTF8StringEncoding]);
     
     NSMutableURLRequest *request = [[NSMutableURLRequest alloc] init];
     
@@ -829,14 +923,45 @@ withCompletionHandler:(void (^)(NSDictionary *businessSDKConfig, NSError *error)
                 [self reportNetworkReqforPath:[self urlType:url] duration:duration reqID:log_id error:nil];
             }
         }
-        NSString *requestResponse = [[NSString alloc] initWithData:data encoding:NSASCIIStringEncoding];
-        [self.logger verbose:@"[TikTokRequestHandler] Request response from ddl: %@", requestResponse];
+        TTLogVerbose(self.logger, @"[TikTokRequestHandler] Request response from ddl: %@", [[NSString alloc] initWithData:data encoding:NSASCIIStringEncoding]);
     }] resume];
     
 }
 
 // MARK: - Utils
 
+- (TikTokRequestContext *)requestContextWithConfig:(TikTokConfig *)config
+                                         isMonitor:(BOOL)isMonitor
+{
+    TikTokRequestContextCache *cache = [TikTokRequestContextCache sharedCache];
+    TikTokRequestContext *requestContext = [cache contextForConfig:config isMonitor:isMonitor];
+    if (requestContext) {
+        return requestContext;
+    }
+    
+    // read the version first, so an invalidation during the build discards the result
+    NSUInteger version = cache.version;
+    TikTokDeviceInfo *deviceInfo = [TikTokDeviceInfo deviceInfo];
+    NSDictionary *app = [self getAPPWithDeviceInfo:deviceInfo config:config];
+    if (isMonitor) {
+        NSMutableDictionary *tempAppDict = [app mutableCopy];
+        NSString *appNamespace = [tempAppDict objectForKey:@"namespace"];
+        [tempAppDict removeObjectForKey:@"namespace"];
+        [TikTokTypeUtility dictionary:tempAppDict setObject:appNamespace forKey:@"app_namespace"];
+        [TikTokTypeUtility dictionary:tempAppDict setObject:config.tiktokAppId forKey:@"tiktok_app_id"];
+        app = tempAppDict.copy;
+    }
+    requestContext = [[TikTokRequestContext alloc] initWithVersion:version
+                                                               app:app
+                                                            device:[self getDeviceInfo:deviceInfo withConfig:config isMonitor:isMonitor]
+                                                           library:[self getLibraryWithConfig:config]
+                                                         userAgent:[self getUserAgentWithDeviceInfo:deviceInfo]
+                                                            locale:TTSafeString(deviceInfo.localeInfo)
+                                                                ip:TTSafeString(deviceInfo.ipInfo)];
+    [cache storeContext:requestContext forConfig:config isMonitor:isMonitor];
+    return requestContext;
+}
+
 - (NSDictionary *)paramDictForConfig:(TikTokConfig *)config {
     TikTokDeviceInfo *deviceInfo = [TikTokDeviceInfo deviceInfo];
     // APP Info
@@ -987,25 +1112,12 @@ withCompletionHandler:(void (^)(NSDictionary *businessSDKConfig, NSError *error)
 }
 
 - (void)reportNetworkReqforPath:(NSString *)path duration:(long long)duration reqID:(NSString *)reqID error:(NSError *)error {
-    NSMutableDictionary *meta = @{
-        @"duration": @(duration),
-        @"result": @(error!=nil?1:0),
-        @"path": TTSafeString(path)
-    }.mutableCopy;
-    if (error) {
-        [meta setValue:@(error.code) forKey:@"err_code"];
-        [meta setValue:TTSafeString(error.localizedDescription) forKey:@"err_msg"];
-    }
-    if (TTCheckValidString(reqID)) {
-        [meta setValue:TTSafeString(reqID) forKey:@"req_id"];
-    }
-    NSDictionary *apiErrorProperties = @{
-        @"monitor_type": @"metric",
-        @"monitor_name": @"network_req",
-        @"meta": meta
-    };
-    TikTokAppEvent *monitorApiErrorEvent = [[TikTokAppEvent alloc] initWithEventName:@"MonitorEvent" withProperties:apiErrorProperties withType:@"monitor"];
-    [[TikTokBusiness getEventLogger] addEvent:monitorApiErrorEvent];
+    // Folded into the aggregated monitor event of the current window. Failed requests
+    // still report their request id through the api_err monitor event.
+    [[TikTokMonitorAggregator sharedAggregator] recordMetric:@"network_req"
+                                                         key:TTSafeString(path)
+                                                       value:duration
+                                                   errorCode:error ? @(error.code) : nil];
 }
 
 - (void)reportGzipErrorCode:(NSInteger)code path:(NSString *)path {
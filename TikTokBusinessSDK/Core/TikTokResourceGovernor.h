@@ -0,0 +1,77 @@
+//
+//  TikTokResourceGovernor.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "TTSDKCrashAppMemory.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, TikTokMemoryMode) {
+    TikTokMemoryModeNormal = 0,
+    /// Memory pressure is at warn or urgent, or the level is at urgent
+    TikTokMemoryModeElevated,
+    /// Memory level or pressure is at critical or the app is about to be terminated
+    TikTokMemoryModeCritical,
+};
+
+/// Current memory of the app, or nil if it can't be read
+typedef TTSDKCrashAppMemory * _Nullable (^TikTokMemoryProvider)(void);
+
+/// Called on the governor's queue with the mode memory has just risen to
+typedef void (^TikTokMemoryPressureHandler)(TikTokMemoryMode mode);
+
+/**
+ * @brief Keeps the SDK's footprint down while the app is short of memory.
+ *
+ *        Follows the memory level and pressure reported by TTSDKCrashAppMemoryTracker.
+ *        Each time they rise, the registered handlers run, e.g. to drop caches or spill
+ *        buffered data to disk, and while they are up flushes read and send fewer events
+ *        at a time and monitor uploads wait. Every mode change and every action taken
+ *        is recorded as a "memory_mode" or "memory_action" metric.
+ */
+@interface TikTokResourceGovernor : NSObject
+
++ (instancetype)sharedGovernor;
+
+/**
+ * @param memoryProvider Read instead of the memory tracker, e.g. to simulate pressure
+ *        in tests. Nil to follow the tracker.
+ */
+- (instancetype)initWithMemoryProvider:(nullable TikTokMemoryProvider)memoryProvider NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (atomic, assign, readonly) TikTokMemoryMode mode;
+
+/**
+ * @brief Run handler each time memory rises to a higher mode.
+ *
+ * @param action Names the action in the "memory_action" metric, e.g. "shrink_product_cache"
+ */
+- (void)addPressureHandler:(TikTokMemoryPressureHandler)handler forAction:(NSString *)action;
+
+/// Start following the memory tracker. Does nothing with a memory provider.
+- (void)start;
+
+- (void)stop;
+
+/// Read memory now and apply the mode it's in before returning.
+- (void)evaluate;
+
+/// Events to send per request in place of batchSize in the current mode, at least 1
+- (NSUInteger)batchSizeForSize:(NSUInteger)batchSize;
+
+/// Most events a flush reads from disk at once in the current mode, or 0 for no limit
+- (NSUInteger)retrievalLimit;
+
+/// Whether monitor events should stay on disk instead of being uploaded now
+- (BOOL)shouldDeferMonitorUploads;
+
+@end
+
+NS_ASSUME_NONNULL_END
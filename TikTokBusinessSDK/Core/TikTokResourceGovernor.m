@@ -0,0 +1,200 @@
+//
+//  TikTokResourceGovernor.m
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokResourceGovernor.h"
+#import "TTSDKCrashAppMemoryTracker.h"
+#import "TikTokMonitorAggregator.h"
+#import "TikTokFactory.h"
+#import "TikTokLogger.h"
+#import "TikTokTypeUtility.h"
+
+// Events held in memory by one flush while memory is short. The rest stay on disk for
+// the next flush.
+static const NSUInteger kElevatedRetrievalLimit = 200;
+static const NSUInteger kCriticalRetrievalLimit = 50;
+
+static TikTokMemoryMode TikTokMemoryModeForMemory(TTSDKCrashAppMemory *memory)
+{
+    if (memory == nil) {
+        return TikTokMemoryModeNormal;
+    }
+    if (memory.pressure >= TTSDKCrashAppMemoryStateCritical || memory.level >= TTSDKCrashAppMemoryStateCritical) {
+        return TikTokMemoryModeCritical;
+    }
+    // The level is already warn at a quarter of the limit, too early to hold back work
+    if (memory.pressure >= TTSDKCrashAppMemoryStateWarn || memory.level >= TTSDKCrashAppMemoryStateUrgent) {
+        return TikTokMemoryModeElevated;
+    }
+    return TikTokMemoryModeNormal;
+}
+
+static NSString *TikTokMemoryModeName(TikTokMemoryMode mode)
+{
+    switch (mode) {
+        case TikTokMemoryModeElevated:
+            return @"elevated";
+        case TikTokMemoryModeCritical:
+            return @"critical";
+        default:
+            return @"normal";
+    }
+}
+
+@interface TikTokPressureAction : NSObject
+
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, copy) TikTokMemoryPressureHandler handler;
+
+@end
+
+@implementation TikTokPressureAction
+@end
+
+@interface TikTokResourceGovernor () <TTSDKCrashAppMemoryTrackerDelegate>
+
+@property (nonatomic, copy, nullable) TikTokMemoryProvider memoryProvider;
+@property (nonatomic, strong, nullable) TTSDKCrashAppMemoryTracker *tracker;
+@property (nonatomic, strong) dispatch_queue_t queue;
+// Only touched on queue
+@property (nonatomic, strong) NSMutableArray<TikTokPressureAction *> *actions;
+@property (atomic, assign, readwrite) TikTokMemoryMode mode;
+
+@end
+
+@implementation TikTokResourceGovernor
+
++ (instancetype)sharedGovernor
+{
+    static TikTokResourceGovernor *governor;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        governor = [[TikTokResourceGovernor alloc] initWithMemoryProvider:nil];
+    });
+    return governor;
+}
+
+- (instancetype)initWithMemoryProvider:(TikTokMemoryProvider)memoryProvider
+{
+    self = [super init];
+    if (self) {
+        _memoryProvider = [memoryProvider copy];
+        _queue = dispatch_queue_create("com.TikTokBusiness.resourceGovernor", DISPATCH_QUEUE_SERIAL);
+        _actions = [NSMutableArray array];
+        if (memoryProvider == nil) {
+            _tracker = [[TTSDKCrashAppMemoryTracker alloc] init];
+        }
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [_tracker stop];
+}
+
+- (void)addPressureHandler:(TikTokMemoryPressureHandler)handler forAction:(NSString *)action
+{
+    if (!handler || !TTCheckValidString(action)) {
+        return;
+    }
+    TikTokPressureAction *pressureAction = [TikTokPressureAction new];
+    pressureAction.name = action;
+    pressureAction.handler = handler;
+    dispatch_async(self.queue, ^{
+        [self.actions addObject:pressureAction];
+    });
+}
+
+- (void)start
+{
+    self.tracker.delegate = self;
+    [self.tracker start];
+    [self evaluate];
+}
+
+- (void)stop
+{
+    [self.tracker stop];
+    self.tracker.delegate = nil;
+}
+
+- (void)evaluate
+{
+    TTSDKCrashAppMemory *memory = self.memoryProvider ? self.memoryProvider() : self.tracker.currentAppMemory;
+    dispatch_sync(self.queue, ^{
+        [self applyMode:TikTokMemoryModeForMemory(memory)];
+    });
+}
+
+- (void)appMemoryTracker:(TTSDKCrashAppMemoryTracker *)tracker
+                  memory:(TTSDKCrashAppMemory *)memory
+                 changed:(TTSDKCrashAppMemoryTrackerChangeType)changes
+{
+    if (!(changes & (TTSDKCrashAppMemoryTrackerChangeTypeLevel | TTSDKCrashAppMemoryTrackerChangeTypePressure))) {
+        return;
+    }
+    TikTokMemoryMode mode = TikTokMemoryModeForMemory(memory);
+    dispatch_async(self.queue, ^{
+        [self applyMode:mode];
+    });
+}
+
+// Runs on queue
+- (void)applyMode:(TikTokMemoryMode)mode
+{
+    TikTokMemoryMode previousMode = self.mode;
+    if (mode == previousMode) {
+        return;
+    }
+    self.mode = mode;
+    TikTokMonitorAggregator *aggregator = [TikTokMonitorAggregator sharedAggregator];
+    [aggregator recordMetric:@"memory_mode" key:TikTokMemoryModeName(mode) value:mode errorCode:nil];
+    [[TikTokFactory getLogger] info:@"[TikTokResourceGovernor] Memory mode changed from %@ to %@", TikTokMemoryModeName(previousMode), TikTokMemoryModeName(mode)];
+    if (mode < previousMode) {
+        return;
+    }
+    for (TikTokPressureAction *action in self.actions) {
+        @try {
+            action.handler(mode);
+            [aggregator recordMetric:@"memory_action" key:action.name value:mode errorCode:nil];
+        } @catch (NSException *exception) {
+            [[TikTokFactory getLogger] error:@"[TikTokResourceGovernor] %@ failed: %@", action.name, exception];
+        }
+    }
+}
+
+- (NSUInteger)batchSizeForSize:(NSUInteger)batchSize
+{
+    switch (self.mode) {
+        case TikTokMemoryModeElevated:
+            return MAX(batchSize / 2, 1);
+        case TikTokMemoryModeCritical:
+            return MAX(batchSize / 4, 1);
+        default:
+            return batchSize;
+    }
+}
+
+- (NSUInteger)retrievalLimit
+{
+    switch (self.mode) {
+        case TikTokMemoryModeElevated:
+            return kElevatedRetrievalLimit;
+        case TikTokMemoryModeCritical:
+            return kCriticalRetrievalLimit;
+        default:
+            return 0;
+    }
+}
+
+- (BOOL)shouldDeferMonitorUploads
+{
+    return self.mode >= TikTokMemoryModeElevated;
+}
+
+@end
@@ -9,6 +9,7 @@
 #import <Foundation/Foundation.h>
 #import "TikTokSKAdNetworkRule.h"
 #import "TikTokSKAdNetworkWindow.h"
+#import "TikTokSKAdNetworkRuleIndex.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -17,6 +18,8 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, readonly, copy) NSArray<TikTokSKAdNetworkWindow *> *conversionValueWindows;
 @property (nonatomic, readonly, copy) NSDictionary *configDict;
 @property (nonatomic, strong) NSString *currency;
+/// conversionValueWindows compiled by configWithDict:, nil until a config has been set
+@property (atomic, readonly, strong, nullable) TikTokSKAdNetworkRuleIndex *ruleIndex;
 
 + (TikTokSKAdNetworkConversionConfiguration *)sharedInstance;
 - (void)configWithDict:(NSDictionary *)dict;
@@ -10,6 +10,12 @@
 #import "TikTokTypeUtility.h"
 #import "TikTokSKAdNetworkRuleEvent.h"
 
+@interface TikTokSKAdNetworkConversionConfiguration ()
+
+@property (atomic, readwrite, strong, nullable) TikTokSKAdNetworkRuleIndex *ruleIndex;
+
+@end
+
 @implementation TikTokSKAdNetworkConversionConfiguration
 
 + (TikTokSKAdNetworkConversionConfiguration *)sharedInstance
@@ -40,6 +46,7 @@
                     }
                 }
                 _conversionValueWindows = windows.copy;
+                self.ruleIndex = [[TikTokSKAdNetworkRuleIndex alloc] initWithWindows:_conversionValueWindows];
             }
         }
     } @catch(NSException *exception) {
@@ -21,6 +21,12 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (BOOL)isMatched;
 
+/**
+ * @brief Flag the funnel event at index as matched or not, keeping the funnel bits in sync
+ * @return Whether the whole funnel is matched afterwards
+ */
+- (BOOL)markFunnelEventAtIndex:(NSUInteger)index matched:(BOOL)matched;
+
 @end
 
 NS_ASSUME_NONNULL_END
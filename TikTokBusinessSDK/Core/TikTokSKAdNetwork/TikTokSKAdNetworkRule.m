@@ -10,6 +10,15 @@
 #import "TikTokTypeUtility.h"
 #import "TikTokSKAdNetworkRuleEvent.h"
 
+// Funnels longer than this are checked event by event
+static const NSUInteger kMaxFunnelBits = 64;
+
+@interface TikTokSKAdNetworkRule ()
+
+@property (nonatomic, assign) uint64_t matchedFunnelBits;
+
+@end
+
 @implementation TikTokSKAdNetworkRule
 
 - (instancetype)initWithDict:(NSDictionary *)dict
@@ -33,7 +42,24 @@
     return self;
 }
 
+- (void)setEventFunnel:(NSArray *)eventFunnel {
+    _eventFunnel = [eventFunnel copy];
+    uint64_t bits = 0;
+    for (NSUInteger i = 0; i < MIN(_eventFunnel.count, kMaxFunnelBits); i++) {
+        TikTokSKAdNetworkRuleEvent *event = [_eventFunnel objectAtIndex:i];
+        if (event.isMatched) {
+            bits |= (1ULL << i);
+        }
+    }
+    _matchedFunnelBits = bits;
+}
+
 - (BOOL)isMatched {
+    NSUInteger count = self.eventFunnel.count;
+    if (count <= kMaxFunnelBits) {
+        uint64_t allBits = count == kMaxFunnelBits ? UINT64_MAX : ((1ULL << count) - 1);
+        return self.matchedFunnelBits == allBits;
+    }
     BOOL isMatched = YES;
     for (TikTokSKAdNetworkRuleEvent *event in self.eventFunnel) {
         isMatched = isMatched && event.isMatched;
@@ -41,4 +67,20 @@
     return isMatched;
 }
 
+- (BOOL)markFunnelEventAtIndex:(NSUInteger)index matched:(BOOL)matched {
+    if (index >= self.eventFunnel.count) {
+        return [self isMatched];
+    }
+    TikTokSKAdNetworkRuleEvent *event = [self.eventFunnel objectAtIndex:index];
+    event.isMatched = matched;
+    if (index < kMaxFunnelBits) {
+        if (matched) {
+            self.matchedFunnelBits |= (1ULL << index);
+        } else {
+            self.matchedFunnelBits &= ~(1ULL << index);
+        }
+    }
+    return [self isMatched];
+}
+
 @end
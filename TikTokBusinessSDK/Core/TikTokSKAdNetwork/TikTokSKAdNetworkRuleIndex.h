@@ -0,0 +1,51 @@
+//
+//  TikTokSKAdNetworkRuleIndex.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "TikTokSKAdNetworkWindow.h"
+#import "TikTokSKAdNetworkRule.h"
+#import "TikTokSKAdNetworkRuleEvent.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief One funnel event of a rule that an event name can move
+ */
+@interface TikTokSKAdNetworkRuleTarget : NSObject
+
+@property (nonatomic, strong, readonly) TikTokSKAdNetworkRule *rule;
+@property (nonatomic, strong, readonly) TikTokSKAdNetworkRuleEvent *ruleEvent;
+@property (nonatomic, assign, readonly) NSUInteger funnelIndex;
+@property (nonatomic, assign, readonly) BOOL isFine;
+@property (nonatomic, assign, readonly) double minRevenue;
+@property (nonatomic, assign, readonly) double maxRevenue;
+
+@end
+
+/**
+ * @brief Conversion windows compiled into a lookup from postback index and event name
+ * to the rule funnel events that name touches. Targets keep the window's rule order,
+ * fine rules first, so matching through the index behaves like walking the window.
+ */
+@interface TikTokSKAdNetworkRuleIndex : NSObject
+
+- (instancetype)initWithWindows:(NSArray<TikTokSKAdNetworkWindow *> *)windows;
+
+/**
+ * @return The targets of eventName in the first window with postbackIndex, nil if none
+ */
+- (nullable NSArray<TikTokSKAdNetworkRuleTarget *> *)targetsForEvent:(NSString *)eventName inWindow:(NSInteger)postbackIndex;
+
+/**
+ * @return Whether any window has a rule on eventName
+ */
+- (BOOL)containsEvent:(NSString *)eventName;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,97 @@
+//
+//  TikTokSKAdNetworkRuleIndex.m
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokSKAdNetworkRuleIndex.h"
+#import "TikTokTypeUtility.h"
+
+@interface TikTokSKAdNetworkRuleTarget ()
+
+@property (nonatomic, strong, readwrite) TikTokSKAdNetworkRule *rule;
+@property (nonatomic, strong, readwrite) TikTokSKAdNetworkRuleEvent *ruleEvent;
+@property (nonatomic, assign, readwrite) NSUInteger funnelIndex;
+@property (nonatomic, assign, readwrite) BOOL isFine;
+@property (nonatomic, assign, readwrite) double minRevenue;
+@property (nonatomic, assign, readwrite) double maxRevenue;
+
+@end
+
+@implementation TikTokSKAdNetworkRuleTarget
+
+@end
+
+@interface TikTokSKAdNetworkRuleIndex ()
+
+// postback index -> event name -> targets
+@property (nonatomic, copy) NSDictionary<NSNumber *, NSDictionary<NSString *, NSArray<TikTokSKAdNetworkRuleTarget *> *> *> *windowTargets;
+@property (nonatomic, copy) NSSet<NSString *> *eventNames;
+
+@end
+
+@implementation TikTokSKAdNetworkRuleIndex
+
+- (instancetype)initWithWindows:(NSArray<TikTokSKAdNetworkWindow *> *)windows
+{
+    self = [super init];
+    if (self) {
+        NSMutableDictionary *windowTargets = [NSMutableDictionary dictionary];
+        NSMutableSet *eventNames = [NSMutableSet set];
+        for (TikTokSKAdNetworkWindow *window in windows) {
+            NSNumber *postbackIndex = @(window.postbackIndex);
+            if ([windowTargets objectForKey:postbackIndex]) {
+                continue;
+            }
+            NSMutableDictionary<NSString *, NSMutableArray *> *targets = [NSMutableDictionary dictionary];
+            [self addRules:window.fineValueRules isFine:YES toTargets:targets];
+            [self addRules:window.coarseValueRules isFine:NO toTargets:targets];
+            [eventNames addObjectsFromArray:targets.allKeys];
+            [windowTargets setObject:targets.copy forKey:postbackIndex];
+        }
+        _windowTargets = windowTargets.copy;
+        _eventNames = eventNames.copy;
+    }
+    return self;
+}
+
+- (void)addRules:(NSArray<TikTokSKAdNetworkRule *> *)rules isFine:(BOOL)isFine toTargets:(NSMutableDictionary<NSString *, NSMutableArray *> *)targets
+{
+    for (TikTokSKAdNetworkRule *rule in rules) {
+        [rule.eventFunnel enumerateObjectsUsingBlock:^(TikTokSKAdNetworkRuleEvent *ruleEvent, NSUInteger idx, BOOL *stop) {
+            if (!TTCheckValidString(ruleEvent.eventName)) {
+                return;
+            }
+            TikTokSKAdNetworkRuleTarget *target = [[TikTokSKAdNetworkRuleTarget alloc] init];
+            target.rule = rule;
+            target.ruleEvent = ruleEvent;
+            target.funnelIndex = idx;
+            target.isFine = isFine;
+            target.minRevenue = [ruleEvent.minRevenue doubleValue];
+            target.maxRevenue = [ruleEvent.maxRevenue doubleValue];
+            NSMutableArray *eventTargets = [targets objectForKey:ruleEvent.eventName];
+            if (!eventTargets) {
+                eventTargets = [NSMutableArray array];
+                [targets setObject:eventTargets forKey:ruleEvent.eventName];
+            }
+            [eventTargets addObject:target];
+        }];
+    }
+}
+
+- (NSArray<TikTokSKAdNetworkRuleTarget *> *)targetsForEvent:(NSString *)eventName inWindow:(NSInteger)postbackIndex
+{
+    if (!TTCheckValidString(eventName)) {
+        return nil;
+    }
+    return [[self.windowTargets objectForKey:@(postbackIndex)] objectForKey:eventName];
+}
+
+- (BOOL)containsEvent:(NSString *)eventName
+{
+    return TTCheckValidString(eventName) && [self.eventNames containsObject:eventName];
+}
+
+@end
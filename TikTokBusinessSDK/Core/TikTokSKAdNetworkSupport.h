@@ -23,6 +23,12 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)updateConversionValue:(NSInteger)conversionValue;
 - (void)matchEventToSKANConfig:(NSString *)eventName withValue:(nullable NSString *)value currency:(nullable NSString *)currency;
 - (void)matchPersistedSKANEventsInWindow:(TikTokSKAdNetworkWindow *)window;
+/* Accumulated values and the latest fine/coarse values are kept in memory and written
+ * to the key-value store a few seconds after they change, or when the app enters background.
+*/
+- (NSNumber *)accumulatedValueForEvent:(NSString *)eventName;
+- (void)resetConversionValues;
+- (void)persistConversionState;
 - (NSInteger)getConversionWindowForTimestamp:(long long)timeStamp;
 //- (BOOL)canClearCachedEvents;
 
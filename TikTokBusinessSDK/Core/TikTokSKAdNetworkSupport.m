@@ -11,6 +11,7 @@
 #import "TikTokBusinessSDKMacros.h"
 #import <StoreKit/SKAdNetwork.h>
 #import "TikTokLogger.h"
+#import "TikTokLogger+private.h"
 #import "TikTokFactory.h"
 #import "TikTokTypeUtility.h"
 #import "TikTokBusiness.h"
@@ -20,10 +21,15 @@
 #import "TikTokCurrencyUtility.h"
 #import "TikTokBaseEventPersistence.h"
 #import "TikTokSKANEventPersistence.h"
+#import "TikTokKeyValueStore.h"
+#import <UIKit/UIKit.h>
+#import <pthread.h>
 
 static const long long firstWindowEnds = 172800000;
 static const long long secondWindowEnds = 604800000;
 static const long long thirdWindowEnds = 3024000000;
+// Seconds accumulated values may stay in memory only before being written to the key-value store
+static const NSTimeInterval TTSKANPersistenceDelay = 5;
 
 @interface TikTokSKAdNetworkSupport()
 
@@ -31,11 +37,21 @@ static const long long thirdWindowEnds = 3024000000;
 @property (nonatomic, assign, readwrite) SEL skAdNetworkRegisterAppForAdNetworkAttribution;
 @property (nonatomic, assign, readwrite) SEL skAdNetworkUpdateConversionValue;
 @property (nonatomic, strong) TikTokLogger *logger;
+@property (nonatomic, strong) NSNumberFormatter *formatter;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *accumulatedValues;
+@property (nonatomic, strong, nullable) NSNumber *latestFineValue;
+@property (nonatomic, copy, nullable) NSString *latestCoarseValue;
+@property (nonatomic, assign) BOOL conversionStateDirty;
+@property (nonatomic, assign) BOOL persistenceScheduled;
+@property (nonatomic, strong) dispatch_queue_t persistenceQueue;
 
 @end
 
 
 @implementation TikTokSKAdNetworkSupport
+{
+    pthread_mutex_t _mutex;
+}
 
 + (TikTokSKAdNetworkSupport *)sharedInstance
 {
@@ -56,10 +72,35 @@ static const long long thirdWindowEnds = 3024000000;
         self.skAdNetworkRegisterAppForAdNetworkAttribution = NSSelectorFromString(@"registerAppForAdNetworkAttribution");
         self.skAdNetworkUpdateConversionValue = NSSelectorFromString(@"updateConversionValue:");
         self.logger = [TikTokFactory getLogger];
+        self.formatter = [[NSNumberFormatter alloc] init];
+        self.formatter.numberStyle = NSNumberFormatterDecimalStyle;
+        self.persistenceQueue = dispatch_queue_create("com.TikTokBusiness.TikTokSKAdNetworkSupport", DISPATCH_QUEUE_SERIAL);
+        pthread_mutex_init(&_mutex, NULL);
+        [self loadConversionState];
+        NSNotificationCenter *defaultCenter = [NSNotificationCenter defaultCenter];
+        [defaultCenter addObserver:self selector:@selector(applicationDidEnterBackground:) name:UIApplicationDidEnterBackgroundNotification object:nil];
+        [defaultCenter addObserver:self selector:@selector(applicationDidEnterBackground:) name:UIApplicationWillTerminateNotification object:nil];
     }
     return self;
 }
 
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    pthread_mutex_destroy(&_mutex);
+}
+
+- (void)loadConversionState
+{
+    TikTokKeyValueStore *defaults = [TikTokKeyValueStore sharedStore];
+    id dicObj = [defaults objectForKey:TTAccumulatedSKANValuesKey];
+    self.accumulatedValues = [dicObj isKindOfClass:[NSDictionary class]] ? [(NSDictionary *)dicObj mutableCopy] : [NSMutableDictionary dictionary];
+    id fineValue = [defaults objectForKey:TTLatestFineValueKey];
+    self.latestFineValue = [fineValue respondsToSelector:@selector(integerValue)] ? @([fineValue integerValue]) : nil;
+    id coarseValue = [defaults objectForKey:TTLatestCoarseValueKey];
+    self.latestCoarseValue = TTCheckValidString(coarseValue) ? coarseValue : nil;
+}
+
 - (void)registerAppForAdNetworkAttribution
 {
     if (@available(iOS 14.0, *)) {
@@ -82,109 +123,151 @@ static const long long thirdWindowEnds = 3024000000;
     if (currentWindow == -1) {
         return;
     }
-    NSNumberFormatter *formatter = [[NSNumberFormatter alloc] init];
-    formatter.numberStyle = NSNumberFormatterDecimalStyle;
-    NSNumber *eventValue = [formatter numberFromString:value];
-    // Persist current event
+    TikTokSKAdNetworkConversionConfiguration *configuration = [TikTokSKAdNetworkConversionConfiguration sharedInstance];
+    TikTokSKAdNetworkRuleIndex *ruleIndex = configuration.ruleIndex;
+    pthread_mutex_lock(&_mutex);
+    NSNumber *eventValue = [self.formatter numberFromString:value];
+    pthread_mutex_unlock(&_mutex);
+    // Persist current event, also without a rule on it, so a config update can still match it
     [[TikTokSKANEventPersistence persistence] persistSKANEventWithName:eventName value:eventValue currency:currency];
     
     if (TTCheckValidString(currency)) {
-        eventValue = [[TikTokCurrencyUtility sharedInstance] exchangeAmount:eventValue fromCurrency:currency toCurrency:[TikTokSKAdNetworkConversionConfiguration sharedInstance].currency shouldReport:YES];
+        eventValue = [[TikTokCurrencyUtility sharedInstance] exchangeAmount:eventValue fromCurrency:currency toCurrency:configuration.currency shouldReport:YES];
     }
     
-    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
-    id dicObj = [defaults objectForKey:TTAccumulatedSKANValuesKey];
-    NSMutableDictionary *accumulatedValues = [NSMutableDictionary dictionary];
-    NSNumber *accumulatedValue = nil;
-    if ([dicObj isKindOfClass:[NSDictionary class]]) {
-        accumulatedValues = [(NSDictionary *)dicObj mutableCopy];
-        accumulatedValue = [accumulatedValues objectForKey:eventName];
-    }
+    pthread_mutex_lock(&_mutex);
+    NSNumber *accumulatedValue = [self.accumulatedValues objectForKey:eventName];
     eventValue = [NSNumber numberWithDouble:[accumulatedValue doubleValue] + [eventValue doubleValue]];
-    [TikTokTypeUtility dictionary:accumulatedValues setObject:eventValue forKey:eventName];
-    [defaults setObject:accumulatedValues.copy forKey:TTAccumulatedSKANValuesKey];
-    [defaults synchronize];
+    [TikTokTypeUtility dictionary:self.accumulatedValues setObject:eventValue forKey:eventName];
+    if (ruleIndex && ![ruleIndex containsEvent:eventName]) {
+        // No window has a rule on this event
+        [self scheduleConversionStatePersistence];
+        pthread_mutex_unlock(&_mutex);
+        return;
+    }
     
-    NSArray *windows = [TikTokSKAdNetworkConversionConfiguration sharedInstance].conversionValueWindows;
+    NSInteger fineValue = [self.latestFineValue integerValue];
+    NSString *coarseValue = TTCheckValidString(self.latestCoarseValue) ? self.latestCoarseValue : @"low";
+    BOOL shouldLock = NO;
+    BOOL shouldUpdateFine = NO;
+    BOOL shouldUpdateCoarse = NO;
+    double amount = [eventValue doubleValue];
+    TikTokSKAdNetworkRule *updatedRule = nil;
+    for (TikTokSKAdNetworkRuleTarget *target in [ruleIndex targetsForEvent:eventName inWindow:currentWindow]) {
+        if (target.rule == updatedRule) {
+            continue;
+        }
+        BOOL valueMatched = (amount > target.minRevenue) || (target.minRevenue == 0 && target.maxRevenue == 0);
+        BOOL ruleMatched = [target.rule markFunnelEventAtIndex:target.funnelIndex matched:valueMatched];
+        if (!ruleMatched) {
+            continue;
+        }
+        if (target.isFine && !shouldUpdateFine) {
+            fineValue = target.rule.fineConversionValue;
+            self.latestFineValue = @(fineValue);
+            shouldUpdateFine = YES;
+            updatedRule = target.rule;
+        } else if (!target.isFine && !shouldUpdateCoarse) {
+            coarseValue = target.rule.coarseConversionValue;
+            self.latestCoarseValue = coarseValue;
+            shouldUpdateCoarse = YES;
+            updatedRule = target.rule;
+        }
+    }
+    [self scheduleConversionStatePersistence];
+    pthread_mutex_unlock(&_mutex);
     
-    for (TikTokSKAdNetworkWindow * window in windows) {
-        if (currentWindow == window.postbackIndex) {
-            NSInteger fineValue = [[defaults objectForKey:TTLatestFineValueKey] integerValue];
-            NSString *coarseValue = [defaults objectForKey:TTLatestCoarseValueKey];
-            if (!TTCheckValidString(coarseValue)) {
-                coarseValue = @"low";
-            }
-            BOOL shouldLock = NO;
-            BOOL shouldUpdateFine = NO;
-            BOOL shouldUpdateCoarse = NO;
-            NSArray *fineRules = window.fineValueRules;
-            for (TikTokSKAdNetworkRule *rule in fineRules) {
-                for (TikTokSKAdNetworkRuleEvent *ruleEvent in rule.eventFunnel) {
-                    if ([eventName isEqualToString:ruleEvent.eventName]) {
-                        BOOL valueMatched = ([eventValue doubleValue] > [ruleEvent.minRevenue doubleValue]) || ([ruleEvent.minRevenue doubleValue] == 0 && [ruleEvent.maxRevenue doubleValue] == 0);
-                        ruleEvent.isMatched = valueMatched;
-                        if ([rule isMatched] && !shouldUpdateFine) {
-                            fineValue = rule.fineConversionValue;
-                            [defaults setObject:@(fineValue) forKey:TTLatestFineValueKey];
-                            [defaults synchronize];
-                            shouldUpdateFine = YES;
-                            break;
-                        }
-                    }
-                }
-            }
-            NSArray *coarseRules = window.coarseValueRules;
-            for (TikTokSKAdNetworkRule *rule in coarseRules) {
-                for (TikTokSKAdNetworkRuleEvent *ruleEvent in rule.eventFunnel) {
-                    if ([eventName isEqualToString:ruleEvent.eventName]) {
-                        BOOL valueMatched = ([eventValue doubleValue] > [ruleEvent.minRevenue doubleValue]) || ([ruleEvent.minRevenue doubleValue] == 0 && [ruleEvent.maxRevenue doubleValue] == 0);
-                        ruleEvent.isMatched = valueMatched;
-                        if ([rule isMatched] && !shouldUpdateCoarse) {
-                            coarseValue = rule.coarseConversionValue;
-                            [defaults setObject:coarseValue forKey:TTLatestCoarseValueKey];
-                            [defaults synchronize];
-                            shouldUpdateCoarse = YES;
-                            break;
-                        }
-                    }
-                }
-            }
-            
-            if (shouldUpdateFine || shouldUpdateCoarse) {
-                [self TTUpdateConversionValue:fineValue coarseValue:coarseValue lockWindow:shouldLock completionHandler:^(NSError *error) {
-                    NSMutableDictionary *skanUpdateCVMeta = @{
-                        @"fine": @(fineValue),
-                        @"coarse": coarseValue,
-                        @"lock_window": @(shouldLock),
-                        @"event_name": eventName,
-                        @"value": eventValue ?: @(0),
-                        @"window": @(currentWindow),
-                    }.mutableCopy;
-                    if (error) {
-                        [skanUpdateCVMeta setValue:@(NO) forKey:@"success"];
-                        [skanUpdateCVMeta setValue:@(error.code) forKey:@"code"];
-                        [skanUpdateCVMeta setValue:error.localizedDescription forKey:@"description"];
-                    } else {
-                        [skanUpdateCVMeta setValue:@(YES) forKey:@"success"];
-                    }
-                    NSDictionary *monitorSkanUpdateCVProperties = @{
-                        @"monitor_type": @"metric",
-                        @"monitor_name": @"skan_update_cv",
-                        @"meta": skanUpdateCVMeta.copy
-                    };
-                    TikTokAppEvent *skanUpdateCVEvent = [[TikTokAppEvent alloc] initWithEventName:@"MonitorEvent" withProperties:monitorSkanUpdateCVProperties withType:@"monitor"];
-                    [[TikTokBusiness getEventLogger] addEvent:skanUpdateCVEvent];
-                }];
+    if (shouldUpdateFine || shouldUpdateCoarse) {
+        [self TTUpdateConversionValue:fineValue coarseValue:coarseValue lockWindow:shouldLock completionHandler:^(NSError *error) {
+            NSMutableDictionary *skanUpdateCVMeta = @{
+                @"fine": @(fineValue),
+                @"coarse": coarseValue,
+                @"lock_window": @(shouldLock),
+                @"event_name": eventName,
+                @"value": eventValue ?: @(0),
+                @"window": @(currentWindow),
+            }.mutableCopy;
+            if (error) {
+                [skanUpdateCVMeta setValue:@(NO) forKey:@"success"];
+                [skanUpdateCVMeta setValue:@(error.code) forKey:@"code"];
+                [skanUpdateCVMeta setValue:error.localizedDescription forKey:@"description"];
+            } else {
+                [skanUpdateCVMeta setValue:@(YES) forKey:@"success"];
             }
-            break;
+            NSDictionary *monitorSkanUpdateCVProperties = @{
+                @"monitor_type": @"metric",
+                @"monitor_name": @"skan_update_cv",
+                @"meta": skanUpdateCVMeta.copy
+            };
+            TikTokAppEvent *skanUpdateCVEvent = [[TikTokAppEvent alloc] initWithEventName:@"MonitorEvent" withProperties:monitorSkanUpdateCVProperties withType:@"monitor"];
+            [[TikTokBusiness getEventLogger] addEvent:skanUpdateCVEvent];
+        }];
+    }
+}
+
+- (NSNumber *)accumulatedValueForEvent:(NSString *)eventName
+{
+    pthread_mutex_lock(&_mutex);
+    NSNumber *value = [self.accumulatedValues objectForKey:eventName];
+    pthread_mutex_unlock(&_mutex);
+    return value ?: @(0);
+}
+
+- (void)resetConversionValues
+{
+    pthread_mutex_lock(&_mutex);
+    [self.accumulatedValues removeAllObjects];
+    self.latestFineValue = nil;
+    self.latestCoarseValue = nil;
+    self.conversionStateDirty = NO;
+    TikTokKeyValueStore *defaults = [TikTokKeyValueStore sharedStore];
+    [defaults removeObjectForKey:TTLatestFineValueKey];
+    [defaults removeObjectForKey:TTLatestCoarseValueKey];
+    [defaults removeObjectForKey:TTAccumulatedSKANValuesKey];
+    pthread_mutex_unlock(&_mutex);
+}
+
+// Must be called with the mutex held
+- (void)scheduleConversionStatePersistence
+{
+    self.conversionStateDirty = YES;
+    if (self.persistenceScheduled) {
+        return;
+    }
+    self.persistenceScheduled = YES;
+    __weak typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(TTSKANPersistenceDelay * NSEC_PER_SEC)), self.persistenceQueue, ^{
+        [weakSelf persistConversionState];
+    });
+}
+
+- (void)persistConversionState
+{
+    pthread_mutex_lock(&_mutex);
+    self.persistenceScheduled = NO;
+    if (self.conversionStateDirty) {
+        self.conversionStateDirty = NO;
+        TikTokKeyValueStore *defaults = [TikTokKeyValueStore sharedStore];
+        [defaults setObject:self.accumulatedValues.copy forKey:TTAccumulatedSKANValuesKey];
+        if (self.latestFineValue) {
+            [defaults setObject:self.latestFineValue forKey:TTLatestFineValueKey];
+        }
+        if (self.latestCoarseValue) {
+            [defaults setObject:self.latestCoarseValue forKey:TTLatestCoarseValueKey];
         }
     }
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (void)applicationDidEnterBackground:(NSNotification *)notification
+{
+    [self persistConversionState];
 }
 
 - (NSInteger)getConversionWindowForTimestamp:(long long)timeStamp {
     if (@available(iOS 16.1, *)) {
         //Supports SKAN 4.0.
-        NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+        TikTokKeyValueStore *defaults = [TikTokKeyValueStore sharedStore];
         long long firstLaunchTime = [[defaults objectForKey:TTUserDefaultsKey_firstLaunchTime] longLongValue];
         long long timePassed = timeStamp - firstLaunchTime;
         if (timePassed < 0 || timePassed >= thirdWindowEnds) {
@@ -215,7 +298,7 @@ static const long long thirdWindowEnds = 3024000000;
             if (error) {
                 [self.logger error:@"Call to SKAdNetwork's updatePostbackConversionValue:coarseValue:lockWindow:completionHandler: method with conversion value: %d, coarse value: %@, lock window: %d failed\nDescription: %@", conversionValue, coarseValue, lockWindow, error.localizedDescription];
             } else {
-                [self.logger debug:@"Called SKAdNetwork's updatePostbackConversionValue:coarseValue:lockWindow:completionHandler: method with conversion value: %d, coarse value: %@, lock window: %d", conversionValue, coarseValue, lockWindow];
+                TTLogDebug(self.logger, @"Called SKAdNetwork's updatePostbackConversionValue:coarseValue:lockWindow:completionHandler: method with conversion value: %d, coarse value: %@, lock window: %d", conversionValue, coarseValue, lockWindow);
             }
             if (completionHandler) {
                 completionHandler(error);
@@ -227,7 +310,7 @@ static const long long thirdWindowEnds = 3024000000;
             if (error) {
                 [self.logger error:@"Call to updatePostbackConversionValue:completionHandler: method with conversion value: %d failed\nDescription: %@", conversionValue, error.localizedDescription];
             } else {
-                [self.logger debug:@"Called SKAdNetwork's updatePostbackConversionValue:completionHandler: method with conversion value: %d", conversionValue];
+                TTLogDebug(self.logger, @"Called SKAdNetwork's updatePostbackConversionValue:completionHandler: method with conversion value: %d", conversionValue);
             }
             if (completionHandler) {
                 completionHandler(error);
@@ -242,40 +325,35 @@ static const long long thirdWindowEnds = 3024000000;
 }
 
 - (void)matchPersistedSKANEventsInWindow:(TikTokSKAdNetworkWindow *)window {
+    TikTokSKAdNetworkConversionConfiguration *configuration = [TikTokSKAdNetworkConversionConfiguration sharedInstance];
+    TikTokSKAdNetworkRuleIndex *ruleIndex = configuration.ruleIndex;
     NSArray *skanEvents = [[TikTokSKANEventPersistence persistence] retrievePersistedEvents];
-    if (TTCheckValidArray(skanEvents)) {
-        for (NSDictionary *eventDict in skanEvents) {
-            if (TTCheckValidDictionary(eventDict)) {
-                NSString *eventName = [eventDict objectForKey:@"eventName"];
-                NSNumber *value = [eventDict objectForKey:@"value"];
-                NSString *currency = [eventDict objectForKey:@"currency"];
-                if (TTCheckValidString(currency)) {
-                    value = [[TikTokCurrencyUtility sharedInstance] exchangeAmount:value fromCurrency:currency toCurrency:[TikTokSKAdNetworkConversionConfiguration sharedInstance].currency shouldReport:NO];
-                }
-                for (TikTokSKAdNetworkRule *fineRule in window.fineValueRules) {
-                    for (TikTokSKAdNetworkRuleEvent *ruleEvent in fineRule.eventFunnel) {
-                        if (ruleEvent.isMatched) continue;
-                        if ([eventName isEqualToString:ruleEvent.eventName]) {
-                            BOOL valueMatched = ([value doubleValue] > [ruleEvent.minRevenue doubleValue] && [value doubleValue] <= [ruleEvent.maxRevenue doubleValue]) || ([ruleEvent.minRevenue doubleValue] == 0 && [ruleEvent.maxRevenue doubleValue] == 0);
-                            ruleEvent.isMatched = valueMatched;
-                        }
-                    }
-                }
-                for (TikTokSKAdNetworkRule *coarseRule in window.coarseValueRules) {
-                    for (TikTokSKAdNetworkRuleEvent *ruleEvent in coarseRule.eventFunnel) {
-                        if (ruleEvent.isMatched) continue;
-                        if ([eventName isEqualToString:ruleEvent.eventName]) {
-                            BOOL valueMatched = ([value doubleValue] > [ruleEvent.minRevenue doubleValue] && [value doubleValue] <= [ruleEvent.maxRevenue doubleValue]) || ([ruleEvent.minRevenue doubleValue] == 0 && [ruleEvent.maxRevenue doubleValue] == 0);
-                            ruleEvent.isMatched = valueMatched;
-                        }
-                    }
-                }
-            }
+    if (!ruleIndex || !TTCheckValidArray(skanEvents)) {
+        return;
+    }
+    for (NSDictionary *eventDict in skanEvents) {
+        if (!TTCheckValidDictionary(eventDict)) {
+            continue;
         }
+        NSString *eventName = [eventDict objectForKey:@"eventName"];
+        NSArray<TikTokSKAdNetworkRuleTarget *> *targets = [ruleIndex targetsForEvent:eventName inWindow:window.postbackIndex];
+        if (targets.count == 0) {
+            continue;
+        }
+        NSNumber *value = [eventDict objectForKey:@"value"];
+        NSString *currency = [eventDict objectForKey:@"currency"];
+        if (TTCheckValidString(currency)) {
+            value = [[TikTokCurrencyUtility sharedInstance] exchangeAmount:value fromCurrency:currency toCurrency:configuration.currency shouldReport:NO];
+        }
+        double amount = [value doubleValue];
+        pthread_mutex_lock(&_mutex);
+        for (TikTokSKAdNetworkRuleTarget *target in targets) {
+            if (target.ruleEvent.isMatched) continue;
+            BOOL valueMatched = (amount > target.minRevenue && amount <= target.maxRevenue) || (target.minRevenue == 0 && target.maxRevenue == 0);
+            [target.rule markFunnelEventAtIndex:target.funnelIndex matched:valueMatched];
+        }
+        pthread_mutex_unlock(&_mutex);
     }
-    
 }
 
-
-
 @end
@@ -0,0 +1,56 @@
+//
+//  TikTokStartupScheduler.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class TikTokStartupTrace;
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, TikTokStartupPriority) {
+    /// Needed before the first flush, e.g. opening persistence
+    TikTokStartupPriorityHigh = 0,
+    /// Observers and registrations that should be up soon after launch
+    TikTokStartupPriorityDefault,
+    /// Work that can wait until everything else has run, e.g. uploading old reports
+    TikTokStartupPriorityLow,
+    TikTokStartupPriorityCount
+};
+
+/**
+ * @brief Runs the parts of SDK startup that don't have to finish before initializeSdk
+ *        returns, one at a time on a background queue. The highest priority stage
+ *        waiting runs next, so a stage scheduled later can still go ahead of lower ones.
+ *        Each stage is timed as a deferred startup span.
+ */
+@interface TikTokStartupScheduler : NSObject
+
+- (instancetype)initWithTrace:(TikTokStartupTrace *)trace;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * @brief Safe to call from any thread, including from within a stage
+ */
+- (void)scheduleStage:(NSString *)name priority:(TikTokStartupPriority)priority block:(dispatch_block_t)block;
+
+/**
+ * @brief Call block on the scheduler's queue once no stages are waiting or running
+ */
+- (void)notifyWhenIdle:(dispatch_block_t)block;
+
+/**
+ * @brief Call block on queue once every stage scheduled so far under name has run,
+ *        or straight away if none is waiting or running. Blocks added for the same
+ *        stage are submitted in the order they were added.
+ */
+- (void)notifyWhenStageFinished:(NSString *)name queue:(dispatch_queue_t)queue block:(dispatch_block_t)block;
+
+@end
+
+NS_ASSUME_NONNULL_END
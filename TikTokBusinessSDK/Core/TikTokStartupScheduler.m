@@ -0,0 +1,162 @@
+//
+//  TikTokStartupScheduler.m
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokStartupScheduler.h"
+#import "TikTokStartupTrace.h"
+#import <pthread.h>
+
+@interface TikTokStartupStage : NSObject
+
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, copy) dispatch_block_t block;
+@property (nonatomic, strong) dispatch_group_t group;
+
+@end
+
+@implementation TikTokStartupStage
+@end
+
+@interface TikTokStartupScheduler ()
+{
+    pthread_mutex_t _mutex;
+}
+
+@property (nonatomic, strong) TikTokStartupTrace *trace;
+@property (nonatomic, strong) dispatch_queue_t queue;
+// Waiting stages, one FIFO per priority
+@property (nonatomic, strong) NSArray<NSMutableArray<TikTokStartupStage *> *> *stages;
+@property (nonatomic, assign) BOOL draining;
+@property (nonatomic, strong) NSMutableArray<dispatch_block_t> *idleBlocks;
+// Entered by each stage of a name until it has run
+@property (nonatomic, strong) NSMutableDictionary<NSString *, dispatch_group_t> *stageGroups;
+
+@end
+
+@implementation TikTokStartupScheduler
+
+- (instancetype)initWithTrace:(TikTokStartupTrace *)trace
+{
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_mutex, NULL);
+        _trace = trace;
+        dispatch_queue_attr_t attributes = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0);
+        _queue = dispatch_queue_create("com.TikTokBusiness.startup", attributes);
+        NSMutableArray *stages = [NSMutableArray arrayWithCapacity:TikTokStartupPriorityCount];
+        for (NSInteger i = 0; i < TikTokStartupPriorityCount; i++) {
+            [stages addObject:[NSMutableArray array]];
+        }
+        _stages = stages;
+        _idleBlocks = [NSMutableArray array];
+        _stageGroups = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_mutex);
+}
+
+- (void)scheduleStage:(NSString *)name priority:(TikTokStartupPriority)priority block:(dispatch_block_t)block
+{
+    if (!block) {
+        return;
+    }
+    TikTokStartupStage *stage = [[TikTokStartupStage alloc] init];
+    stage.name = name;
+    stage.block = block;
+    NSInteger index = MIN(MAX(priority, TikTokStartupPriorityHigh), TikTokStartupPriorityLow);
+    pthread_mutex_lock(&_mutex);
+    stage.group = [self groupForStage:name];
+    dispatch_group_enter(stage.group);
+    [self.stages[index] addObject:stage];
+    BOOL startDraining = !self.draining;
+    self.draining = YES;
+    pthread_mutex_unlock(&_mutex);
+    if (startDraining) {
+        dispatch_async(self.queue, ^{
+            [self runNextStage];
+        });
+    }
+}
+
+- (void)notifyWhenIdle:(dispatch_block_t)block
+{
+    if (!block) {
+        return;
+    }
+    pthread_mutex_lock(&_mutex);
+    BOOL idle = !self.draining;
+    if (!idle) {
+        [self.idleBlocks addObject:[block copy]];
+    }
+    pthread_mutex_unlock(&_mutex);
+    if (idle) {
+        dispatch_async(self.queue, block);
+    }
+}
+
+- (void)notifyWhenStageFinished:(NSString *)name queue:(dispatch_queue_t)queue block:(dispatch_block_t)block
+{
+    if (!block || !queue) {
+        return;
+    }
+    pthread_mutex_lock(&_mutex);
+    dispatch_group_notify([self groupForStage:name], queue, block);
+    pthread_mutex_unlock(&_mutex);
+}
+
+// Must be called with the mutex held
+- (dispatch_group_t)groupForStage:(NSString *)name
+{
+    NSString *key = name ?: @"";
+    dispatch_group_t group = self.stageGroups[key];
+    if (group == nil) {
+        group = dispatch_group_create();
+        self.stageGroups[key] = group;
+    }
+    return group;
+}
+
+// One stage per queue item, so the highest priority is picked again after each stage
+- (void)runNextStage
+{
+    TikTokStartupStage *stage = nil;
+    NSArray<dispatch_block_t> *idleBlocks = nil;
+    pthread_mutex_lock(&_mutex);
+    for (NSMutableArray<TikTokStartupStage *> *stages in self.stages) {
+        if (stages.count > 0) {
+            stage = stages.firstObject;
+            [stages removeObjectAtIndex:0];
+            break;
+        }
+    }
+    if (stage == nil) {
+        self.draining = NO;
+        idleBlocks = [self.idleBlocks copy];
+        [self.idleBlocks removeAllObjects];
+    }
+    pthread_mutex_unlock(&_mutex);
+
+    if (stage == nil) {
+        for (dispatch_block_t block in idleBlocks) {
+            block();
+        }
+        return;
+    }
+    TikTokStartupSpan *span = [self.trace beginSpan:stage.name deferred:YES];
+    stage.block();
+    [span end];
+    dispatch_group_leave(stage.group);
+    dispatch_async(self.queue, ^{
+        [self runNextStage];
+    });
+}
+
+@end
@@ -0,0 +1,68 @@
+//
+//  TikTokStartupTrace.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief One timed step of SDK startup. Times are in microseconds since the trace began.
+ */
+@interface TikTokStartupSpan : NSObject
+
+@property (nonatomic, copy, readonly) NSString *name;
+@property (nonatomic, assign, readonly) uint64_t startTime;
+/// 0 until the span has ended
+@property (nonatomic, assign, readonly) uint64_t duration;
+/// Whether the span ran on the main thread, i.e. added to the app's launch time
+@property (nonatomic, assign, readonly) BOOL onMainThread;
+@property (nonatomic, assign, readonly, getter=isDeferred) BOOL deferred;
+
+/**
+ * @brief End the span. Later calls are ignored.
+ */
+- (void)end;
+
+@end
+
+/**
+ * @brief Spans timed while the SDK starts up, in the order they began.
+ *
+ *        Each span is also an os_signpost interval in the "Startup" category, for
+ *        Instruments, and is reported through the aggregated monitor metrics as
+ *        "startup_span".
+ */
+@interface TikTokStartupTrace : NSObject
+
++ (instancetype)sharedTrace;
+
+/**
+ * @param deferred Whether the span runs after initializeSdk has returned
+ */
+- (TikTokStartupSpan *)beginSpan:(NSString *)name deferred:(BOOL)deferred;
+
+/**
+ * @brief Time a block run synchronously on the current thread
+ */
+- (void)traceSpan:(NSString *)name block:(NS_NOESCAPE dispatch_block_t)block;
+
+- (NSArray<TikTokStartupSpan *> *)spans;
+
+/**
+ * @brief Total duration of the ended spans that weren't deferred
+ */
+- (uint64_t)synchronousDuration;
+
+/**
+ * @brief Spans keyed by name, each with start_us, duration_us, main_thread and deferred
+ */
+- (NSDictionary<NSString *, NSDictionary *> *)dictionaryRepresentation;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,166 @@
+//
+//  TikTokStartupTrace.m
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokStartupTrace.h"
+#import "TikTokPipelineMetrics+private.h"
+#import "TikTokMonitorAggregator.h"
+#import "TikTokTypeUtility.h"
+#import <os/signpost.h>
+#import <pthread.h>
+#import <stdatomic.h>
+
+// Startup only has a few dozen spans; anything past this is dropped
+static const NSUInteger kMaxStartupSpans = 128;
+
+static os_log_t startupLog(void)
+{
+    static os_log_t log;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        log = os_log_create("com.TikTokBusiness", "Startup");
+    });
+    return log;
+}
+
+@interface TikTokStartupSpan ()
+{
+    atomic_bool _ended;
+    os_signpost_id_t _signpostID;
+}
+
+@property (nonatomic, copy, readwrite) NSString *name;
+@property (nonatomic, assign, readwrite) uint64_t startTime;
+@property (atomic, assign, readwrite) uint64_t duration;
+@property (nonatomic, assign, readwrite) BOOL onMainThread;
+@property (nonatomic, assign, readwrite, getter=isDeferred) BOOL deferred;
+// Clock reading the trace began at
+@property (nonatomic, assign) uint64_t origin;
+
+@end
+
+@implementation TikTokStartupSpan
+
+- (void)begin
+{
+    _signpostID = os_signpost_id_generate(startupLog());
+    os_signpost_interval_begin(startupLog(), _signpostID, "StartupSpan", "%{public}@", self.name);
+}
+
+- (void)end
+{
+    bool expected = false;
+    if (!atomic_compare_exchange_strong(&_ended, &expected, true)) {
+        return;
+    }
+    uint64_t now = TikTokPipelineMetricsNow() - self.origin;
+    // a span that ended within the same microsecond still counts as ended
+    self.duration = MAX(now > self.startTime ? now - self.startTime : 0, 1);
+    os_signpost_interval_end(startupLog(), _signpostID, "StartupSpan", "%{public}@", self.name);
+    [[TikTokMonitorAggregator sharedAggregator] recordMetric:@"startup_span" key:self.name value:self.duration / 1000.0 errorCode:nil];
+}
+
+@end
+
+@interface TikTokStartupTrace ()
+{
+    pthread_mutex_t _mutex;
+}
+
+@property (nonatomic, assign) uint64_t origin;
+@property (nonatomic, strong) NSMutableArray<TikTokStartupSpan *> *recordedSpans;
+
+@end
+
+@implementation TikTokStartupTrace
+
++ (instancetype)sharedTrace
+{
+    static TikTokStartupTrace *trace;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        trace = [[TikTokStartupTrace alloc] init];
+    });
+    return trace;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_mutex, NULL);
+        _origin = TikTokPipelineMetricsNow();
+        _recordedSpans = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_mutex);
+}
+
+- (TikTokStartupSpan *)beginSpan:(NSString *)name deferred:(BOOL)deferred
+{
+    TikTokStartupSpan *span = [[TikTokStartupSpan alloc] init];
+    span.name = TTCheckValidString(name) ? name : @"unnamed";
+    span.origin = self.origin;
+    span.startTime = TikTokPipelineMetricsNow() - self.origin;
+    span.onMainThread = [NSThread isMainThread];
+    span.deferred = deferred;
+    pthread_mutex_lock(&_mutex);
+    if (self.recordedSpans.count < kMaxStartupSpans) {
+        [self.recordedSpans addObject:span];
+    }
+    pthread_mutex_unlock(&_mutex);
+    [span begin];
+    return span;
+}
+
+- (void)traceSpan:(NSString *)name block:(NS_NOESCAPE dispatch_block_t)block
+{
+    TikTokStartupSpan *span = [self beginSpan:name deferred:NO];
+    if (block) {
+        block();
+    }
+    [span end];
+}
+
+- (NSArray<TikTokStartupSpan *> *)spans
+{
+    pthread_mutex_lock(&_mutex);
+    NSArray *spans = [self.recordedSpans copy];
+    pthread_mutex_unlock(&_mutex);
+    return spans;
+}
+
+- (uint64_t)synchronousDuration
+{
+    uint64_t total = 0;
+    for (TikTokStartupSpan *span in [self spans]) {
+        if (!span.isDeferred) {
+            total += span.duration;
+        }
+    }
+    return total;
+}
+
+- (NSDictionary<NSString *, NSDictionary *> *)dictionaryRepresentation
+{
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+    for (TikTokStartupSpan *span in [self spans]) {
+        dictionary[span.name] = @{
+            @"start_us": @(span.startTime),
+            @"duration_us": @(span.duration),
+            @"main_thread": @(span.onMainThread),
+            @"deferred": @(span.isDeferred),
+        };
+    }
+    return dictionary;
+}
+
+@end
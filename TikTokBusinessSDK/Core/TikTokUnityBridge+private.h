@@ -0,0 +1,29 @@
+//
+//  TikTokUnityBridge+private.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokUnityBridge.h"
+
+@class TikTokAppEvent;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief Receives the events parsed from a batch and returns the indexes of those accepted,
+ *        or nil if events aren't being tracked
+ */
+typedef NSIndexSet * _Nullable (^TikTokBridgeEventSink)(NSArray<TikTokAppEvent *> *events);
+
+/**
+ * @brief TikTokUnityTrackEvents with the events handed to sink instead of TikTokBusiness.
+ *        With a nil sink, parsed events are reported as not tracking.
+ */
+FOUNDATION_EXPORT int32_t TikTokUnityTrackEventsWithSink(const char * _Nullable buffer, int32_t length,
+                                                         int32_t * _Nullable statuses, int32_t statusCapacity,
+                                                         TikTokBridgeEventSink _Nullable sink);
+
+NS_ASSUME_NONNULL_END
@@ -16,4 +16,15 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+/**
+ * @brief Track a batch of events in one call, for engine wrappers that would otherwise
+ *        cross the bridge once per event. Callable from Unity with DllImport("__Internal").
+ *
+ * @param buffer Events as UTF-8 JSON lines, see TikTokEventBatchParser.h
+ * @param statuses Receives a TikTokEventBatchStatus per event, up to statusCapacity
+ * @return Number of events in buffer, or -1 if buffer is NULL or length negative
+ */
+FOUNDATION_EXPORT int32_t TikTokUnityTrackEvents(const char * _Nullable buffer, int32_t length,
+                                                 int32_t * _Nullable statuses, int32_t statusCapacity);
+
 NS_ASSUME_NONNULL_END
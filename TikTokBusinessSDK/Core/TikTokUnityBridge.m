@@ -7,6 +7,11 @@
 //
 
 #import "TikTokUnityBridge.h"
+#import "TikTokUnityBridge+private.h"
+#import "TikTokEventBatchParser.h"
+#import "TikTokBusiness.h"
+#import "TikTokBusiness+private.h"
+#import "TikTokAppEvent.h"
 #import <objc/runtime.h>
 
 @implementation TikTokUnityBridge
@@ -46,3 +51,102 @@
 #pragma clang diagnostic pop
 
 @end
+
+typedef struct {
+    int32_t *statuses;
+    size_t capacity;
+    __unsafe_unretained NSMutableArray<TikTokAppEvent *> *events;
+    // Batch index of each entry in events
+    __unsafe_unretained NSMutableIndexSet *indexes;
+} TTBridgeBatch;
+
+static void TTBridgeSetStatus(TTBridgeBatch *batch, size_t index, TikTokEventBatchStatus status)
+{
+    if (batch->statuses && index < batch->capacity) {
+        batch->statuses[index] = (int32_t)status;
+    }
+}
+
+static NSString *TTBridgeString(TikTokEventBatchString string)
+{
+    if (string.length == 0) {
+        return @"";
+    }
+    if (!string.escaped) {
+        return [[NSString alloc] initWithBytes:string.bytes length:string.length encoding:NSUTF8StringEncoding];
+    }
+    // The span with its quotes is a JSON string
+    NSData *data = [NSData dataWithBytesNoCopy:(void *)(string.bytes - 1) length:string.length + 2 freeWhenDone:NO];
+    id value = [NSJSONSerialization JSONObjectWithData:data options:NSJSONReadingAllowFragments error:nil];
+    return [value isKindOfClass:[NSString class]] ? value : nil;
+}
+
+static TikTokAppEvent *TTBridgeAppEvent(const TikTokEventBatchEvent *event)
+{
+    NSString *name = TTBridgeString(event->name);
+    NSString *eventId = TTBridgeString(event->eventId);
+    if (name.length == 0 || eventId == nil) {
+        return nil;
+    }
+    NSDictionary *properties = nil;
+    if (event->properties) {
+        NSData *data = [NSData dataWithBytesNoCopy:(void *)event->properties length:event->propertiesLength freeWhenDone:NO];
+        properties = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+        if (![properties isKindOfClass:[NSDictionary class]]) {
+            return nil;
+        }
+    }
+    return [[TikTokAppEvent alloc] initWithEventName:name withProperties:properties withEventID:eventId];
+}
+
+static void TTBridgeVisitEvent(size_t index, TikTokEventBatchStatus status, const TikTokEventBatchEvent *event, void *context)
+{
+    TTBridgeBatch *batch = context;
+    if (status == TikTokEventBatchStatusAccepted) {
+        @autoreleasepool {
+            TikTokAppEvent *appEvent = TTBridgeAppEvent(event);
+            if (appEvent) {
+                [batch->events addObject:appEvent];
+                [batch->indexes addIndex:index];
+                return;
+            }
+        }
+        status = TikTokEventBatchStatusInvalidField;
+    }
+    TTBridgeSetStatus(batch, index, status);
+}
+
+int32_t TikTokUnityTrackEventsWithSink(const char *buffer, int32_t length, int32_t *statuses, int32_t statusCapacity, TikTokBridgeEventSink sink)
+{
+    if (buffer == NULL || length < 0) {
+        return -1;
+    }
+    NSMutableArray<TikTokAppEvent *> *events = [NSMutableArray array];
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    TTBridgeBatch batch = { statuses, (size_t)MAX(statusCapacity, 0), events, indexes };
+    size_t count = TikTokEventBatchParse(buffer, (size_t)length, TTBridgeVisitEvent, &batch);
+
+    // A sink returning nil isn't tracking after all, e.g. the remote switch is off
+    NSIndexSet *added = (sink && events.count > 0) ? sink(events) : nil;
+    __block NSUInteger position = 0;
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        TikTokEventBatchStatus status = TikTokEventBatchStatusNotTracking;
+        if (added) {
+            status = [added containsIndex:position] ? TikTokEventBatchStatusAccepted : TikTokEventBatchStatusDropped;
+        }
+        TTBridgeSetStatus(&batch, index, status);
+        position++;
+    }];
+    return (int32_t)count;
+}
+
+int32_t TikTokUnityTrackEvents(const char *buffer, int32_t length, int32_t *statuses, int32_t statusCapacity)
+{
+    TikTokBridgeEventSink sink = nil;
+    if ([TikTokBusiness isInitialized] && [TikTokBusiness isTrackingEnabled]) {
+        sink = ^NSIndexSet *(NSArray<TikTokAppEvent *> *events) {
+            return [[TikTokBusiness getInstance] trackEvents:events];
+        };
+    }
+    return TikTokUnityTrackEventsWithSink(buffer, length, statuses, statusCapacity, sink);
+}
@@ -0,0 +1,59 @@
+//
+//  TikTokUploadGate.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class TikTokLaneScheduler;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief Source of network reachability. The SDK's own follows TTSDKReachabilityTTSDKCrash;
+ *        tests pass one they control.
+ */
+@protocol TikTokReachability <NSObject>
+
+/// Set by the gate. Called with the new state each time reachability is reported.
+@property (nonatomic, copy, nullable) void (^reachabilityChanged)(BOOL reachable);
+
+- (void)start;
+
+@end
+
+/**
+ * @brief Called when the network comes back, to upload the events left on disk while it
+ *        was gone. Call done once they are sent; the gate allows no other drain until then.
+ */
+typedef void (^TikTokBacklogDrain)(dispatch_block_t done);
+
+/**
+ * @brief Holds uploads back while the network is unreachable, following TikTokUploadPolicy.
+ *        On reconnect it runs the backlog drain once with a wider in-flight window on
+ *        the lane scheduler, and narrows it again when the drain is done.
+ */
+@interface TikTokUploadGate : NSObject
+
++ (instancetype)sharedGate;
+
+- (instancetype)initWithReachability:(id<TikTokReachability>)reachability
+                           scheduler:(TikTokLaneScheduler *)scheduler NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, copy, nullable) TikTokBacklogDrain backlogDrain;
+
+- (void)start;
+
+/// NO while the network is known to be unreachable
+- (BOOL)shouldUpload;
+
+- (BOOL)isDraining;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,178 @@
+//
+//  TikTokUploadGate.m
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import "TikTokUploadGate.h"
+#import "TikTokUploadPolicy.h"
+#import "TikTokLaneScheduler.h"
+#import "TikTokRequestContext.h"
+#import "TikTokMonitorAggregator.h"
+#import "TikTokFactory.h"
+#import "TikTokLogger.h"
+#import "TikTokBusinessSDKMacros.h"
+#import "TTSDKReachabilityTTSDKCrash.h"
+#import <netinet/in.h>
+
+// Requests in flight while the backlog left by an outage is drained
+#define DRAIN_MAX_CONCURRENT_SENDS 6
+
+// Reachability to the internet in general, from the crash reporter's monitor
+@interface TikTokSystemReachability : NSObject <TikTokReachability>
+
+@property (nonatomic, copy, nullable) void (^reachabilityChanged)(BOOL reachable);
+@property (nonatomic, strong, nullable) TTSDKReachabilityTTSDKCrash *reachability;
+
+@end
+
+@implementation TikTokSystemReachability
+
+- (void)start
+{
+    // The monitor is scheduled on the run loop of the thread creating it
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (self.reachability) {
+            return;
+        }
+        self.reachability = [TTSDKReachabilityTTSDKCrash reachabilityToHost:nil];
+        tt_weakify(self)
+        self.reachability.onReachabilityChanged = ^(TTSDKReachabilityTTSDKCrash *reachability) {
+            tt_strongify(self)
+            if (self.reachabilityChanged) {
+                self.reachabilityChanged(reachability.reachable);
+            }
+        };
+        [self reportInitialReachability];
+    });
+}
+
+// The monitor only reports flags that differ from the 0 it starts with, so launching
+// offline (flags 0) would never be reported. Read the flags once and report that case.
+- (void)reportInitialReachability
+{
+#if TTSDKCRASH_HAS_REACHABILITY
+    tt_weakify(self)
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        struct sockaddr_in address;
+        bzero(&address, sizeof(address));
+        address.sin_len = sizeof(address);
+        address.sin_family = AF_INET;
+        SCNetworkReachabilityRef reachabilityRef = SCNetworkReachabilityCreateWithAddress(kCFAllocatorDefault, (const struct sockaddr *)&address);
+        if (reachabilityRef == NULL) {
+            return;
+        }
+        SCNetworkReachabilityFlags flags = 0;
+        BOOL read = SCNetworkReachabilityGetFlags(reachabilityRef, &flags);
+        CFRelease(reachabilityRef);
+        if (!read || flags != 0) {
+            // anything else differs from 0 and is reported by the monitor
+            return;
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            tt_strongify(self)
+            // unless the monitor has seen other flags since
+            if (self.reachability && self.reachability.flags == 0 && self.reachabilityChanged) {
+                self.reachabilityChanged(NO);
+            }
+        });
+    });
+#endif
+}
+
+@end
+
+@interface TikTokUploadGate ()
+{
+    TikTokUploadPolicy *_policy;
+}
+
+@property (nonatomic, strong) id<TikTokReachability> reachability;
+@property (nonatomic, strong) TikTokLaneScheduler *scheduler;
+
+@end
+
+@implementation TikTokUploadGate
+
++ (instancetype)sharedGate
+{
+    static TikTokUploadGate *gate;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        gate = [[TikTokUploadGate alloc] initWithReachability:[TikTokSystemReachability new]
+                                                    scheduler:[TikTokLaneScheduler sharedScheduler]];
+    });
+    return gate;
+}
+
+- (instancetype)initWithReachability:(id<TikTokReachability>)reachability scheduler:(TikTokLaneScheduler *)scheduler
+{
+    self = [super init];
+    if (self) {
+        _reachability = reachability;
+        _scheduler = scheduler;
+        uint32_t maxInFlight = (uint32_t)scheduler.maxConcurrentSends;
+        _policy = TikTokUploadPolicyCreate(maxInFlight, MAX(maxInFlight, DRAIN_MAX_CONCURRENT_SENDS));
+        tt_weakify(self)
+        _reachability.reachabilityChanged = ^(BOOL reachable) {
+            tt_strongify(self)
+            [self updateReachable:reachable];
+        };
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    TikTokUploadPolicyDestroy(_policy);
+}
+
+- (void)start
+{
+    [self.reachability start];
+}
+
+- (BOOL)shouldUpload
+{
+    return TikTokUploadPolicyShouldUpload(_policy);
+}
+
+- (BOOL)isDraining
+{
+    return TikTokUploadPolicyIsDraining(_policy);
+}
+
+- (void)updateReachable:(BOOL)reachable
+{
+    // called on every change of the network, e.g. from Wi-Fi to cellular, which may change the IP
+    [[TikTokRequestContextCache sharedCache] invalidate];
+    TikTokUploadReachability previous = TikTokUploadPolicyGetReachability(_policy);
+    TikTokUploadReachability current = reachable ? TikTokUploadReachabilityReachable : TikTokUploadReachabilityUnreachable;
+    BOOL startDrain = TikTokUploadPolicySetReachability(_policy, current);
+    if (previous != current) {
+        [[TikTokFactory getLogger] info:@"[TikTokUploadGate] Network %@", reachable ? @"reachable" : @"unreachable"];
+        [[TikTokMonitorAggregator sharedAggregator] recordMetric:@"network_reachability" key:reachable ? @"reachable" : @"unreachable" value:1 errorCode:nil];
+    }
+    if (!startDrain) {
+        return;
+    }
+    TikTokBacklogDrain backlogDrain = self.backlogDrain;
+    if (!backlogDrain) {
+        TikTokUploadPolicyEndDrain(_policy);
+        return;
+    }
+    self.scheduler.maxConcurrentSends = TikTokUploadPolicyMaxInFlight(_policy);
+    tt_weakify(self)
+    backlogDrain(^{
+        tt_strongify(self)
+        if (self == nil || !TikTokUploadPolicyIsDraining(self->_policy)) {
+            return;
+        }
+        TikTokUploadPolicyEndDrain(self->_policy);
+        self.scheduler.maxConcurrentSends = TikTokUploadPolicyMaxInFlight(self->_policy);
+    });
+}
+
+@end
@@ -0,0 +1,107 @@
+//
+//  TikTokUploadPolicy.c
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#include "TikTokUploadPolicy.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+struct TikTokUploadPolicy {
+    pthread_mutex_t mutex;
+    TikTokUploadReachability reachability;
+    bool draining;
+    uint32_t maxInFlight;
+    uint32_t drainMaxInFlight;
+};
+
+TikTokUploadPolicy *TikTokUploadPolicyCreate(uint32_t maxInFlight, uint32_t drainMaxInFlight)
+{
+    TikTokUploadPolicy *policy = calloc(1, sizeof(TikTokUploadPolicy));
+    if (policy == NULL) {
+        return NULL;
+    }
+    pthread_mutex_init(&policy->mutex, NULL);
+    policy->maxInFlight = maxInFlight > 0 ? maxInFlight : 1;
+    policy->drainMaxInFlight = drainMaxInFlight > policy->maxInFlight ? drainMaxInFlight : policy->maxInFlight;
+    return policy;
+}
+
+void TikTokUploadPolicyDestroy(TikTokUploadPolicy *policy)
+{
+    if (policy == NULL) {
+        return;
+    }
+    pthread_mutex_destroy(&policy->mutex);
+    free(policy);
+}
+
+bool TikTokUploadPolicySetReachability(TikTokUploadPolicy *policy, TikTokUploadReachability reachability)
+{
+    if (policy == NULL) {
+        return false;
+    }
+    pthread_mutex_lock(&policy->mutex);
+    // Only a reconnect leaves a backlog behind; the first report at launch doesn't
+    bool reconnected = policy->reachability == TikTokUploadReachabilityUnreachable &&
+                       reachability == TikTokUploadReachabilityReachable;
+    bool startDrain = reconnected && !policy->draining;
+    policy->reachability = reachability;
+    if (startDrain) {
+        policy->draining = true;
+    }
+    pthread_mutex_unlock(&policy->mutex);
+    return startDrain;
+}
+
+TikTokUploadReachability TikTokUploadPolicyGetReachability(TikTokUploadPolicy *policy)
+{
+    if (policy == NULL) {
+        return TikTokUploadReachabilityUnknown;
+    }
+    pthread_mutex_lock(&policy->mutex);
+    TikTokUploadReachability reachability = policy->reachability;
+    pthread_mutex_unlock(&policy->mutex);
+    return reachability;
+}
+
+bool TikTokUploadPolicyShouldUpload(TikTokUploadPolicy *policy)
+{
+    return TikTokUploadPolicyGetReachability(policy) != TikTokUploadReachabilityUnreachable;
+}
+
+bool TikTokUploadPolicyIsDraining(TikTokUploadPolicy *policy)
+{
+    if (policy == NULL) {
+        return false;
+    }
+    pthread_mutex_lock(&policy->mutex);
+    bool draining = policy->draining;
+    pthread_mutex_unlock(&policy->mutex);
+    return draining;
+}
+
+void TikTokUploadPolicyEndDrain(TikTokUploadPolicy *policy)
+{
+    if (policy == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&policy->mutex);
+    policy->draining = false;
+    pthread_mutex_unlock(&policy->mutex);
+}
+
+uint32_t TikTokUploadPolicyMaxInFlight(TikTokUploadPolicy *policy)
+{
+    if (policy == NULL) {
+        return 1;
+    }
+    pthread_mutex_lock(&policy->mutex);
+    uint32_t maxInFlight = policy->draining ? policy->drainMaxInFlight : policy->maxInFlight;
+    pthread_mutex_unlock(&policy->mutex);
+    return maxInFlight;
+}
@@ -0,0 +1,72 @@
+//
+//  TikTokUploadPolicy.h
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#ifndef TikTokUploadPolicy_h
+#define TikTokUploadPolicy_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Decides when event uploads may run, from what is known about connectivity.
+ *
+ * While the network is unreachable, flushes don't read events or send requests. When it
+ * becomes reachable again, one backlog drain is started with a wider in-flight window;
+ * further reconnects while it runs don't start another. Until reachability has been
+ * reported, uploads go ahead as usual.
+ *
+ * Plain C without platform dependencies, so the policy can be tested anywhere.
+ * All functions are thread-safe.
+ */
+typedef struct TikTokUploadPolicy TikTokUploadPolicy;
+
+typedef enum {
+    TikTokUploadReachabilityUnknown = 0,
+    TikTokUploadReachabilityUnreachable,
+    TikTokUploadReachabilityReachable,
+} TikTokUploadReachability;
+
+/**
+ * @param maxInFlight Requests allowed in flight normally, at least 1
+ * @param drainMaxInFlight Requests allowed in flight while draining the backlog, at least maxInFlight
+ * @return NULL if out of memory
+ */
+TikTokUploadPolicy *TikTokUploadPolicyCreate(uint32_t maxInFlight, uint32_t drainMaxInFlight);
+
+void TikTokUploadPolicyDestroy(TikTokUploadPolicy *policy);
+
+/**
+ * Record the current reachability.
+ *
+ * @return true if the network just came back and a backlog drain was started. The caller
+ *         runs it and calls TikTokUploadPolicyEndDrain once it is done.
+ */
+bool TikTokUploadPolicySetReachability(TikTokUploadPolicy *policy, TikTokUploadReachability reachability);
+
+TikTokUploadReachability TikTokUploadPolicyGetReachability(TikTokUploadPolicy *policy);
+
+/** Whether a flush may read events and send them now. */
+bool TikTokUploadPolicyShouldUpload(TikTokUploadPolicy *policy);
+
+/** Whether a backlog drain is running. */
+bool TikTokUploadPolicyIsDraining(TikTokUploadPolicy *policy);
+
+void TikTokUploadPolicyEndDrain(TikTokUploadPolicy *policy);
+
+/** Requests allowed in flight now. */
+uint32_t TikTokUploadPolicyMaxInFlight(TikTokUploadPolicy *policy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TikTokUploadPolicy_h */
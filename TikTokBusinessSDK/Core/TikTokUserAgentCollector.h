@@ -11,16 +11,25 @@
 NS_ASSUME_NONNULL_BEGIN
 
 /**
- * @brief This class is used to fetch User Agent from WebKit
+ * @brief This class is used to fetch User Agent from WebKit. The result is kept in
+ * the key-value store with the OS build and app version it was collected under, and
+ * WebKit is only asked again once either of them changes.
 */
 @interface TikTokUserAgentCollector : NSObject
 
-@property (nonatomic, copy, readwrite) NSString *userAgent;
+@property (atomic, copy, readwrite, nullable) NSString *userAgent;
 
 + (TikTokUserAgentCollector *)singleton;
 
 /**
- * @brief Handles asynchronous Javascript call to the WebKit browser
+ * @brief OS build and app version the cached user agent is valid for
+*/
++ (NSString *)cacheKey;
+
+/**
+ * @brief Calls completion right away with the cached user agent. If it is missing or was
+ * collected under another OS build or app version, schedules one WebKit collection for
+ * when the main run loop goes idle.
 */
 - (void)loadUserAgentWithCompletion:(void(^)(NSString * _Nullable userAgent))completion;
 - (void)setCustomUserAgent:(NSString *)userAgent;
@@ -8,13 +8,25 @@
 #import "TikTokUserAgentCollector.h"
 #import "TikTokBusinessSDKMacros.h"
 #import "TikTokTypeUtility.h"
+#import "TikTokRequestContext.h"
+#import "TikTokKeyValueStore.h"
+#import <sys/sysctl.h>
 
+// User agent stored by earlier SDK versions, without the key it was collected under
 static NSString *TT_UserAgent = @"TT_UserAgent";
+static NSString *TT_UserAgentCache = @"TT_UserAgentCache";
+
+static NSString * const kUserAgentKey = @"ua";
+static NSString * const kCacheKeyKey = @"key";
+static NSString * const kCustomKey = @"custom";
 
 @interface TikTokUserAgentCollector()
 
 @property (nonatomic, strong, readwrite) WKWebView *webView;
 @property (nonatomic, assign) BOOL updatedUa;
+// Whether the WebKit user agent has to be collected again
+@property (atomic, assign) BOOL needsRefresh;
+@property (atomic, assign) BOOL refreshScheduled;
 
 @end
 
@@ -30,11 +42,40 @@ static NSString *TT_UserAgent = @"TT_UserAgent";
     return collector;
 }
 
++ (NSString *)cacheKey
+{
+    static NSString *cacheKey;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        char osBuild[64] = {0};
+        size_t size = sizeof(osBuild) - 1;
+        if (sysctlbyname("kern.osversion", osBuild, &size, NULL, 0) != 0) {
+            osBuild[0] = '\0';
+        }
+        NSDictionary *info = [[NSBundle mainBundle] infoDictionary];
+        cacheKey = [NSString stringWithFormat:@"%s|%@|%@", osBuild,
+                    TTSafeString([info objectForKey:@"CFBundleShortVersionString"]),
+                    TTSafeString([info objectForKey:@"CFBundleVersion"])];
+    });
+    return cacheKey;
+}
+
 - (instancetype)init
 {
     self = [super init];
     if(self) {
-        self.userAgent = [[NSUserDefaults standardUserDefaults] objectForKey:TT_UserAgent];
+        TikTokKeyValueStore *defaults = [TikTokKeyValueStore sharedStore];
+        NSDictionary *cache = [defaults objectForKey:TT_UserAgentCache];
+        if (TTCheckValidDictionary(cache) && TTCheckValidString([cache objectForKey:kUserAgentKey])) {
+            self.userAgent = [cache objectForKey:kUserAgentKey];
+            BOOL isCustom = [[cache objectForKey:kCustomKey] boolValue];
+            self.needsRefresh = !isCustom && ![[cache objectForKey:kCacheKeyKey] isEqual:[[self class] cacheKey]];
+        } else {
+            // serve what an earlier version stored until it is collected again
+            NSString *legacyUserAgent = [defaults objectForKey:TT_UserAgent];
+            self.userAgent = TTCheckValidString(legacyUserAgent) ? legacyUserAgent : nil;
+            self.needsRefresh = YES;
+        }
         self.updatedUa = NO;
     }
     return self;
@@ -42,23 +83,45 @@ static NSString *TT_UserAgent = @"TT_UserAgent";
 
 - (void)loadUserAgentWithCompletion:(void (^)(NSString * _Nullable))completion
 {
-    if (!self.updatedUa && !TTCheckValidString(self.userAgent)) {
-        dispatch_async(dispatch_get_main_queue(), ^{
-            if (!self.webView) {
-                @try {
-                    self.webView = [[WKWebView alloc] initWithFrame:CGRectZero];
-                } @catch (NSException *exception) {
-                } @finally {
-                }
-            }
-            [self _update];
-        });
+    if (!self.updatedUa && self.needsRefresh) {
+        [self scheduleRefresh];
     }
     if (completion) {
         completion(self.userAgent);
     }
 }
 
+// Collects the WebKit user agent once the main run loop is about to go idle. Later
+// callers share the scheduled collection.
+- (void)scheduleRefresh
+{
+    @synchronized (self) {
+        if (self.refreshScheduled) {
+            return;
+        }
+        self.refreshScheduled = YES;
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        CFRunLoopObserverRef observer = CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault, kCFRunLoopBeforeWaiting, false, 0, ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+            if (!self.updatedUa) {
+                if (!self.webView) {
+                    @try {
+                        self.webView = [[WKWebView alloc] initWithFrame:CGRectZero];
+                    } @catch (NSException *exception) {
+                    } @finally {
+                    }
+                }
+                [self _update];
+            }
+            if (!self.webView) {
+                self.refreshScheduled = NO;
+            }
+        });
+        CFRunLoopAddObserver(CFRunLoopGetMain(), observer, kCFRunLoopDefaultMode);
+        CFRelease(observer);
+    });
+}
+
 - (void)_update {
     if (!self.webView) {
         return;
@@ -66,33 +129,41 @@ static NSString *TT_UserAgent = @"TT_UserAgent";
     tt_weakify(self)
     [self.webView evaluateJavaScript:@"navigator.userAgent" completionHandler:^(id _Nullable result, NSError * _Nullable error) {
         tt_strongify(self)
-        if (!TTCheckValidString(result)) {
+        // WebKit is only needed again when the OS or app is updated
+        self.webView = nil;
+        self.refreshScheduled = NO;
+        if (!TTCheckValidString(result) || self.updatedUa) {
             // Don't replace the existing value if fetched nil.
             return;
         }
         self.userAgent = result;
         self.updatedUa = YES;
-        if (TTCheckValidString(result)) {
-            dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-                NSUserDefaults *userDefaults = [NSUserDefaults standardUserDefaults];
-                [userDefaults setObject:result forKey:TT_UserAgent];
-                [userDefaults synchronize];
-            });
-        }
+        self.needsRefresh = NO;
+        [[TikTokRequestContextCache sharedCache] invalidate];
+        [self storeUserAgent:result isCustom:NO];
     }];
 }
 
 - (void)setCustomUserAgent:(NSString *)userAgent
 {
-    _userAgent = userAgent;
+    self.userAgent = userAgent;
     self.updatedUa = YES;
+    [[TikTokRequestContextCache sharedCache] invalidate];
     if (TTCheckValidString(userAgent)) {
-        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-            NSUserDefaults *userDefaults = [NSUserDefaults standardUserDefaults];
-            [userDefaults setObject:userAgent forKey:TT_UserAgent];
-            [userDefaults synchronize];
-        });
+        [self storeUserAgent:userAgent isCustom:YES];
     }
 }
 
+- (void)storeUserAgent:(NSString *)userAgent isCustom:(BOOL)isCustom
+{
+    NSDictionary *cache = @{
+        kUserAgentKey: userAgent,
+        kCacheKeyKey: [[self class] cacheKey],
+        kCustomKey: @(isCustom)
+    };
+    TikTokKeyValueStore *store = [TikTokKeyValueStore sharedStore];
+    [store setObject:cache forKey:TT_UserAgentCache];
+    [store removeObjectForKey:TT_UserAgent];
+}
+
 @end
@@ -10,6 +10,7 @@
 #import "TikTokBusinessSDKMacros.h"
 #import "TikTokEDPConfig.h"
 #import "TikTokTypeUtility.h"
+#import "TikTokKeyValueStore.h"
 
 NSString * const defaultPattern = @"([a-zA-Z0-9._-]+@[a-zA-Z0-9._-]+\\.[a-zA-Z0-9._-]+)|(\\+?0?86-?)?1[3-9]\\d{9}|(\\+\\d{1,2}\\s?)?\\(?\\d{3}\\)?[\\s.-]?\\d{3}[\\s.-]?\\d{4}";
 
@@ -114,7 +115,7 @@ NSString * const defaultPattern = @"([a-zA-Z0-9._-]+@[a-zA-Z0-9._-]+\\.[a-zA-Z0-
 + (NSString *)getSensigPattern {
     NSString *regexPattern = [TikTokEDPConfig sharedConfig].sensig_filtering_regex_list.firstObject;
     NSNumber *regexVersion = [TikTokEDPConfig sharedConfig].sensig_filtering_regex_version;
-    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+    TikTokKeyValueStore *defaults = [TikTokKeyValueStore sharedStore];
     NSString *resultPattern = defaultPattern;
     if (TTCheckValidString(regexPattern)) { // use the pattern from config
         NSNumber *prevRegexVersion = [defaults objectForKey:@"sensig_filtering_regex_version"];
@@ -14,6 +14,7 @@ fileprivate let TTIAP_TRANSACTION_CHECK_DATE_KEY: String = "TTIAP_TRANSACTION_CH
 @available(iOS 15.0, *)
 final actor TTIAPTransactionCacheManager {
     
+    /// Entry of the set earlier versions saved to UserDefaults
     fileprivate struct CacheModel: Codable, Hashable, Equatable {
         let transactionId: String
         let productId: String
@@ -36,41 +37,43 @@ final actor TTIAPTransactionCacheManager {
     
     private(set) var lastCheckedDate: Date {
         didSet {
-            UserDefaults.tiktokBusiness.set(lastCheckedDate, forKey: TTIAP_TRANSACTION_CHECK_DATE_KEY)
+            TTKeyValueStore.setObject(lastCheckedDate, forKey: TTIAP_TRANSACTION_CHECK_DATE_KEY)
         }
     }
     
-    private var cachedTransactions: Set<CacheModel>
+    private let transactionLog: TTIAPTransactionLog
+    
+    private var compactionScheduled = false
     
     init() {
-        let data = UserDefaults.tiktokBusiness.data(forKey: TTIAP_TRANSACTION_CACHE_KEY)
-        if let data, let caches = try? JSONDecoder().decode(Set<CacheModel>.self, from: data) {
-            cachedTransactions = caches
-        } else {
-            cachedTransactions = []
+        let libraryDirectory = FileManager.default.urls(for: .libraryDirectory, in: .userDomainMask)[0]
+        let transactionLog = TTIAPTransactionLog(directory: libraryDirectory.appendingPathComponent("tiktok_iap_transactions", isDirectory: true))
+        // Move the set saved by earlier versions into the log
+        if let data = UserDefaults.tiktokBusiness.data(forKey: TTIAP_TRANSACTION_CACHE_KEY) {
+            if let caches = try? JSONDecoder().decode(Set<CacheModel>.self, from: data) {
+                transactionLog.insert(caches.map { cache in
+                    (TTIAPTransactionLog.Key(transactionId: cache.transactionId, productId: cache.productId, eventName: cache.eventName), cache.date)
+                })
+            }
+            UserDefaults.tiktokBusiness.removeObject(forKey: TTIAP_TRANSACTION_CACHE_KEY)
         }
-        lastCheckedDate = UserDefaults.tiktokBusiness.value(forKey: TTIAP_TRANSACTION_CHECK_DATE_KEY) as? Date ?? Date()
+        self.transactionLog = transactionLog
+        lastCheckedDate = TTKeyValueStore.object(forKey: TTIAP_TRANSACTION_CHECK_DATE_KEY) as? Date ?? Date()
     }
     
-    private func save() {
-        clearExpiredCache()
-        guard
-            cachedTransactions.isEmpty == false,
-            let data = try? JSONEncoder().encode(cachedTransactions)
-        else {
+    private func scheduleCompactionIfNeeded() {
+        guard transactionLog.needsCompaction, compactionScheduled == false else {
             return
         }
-        UserDefaults.tiktokBusiness.set(data, forKey: TTIAP_TRANSACTION_CACHE_KEY)
+        compactionScheduled = true
+        Task(priority: .background) {
+            await self.compact()
+        }
     }
     
-    private func clearExpiredCache() {
-        guard cachedTransactions.isEmpty == false else {
-            return
-        }
-        let earlierDate = Date.init(timeInterval: -60 * 60 * 24 * 30, since: Date())    // 清除 30 天前的数据
-        cachedTransactions = cachedTransactions.filter({ cache in
-            return cache.date >= earlierDate
-        })
+    private func compact() {
+        compactionScheduled = false
+        transactionLog.compact()
     }
 }
 
@@ -87,9 +90,8 @@ extension TTIAPTransactionCacheManager {
             return
         }
         
-        cachedTransactions.insert(.init(transactionId: transactionId, productId: productId, eventName: eventName, date: Date()))
-        
-        save()
+        transactionLog.insert(TTIAPTransactionLog.Key(transactionId: transactionId, productId: productId, eventName: eventName))
+        scheduleCompactionIfNeeded()
     }
     
     func cacheContains(transactionId: String, productId: String, eventName: String) -> Bool {
@@ -97,9 +99,6 @@ extension TTIAPTransactionCacheManager {
             return false
         }
         
-        if cachedTransactions.contains(.init(transactionId: transactionId, productId: productId, eventName: eventName, date: Date())) {
-            return true
-        }
-        return false
+        return transactionLog.contains(TTIAPTransactionLog.Key(transactionId: transactionId, productId: productId, eventName: eventName))
     }
 }
@@ -10,6 +10,8 @@ import StoreKit
 // MARK: TTIAPTransactionEventRouter API for SK2
 @available(iOS 15.0, *)
 extension TTIAPTransactionEventRouter {
+    static let productCache = TTProductCache<Product>.storeKit()
+
     func routeSK2(_ transaction: Transaction?, productId: String, isRestored: Bool = false) async {
         var transactionId: String = ""
         var originalTransactionId: String = ""
@@ -17,7 +19,7 @@ extension TTIAPTransactionEventRouter {
             transactionId = String(transaction.id)
             originalTransactionId = String(transaction.originalID)
         }
-        let product = try? await Product.products(for: [productId]).first
+        let product = await Self.productCache.value(for: productId)
         guard let product else {
             return
         }
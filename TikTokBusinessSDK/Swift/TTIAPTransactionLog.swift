@@ -0,0 +1,250 @@
+//
+//  TTIAPTransactionLog.swift
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+
+import Foundation
+
+fileprivate let secondsPerDay: TimeInterval = 60 * 60 * 24
+
+fileprivate let newline = UInt8(ascii: "\n")
+
+/// Append-only log of reported transactions with an in-memory index.
+///
+/// Each day's transactions are appended to a segment file of their own, one line per
+/// transaction, so an insert writes a single line and a lookup is a hash lookup. Entries
+/// expire together with their segment, which is deleted once all of its day is past the
+/// retention period. Lines left broken by a crash are skipped on load, and `compact()`
+/// rewrites the segments they are in.
+///
+/// Not thread-safe. `TTIAPTransactionCacheManager` owns it.
+@available(iOS 15.0, *)
+final class TTIAPTransactionLog {
+
+    struct Key: Hashable {
+        let transactionId: String
+        let productId: String
+        let eventName: String
+    }
+
+    let directory: URL
+
+    let retention: TimeInterval
+
+    /// Day of the segment each key was appended to
+    private var index: [Key: Int] = [:]
+
+    private var segmentKeys: [Int: [Key]] = [:]
+
+    /// Segments with broken or duplicate lines, for `compact()` to rewrite
+    private var damagedSegments: Set<Int> = []
+
+    private var handle: FileHandle?
+
+    private var handleDay: Int?
+
+    init(directory: URL, retention: TimeInterval = 60 * 60 * 24 * 30, now: Date = Date()) {
+        self.directory = directory
+        self.retention = retention
+        try? FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        load(now: now)
+    }
+
+    deinit {
+        try? handle?.close()
+    }
+
+    var count: Int {
+        return index.count
+    }
+
+    var segmentCount: Int {
+        return segmentKeys.count
+    }
+
+    var needsCompaction: Bool {
+        return damagedSegments.isEmpty == false
+    }
+
+    func contains(_ key: Key) -> Bool {
+        return index[key] != nil
+    }
+
+    /// Returns false if key is already in the log.
+    @discardableResult
+    func insert(_ key: Key, date: Date = Date()) -> Bool {
+        return insert([(key, date)]) == 1
+    }
+
+    /// Appends the keys that aren't in the log yet, one write per segment. Returns how many were added.
+    @discardableResult
+    func insert(_ entries: [(Key, Date)]) -> Int {
+        var lines: [Int: Data] = [:]
+        var added = 0
+        for (key, date) in entries where index[key] == nil {
+            let day = Self.day(of: date)
+            index[key] = day
+            segmentKeys[day, default: []].append(key)
+            added += 1
+            if let line = Self.line(for: key, date: date) {
+                lines[day, default: Data()].append(line)
+            }
+        }
+        for day in lines.keys.sorted() {
+            append(lines[day]!, toSegment: day)
+        }
+        if let newest = lines.keys.max() {
+            expire(now: Date(timeIntervalSince1970: TimeInterval(newest) * secondsPerDay))
+        }
+        return added
+    }
+
+    /// Delete the segments whose whole day is past the retention period.
+    func expire(now: Date = Date()) {
+        let firstKeptDay = Self.day(of: now.addingTimeInterval(-retention))
+        for day in segmentKeys.keys where day < firstKeptDay {
+            removeSegment(day)
+        }
+    }
+
+    /// Rewrite the segments with broken or duplicate lines.
+    func compact() {
+        for day in damagedSegments.sorted() {
+            closeHandle(ifDay: day)
+            let url = segmentURL(day)
+            let lines = (try? Data(contentsOf: url)).map { Self.lines(in: $0) } ?? []
+            var seen: Set<Key> = []
+            var data = Data()
+            for line in lines {
+                if let (key, date) = Self.entry(from: line), index[key] == day, seen.insert(key).inserted,
+                   let rewritten = Self.line(for: key, date: date) {
+                    data.append(rewritten)
+                }
+            }
+            try? data.write(to: url, options: .atomic)
+        }
+        damagedSegments.removeAll()
+    }
+}
+
+// MARK: Private
+@available(iOS 15.0, *)
+extension TTIAPTransactionLog {
+
+    static func day(of date: Date) -> Int {
+        return Int((date.timeIntervalSince1970 / secondsPerDay).rounded(.down))
+    }
+
+    private func segmentURL(_ day: Int) -> URL {
+        return directory.appendingPathComponent("\(day).log")
+    }
+
+    private func load(now: Date) {
+        let names = (try? FileManager.default.contentsOfDirectory(atPath: directory.path)) ?? []
+        let firstKeptDay = Self.day(of: now.addingTimeInterval(-retention))
+        for name in names where name.hasSuffix(".log") {
+            guard let day = Int(name.dropLast(4)) else {
+                continue
+            }
+            let url = segmentURL(day)
+            if day < firstKeptDay {
+                try? FileManager.default.removeItem(at: url)
+                continue
+            }
+            guard let data = try? Data(contentsOf: url) else {
+                continue
+            }
+            var keys: [Key] = []
+            var damaged = data.last.map { $0 != newline } ?? false
+            for line in Self.lines(in: data) {
+                guard let (key, _) = Self.entry(from: line), index[key] == nil else {
+                    damaged = true
+                    continue
+                }
+                index[key] = day
+                keys.append(key)
+            }
+            segmentKeys[day] = keys
+            if damaged {
+                damagedSegments.insert(day)
+            }
+        }
+    }
+
+    private func append(_ data: Data, toSegment day: Int) {
+        if handleDay != day {
+            try? handle?.close()
+            handle = nil
+            handleDay = nil
+            let url = segmentURL(day)
+            if FileManager.default.fileExists(atPath: url.path) == false {
+                FileManager.default.createFile(atPath: url.path, contents: nil)
+            }
+            guard let opened = try? FileHandle(forWritingTo: url) else {
+                return
+            }
+            handle = opened
+            handleDay = day
+            // A line cut off by a crash mustn't run into the first line appended now
+            if let end = try? opened.seekToEnd(), end > 0,
+               let reader = try? FileHandle(forReadingFrom: url) {
+                try? reader.seek(toOffset: end - 1)
+                if let last = try? reader.read(upToCount: 1), last.first != newline {
+                    try? opened.write(contentsOf: Data([newline]))
+                    damagedSegments.insert(day)
+                }
+                try? reader.close()
+            }
+        }
+        do {
+            try handle?.seekToEnd()
+            try handle?.write(contentsOf: data)
+        } catch {
+            closeHandle(ifDay: day)
+        }
+    }
+
+    private func closeHandle(ifDay day: Int) {
+        if handleDay == day {
+            try? handle?.close()
+            handle = nil
+            handleDay = nil
+        }
+    }
+
+    private func removeSegment(_ day: Int) {
+        closeHandle(ifDay: day)
+        for key in segmentKeys[day] ?? [] where index[key] == day {
+            index[key] = nil
+        }
+        segmentKeys[day] = nil
+        damagedSegments.remove(day)
+        try? FileManager.default.removeItem(at: segmentURL(day))
+    }
+
+    // Line format: transactionId \t productId \t eventName \t seconds since 1970 \n
+
+    private static func line(for key: Key, date: Date) -> Data? {
+        let fields = [key.transactionId, key.productId, key.eventName]
+        // Such a key only stays in memory
+        guard fields.allSatisfy({ $0.contains("\t") == false && $0.contains("\n") == false }) else {
+            return nil
+        }
+        return Data((fields.joined(separator: "\t") + "\t\(Int64(date.timeIntervalSince1970))\n").utf8)
+    }
+
+    private static func lines(in data: Data) -> [Data.SubSequence] {
+        return data.split(separator: newline, omittingEmptySubsequences: true)
+    }
+
+    private static func entry(from line: Data.SubSequence) -> (Key, Date)? {
+        let fields = String(decoding: line, as: UTF8.self).split(separator: "\t", omittingEmptySubsequences: false)
+        guard fields.count == 4, let seconds = Int64(fields[3]) else {
+            return nil
+        }
+        let key = Key(transactionId: String(fields[0]), productId: String(fields[1]), eventName: String(fields[2]))
+        return (key, Date(timeIntervalSince1970: TimeInterval(seconds)))
+    }
+}
@@ -0,0 +1,100 @@
+//
+//  TTProductCache.swift
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+
+import StoreKit
+
+/// Products by identifier, kept for `timeToLive` after they are loaded.
+///
+/// A lookup of an identifier that is already being loaded waits for that load, and lookups
+/// made within `batchWindow` of each other are loaded together, so a restore or a burst of
+/// renewals makes one StoreKit round-trip instead of one per transaction. Identifiers that
+/// don't resolve aren't cached.
+@available(iOS 15.0, *)
+actor TTProductCache<Value> {
+
+    typealias Loader = @Sendable (Set<String>) async -> [String: Value]
+
+    private struct Entry {
+        let value: Value
+        let expiry: Date
+    }
+
+    let timeToLive: TimeInterval
+
+    let batchWindow: TimeInterval
+
+    private let loader: Loader
+
+    private var entries: [String: Entry] = [:]
+
+    /// Lookups waiting for each identifier that is pending or being loaded
+    private var waiters: [String: [CheckedContinuation<Value?, Never>]] = [:]
+
+    /// Identifiers for the batch about to be loaded
+    private var pending: Set<String> = []
+
+    init(timeToLive: TimeInterval = 60 * 60, batchWindow: TimeInterval = 0.05, loader: @escaping Loader) {
+        self.timeToLive = timeToLive
+        self.batchWindow = batchWindow
+        self.loader = loader
+    }
+
+    func value(for id: String) async -> Value? {
+        if let entry = entries[id], entry.expiry > Date() {
+            return entry.value
+        }
+        return await withCheckedContinuation { continuation in
+            if waiters[id] != nil {
+                waiters[id]?.append(continuation)
+                return
+            }
+            waiters[id] = [continuation]
+            let batchScheduled = pending.isEmpty == false
+            pending.insert(id)
+            if batchScheduled == false {
+                let window = UInt64(batchWindow * 1_000_000_000)
+                Task {
+                    try? await Task.sleep(nanoseconds: window)
+                    await self.loadPending()
+                }
+            }
+        }
+    }
+
+    func removeAll() {
+        entries.removeAll()
+    }
+
+    private func loadPending() async {
+        let ids = pending
+        pending.removeAll()
+        guard ids.isEmpty == false else {
+            return
+        }
+        let values = await loader(ids)
+        let expiry = Date().addingTimeInterval(timeToLive)
+        for id in ids {
+            let value = values[id]
+            if let value {
+                entries[id] = Entry(value: value, expiry: expiry)
+            }
+            for continuation in waiters.removeValue(forKey: id) ?? [] {
+                continuation.resume(returning: value)
+            }
+        }
+    }
+}
+
+@available(iOS 15.0, *)
+extension TTProductCache where Value == Product {
+    static func storeKit() -> TTProductCache<Product> {
+        return TTProductCache { ids in
+            let products = (try? await Product.products(for: ids)) ?? []
+            return Dictionary(products.map { ($0.id, $0) }, uniquingKeysWith: { first, _ in first })
+        }
+    }
+}
@@ -0,0 +1,71 @@
+//
+//  TTRuntimeBridge.swift
+//  TikTokBusinessSDK
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+
+import StoreKit
+
+/// Swift only sees the SDK's public headers. SDK classes whose headers stay project-level are
+/// reached through the runtime instead, as the Obj-C side does for `TTStoreKitObserver`, with
+/// a protocol declaring the part of their interface Swift uses.
+enum TTRuntimeBridge {
+
+    /// Shared instance of `className`, declared to conform to `proto`, or nil if the class isn't there
+    static func sharedInstance(ofClass className: String, selector selectorName: String, conformingTo proto: Protocol) -> AnyObject? {
+        guard let cls = NSClassFromString(className) as? NSObject.Type else {
+            return nil
+        }
+        let selector = NSSelectorFromString(selectorName)
+        guard cls.responds(to: selector) else {
+            return nil
+        }
+        // The class implements the protocol's methods but can't declare it in its header
+        class_addProtocol(cls, proto)
+        return cls.perform(selector)?.takeUnretainedValue()
+    }
+}
+
+/// The part of `TikTokKeyValueStore` Swift uses
+@objc protocol TTKeyValueStoring: NSObjectProtocol {
+    @objc(objectForKey:)
+    func object(forKey key: String) -> Any?
+
+    @objc(setObject:forKey:)
+    func setObject(_ value: Any?, forKey key: String)
+}
+
+/// `TikTokKeyValueStore.sharedStore`, falling back to the SDK's UserDefaults suite
+/// if the class can't be reached
+enum TTKeyValueStore {
+
+    static let shared: TTKeyValueStoring? = TTRuntimeBridge.sharedInstance(ofClass: "TikTokKeyValueStore", selector: "sharedStore", conformingTo: TTKeyValueStoring.self) as? TTKeyValueStoring
+
+    static func object(forKey key: String) -> Any? {
+        guard let store = shared else {
+            return UserDefaults.tiktokBusiness.object(forKey: key)
+        }
+        return store.object(forKey: key)
+    }
+
+    static func setObject(_ value: Any?, forKey key: String) {
+        guard let store = shared else {
+            UserDefaults.tiktokBusiness.set(value, forKey: key)
+            return
+        }
+        store.setObject(value, forKey: key)
+    }
+}
+
+/// The part of `TikTokProductCache` Swift uses
+@objc protocol TTProductCaching: NSObjectProtocol {
+    @objc(productForIdentifier:completion:)
+    func product(forIdentifier productIdentifier: String, completion: @escaping (SKProduct?) -> Void)
+}
+
+enum TTProductCacheBridge {
+
+    /// `TikTokProductCache.sharedCache`, shared with the Obj-C payment observer
+    static let shared: TTProductCaching? = TTRuntimeBridge.sharedInstance(ofClass: "TikTokProductCache", selector: "sharedCache", conformingTo: TTProductCaching.self) as? TTProductCaching
+}
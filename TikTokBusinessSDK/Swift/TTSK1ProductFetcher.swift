@@ -7,43 +7,23 @@
 
 import StoreKit
 
+/// Resolves SK1 products through `TikTokProductCache`, which the Obj-C payment observer shares.
 @available(iOS 15.0, *)
-final class TTSK1ProductFetcher: NSObject, SKProductsRequestDelegate {
-    private var request: SKProductsRequest?
-    private var continuation: CheckedContinuation<SKProduct?, Never>?
+final class TTSK1ProductFetcher {
+    private let cache: TTProductCaching?
 
-    func product(for productID: String) async -> SKProduct? {
-        await withCheckedContinuation { continuation in
-            self.continuation = continuation
-
-            let request = SKProductsRequest(productIdentifiers: [productID])
-            request.delegate = self
-            self.request = request
-            request.start()
-        }
-    }
-
-    func productsRequest(_ request: SKProductsRequest, didReceive response: SKProductsResponse) {
-        finish(response.products.first)
-    }
-
-    func request(_ request: SKRequest, didFailWithError error: Error) {
-        finish(nil)
+    init(cache: TTProductCaching? = TTProductCacheBridge.shared) {
+        self.cache = cache
     }
 
-    func requestDidFinish(_ request: SKRequest) {
-        finish(nil)
-    }
-
-    private func finish(_ product: SKProduct?) {
-        guard let continuation else {
-            return
+    func product(for productID: String) async -> SKProduct? {
+        guard let cache else {
+            return nil
+        }
+        return await withCheckedContinuation { continuation in
+            cache.product(forIdentifier: productID) { product in
+                continuation.resume(returning: product)
+            }
         }
-
-        self.continuation = nil
-        request?.delegate = nil
-        request = nil
-
-        continuation.resume(returning: product)
     }
 }
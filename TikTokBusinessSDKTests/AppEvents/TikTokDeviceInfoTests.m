@@ -8,6 +8,8 @@
 
 #import <XCTest/XCTest.h>
 #import "TikTokDeviceInfo.h"
+#import "TikTokUserAgentCollector.h"
+#import "TikTokKeyValueStore.h"
 
 @interface TikTokDeviceInfoTests : XCTestCase
 
@@ -34,5 +36,17 @@
     XCTAssertNotNil([deviceInfo fallbackUserAgent]);
 }
 
+- (void)testCachedUserAgentIsServedSynchronously {
+    TikTokKeyValueStore *store = [TikTokKeyValueStore sharedStore];
+    id previousCache = [store objectForKey:@"TT_UserAgentCache"];
+    [store setObject:@{@"ua": @"Cached UA", @"key": [TikTokUserAgentCollector cacheKey], @"custom": @NO} forKey:@"TT_UserAgentCache"];
+    TikTokUserAgentCollector *collector = [[TikTokUserAgentCollector alloc] init];
+    __block NSString *userAgent = nil;
+    [collector loadUserAgentWithCompletion:^(NSString * _Nullable ua) {
+        userAgent = ua;
+    }];
+    XCTAssertEqualObjects(userAgent, @"Cached UA");
+    [store setObject:previousCache forKey:@"TT_UserAgentCache"];
+}
 
 @end
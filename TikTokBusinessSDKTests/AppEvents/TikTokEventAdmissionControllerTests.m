@@ -0,0 +1,122 @@
+//
+//  TikTokEventAdmissionControllerTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TikTokEventAdmissionController.h"
+#import "TikTokAppEvent.h"
+#import "TikTokMonitorAggregator.h"
+
+@interface TikTokEventAdmissionControllerTests : XCTestCase
+
+@property (nonatomic, strong) TikTokEventAdmissionController *controller;
+
+@end
+
+@implementation TikTokEventAdmissionControllerTests
+
+- (void)setUp {
+    [super setUp];
+    self.controller = [[TikTokEventAdmissionController alloc] init];
+}
+
+- (TikTokAppEvent *)eventNamed:(NSString *)name anonymousID:(NSString *)anonymousID {
+    TikTokAppEvent *event = [[TikTokAppEvent alloc] initWithEventName:name];
+    event.anonymousID = anonymousID;
+    return event;
+}
+
+- (void)testDisabledUnlessConfigured {
+    TikTokAppEvent *event = [self eventNamed:@"Search" anonymousID:@"anon"];
+    for (int i = 0; i < 1000; i++) {
+        XCTAssertTrue([self.controller admitEvent:event now:0]);
+    }
+    [self.controller configWithDict:@{@"enable": @NO, @"default_sampling_rate": @0}];
+    XCTAssertTrue([self.controller admitEvent:event now:0]);
+    XCTAssertEqual(self.controller.droppedEventCount, 0);
+}
+
+- (void)testBurstIsAdmittedThenRateLimited {
+    [self.controller configWithDict:@{@"enable": @YES, @"rate_per_second": @2, @"burst": @5}];
+    TikTokAppEvent *event = [self eventNamed:@"Search" anonymousID:@"anon"];
+    for (int i = 0; i < 5; i++) {
+        XCTAssertTrue([self.controller admitEvent:event now:1000]);
+    }
+    XCTAssertFalse([self.controller admitEvent:event now:1000]);
+    XCTAssertEqual(self.controller.droppedEventCount, 1);
+
+    // half a second refills one token
+    XCTAssertTrue([self.controller admitEvent:event now:1000 + 500000]);
+    XCTAssertFalse([self.controller admitEvent:event now:1000 + 500000]);
+}
+
+- (void)testBucketsArePerEventName {
+    [self.controller configWithDict:@{@"enable": @YES, @"burst": @1}];
+    XCTAssertTrue([self.controller admitEvent:[self eventNamed:@"Search" anonymousID:@"anon"] now:0]);
+    XCTAssertFalse([self.controller admitEvent:[self eventNamed:@"Search" anonymousID:@"anon"] now:0]);
+    XCTAssertTrue([self.controller admitEvent:[self eventNamed:@"Login" anonymousID:@"anon"] now:0]);
+}
+
+- (void)testRevenueEventsAreExempt {
+    [self.controller configWithDict:@{@"enable": @YES, @"burst": @1, @"default_sampling_rate": @0}];
+    TikTokAppEvent *purchase = [self eventNamed:@"Purchase" anonymousID:@"anon"];
+    for (int i = 0; i < 10; i++) {
+        XCTAssertTrue([self.controller admitEvent:purchase now:0]);
+    }
+    XCTAssertEqual(self.controller.droppedEventCount, 0);
+}
+
+- (void)testConfiguredExemptions {
+    [self.controller configWithDict:@{@"enable": @YES, @"sampling_rates": @{@"Rate": @0}, @"exempt_events": @[@"Rate"]}];
+    XCTAssertTrue([self.controller admitEvent:[self eventNamed:@"Rate" anonymousID:@"anon"] now:0]);
+}
+
+- (void)testSamplingIsDeterministicPerDevice {
+    [self.controller configWithDict:@{@"enable": @YES, @"sampling_rates": @{@"Search": @0.5}, @"burst": @100000}];
+    NSUInteger admitted = 0;
+    for (int i = 0; i < 1000; i++) {
+        NSString *anonymousID = [NSString stringWithFormat:@"anon-%d", i];
+        BOOL first = [self.controller admitEvent:[self eventNamed:@"Search" anonymousID:anonymousID] now:0];
+        BOOL second = [self.controller admitEvent:[self eventNamed:@"Search" anonymousID:anonymousID] now:0];
+        XCTAssertEqual(first, second);
+        admitted += first ? 1 : 0;
+    }
+    XCTAssertGreaterThan(admitted, 400);
+    XCTAssertLessThan(admitted, 600);
+}
+
+- (void)testZeroSamplingRateDropsEverything {
+    [self.controller configWithDict:@{@"enable": @YES, @"default_sampling_rate": @0}];
+    XCTAssertFalse([self.controller admitEvent:[self eventNamed:@"Search" anonymousID:@"anon"] now:0]);
+    XCTAssertEqual(self.controller.droppedEventCount, 1);
+}
+
+- (void)testDropMetricsFoldEventNamesBeyondBucketLimit {
+    [self.controller configWithDict:@{@"enable": @YES, @"default_sampling_rate": @0}];
+    [[TikTokMonitorAggregator sharedAggregator] takeSummaries];
+    for (int i = 0; i < 300; i++) {
+        NSString *name = [NSString stringWithFormat:@"Custom%d", i];
+        XCTAssertFalse([self.controller admitEvent:[self eventNamed:name anonymousID:@"anon"] now:0]);
+    }
+    NSUInteger named = 0;
+    NSNumber *overflowCount = nil;
+    for (NSDictionary *summary in [[TikTokMonitorAggregator sharedAggregator] takeSummaries]) {
+        if (![summary[@"name"] isEqualToString:@"event_dropped"]) {
+            continue;
+        }
+        if ([summary[@"key"] isEqualToString:@"sampled:_overflow"]) {
+            overflowCount = summary[@"count"];
+        } else {
+            named++;
+        }
+    }
+    XCTAssertEqual(named, 256);
+    XCTAssertEqualObjects(overflowCount, @44);
+    XCTAssertEqual(self.controller.droppedEventCount, 300);
+}
+
+@end
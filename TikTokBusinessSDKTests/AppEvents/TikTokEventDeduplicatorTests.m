@@ -0,0 +1,102 @@
+//
+//  TikTokEventDeduplicatorTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TikTokEventDeduplicator.h"
+#import "TikTokAppEvent.h"
+
+static const NSTimeInterval kWindow = 100;
+
+@interface TikTokEventDeduplicatorTests : XCTestCase
+
+@property (nonatomic, copy) NSString *path;
+
+@end
+
+@implementation TikTokEventDeduplicatorTests
+
+- (void)setUp {
+    [super setUp];
+    self.path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:self.path error:nil];
+    [super tearDown];
+}
+
+- (TikTokEventDeduplicator *)deduplicatorWithCapacity:(NSUInteger)capacity {
+    return [[TikTokEventDeduplicator alloc] initWithPath:self.path window:kWindow falsePositiveRate:0.001 capacity:capacity];
+}
+
+- (void)testSecondInsertIsDuplicate {
+    TikTokEventDeduplicator *deduplicator = [self deduplicatorWithCapacity:1000];
+    XCTAssertFalse([deduplicator checkAndInsertKey:@"Purchase|id:1" now:1000]);
+    XCTAssertTrue([deduplicator checkAndInsertKey:@"Purchase|id:1" now:1001]);
+    XCTAssertFalse([deduplicator checkAndInsertKey:@"Purchase|id:2" now:1001]);
+}
+
+- (void)testContainsDoesNotRemember {
+    TikTokEventDeduplicator *deduplicator = [self deduplicatorWithCapacity:1000];
+    XCTAssertFalse([deduplicator containsKey:@"Search|id:1" now:1000]);
+    XCTAssertFalse([deduplicator containsKey:@"Search|id:1" now:1000]);
+    [deduplicator insertKey:@"Search|id:1" now:1000];
+    XCTAssertTrue([deduplicator containsKey:@"Search|id:1" now:1001]);
+}
+
+- (void)testKeysSurviveReopening {
+    @autoreleasepool {
+        TikTokEventDeduplicator *deduplicator = [self deduplicatorWithCapacity:1000];
+        XCTAssertFalse([deduplicator checkAndInsertKey:@"Purchase|id:1" now:1000]);
+    }
+    TikTokEventDeduplicator *reopened = [self deduplicatorWithCapacity:1000];
+    XCTAssertTrue([reopened checkAndInsertKey:@"Purchase|id:1" now:1010]);
+}
+
+- (void)testOtherParametersResetTheFile {
+    @autoreleasepool {
+        TikTokEventDeduplicator *deduplicator = [self deduplicatorWithCapacity:1000];
+        XCTAssertFalse([deduplicator checkAndInsertKey:@"Purchase|id:1" now:1000]);
+    }
+    TikTokEventDeduplicator *resized = [self deduplicatorWithCapacity:5000];
+    XCTAssertFalse([resized checkAndInsertKey:@"Purchase|id:1" now:1010]);
+}
+
+- (void)testKeysExpireAfterWindow {
+    TikTokEventDeduplicator *deduplicator = [self deduplicatorWithCapacity:1000];
+    XCTAssertFalse([deduplicator checkAndInsertKey:@"Purchase|id:1" now:1000]);
+    // still remembered by the previous generation after one rotation
+    XCTAssertTrue([deduplicator checkAndInsertKey:@"Purchase|id:1" now:1000 + kWindow / 2 + 1]);
+    XCTAssertFalse([deduplicator checkAndInsertKey:@"Purchase|id:2" now:1000 + kWindow * 3]);
+    XCTAssertFalse([deduplicator checkAndInsertKey:@"Purchase|id:1" now:1000 + kWindow * 3]);
+}
+
+- (void)testFalsePositiveRateIsNearTarget {
+    TikTokEventDeduplicator *deduplicator = [self deduplicatorWithCapacity:10000];
+    for (int i = 0; i < 10000; i++) {
+        [deduplicator checkAndInsertKey:[NSString stringWithFormat:@"inserted-%d", i] now:1000];
+    }
+    NSUInteger falsePositives = 0;
+    for (int i = 0; i < 10000; i++) {
+        falsePositives += [deduplicator checkAndInsertKey:[NSString stringWithFormat:@"other-%d", i] now:1000] ? 1 : 0;
+    }
+    XCTAssertLessThan(falsePositives, 50);
+}
+
+- (void)testDeduplicationKey {
+    TikTokAppEvent *event = [[TikTokAppEvent alloc] initWithEventName:@"Purchase"];
+    XCTAssertNil([TikTokEventDeduplicator deduplicationKeyForEvent:event]);
+
+    event.properties = @{@"order": @{@"order_id": @"2000000123"}};
+    XCTAssertEqualObjects([TikTokEventDeduplicator deduplicationKeyForEvent:event], @"Purchase|order:2000000123");
+
+    event.tteventID = @"abc";
+    XCTAssertEqualObjects([TikTokEventDeduplicator deduplicationKeyForEvent:event], @"Purchase|id:abc");
+}
+
+@end
@@ -0,0 +1,247 @@
+//
+//  TikTokEventJournalTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TikTokEventJournal.h"
+#import "TikTokJournalEventStore.h"
+#import "TikTokSQLiteEventStore.h"
+#import "TikTokDatabase.h"
+
+static const size_t kSegmentSize = 4096;
+
+static void collectRecord(const TikTokEventJournalRecord *record, void *context)
+{
+    NSMutableArray *records = (__bridge NSMutableArray *)context;
+    [records addObject:@{
+        @"id": @(record->identifier),
+        @"payload": [[NSString alloc] initWithBytes:record->payload length:record->length encoding:NSUTF8StringEncoding],
+        @"retry": @(record->retryTimes),
+    }];
+}
+
+@interface TikTokEventJournalTests : XCTestCase
+
+@property (nonatomic, copy) NSString *directory;
+
+@end
+
+@implementation TikTokEventJournalTests
+
+- (void)setUp {
+    [super setUp];
+    self.directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:self.directory error:nil];
+    [super tearDown];
+}
+
+- (TikTokEventJournal *)openJournal {
+    TikTokEventJournal *journal = TikTokEventJournalOpen(self.directory.fileSystemRepresentation, kSegmentSize);
+    XCTAssert(journal != NULL);
+    return journal;
+}
+
+- (uint64_t)append:(NSString *)payload toJournal:(TikTokEventJournal *)journal {
+    NSData *data = [payload dataUsingEncoding:NSUTF8StringEncoding];
+    uint64_t identifier = 0;
+    XCTAssertTrue(TikTokEventJournalAppend(journal, 0, 0, 0, data.bytes, (uint32_t)data.length, &identifier));
+    return identifier;
+}
+
+- (NSArray<NSDictionary *> *)takeUnsentFromJournal:(TikTokEventJournal *)journal {
+    NSMutableArray *records = [NSMutableArray array];
+    TikTokEventJournalTakeUnsent(journal, TikTokEventJournalAnyLane, 0, collectRecord, (__bridge void *)records);
+    return records;
+}
+
+- (NSArray<NSString *> *)segmentPaths {
+    NSArray *names = [[[NSFileManager defaultManager] contentsOfDirectoryAtPath:self.directory error:nil] sortedArrayUsingSelector:@selector(compare:)];
+    NSMutableArray *paths = [NSMutableArray array];
+    for (NSString *name in names) {
+        if ([name.pathExtension isEqualToString:@"segment"]) {
+            [paths addObject:[self.directory stringByAppendingPathComponent:name]];
+        }
+    }
+    return paths;
+}
+
+- (void)testEventsSurviveReopening {
+    TikTokEventJournal *journal = [self openJournal];
+    uint64_t first = [self append:@"first" toJournal:journal];
+    [self append:@"second" toJournal:journal];
+    [self append:@"third" toJournal:journal];
+    XCTAssertTrue(TikTokEventJournalAcknowledge(journal, &first, 1));
+    NSArray *sending = [self takeUnsentFromJournal:journal];
+    uint64_t second = [sending[0][@"id"] unsignedLongLongValue];
+    XCTAssertTrue(TikTokEventJournalRelease(journal, &second, 1));
+    TikTokEventJournalClose(journal);
+
+    journal = [self openJournal];
+    NSArray *records = [self takeUnsentFromJournal:journal];
+    XCTAssertEqual(records.count, 2);
+    XCTAssertEqualObjects(records[0][@"payload"], @"second");
+    XCTAssertEqualObjects(records[0][@"retry"], @1);
+    XCTAssertEqualObjects(records[1][@"payload"], @"third");
+    XCTAssertEqualObjects(records[1][@"retry"], @0);
+    XCTAssertEqual([self takeUnsentFromJournal:journal].count, 0);
+    TikTokEventJournalClose(journal);
+}
+
+- (void)testPutBackDoesNotCountRetry {
+    TikTokEventJournal *journal = [self openJournal];
+    uint64_t identifier = [self append:@"offline" toJournal:journal];
+    XCTAssertEqual([self takeUnsentFromJournal:journal].count, 1);
+    TikTokEventJournalPutBack(journal, &identifier, 1);
+    NSArray *records = [self takeUnsentFromJournal:journal];
+    XCTAssertEqual(records.count, 1);
+    XCTAssertEqualObjects(records[0][@"retry"], @0);
+    TikTokEventJournalClose(journal);
+}
+
+- (void)testTornRecordIsCutOff {
+    TikTokEventJournal *journal = [self openJournal];
+    [self append:@"kept" toJournal:journal];
+    [self append:@"torn" toJournal:journal];
+    TikTokEventJournalClose(journal);
+
+    // damage the last record as if the write had been interrupted
+    NSString *path = [self segmentPaths].lastObject;
+    NSMutableData *segment = [NSMutableData dataWithContentsOfFile:path];
+    NSRange range = [segment rangeOfData:[@"torn" dataUsingEncoding:NSUTF8StringEncoding] options:0 range:NSMakeRange(0, segment.length)];
+    XCTAssertNotEqual(range.location, NSNotFound);
+    ((uint8_t *)segment.mutableBytes)[range.location] ^= 0xff;
+    [segment writeToFile:path atomically:NO];
+
+    journal = [self openJournal];
+    XCTAssertEqual(TikTokEventJournalCount(journal, TikTokEventJournalAnyLane), 1);
+    [self append:@"after" toJournal:journal];
+    TikTokEventJournalClose(journal);
+
+    journal = [self openJournal];
+    NSArray *records = [self takeUnsentFromJournal:journal];
+    XCTAssertEqual(records.count, 2);
+    XCTAssertEqualObjects(records[0][@"payload"], @"kept");
+    XCTAssertEqualObjects(records[1][@"payload"], @"after");
+    TikTokEventJournalClose(journal);
+}
+
+- (void)testAcknowledgedSegmentsAreDeleted {
+    TikTokEventJournal *journal = [self openJournal];
+    NSString *payload = [@"" stringByPaddingToLength:500 withString:@"x" startingAtIndex:0];
+    for (int i = 0; i < 40; i++) {
+        [self append:payload toJournal:journal];
+    }
+    XCTAssertGreaterThan(TikTokEventJournalSegmentCount(journal), 1);
+    NSArray *records = [self takeUnsentFromJournal:journal];
+    for (NSDictionary *record in records) {
+        uint64_t identifier = [record[@"id"] unsignedLongLongValue];
+        TikTokEventJournalAcknowledge(journal, &identifier, 1);
+    }
+    XCTAssertEqual(TikTokEventJournalSegmentCount(journal), 1);
+    TikTokEventJournalClose(journal);
+
+    journal = [self openJournal];
+    XCTAssertEqual(TikTokEventJournalCount(journal, TikTokEventJournalAnyLane), 0);
+    TikTokEventJournalClose(journal);
+}
+
+- (void)testInterruptedCollectionDoesNotRestoreEvents {
+    TikTokEventJournal *journal = [self openJournal];
+    NSString *payload = [@"" stringByPaddingToLength:1000 withString:@"x" startingAtIndex:0];
+    uint64_t identifiers[8];
+    for (int i = 0; i < 8; i++) {
+        identifiers[i] = [self append:payload toJournal:journal];
+    }
+    NSString *oldest = [self segmentPaths].firstObject;
+    NSData *oldestSegment = [NSData dataWithContentsOfFile:oldest];
+    TikTokEventJournalAcknowledge(journal, identifiers, 8);
+    TikTokEventJournalClose(journal);
+
+    // the checkpoint moved past the segment, but deleting it didn't happen
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:oldest]);
+    [oldestSegment writeToFile:oldest atomically:NO];
+
+    journal = [self openJournal];
+    XCTAssertEqual(TikTokEventJournalCount(journal, TikTokEventJournalAnyLane), 0);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:oldest]);
+    TikTokEventJournalClose(journal);
+}
+
+- (void)testLiveEventsAreCopiedForwardFromOldSegments {
+    TikTokEventJournal *journal = [self openJournal];
+    NSData *kept = [@"kept" dataUsingEncoding:NSUTF8StringEncoding];
+    TikTokEventJournalAppend(journal, 1, 0, 3, kept.bytes, (uint32_t)kept.length, NULL);
+    NSString *payload = [@"" stringByPaddingToLength:500 withString:@"x" startingAtIndex:0];
+    for (int i = 0; i < 200; i++) {
+        uint64_t identifier = [self append:payload toJournal:journal];
+        TikTokEventJournalAcknowledge(journal, &identifier, 1);
+    }
+    XCTAssertLessThanOrEqual(TikTokEventJournalSegmentCount(journal), 9);
+    TikTokEventJournalClose(journal);
+
+    journal = [self openJournal];
+    NSArray *records = [self takeUnsentFromJournal:journal];
+    XCTAssertEqual(records.count, 1);
+    XCTAssertEqualObjects(records[0][@"payload"], @"kept");
+    XCTAssertEqualObjects(records[0][@"retry"], @3);
+    XCTAssertEqual(TikTokEventJournalCount(journal, 1), 1);
+    TikTokEventJournalClose(journal);
+}
+
+- (void)testStoreRemovesEDPEvents {
+    TikTokJournalEventStore *store = [[TikTokJournalEventStore alloc] initWithDirectory:self.directory segmentSize:kSegmentSize];
+    for (int i = 0; i < 4; i++) {
+        TikTokStoredEvent *event = [[TikTokStoredEvent alloc] init];
+        event.data = [@"event" dataUsingEncoding:NSUTF8StringEncoding];
+        event.isEDPEvent = i % 2 == 0;
+        XCTAssertTrue([store appendEvent:event]);
+    }
+    XCTAssertTrue([store removeEDPEvents]);
+    NSArray<TikTokStoredEvent *> *events = [store takeUnsentEventsInLane:TikTokEventStoreAnyLane limit:0];
+    XCTAssertEqual(events.count, 2);
+    XCTAssertFalse(events.firstObject.isEDPEvent);
+}
+
+#pragma mark - Throughput
+
+- (void)measureStore:(id<TikTokEventStore>)store {
+    NSData *data = [NSMutableData dataWithLength:600];
+    [self measureBlock:^{
+        for (int batch = 0; batch < 20; batch++) {
+            for (int i = 0; i < 50; i++) {
+                TikTokStoredEvent *event = [[TikTokStoredEvent alloc] init];
+                event.data = data;
+                event.timestamp = @"2026-10-19T00:00:00.000Z";
+                [store appendEvent:event];
+            }
+            NSArray<TikTokStoredEvent *> *events = [store takeUnsentEventsInLane:TikTokEventStoreAnyLane limit:0];
+            [store removeEventsWithIdentifiers:[events valueForKey:@"identifier"]];
+        }
+    }];
+}
+
+- (void)testJournalThroughput {
+    TikTokJournalEventStore *store = [[TikTokJournalEventStore alloc] initWithDirectory:self.directory segmentSize:256 * 1024];
+    [self measureStore:store];
+}
+
+- (void)testSQLiteThroughput {
+    NSString *name = [NSString stringWithFormat:@"TikTokEventJournalTests-%@", [[NSUUID UUID] UUIDString]];
+    TikTokDatabase *database = [TikTokDatabase databaseWithName:name];
+    XCTAssertTrue([database openDatabase]);
+    XCTAssertTrue([database createTableWithName:@"benchmark_table" fields:[TikTokSQLiteEventStore tableFields]]);
+    TikTokSQLiteEventStore *store = [[TikTokSQLiteEventStore alloc] initWithDatabase:database tableName:@"benchmark_table"];
+    [self measureStore:store];
+    [database closeDatabase];
+    NSString *documentsDirectory = [NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES) firstObject];
+    [[NSFileManager defaultManager] removeItemAtPath:[documentsDirectory stringByAppendingPathComponent:[name stringByAppendingPathExtension:@"sqlite"]] error:nil];
+}
+
+@end
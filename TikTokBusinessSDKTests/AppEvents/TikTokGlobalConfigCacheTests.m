@@ -0,0 +1,74 @@
+//
+//  TikTokGlobalConfigCacheTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TikTokGlobalConfigCache.h"
+
+@interface TikTokGlobalConfigCacheTests : XCTestCase
+
+@property (nonatomic, copy) NSString *path;
+@property (nonatomic, copy) NSDictionary *configData;
+
+@end
+
+@implementation TikTokGlobalConfigCacheTests
+
+- (void)setUp {
+    [super setUp];
+    self.path = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"%@.json", [[NSUUID UUID] UUIDString]]];
+    self.configData = @{
+        @"business_sdk_config": @{@"enable_sdk": @YES, @"domain": @"analytics.us.tiktok.com"},
+        @"currency_exchange_info": @{@"USD": @1, @"CNY": @7.1}
+    };
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:self.path error:nil];
+    [super tearDown];
+}
+
+- (void)testEntrySurvivesReopening {
+    TikTokGlobalConfigCache *cache = [[TikTokGlobalConfigCache alloc] initWithPath:self.path maxAge:60];
+    XCTAssertNil([cache configDataForAppId:@"app"]);
+    [cache storeConfigData:self.configData ETag:@"\"v1\"" appId:@"app"];
+
+    cache = [[TikTokGlobalConfigCache alloc] initWithPath:self.path maxAge:60];
+    XCTAssertEqualObjects([cache configDataForAppId:@"app"], self.configData);
+    XCTAssertEqualObjects([cache ETagForAppId:@"app"], @"\"v1\"");
+}
+
+- (void)testEntryIsOnlyServedForItsApp {
+    TikTokGlobalConfigCache *cache = [[TikTokGlobalConfigCache alloc] initWithPath:self.path maxAge:60];
+    [cache storeConfigData:self.configData ETag:@"\"v1\"" appId:@"app"];
+    XCTAssertNil([cache configDataForAppId:@"other"]);
+    XCTAssertNil([cache ETagForAppId:@"other"]);
+}
+
+- (void)testExpiredEntryIsNotServed {
+    TikTokGlobalConfigCache *cache = [[TikTokGlobalConfigCache alloc] initWithPath:self.path maxAge:-1];
+    [cache storeConfigData:self.configData ETag:nil appId:@"app"];
+    XCTAssertNil([cache configDataForAppId:@"app"]);
+}
+
+- (void)testRevalidationKeepsEntry {
+    TikTokGlobalConfigCache *cache = [[TikTokGlobalConfigCache alloc] initWithPath:self.path maxAge:60];
+    [cache storeConfigData:self.configData ETag:@"\"v1\"" appId:@"app"];
+    [cache markRevalidatedForAppId:@"app"];
+    XCTAssertEqualObjects([cache configDataForAppId:@"app"], self.configData);
+    XCTAssertEqualObjects([cache ETagForAppId:@"app"], @"\"v1\"");
+}
+
+- (void)testClearRemovesEntry {
+    TikTokGlobalConfigCache *cache = [[TikTokGlobalConfigCache alloc] initWithPath:self.path maxAge:60];
+    [cache storeConfigData:self.configData ETag:@"\"v1\"" appId:@"app"];
+    [cache clear];
+    XCTAssertNil([cache configDataForAppId:@"app"]);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:self.path]);
+}
+
+@end
@@ -0,0 +1,186 @@
+//
+//  TikTokKeyValueStoreTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TikTokKeyValueStore.h"
+#import "TikTokKVStore.h"
+
+static const int kBenchmarkIterations = 1000;
+
+@interface TikTokKeyValueStoreTests : XCTestCase
+
+@property (nonatomic, copy) NSString *path;
+
+@end
+
+@implementation TikTokKeyValueStoreTests
+
+- (void)setUp {
+    [super setUp];
+    self.path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:self.path error:nil];
+    [[NSFileManager defaultManager] removeItemAtPath:[self.path stringByAppendingPathExtension:@"tmp"] error:nil];
+    [super tearDown];
+}
+
+- (void)testTypedValuesSurviveReopening {
+    TikTokKeyValueStore *store = [[TikTokKeyValueStore alloc] initWithPath:self.path];
+    NSDate *date = [NSDate dateWithTimeIntervalSince1970:1760000000.5];
+    [store setObject:@"true" forKey:@"string"];
+    [store setObject:@(1760000000123LL) forKey:@"integer"];
+    [store setDouble:2.5 forKey:@"double"];
+    [store setBool:YES forKey:@"bool"];
+    [store setObject:date forKey:@"date"];
+    [store setObject:[@"data" dataUsingEncoding:NSUTF8StringEncoding] forKey:@"data"];
+    [store setObject:@{@"Purchase": @5} forKey:@"dictionary"];
+    [store setObject:@"removed" forKey:@"removed"];
+    [store setObject:nil forKey:@"removed"];
+    store = nil;
+
+    store = [[TikTokKeyValueStore alloc] initWithPath:self.path];
+    XCTAssertEqualObjects([store objectForKey:@"string"], @"true");
+    XCTAssertEqualObjects([store objectForKey:@"integer"], @(1760000000123LL));
+    XCTAssertEqual([store doubleForKey:@"double"], 2.5);
+    XCTAssertTrue([store boolForKey:@"bool"]);
+    XCTAssertEqualObjects([store objectForKey:@"date"], date);
+    XCTAssertEqualObjects([store dataForKey:@"data"], [@"data" dataUsingEncoding:NSUTF8StringEncoding]);
+    XCTAssertEqualObjects([store dictionaryForKey:@"dictionary"], @{@"Purchase": @5});
+    XCTAssertNil([store objectForKey:@"removed"]);
+    XCTAssertNil([store objectForKey:@"missing"]);
+    XCTAssertFalse([store boolForKey:@"missing"]);
+}
+
+- (void)testLargeValue {
+    TikTokKeyValueStore *store = [[TikTokKeyValueStore alloc] initWithPath:self.path];
+    NSString *value = [@"" stringByPaddingToLength:100000 withString:@"x" startingAtIndex:0];
+    [store setObject:value forKey:@"large"];
+    XCTAssertEqualObjects([store stringForKey:@"large"], value);
+}
+
+- (void)testMigrationKeepsExistingValues {
+    NSString *suiteName = [[NSUUID UUID] UUIDString];
+    NSUserDefaults *defaults = [[NSUserDefaults alloc] initWithSuiteName:suiteName];
+    [defaults setObject:@"old" forKey:@"kept"];
+    [defaults setObject:@"old" forKey:@"migrated"];
+    [defaults setBool:YES forKey:@"flag"];
+    TikTokKeyValueStore *store = [[TikTokKeyValueStore alloc] initWithPath:self.path];
+    [store setObject:@"new" forKey:@"kept"];
+    [store migrateKeys:@[@"kept", @"migrated", @"flag", @"missing"] fromUserDefaults:defaults];
+    XCTAssertEqualObjects([store objectForKey:@"kept"], @"new");
+    XCTAssertEqualObjects([store objectForKey:@"migrated"], @"old");
+    XCTAssertTrue([store boolForKey:@"flag"]);
+    XCTAssertNil([store objectForKey:@"missing"]);
+    [defaults removePersistentDomainForName:suiteName];
+}
+
+- (void)testTornRecordIsCutOff {
+    TikTokKVStore *store = TikTokKVStoreOpen(self.path.fileSystemRepresentation, 0);
+    XCTAssert(store != NULL);
+    XCTAssertTrue(TikTokKVStoreSet(store, "kept", 1, "before", 6));
+    XCTAssertTrue(TikTokKVStoreSet(store, "kept", 1, "torn!!", 6));
+    TikTokKVStoreClose(store);
+
+    // damage the last record as if the write had been interrupted
+    NSMutableData *file = [NSMutableData dataWithContentsOfFile:self.path];
+    NSRange range = [file rangeOfData:[@"torn!!" dataUsingEncoding:NSUTF8StringEncoding] options:0 range:NSMakeRange(0, file.length)];
+    XCTAssertNotEqual(range.location, NSNotFound);
+    ((uint8_t *)file.mutableBytes)[range.location] ^= 0xff;
+    [file writeToFile:self.path atomically:NO];
+
+    store = TikTokKVStoreOpen(self.path.fileSystemRepresentation, 0);
+    char value[16] = {0};
+    uint32_t length = 0;
+    XCTAssertEqual(TikTokKVStoreGet(store, "kept", value, sizeof(value), &length), 1);
+    XCTAssertEqual(length, 6);
+    XCTAssertEqual(strncmp(value, "before", 6), 0);
+    XCTAssertTrue(TikTokKVStoreSet(store, "after", 1, "1", 1));
+    TikTokKVStoreClose(store);
+
+    store = TikTokKVStoreOpen(self.path.fileSystemRepresentation, 0);
+    XCTAssertEqual(TikTokKVStoreCount(store), 2);
+    TikTokKVStoreClose(store);
+}
+
+- (void)testFullLogIsRewritten {
+    TikTokKVStore *store = TikTokKVStoreOpen(self.path.fileSystemRepresentation, 4096);
+    char value[100];
+    for (int i = 0; i < 1000; i++) {
+        memset(value, 'a' + i % 26, sizeof(value));
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i % 10);
+        XCTAssertTrue(TikTokKVStoreSet(store, key, 1, value, sizeof(value)));
+    }
+    // ten live values fit without the file growing
+    XCTAssertEqual(TikTokKVStoreFileSize(store), 4096);
+    for (int i = 0; i < 100; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "grown%d", i);
+        XCTAssertTrue(TikTokKVStoreSet(store, key, 1, value, sizeof(value)));
+    }
+    XCTAssertGreaterThan(TikTokKVStoreFileSize(store), 4096);
+    XCTAssertTrue(TikTokKVStoreRemove(store, "key0"));
+    TikTokKVStoreClose(store);
+
+    store = TikTokKVStoreOpen(self.path.fileSystemRepresentation, 4096);
+    XCTAssertEqual(TikTokKVStoreCount(store), 109);
+    XCTAssertEqual(TikTokKVStoreGet(store, "key9", value, sizeof(value), NULL), 1);
+    XCTAssertEqual(value[0], 'a' + 999 % 26);
+    XCTAssertEqual(TikTokKVStoreGet(store, "key0", NULL, 0, NULL), TikTokKVStoreTypeNone);
+    TikTokKVStoreClose(store);
+}
+
+#pragma mark - Latency
+
+- (void)testKeyValueStoreLatency {
+    TikTokKeyValueStore *store = [[TikTokKeyValueStore alloc] initWithPath:self.path];
+    [self measureBlock:^{
+        for (int i = 0; i < kBenchmarkIterations; i++) {
+            [store setObject:@(i) forKey:@"foregroundMonitorTime"];
+            [store objectForKey:@"foregroundMonitorTime"];
+            [store setObject:(i % 2 ? @"true" : @"false") forKey:@"AreTimersOn"];
+            [store objectForKey:@"AreTimersOn"];
+        }
+    }];
+}
+
+// What the SDK did before: NSUserDefaults, synchronized after each update
+- (void)testUserDefaultsLatency {
+    NSString *suiteName = [[NSUUID UUID] UUIDString];
+    NSUserDefaults *defaults = [[NSUserDefaults alloc] initWithSuiteName:suiteName];
+    [self measureBlock:^{
+        for (int i = 0; i < kBenchmarkIterations; i++) {
+            [defaults setObject:@(i) forKey:@"foregroundMonitorTime"];
+            [defaults objectForKey:@"foregroundMonitorTime"];
+            [defaults setObject:(i % 2 ? @"true" : @"false") forKey:@"AreTimersOn"];
+            [defaults objectForKey:@"AreTimersOn"];
+            [defaults synchronize];
+        }
+    }];
+    [defaults removePersistentDomainForName:suiteName];
+}
+
+// The whole dictionary written as a property list on each update, as NSUserDefaults persists it
+- (void)testPropertyListLatency {
+    NSMutableDictionary *values = [NSMutableDictionary dictionary];
+    for (int i = 0; i < 20; i++) {
+        values[[NSString stringWithFormat:@"key%d", i]] = @"value";
+    }
+    [self measureBlock:^{
+        for (int i = 0; i < kBenchmarkIterations; i++) {
+            values[@"foregroundMonitorTime"] = @(i);
+            values[@"AreTimersOn"] = i % 2 ? @"true" : @"false";
+            NSData *data = [NSPropertyListSerialization dataWithPropertyList:values format:NSPropertyListBinaryFormat_v1_0 options:0 error:nil];
+            [data writeToFile:self.path atomically:YES];
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,122 @@
+//
+//  TikTokLaneSchedulerTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TikTokLaneScheduler.h"
+#import "TikTokAppEvent.h"
+#import "TikTokConstants.h"
+
+@interface TikTokLaneSchedulerTests : XCTestCase
+
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) NSMutableArray<NSString *> *order;
+
+@end
+
+@implementation TikTokLaneSchedulerTests
+
+- (void)setUp {
+    [super setUp];
+    self.queue = dispatch_queue_create("com.TikTokBusiness.TikTokLaneSchedulerTests", DISPATCH_QUEUE_SERIAL);
+    self.order = [NSMutableArray array];
+}
+
+// Holds the only send slot until the returned block is called, so the sends queued meanwhile are ordered together.
+- (dispatch_block_t)occupyScheduler:(TikTokLaneScheduler *)scheduler {
+    __block dispatch_block_t blockerDone = nil;
+    XCTestExpectation *started = [self expectationWithDescription:@"blocker started"];
+    [scheduler enqueueSend:^(dispatch_block_t done) {
+        blockerDone = done;
+        [started fulfill];
+    } inLane:TikTokEventLaneStandard];
+    [self waitForExpectations:@[started] timeout:1];
+    return blockerDone;
+}
+
+- (void)enqueueLabel:(NSString *)label inLane:(TikTokEventLane)lane scheduler:(TikTokLaneScheduler *)scheduler expectation:(XCTestExpectation *)expectation {
+    [scheduler enqueueSend:^(dispatch_block_t done) {
+        [self.order addObject:label];
+        [expectation fulfill];
+        done();
+    } inLane:lane];
+}
+
+- (void)testLaneForEvent {
+    XCTAssertEqual(TikTokEventLaneForEvent([[TikTokAppEvent alloc] initWithEventName:@"Purchase"]), TikTokEventLaneRevenue);
+    XCTAssertEqual(TikTokEventLaneForEvent([[TikTokAppEvent alloc] initWithEventName:TTEventNameAddPaymentInfo]), TikTokEventLaneRevenue);
+    XCTAssertEqual(TikTokEventLaneForEvent([[TikTokAppEvent alloc] initWithEventName:TTEventNameSubscribe]), TikTokEventLaneRevenue);
+    XCTAssertEqual(TikTokEventLaneForEvent([[TikTokAppEvent alloc] initWithEventName:@"Search"]), TikTokEventLaneStandard);
+    TikTokAppEvent *monitor = [[TikTokAppEvent alloc] initWithEventName:@"MonitorEvent" withProperties:@{} withType:@"monitor"];
+    XCTAssertEqual(TikTokEventLaneForEvent(monitor), TikTokEventLaneMonitor);
+    XCTAssertLessThan(TikTokEventLaneBatchSize(TikTokEventLaneRevenue), TikTokEventLaneBatchSize(TikTokEventLaneStandard));
+}
+
+- (void)testRevenueSendsGoFirst {
+    TikTokLaneScheduler *scheduler = [[TikTokLaneScheduler alloc] initWithMaxConcurrentSends:1 queue:self.queue];
+    dispatch_block_t blockerDone = [self occupyScheduler:scheduler];
+    XCTestExpectation *sent = [self expectationWithDescription:@"sent"];
+    sent.expectedFulfillmentCount = 4;
+    [self enqueueLabel:@"standard" inLane:TikTokEventLaneStandard scheduler:scheduler expectation:sent];
+    [self enqueueLabel:@"monitor" inLane:TikTokEventLaneMonitor scheduler:scheduler expectation:sent];
+    [self enqueueLabel:@"revenue1" inLane:TikTokEventLaneRevenue scheduler:scheduler expectation:sent];
+    [self enqueueLabel:@"revenue2" inLane:TikTokEventLaneRevenue scheduler:scheduler expectation:sent];
+    XCTAssertEqual([scheduler pendingSendCountInLane:TikTokEventLaneRevenue], 2);
+    blockerDone();
+    [self waitForExpectations:@[sent] timeout:1];
+    NSArray *expected = @[@"revenue1", @"revenue2", @"standard", @"monitor"];
+    XCTAssertEqualObjects(self.order, expected);
+}
+
+- (void)testStandardAndMonitorShareByWeight {
+    TikTokLaneScheduler *scheduler = [[TikTokLaneScheduler alloc] initWithMaxConcurrentSends:1 queue:self.queue];
+    dispatch_block_t blockerDone = [self occupyScheduler:scheduler];
+    XCTestExpectation *sent = [self expectationWithDescription:@"sent"];
+    sent.expectedFulfillmentCount = 20;
+    for (int i = 0; i < 10; i++) {
+        [self enqueueLabel:@"standard" inLane:TikTokEventLaneStandard scheduler:scheduler expectation:sent];
+        [self enqueueLabel:@"monitor" inLane:TikTokEventLaneMonitor scheduler:scheduler expectation:sent];
+    }
+    blockerDone();
+    [self waitForExpectations:@[sent] timeout:1];
+    // weights 4:1, so 8 standard and 2 monitor sends in the first 10
+    NSArray *firstTen = [self.order subarrayWithRange:NSMakeRange(0, 10)];
+    NSUInteger monitorCount = [[firstTen indexesOfObjectsPassingTest:^BOOL(NSString *label, NSUInteger idx, BOOL *stop) {
+        return [label isEqualToString:@"monitor"];
+    }] count];
+    XCTAssertEqual(monitorCount, 2);
+}
+
+- (void)testInFlightIsBounded {
+    TikTokLaneScheduler *scheduler = [[TikTokLaneScheduler alloc] initWithMaxConcurrentSends:2 queue:self.queue];
+    NSMutableArray<dispatch_block_t> *dones = [NSMutableArray array];
+    XCTestExpectation *started = [self expectationWithDescription:@"started"];
+    started.expectedFulfillmentCount = 2;
+    for (int i = 0; i < 5; i++) {
+        [scheduler enqueueSend:^(dispatch_block_t done) {
+            [dones addObject:done];
+            if (dones.count <= 2) {
+                [started fulfill];
+            }
+        } inLane:TikTokEventLaneStandard];
+    }
+    [self waitForExpectations:@[started] timeout:1];
+    XCTAssertEqual(scheduler.inFlightCount, 2);
+    XCTAssertEqual([scheduler pendingSendCountInLane:TikTokEventLaneStandard], 3);
+
+    // calling done twice releases a single slot
+    dispatch_sync(self.queue, ^{
+        dispatch_block_t done = dones.firstObject;
+        done();
+        done();
+    });
+    dispatch_sync(self.queue, ^{});
+    XCTAssertEqual(scheduler.inFlightCount, 2);
+    XCTAssertEqual([scheduler pendingSendCountInLane:TikTokEventLaneStandard], 2);
+}
+
+@end
@@ -0,0 +1,118 @@
+//
+//  TikTokLoggerTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TikTokLogger.h"
+#import "TikTokLogger+private.h"
+
+static const int kCallCount = 100000;
+
+@interface TikTokLoggerTests : XCTestCase
+
+@property (nonatomic, strong) TikTokLogger *logger;
+@property (nonatomic, assign) int argumentEvaluationCount;
+
+@end
+
+@implementation TikTokLoggerTests
+
+- (void)setUp {
+    [super setUp];
+    self.logger = [[TikTokLogger alloc] init];
+    self.argumentEvaluationCount = 0;
+}
+
+- (void)tearDown {
+    [self.logger flush];
+    [super tearDown];
+}
+
+- (NSString *)expensiveArgument {
+    self.argumentEvaluationCount++;
+    return @"payload";
+}
+
+- (void)testLevelGate {
+    [self.logger setLogLevel:TikTokLogLevelWarn];
+    XCTAssertFalse([self.logger isLevelEnabled:TikTokLogLevelInfo]);
+    XCTAssertTrue([self.logger isLevelEnabled:TikTokLogLevelWarn]);
+    XCTAssertTrue([self.logger isLevelEnabled:TikTokLogLevelError]);
+    [self.logger setLogLevel:TikTokLogLevelSuppress];
+    XCTAssertFalse([self.logger isLevelEnabled:TikTokLogLevelAssert]);
+}
+
+- (void)testDisabledLevelDoesNotEvaluateArguments {
+    [self.logger setLogLevel:TikTokLogLevelError];
+    TTLogInfo(self.logger, @"payload: %@", [self expensiveArgument]);
+    TTLogVerbose(self.logger, @"payload: %@", [self expensiveArgument]);
+    XCTAssertEqual(self.argumentEvaluationCount, 0);
+}
+
+- (void)testEnabledLevelFormatsOnCallingThread {
+    [self.logger setLogLevel:TikTokLogLevelInfo];
+    dispatch_semaphore_t gate = dispatch_semaphore_create(0);
+    dispatch_async(self.logger.logQueue, ^{
+        dispatch_semaphore_wait(gate, DISPATCH_TIME_FOREVER);
+    });
+    TTLogInfo(self.logger, @"payload: %@", [self expensiveArgument]);
+    // Built before the call returns, even though the queue can't write it yet
+    XCTAssertEqual(self.argumentEvaluationCount, 1);
+    dispatch_semaphore_signal(gate);
+}
+
+- (void)testMessagesBeyondQueueBoundAreDropped {
+    [self.logger setLogLevel:TikTokLogLevelInfo];
+    dispatch_semaphore_t gate = dispatch_semaphore_create(0);
+    dispatch_async(self.logger.logQueue, ^{
+        dispatch_semaphore_wait(gate, DISPATCH_TIME_FOREVER);
+    });
+    for (int i = 0; i < 1000; i++) {
+        TTLogInfo(self.logger, @"message %d", i);
+    }
+    NSUInteger droppedInfo = [self.logger droppedMessageCount];
+    for (int i = 0; i < 1000; i++) {
+        TTLogError(self.logger, @"error %d", i);
+    }
+    dispatch_semaphore_signal(gate);
+    [self.logger flush];
+    XCTAssertGreaterThan(droppedInfo, 0);
+    XCTAssertLessThan(droppedInfo, 1000);
+    // Errors are written even with the queue full
+    XCTAssertEqual([self.logger droppedMessageCount], droppedInfo);
+}
+
+- (void)testDisabledLevelCallPerformance {
+    [self.logger setLogLevel:TikTokLogLevelInfo];
+    [self measureBlock:^{
+        for (int i = 0; i < kCallCount; i++) {
+            TTLogAtLevel(self.logger, TikTokLogLevelDebug, @"payload %d: %@", i, [self expensiveArgument]);
+        }
+    }];
+}
+
+- (void)testDisabledLevelLegacyCallPerformance {
+    // The varargs methods check the level too, but only after the arguments were built.
+    [self.logger setLogLevel:TikTokLogLevelInfo];
+    [self measureBlock:^{
+        for (int i = 0; i < kCallCount; i++) {
+            [self.logger debug:@"payload %d: %@", i, [self expensiveArgument]];
+        }
+    }];
+}
+
+- (void)testEnabledLevelCallPerformance {
+    [self.logger setLogLevel:TikTokLogLevelInfo];
+    [self measureBlock:^{
+        for (int i = 0; i < 1000; i++) {
+            TTLogInfo(self.logger, @"payload %d: %@", i, @"payload");
+        }
+        [self.logger flush];
+    }];
+}
+
+@end
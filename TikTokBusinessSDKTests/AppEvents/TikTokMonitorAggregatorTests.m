@@ -0,0 +1,93 @@
+//
+//  TikTokMonitorAggregatorTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TikTokMonitorAggregator.h"
+
+@interface TikTokMonitorAggregatorTests : XCTestCase
+
+@property (nonatomic, strong) TikTokMonitorAggregator *aggregator;
+
+@end
+
+@implementation TikTokMonitorAggregatorTests
+
+- (void)setUp {
+    [super setUp];
+    self.aggregator = [[TikTokMonitorAggregator alloc] init];
+}
+
+- (NSDictionary *)summaryNamed:(NSString *)name key:(NSString *)key in:(NSArray<NSDictionary *> *)summaries {
+    for (NSDictionary *summary in summaries) {
+        if ([summary[@"name"] isEqualToString:name] && [summary[@"key"] isEqualToString:key]) {
+            return summary;
+        }
+    }
+    return nil;
+}
+
+- (void)testRequestsFoldIntoOneSummaryPerPath {
+    for (int i = 1; i <= 100; i++) {
+        [self.aggregator recordMetric:@"network_req" key:@"batch" value:i errorCode:(i % 10 == 0 ? @500 : nil)];
+    }
+    [self.aggregator recordMetric:@"network_req" key:@"monitor" value:42 errorCode:nil];
+    NSArray *summaries = [self.aggregator takeSummaries];
+    XCTAssertEqual(summaries.count, 2);
+
+    NSDictionary *batch = [self summaryNamed:@"network_req" key:@"batch" in:summaries];
+    XCTAssertEqualObjects(batch[@"count"], @100);
+    XCTAssertEqualObjects(batch[@"sum"], @5050);
+    XCTAssertEqualObjects(batch[@"min"], @1);
+    XCTAssertEqualObjects(batch[@"max"], @100);
+    XCTAssertEqualObjects(batch[@"p50"], @50);
+    XCTAssertEqualObjects(batch[@"p99"], @99);
+    XCTAssertEqualObjects(batch[@"err_codes"], (@{@"500": @10}));
+
+    NSDictionary *monitor = [self summaryNamed:@"network_req" key:@"monitor" in:summaries];
+    XCTAssertEqualObjects(monitor[@"count"], @1);
+    XCTAssertNil(monitor[@"err_codes"]);
+}
+
+- (void)testTakingSummariesStartsANewWindow {
+    XCTAssertNil([self.aggregator takeSummaries]);
+    [self.aggregator recordMetric:@"flush" key:@"TIMER" value:12 errorCode:nil];
+    XCTAssertEqual([self.aggregator takeSummaries].count, 1);
+    XCTAssertNil([self.aggregator takeSummaries]);
+}
+
+- (void)testSamplingKeepsExactTotals {
+    for (int i = 0; i < 10000; i++) {
+        [self.aggregator recordMetric:@"network_req" key:@"batch" value:i % 100 errorCode:nil];
+    }
+    NSDictionary *summary = [self.aggregator takeSummaries].firstObject;
+    XCTAssertEqualObjects(summary[@"count"], @10000);
+    XCTAssertEqualObjects(summary[@"max"], @99);
+    XCTAssertEqualWithAccuracy([summary[@"p50"] doubleValue], 50, 15);
+}
+
+- (void)testSummariesPerWindowAreCapped {
+    for (int i = 0; i < 1000; i++) {
+        [self.aggregator recordMetric:@"event_dropped" key:[NSString stringWithFormat:@"sampled:Event%d", i] value:1 errorCode:nil];
+    }
+    [self.aggregator recordMetric:@"event_dropped" key:@"sampled:Event0" value:1 errorCode:nil];
+    NSArray *summaries = [self.aggregator takeSummaries];
+    XCTAssertEqual(summaries.count, 513);
+    XCTAssertEqualObjects([self summaryNamed:@"event_dropped" key:@"sampled:Event0" in:summaries][@"count"], @2);
+    XCTAssertEqualObjects([self summaryNamed:@"event_dropped" key:@"_overflow" in:summaries][@"count"], @488);
+}
+
+- (void)testRecordPerformance {
+    [self measureBlock:^{
+        for (int i = 0; i < 10000; i++) {
+            [self.aggregator recordMetric:@"network_req" key:@"batch" value:i errorCode:nil];
+        }
+        [self.aggregator takeSummaries];
+    }];
+}
+
+@end
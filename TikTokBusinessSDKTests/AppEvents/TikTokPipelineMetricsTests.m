@@ -0,0 +1,98 @@
+//
+//  TikTokPipelineMetricsTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TikTokPipelineMetrics.h"
+#import "TikTokPipelineMetrics+private.h"
+
+@interface TikTokPipelineMetricsTests : XCTestCase
+
+@property (nonatomic, strong) TikTokPipelineMetrics *metrics;
+
+@end
+
+@implementation TikTokPipelineMetricsTests
+
+- (void)setUp {
+    [super setUp];
+    self.metrics = [[TikTokPipelineMetrics alloc] init];
+}
+
+- (void)testPercentilesAreWithinBucketPrecision {
+    for (uint64_t value = 1; value <= 100000; value++) {
+        [self.metrics recordValue:value forHistogram:TikTokPipelineHistogramRequestLatency];
+    }
+    TikTokHistogramSnapshot *snapshot = [self.metrics snapshotForHistogram:TikTokPipelineHistogramRequestLatency];
+    XCTAssertEqual(snapshot.count, 100000);
+    XCTAssertEqual(snapshot.min, 1);
+    XCTAssertEqual(snapshot.max, 100000);
+    XCTAssertEqualWithAccuracy(snapshot.mean, 50000.5, 0.01);
+    XCTAssertEqualWithAccuracy((double)[snapshot valueAtPercentile:50], 50000, 50000 * 0.0625);
+    XCTAssertEqualWithAccuracy((double)[snapshot valueAtPercentile:99], 99000, 99000 * 0.0625);
+    XCTAssertEqual([snapshot valueAtPercentile:100], 100000);
+}
+
+- (void)testSmallValuesAreExact {
+    [self.metrics recordValue:3 forHistogram:TikTokPipelineHistogramQueueDepth];
+    [self.metrics recordValue:7 forHistogram:TikTokPipelineHistogramQueueDepth];
+    TikTokHistogramSnapshot *snapshot = [self.metrics snapshotForHistogram:TikTokPipelineHistogramQueueDepth];
+    XCTAssertEqual([snapshot valueAtPercentile:50], 3);
+    XCTAssertEqual([snapshot valueAtPercentile:90], 7);
+}
+
+- (void)testEmptyHistogram {
+    TikTokHistogramSnapshot *snapshot = [self.metrics snapshotForHistogram:TikTokPipelineHistogramPersistTime];
+    XCTAssertEqual(snapshot.count, 0);
+    XCTAssertEqual(snapshot.min, 0);
+    XCTAssertEqual([snapshot valueAtPercentile:99], 0);
+}
+
+- (void)testCounters {
+    [self.metrics incrementCounter:TikTokPipelineCounterBytesSent by:100];
+    [self.metrics incrementCounter:TikTokPipelineCounterBytesSent by:23];
+    XCTAssertEqual([self.metrics valueForCounter:TikTokPipelineCounterBytesSent], 123);
+    XCTAssertEqual([self.metrics valueForCounter:TikTokPipelineCounterRequestsSent], 0);
+    NSDictionary *dictionary = [self.metrics dictionaryRepresentation];
+    XCTAssertEqualObjects(dictionary[@"counters"][@"bytes_sent"], @123);
+    XCTAssertNotNil(dictionary[@"histograms"][@"request_latency_us"]);
+}
+
+- (void)testIntervalSummaryOnlyCoversItsWindow {
+    XCTAssertNil([self.metrics takeIntervalSummary]);
+    [self.metrics incrementCounter:TikTokPipelineCounterRequestsSent by:2];
+    [self.metrics recordValue:500 forHistogram:TikTokPipelineHistogramRequestBytes];
+    NSDictionary *summary = [self.metrics takeIntervalSummary];
+    XCTAssertEqualObjects(summary[@"counters"][@"requests_sent"], @2);
+    XCTAssertEqualObjects(summary[@"histograms"][@"request_bytes"][@"count"], @1);
+    XCTAssertNil(summary[@"histograms"][@"persist_us"]);
+    XCTAssertNil([self.metrics takeIntervalSummary]);
+    // The totals are unaffected by taking interval summaries.
+    XCTAssertEqual([self.metrics valueForCounter:TikTokPipelineCounterRequestsSent], 2);
+    XCTAssertEqual([self.metrics snapshotForHistogram:TikTokPipelineHistogramRequestBytes].count, 1);
+}
+
+- (void)testConcurrentRecording {
+    dispatch_apply(8, dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^(size_t thread) {
+        for (uint64_t i = 0; i < 10000; i++) {
+            [self.metrics recordValue:i forHistogram:TikTokPipelineHistogramPersistTime];
+            [self.metrics incrementCounter:TikTokPipelineCounterEventsPersisted by:1];
+        }
+    });
+    XCTAssertEqual([self.metrics snapshotForHistogram:TikTokPipelineHistogramPersistTime].count, 80000);
+    XCTAssertEqual([self.metrics valueForCounter:TikTokPipelineCounterEventsPersisted], 80000);
+}
+
+- (void)testRecordPerformance {
+    [self measureBlock:^{
+        for (uint64_t i = 0; i < 100000; i++) {
+            [self.metrics recordValue:i forHistogram:TikTokPipelineHistogramRequestLatency];
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,139 @@
+//
+//  TikTokProductCacheTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TikTokProductCache.h"
+#import "TikTokProductCache+private.h"
+
+@interface TikTokFakeProduct : SKProduct
+
+@property (nonatomic, copy) NSString *fakeIdentifier;
+
+@end
+
+@implementation TikTokFakeProduct
+
+- (NSString *)productIdentifier
+{
+    return self.fakeIdentifier;
+}
+
+@end
+
+// Answers requests from a fixed catalog instead of StoreKit
+@interface TikTokStubProductCache : TikTokProductCache
+
+@property (nonatomic, copy) NSArray<NSString *> *catalog;
+@property (nonatomic, assign) BOOL failRequests;
+@property (nonatomic, strong) NSMutableArray<NSSet<NSString *> *> *requestedBatches;
+
+@end
+
+@implementation TikTokStubProductCache
+
+- (void)requestProductsWithIdentifiers:(NSSet<NSString *> *)productIdentifiers
+{
+    @synchronized (self) {
+        [self.requestedBatches addObject:productIdentifiers];
+    }
+    if (self.failRequests) {
+        [self finishRequestForIdentifiers:productIdentifiers products:nil];
+        return;
+    }
+    NSMutableArray *products = [NSMutableArray array];
+    for (NSString *identifier in productIdentifiers) {
+        if ([self.catalog containsObject:identifier]) {
+            TikTokFakeProduct *product = [TikTokFakeProduct new];
+            product.fakeIdentifier = identifier;
+            [products addObject:product];
+        }
+    }
+    [self finishRequestForIdentifiers:productIdentifiers products:products];
+}
+
+@end
+
+@interface TikTokProductCacheTests : XCTestCase
+
+@property (nonatomic, strong) TikTokStubProductCache *cache;
+
+@end
+
+@implementation TikTokProductCacheTests
+
+- (void)setUp {
+    [super setUp];
+    self.cache = [[TikTokStubProductCache alloc] initWithTimeToLive:60 batchWindow:0.05];
+    self.cache.catalog = @[@"coins", @"gems", @"premium"];
+    self.cache.requestedBatches = [NSMutableArray array];
+}
+
+- (NSDictionary<NSString *, id> *)lookUp:(NSArray<NSString *> *)identifiers {
+    NSMutableDictionary *results = [NSMutableDictionary dictionary];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"lookups"];
+    expectation.expectedFulfillmentCount = identifiers.count;
+    for (NSUInteger i = 0; i < identifiers.count; i++) {
+        [self.cache productForIdentifier:identifiers[i] completion:^(SKProduct * _Nullable product) {
+            @synchronized (results) {
+                results[@(i)] = product.productIdentifier ?: [NSNull null];
+            }
+            [expectation fulfill];
+        }];
+    }
+    [self waitForExpectations:@[expectation] timeout:2];
+    return results;
+}
+
+- (void)testConcurrentLookupsShareOneRequest {
+    NSDictionary *results = [self lookUp:@[@"coins", @"gems", @"coins", @"unknown", @"coins"]];
+    XCTAssertEqual(self.cache.requestedBatches.count, 1);
+    NSSet *expected = [NSSet setWithArray:@[@"coins", @"gems", @"unknown"]];
+    XCTAssertEqualObjects(self.cache.requestedBatches.firstObject, expected);
+    XCTAssertEqualObjects(results[@0], @"coins");
+    XCTAssertEqualObjects(results[@1], @"gems");
+    XCTAssertEqualObjects(results[@2], @"coins");
+    XCTAssertEqualObjects(results[@3], [NSNull null]);
+    XCTAssertEqualObjects(results[@4], @"coins");
+}
+
+- (void)testResolvedProductsAreServedFromCache {
+    [self lookUp:@[@"premium", @"unknown"]];
+    NSDictionary *results = [self lookUp:@[@"premium", @"unknown"]];
+    XCTAssertEqualObjects(results[@0], @"premium");
+    XCTAssertEqualObjects(results[@1], [NSNull null]);
+    // only the identifier that didn't resolve is requested again
+    XCTAssertEqual(self.cache.requestedBatches.count, 2);
+    XCTAssertEqualObjects(self.cache.requestedBatches.lastObject, [NSSet setWithObject:@"unknown"]);
+
+    [self.cache removeAllProducts];
+    [self lookUp:@[@"premium"]];
+    XCTAssertEqual(self.cache.requestedBatches.count, 3);
+}
+
+- (void)testExpiredProductIsRequestedAgain {
+    self.cache = [[TikTokStubProductCache alloc] initWithTimeToLive:0 batchWindow:0.01];
+    self.cache.catalog = @[@"coins"];
+    self.cache.requestedBatches = [NSMutableArray array];
+    [self lookUp:@[@"coins"]];
+    NSDictionary *results = [self lookUp:@[@"coins"]];
+    XCTAssertEqualObjects(results[@0], @"coins");
+    XCTAssertEqual(self.cache.requestedBatches.count, 2);
+}
+
+- (void)testFailedRequestIsNotCached {
+    self.cache.failRequests = YES;
+    NSDictionary *results = [self lookUp:@[@"coins", @"coins"]];
+    XCTAssertEqualObjects(results[@0], [NSNull null]);
+    XCTAssertEqualObjects(results[@1], [NSNull null]);
+    self.cache.failRequests = NO;
+    results = [self lookUp:@[@"coins"]];
+    XCTAssertEqualObjects(results[@0], @"coins");
+    XCTAssertEqual(self.cache.requestedBatches.count, 2);
+}
+
+@end
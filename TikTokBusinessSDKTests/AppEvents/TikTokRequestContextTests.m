@@ -0,0 +1,82 @@
+//
+//  TikTokRequestContextTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TikTokRequestContext.h"
+#import "TikTokConfig.h"
+
+@interface TikTokRequestContextTests : XCTestCase
+
+@property (nonatomic, strong) TikTokRequestContextCache *cache;
+@property (nonatomic, strong) TikTokConfig *config;
+
+@end
+
+@implementation TikTokRequestContextTests
+
+- (void)setUp {
+    [super setUp];
+    self.cache = [[TikTokRequestContextCache alloc] init];
+    self.config = [[TikTokConfig alloc] initWithAppId:@"123" tiktokAppId:@"456"];
+}
+
+- (TikTokRequestContext *)contextAtVersion:(NSUInteger)version {
+    return [[TikTokRequestContext alloc] initWithVersion:version
+                                                     app:@{@"name": @"app", @"namespace": @"com.test"}
+                                                  device:@{@"platform": @"iOS"}
+                                                 library:@{@"name": @"library"}
+                                               userAgent:@"ua"
+                                                  locale:@"en/US"
+                                                      ip:@""];
+}
+
+- (void)testStoredContextIsReused {
+    XCTAssertNil([self.cache contextForConfig:self.config isMonitor:NO]);
+    TikTokRequestContext *context = [self contextAtVersion:self.cache.version];
+    [self.cache storeContext:context forConfig:self.config isMonitor:NO];
+    XCTAssertEqual([self.cache contextForConfig:self.config isMonitor:NO], context);
+    XCTAssertNil([self.cache contextForConfig:self.config isMonitor:YES]);
+}
+
+- (void)testInvalidateDropsContext {
+    [self.cache storeContext:[self contextAtVersion:self.cache.version] forConfig:self.config isMonitor:NO];
+    [self.cache invalidate];
+    XCTAssertNil([self.cache contextForConfig:self.config isMonitor:NO]);
+}
+
+- (void)testContextBuiltBeforeInvalidationIsNotStored {
+    NSUInteger version = self.cache.version;
+    [self.cache invalidate];
+    [self.cache storeContext:[self contextAtVersion:version] forConfig:self.config isMonitor:NO];
+    XCTAssertNil([self.cache contextForConfig:self.config isMonitor:NO]);
+}
+
+- (void)testLocaleChangeInvalidates {
+    [self.cache storeContext:[self contextAtVersion:self.cache.version] forConfig:self.config isMonitor:NO];
+    [[NSNotificationCenter defaultCenter] postNotificationName:NSCurrentLocaleDidChangeNotification object:nil];
+    XCTAssertNil([self.cache contextForConfig:self.config isMonitor:NO]);
+}
+
+- (void)testOtherConfigMisses {
+    [self.cache storeContext:[self contextAtVersion:self.cache.version] forConfig:self.config isMonitor:NO];
+    TikTokConfig *otherConfig = [[TikTokConfig alloc] initWithAppId:@"789" tiktokAppId:@"012"];
+    XCTAssertNil([self.cache contextForConfig:otherConfig isMonitor:NO]);
+}
+
+- (void)testAppIsSharedPerAnonymousID {
+    TikTokRequestContext *context = [self contextAtVersion:1];
+    NSDictionary *app = [context appWithAnonymousID:@"anon-1"];
+    XCTAssertEqualObjects(app[@"anonymous_id"], @"anon-1");
+    XCTAssertEqualObjects(app[@"name"], @"app");
+    XCTAssertEqual([context appWithAnonymousID:@"anon-1"], app);
+    XCTAssertEqualObjects([context appWithAnonymousID:@"anon-2"][@"anonymous_id"], @"anon-2");
+    XCTAssertNil(context.app[@"anonymous_id"]);
+    XCTAssertEqual([context appWithAnonymousID:nil], context.app);
+}
+
+@end
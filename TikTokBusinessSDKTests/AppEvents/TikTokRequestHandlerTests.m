@@ -11,7 +11,11 @@
 #import "TikTokRequestHandler.h"
 #import "TikTokFactory.h"
 #import "TikTokBusiness.h"
+#import "TikTokBusiness+private.h"
 #import "TikTokAppEvent.h"
+#import "TikTokGlobalConfigCache.h"
+#import "TikTokUnityBridge.h"
+#import "TikTokEventAdmissionController.h"
 
 @interface TikTokRequestHandlerTests : XCTestCase
 
@@ -81,4 +85,89 @@
     XCTAssert(1 == 1, @"Network request sent successfully");
 }
 
+- (NSDictionary *)configDataWithAdmission:(NSDictionary *)admission {
+    return @{
+        @"business_sdk_config": @{@"enable_sdk": @YES, @"event_admission_control": admission},
+        @"currency_exchange_info": @{@"USD": @1}
+    };
+}
+
+- (void)stubRequestHandler:(id)requestHandler cachedConfig:(NSDictionary *)cachedConfig fetchedConfig:(NSDictionary *)fetchedConfig {
+    OCMStub([requestHandler applyCachedGlobalConfig:OCMOCK_ANY withCompletionHandler:OCMOCK_ANY]).andDo(^(NSInvocation *invocation) {
+        __unsafe_unretained void (^handler)(BOOL, NSDictionary *);
+        [invocation getArgument:&handler atIndex:3];
+        handler(YES, cachedConfig);
+        BOOL applied = YES;
+        [invocation setReturnValue:&applied];
+    });
+    OCMStub([requestHandler getRemoteSwitch:OCMOCK_ANY isRetry:NO withCompletionHandler:OCMOCK_ANY]).andDo(^(NSInvocation *invocation) {
+        __unsafe_unretained void (^handler)(BOOL, NSDictionary *);
+        [invocation getArgument:&handler atIndex:4];
+        handler(YES, fetchedConfig);
+    });
+}
+
+- (void)testRevalidatedConfigIsNotSentToBridgeAgain {
+    NSDictionary *configData = [self configDataWithAdmission:@{@"enable": @NO}];
+    id cache = OCMPartialMock([TikTokGlobalConfigCache sharedCache]);
+    OCMStub([cache configDataForAppId:OCMOCK_ANY]).andReturn(configData);
+    id bridge = OCMClassMock([TikTokUnityBridge class]);
+    __block NSInteger callbacks = 0;
+    OCMStub([bridge sendConfigCallback:OCMOCK_ANY]).andDo(^(NSInvocation *invocation) {
+        callbacks++;
+    });
+
+    TikTokRequestHandler *requestHandler = [[TikTokRequestHandler alloc] init];
+    void (^handler)(BOOL, NSDictionary *) = ^(BOOL isRemoteSwitchOn, NSDictionary *globalConfig) {};
+    XCTAssertTrue([requestHandler applyCachedGlobalConfig:self.config withCompletionHandler:handler]);
+    // a 304 applies the cached entry again
+    XCTAssertTrue([requestHandler applyCachedGlobalConfig:self.config withCompletionHandler:handler]);
+    XCTAssertEqual(callbacks, 1);
+
+    [bridge stopMocking];
+    [cache stopMocking];
+}
+
+- (void)testNotModifiedConfigIsAppliedOnce {
+    NSDictionary *globalConfig = [self configDataWithAdmission:@{@"enable": @NO}][@"business_sdk_config"];
+    id requestHandler = OCMClassMock([TikTokRequestHandler class]);
+    [self stubRequestHandler:requestHandler cachedConfig:globalConfig fetchedConfig:globalConfig];
+    __block NSInteger userAgentLoads = 0;
+    OCMStub([self.tiktokBusiness loadUserAgent]).andDo(^(NSInvocation *invocation) {
+        userAgentLoads++;
+    });
+    TikTokRequestHandler *previousRequestHandler = [self.tiktokBusiness requestHandler];
+    [self.tiktokBusiness setRequestHandler:requestHandler];
+    [self.tiktokBusiness setIsGlobalConfigFetched:NO];
+
+    [self.tiktokBusiness getGlobalConfig:self.config isFirstInitialization:NO];
+    XCTAssertEqual(userAgentLoads, 1);
+    XCTAssertTrue([self.tiktokBusiness isGlobalConfigFetched]);
+
+    [self.tiktokBusiness setRequestHandler:previousRequestHandler];
+    [requestHandler stopMocking];
+}
+
+- (void)testChangedConfigOnlyAppliesDifference {
+    NSDictionary *cachedConfig = [self configDataWithAdmission:@{@"enable": @NO}][@"business_sdk_config"];
+    NSDictionary *fetchedConfig = [self configDataWithAdmission:@{@"enable": @YES}][@"business_sdk_config"];
+    id requestHandler = OCMClassMock([TikTokRequestHandler class]);
+    [self stubRequestHandler:requestHandler cachedConfig:cachedConfig fetchedConfig:fetchedConfig];
+    __block NSInteger userAgentLoads = 0;
+    OCMStub([self.tiktokBusiness loadUserAgent]).andDo(^(NSInvocation *invocation) {
+        userAgentLoads++;
+    });
+    TikTokRequestHandler *previousRequestHandler = [self.tiktokBusiness requestHandler];
+    [self.tiktokBusiness setRequestHandler:requestHandler];
+    [self.tiktokBusiness setIsGlobalConfigFetched:NO];
+
+    [self.tiktokBusiness getGlobalConfig:self.config isFirstInitialization:NO];
+    XCTAssertEqual(userAgentLoads, 1);
+    XCTAssertTrue([TikTokEventAdmissionController sharedController].isEnabled);
+
+    [[TikTokEventAdmissionController sharedController] reset];
+    [self.tiktokBusiness setRequestHandler:previousRequestHandler];
+    [requestHandler stopMocking];
+}
+
 @end
@@ -0,0 +1,109 @@
+//
+//  TikTokResourceGovernorTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TikTokResourceGovernor.h"
+#import "TTSDKCrashAppMemory+Private.h"
+
+@interface TikTokResourceGovernorTests : XCTestCase
+
+@property (atomic, assign) TTSDKCrashAppMemoryState pressure;
+@property (atomic, assign) uint64_t footprint;
+@property (nonatomic, strong) TikTokResourceGovernor *governor;
+
+@end
+
+@implementation TikTokResourceGovernorTests
+
+- (void)setUp {
+    [super setUp];
+    self.pressure = TTSDKCrashAppMemoryStateNormal;
+    // a tenth of a 1GB limit, a normal level, unless a test raises it
+    self.footprint = 100 * 1024 * 1024;
+    __weak typeof(self) weakSelf = self;
+    self.governor = [[TikTokResourceGovernor alloc] initWithMemoryProvider:^TTSDKCrashAppMemory *{
+        return [[TTSDKCrashAppMemory alloc] initWithFootprint:weakSelf.footprint
+                                                    remaining:1024ULL * 1024 * 1024 - weakSelf.footprint
+                                                     pressure:weakSelf.pressure];
+    }];
+}
+
+- (void)testModeFollowsPressure {
+    [self.governor evaluate];
+    XCTAssertEqual(self.governor.mode, TikTokMemoryModeNormal);
+    XCTAssertEqual([self.governor batchSizeForSize:50], 50);
+    XCTAssertEqual([self.governor retrievalLimit], 0);
+    XCTAssertFalse([self.governor shouldDeferMonitorUploads]);
+
+    self.pressure = TTSDKCrashAppMemoryStateUrgent;
+    [self.governor evaluate];
+    XCTAssertEqual(self.governor.mode, TikTokMemoryModeElevated);
+    XCTAssertEqual([self.governor batchSizeForSize:50], 25);
+    XCTAssertGreaterThan([self.governor retrievalLimit], 0);
+    XCTAssertTrue([self.governor shouldDeferMonitorUploads]);
+
+    self.pressure = TTSDKCrashAppMemoryStateCritical;
+    [self.governor evaluate];
+    XCTAssertEqual(self.governor.mode, TikTokMemoryModeCritical);
+    XCTAssertEqual([self.governor batchSizeForSize:50], 12);
+    XCTAssertEqual([self.governor batchSizeForSize:2], 1);
+
+    self.pressure = TTSDKCrashAppMemoryStateNormal;
+    [self.governor evaluate];
+    XCTAssertEqual(self.governor.mode, TikTokMemoryModeNormal);
+    XCTAssertEqual([self.governor retrievalLimit], 0);
+}
+
+- (void)testModeFollowsFootprint {
+    // 40% of the limit is a warn level, which alone doesn't hold back work
+    self.footprint = 400 * 1024 * 1024;
+    [self.governor evaluate];
+    XCTAssertEqual(self.governor.mode, TikTokMemoryModeNormal);
+    XCTAssertEqual([self.governor batchSizeForSize:50], 50);
+
+    // 60% is urgent
+    self.footprint = 600 * 1024 * 1024;
+    [self.governor evaluate];
+    XCTAssertEqual(self.governor.mode, TikTokMemoryModeElevated);
+    XCTAssertEqual([self.governor batchSizeForSize:50], 25);
+
+    // 85% is critical
+    self.footprint = 850 * 1024 * 1024;
+    [self.governor evaluate];
+    XCTAssertEqual(self.governor.mode, TikTokMemoryModeCritical);
+
+    // pressure raises a warn level
+    self.footprint = 400 * 1024 * 1024;
+    self.pressure = TTSDKCrashAppMemoryStateWarn;
+    [self.governor evaluate];
+    XCTAssertEqual(self.governor.mode, TikTokMemoryModeElevated);
+}
+
+- (void)testHandlersRunWhenPressureRises {
+    NSMutableArray<NSNumber *> *modes = [NSMutableArray array];
+    [self.governor addPressureHandler:^(TikTokMemoryMode mode) {
+        [modes addObject:@(mode)];
+    } forAction:@"test_action"];
+
+    self.pressure = TTSDKCrashAppMemoryStateWarn;
+    [self.governor evaluate];
+    // no change, nothing to do again
+    [self.governor evaluate];
+    self.pressure = TTSDKCrashAppMemoryStateTerminal;
+    [self.governor evaluate];
+    // falling back doesn't run them
+    self.pressure = TTSDKCrashAppMemoryStateNormal;
+    [self.governor evaluate];
+    self.pressure = TTSDKCrashAppMemoryStateWarn;
+    [self.governor evaluate];
+
+    NSArray *expected = @[@(TikTokMemoryModeElevated), @(TikTokMemoryModeCritical), @(TikTokMemoryModeElevated)];
+    XCTAssertEqualObjects(modes, expected);
+}
+
+@end
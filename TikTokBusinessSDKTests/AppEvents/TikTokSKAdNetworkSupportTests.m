@@ -11,9 +11,16 @@
 #import "TikTokSKAdNetworkConversionConfiguration.h"
 #import "TikTokCurrencyUtility.h"
 #import "TikTokCurrencyUtility.h"
+#import "TikTokSKAdNetworkRuleIndex.h"
+#import "TikTokConstants.h"
+#import "TikTokAppEventUtility.h"
+#import "TikTokKeyValueStore.h"
+#import "TikTokBusinessSDKMacros.h"
 
 @interface TikTokSKAdNetworkSupportTests : XCTestCase
 
+@property (nonatomic, strong, nullable) id savedFirstLaunchTime;
+
 @end
 
 @implementation TikTokSKAdNetworkSupportTests
@@ -26,9 +33,14 @@
     NSDictionary *configDic = [NSJSONSerialization JSONObjectWithData:configData options:NSJSONReadingMutableContainers error:&err];
     [[TikTokSKAdNetworkConversionConfiguration sharedInstance] configWithDict:configDic];
     [[TikTokCurrencyUtility sharedInstance] configWithDict:@{@"USD": @(1.0), @"CNY": @(7.1)}];
+    // Launched just now, so the first conversion window is active
+    TikTokKeyValueStore *store = [TikTokKeyValueStore sharedStore];
+    self.savedFirstLaunchTime = [store objectForKey:TTUserDefaultsKey_firstLaunchTime];
+    [store setObject:@([TikTokAppEventUtility getCurrentTimestamp]) forKey:TTUserDefaultsKey_firstLaunchTime];
 }
 
 - (void)tearDown {
+    [[TikTokKeyValueStore sharedStore] setObject:self.savedFirstLaunchTime forKey:TTUserDefaultsKey_firstLaunchTime];
     [super tearDown];
 }
 
@@ -36,6 +48,59 @@
     [[TikTokSKAdNetworkSupport sharedInstance] matchEventToSKANConfig:@"Purchase" withValue:@"30" currency:@"USD"];
 }
 
+- (void)testRuleIndex {
+    TikTokSKAdNetworkRuleIndex *ruleIndex = [TikTokSKAdNetworkConversionConfiguration sharedInstance].ruleIndex;
+    XCTAssertNotNil(ruleIndex);
+    NSArray<TikTokSKAdNetworkRuleTarget *> *targets = [ruleIndex targetsForEvent:@"Purchase" inWindow:0];
+    XCTAssertEqual(targets.count, 2);
+    // coarse rules are sorted high first
+    XCTAssertEqualObjects(targets[0].rule.coarseConversionValue, @"high");
+    XCTAssertFalse(targets[0].isFine);
+    XCTAssertEqual(targets[0].minRevenue, 3);
+    XCTAssertEqual([ruleIndex targetsForEvent:@"LaunchAPP" inWindow:0].count, 1);
+    XCTAssertTrue([ruleIndex targetsForEvent:@"LaunchAPP" inWindow:0].firstObject.isFine);
+    XCTAssertNil([ruleIndex targetsForEvent:@"Checkout" inWindow:0]);
+    XCTAssertEqual([ruleIndex targetsForEvent:@"Checkout" inWindow:1].count, 1);
+    XCTAssertTrue([ruleIndex containsEvent:@"Checkout"]);
+    XCTAssertFalse([ruleIndex containsEvent:@"ViewContent"]);
+}
+
+- (void)testFunnelBits {
+    TikTokSKAdNetworkRule *rule = [[TikTokSKAdNetworkRule alloc] initWithDict:@{
+        @"conversion_value": @"5",
+        @"event_funnel": @[@{@"event_name_report": @"AddToCart"}, @{@"event_name_report": @"Purchase"}]
+    }];
+    XCTAssertFalse([rule isMatched]);
+    XCTAssertFalse([rule markFunnelEventAtIndex:1 matched:YES]);
+    XCTAssertTrue([rule markFunnelEventAtIndex:0 matched:YES]);
+    XCTAssertTrue([rule.eventFunnel[0] isMatched]);
+    XCTAssertFalse([rule markFunnelEventAtIndex:1 matched:NO]);
+}
+
+- (void)testConversionStateIsWrittenBehind {
+    TikTokKeyValueStore *store = [TikTokKeyValueStore sharedStore];
+    TikTokSKAdNetworkSupport *support = [TikTokSKAdNetworkSupport sharedInstance];
+    [support resetConversionValues];
+    XCTAssertNil([store objectForKey:TTAccumulatedSKANValuesKey]);
+    [support matchEventToSKANConfig:@"Purchase" withValue:@"2" currency:@"USD"];
+    [support matchEventToSKANConfig:@"Purchase" withValue:@"3" currency:@"USD"];
+    XCTAssertEqual([support getConversionWindowForTimestamp:[TikTokAppEventUtility getCurrentTimestamp]], 0);
+    XCTAssertEqualObjects([support accumulatedValueForEvent:@"Purchase"], @5);
+    XCTAssertNil([store objectForKey:TTAccumulatedSKANValuesKey]);
+    [support persistConversionState];
+    XCTAssertEqualObjects([store objectForKey:TTAccumulatedSKANValuesKey][@"Purchase"], @5);
+    [support resetConversionValues];
+}
+
+- (void)testEventWithoutRuleIsStillAccumulated {
+    TikTokSKAdNetworkSupport *support = [TikTokSKAdNetworkSupport sharedInstance];
+    [support resetConversionValues];
+    XCTAssertFalse([[TikTokSKAdNetworkConversionConfiguration sharedInstance].ruleIndex containsEvent:@"ViewContent"]);
+    [support matchEventToSKANConfig:@"ViewContent" withValue:@"4" currency:@"USD"];
+    XCTAssertEqualObjects([support accumulatedValueForEvent:@"ViewContent"], @4);
+    [support resetConversionValues];
+}
+
 - (void)testExchange {
     XCTAssertTrue([[[TikTokCurrencyUtility sharedInstance] exchangeAmount:@(1) fromCurrency:@"USD" toCurrency:@"CNY" shouldReport:YES] doubleValue] == 7.1);
 }
@@ -0,0 +1,137 @@
+//
+//  TikTokStartupSchedulerTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TikTokStartupTrace.h"
+#import "TikTokStartupScheduler.h"
+
+@interface TikTokStartupSchedulerTests : XCTestCase
+
+@property (nonatomic, strong) TikTokStartupTrace *trace;
+@property (nonatomic, strong) TikTokStartupScheduler *scheduler;
+
+@end
+
+@implementation TikTokStartupSchedulerTests
+
+- (void)setUp {
+    [super setUp];
+    self.trace = [[TikTokStartupTrace alloc] init];
+    self.scheduler = [[TikTokStartupScheduler alloc] initWithTrace:self.trace];
+}
+
+- (void)waitUntilIdle {
+    XCTestExpectation *idle = [self expectationWithDescription:@"idle"];
+    [self.scheduler notifyWhenIdle:^{
+        [idle fulfill];
+    }];
+    [self waitForExpectations:@[idle] timeout:2];
+}
+
+- (void)testSpansAreRecordedInOrder {
+    [self.trace traceSpan:@"first" block:^{
+        usleep(2000);
+    }];
+    TikTokStartupSpan *second = [self.trace beginSpan:@"second" deferred:YES];
+    XCTAssertEqual(second.duration, 0);
+    [second end];
+    uint64_t duration = second.duration;
+    [second end];
+    XCTAssertEqual(second.duration, duration);
+
+    NSArray<TikTokStartupSpan *> *spans = [self.trace spans];
+    XCTAssertEqual(spans.count, 2);
+    XCTAssertEqualObjects(spans[0].name, @"first");
+    XCTAssertGreaterThanOrEqual(spans[0].duration, 2000);
+    XCTAssertTrue(spans[0].onMainThread);
+    XCTAssertFalse(spans[0].isDeferred);
+    XCTAssertTrue(spans[1].isDeferred);
+    XCTAssertGreaterThanOrEqual(spans[1].startTime, spans[0].startTime + spans[0].duration);
+    XCTAssertEqual([self.trace synchronousDuration], spans[0].duration);
+    XCTAssertEqualObjects([self.trace dictionaryRepresentation][@"second"][@"deferred"], @YES);
+}
+
+- (void)testStagesRunByPriority {
+    NSMutableArray<NSString *> *order = [NSMutableArray array];
+    dispatch_semaphore_t started = dispatch_semaphore_create(0);
+    dispatch_semaphore_t blocker = dispatch_semaphore_create(0);
+    [self.scheduler scheduleStage:@"blocking" priority:TikTokStartupPriorityDefault block:^{
+        dispatch_semaphore_signal(started);
+        dispatch_semaphore_wait(blocker, DISPATCH_TIME_FOREVER);
+        [order addObject:@"blocking"];
+    }];
+    dispatch_semaphore_wait(started, DISPATCH_TIME_FOREVER);
+    [self.scheduler scheduleStage:@"upload" priority:TikTokStartupPriorityLow block:^{
+        [order addObject:@"upload"];
+    }];
+    [self.scheduler scheduleStage:@"observers" priority:TikTokStartupPriorityDefault block:^{
+        [order addObject:@"observers"];
+    }];
+    [self.scheduler scheduleStage:@"persistence" priority:TikTokStartupPriorityHigh block:^{
+        [order addObject:@"persistence"];
+        // scheduled from within a stage, still ahead of the lower priorities
+        [self.scheduler scheduleStage:@"nested" priority:TikTokStartupPriorityHigh block:^{
+            [order addObject:@"nested"];
+        }];
+    }];
+    dispatch_semaphore_signal(blocker);
+    [self waitUntilIdle];
+
+    NSArray *expected = @[@"blocking", @"persistence", @"nested", @"observers", @"upload"];
+    XCTAssertEqualObjects(order, expected);
+    NSArray<TikTokStartupSpan *> *spans = [self.trace spans];
+    XCTAssertEqual(spans.count, 5);
+    for (TikTokStartupSpan *span in spans) {
+        XCTAssertTrue(span.isDeferred);
+        XCTAssertFalse(span.onMainThread);
+        XCTAssertGreaterThan(span.duration, 0);
+    }
+    XCTAssertEqual([self.trace synchronousDuration], 0);
+}
+
+- (void)testStageNotificationWaitsForStage {
+    NSMutableArray<NSString *> *order = [NSMutableArray array];
+    dispatch_queue_t queue = dispatch_queue_create("com.TikTokBusiness.tests.stage", DISPATCH_QUEUE_SERIAL);
+    dispatch_semaphore_t blocker = dispatch_semaphore_create(0);
+    [self.scheduler scheduleStage:@"window" priority:TikTokStartupPriorityDefault block:^{
+        dispatch_semaphore_wait(blocker, DISPATCH_TIME_FOREVER);
+        @synchronized (order) {
+            [order addObject:@"window"];
+        }
+    }];
+    XCTestExpectation *notified = [self expectationWithDescription:@"notified"];
+    for (NSString *event in @[@"first", @"second"]) {
+        [self.scheduler notifyWhenStageFinished:@"window" queue:queue block:^{
+            @synchronized (order) {
+                [order addObject:event];
+            }
+            if ([event isEqualToString:@"second"]) {
+                [notified fulfill];
+            }
+        }];
+    }
+    dispatch_semaphore_signal(blocker);
+    [self waitForExpectations:@[notified] timeout:2];
+    NSArray *expected = @[@"window", @"first", @"second"];
+    XCTAssertEqualObjects(order, expected);
+
+    XCTestExpectation *unscheduled = [self expectationWithDescription:@"unscheduled"];
+    [self.scheduler notifyWhenStageFinished:@"never" queue:queue block:^{
+        [unscheduled fulfill];
+    }];
+    [self waitForExpectations:@[unscheduled] timeout:2];
+}
+
+- (void)testIdleNotificationWithoutStages {
+    [self waitUntilIdle];
+    [self.scheduler scheduleStage:@"stage" priority:TikTokStartupPriorityLow block:^{}];
+    [self waitUntilIdle];
+    XCTAssertEqual([self.trace spans].count, 1);
+}
+
+@end
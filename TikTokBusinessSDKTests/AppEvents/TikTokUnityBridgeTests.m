@@ -0,0 +1,223 @@
+//
+//  TikTokUnityBridgeTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TikTokUnityBridge+private.h"
+#import "TikTokEventBatchParser.h"
+#import "TikTokAppEvent.h"
+#import "TikTokBusiness.h"
+#import "TikTokBusiness+private.h"
+#import "TikTokEventLogger.h"
+#import "TikTokBaseEvent.h"
+#import "TikTokBaseEventPersistence.h"
+#import "TikTokJournalEventStore.h"
+
+// Below the 500 events a lane persists, so every event of a run is written
+static const int kBenchmarkEvents = 400;
+
+@interface TikTokUnityBridgeTests : XCTestCase
+
+@property (nonatomic, strong) NSMutableArray<TikTokAppEvent *> *received;
+@property (nonatomic, copy) TikTokBridgeEventSink sink;
+
+@end
+
+@implementation TikTokUnityBridgeTests
+
+- (void)setUp {
+    [super setUp];
+    self.received = [NSMutableArray array];
+    NSMutableArray<TikTokAppEvent *> *received = self.received;
+    // Accepts everything but events named "Duplicate"
+    self.sink = ^NSIndexSet *(NSArray<TikTokAppEvent *> *events) {
+        [received addObjectsFromArray:events];
+        return [events indexesOfObjectsPassingTest:^BOOL(TikTokAppEvent *event, NSUInteger index, BOOL *stop) {
+            return ![event.eventName isEqualToString:@"Duplicate"];
+        }];
+    };
+}
+
+- (int32_t)track:(NSString *)batch statuses:(int32_t *)statuses capacity:(int32_t)capacity sink:(TikTokBridgeEventSink)sink {
+    const char *buffer = batch.UTF8String;
+    return TikTokUnityTrackEventsWithSink(buffer, (int32_t)strlen(buffer), statuses, capacity, sink);
+}
+
+- (void)testStatusPerEvent {
+    NSString *batch = @"{\"event\":\"Purchase\",\"event_id\":\"p1\",\"properties\":{\"value\":1.5,\"currency\":\"USD\"}}\n"
+                      @"not json\n"
+                      @"\n"
+                      @"{\"event_id\":\"p2\"}\n"
+                      @"{\"event\":\"Search\",\"properties\":[1,2]}\n"
+                      @"{\"event\":\"Duplicate\"}\n"
+                      @"{\"event\":\"AddToCart\",\"properties\":null}";
+    int32_t statuses[6];
+    XCTAssertEqual([self track:batch statuses:statuses capacity:6 sink:self.sink], 6);
+    XCTAssertEqual(statuses[0], TikTokEventBatchStatusAccepted);
+    XCTAssertEqual(statuses[1], TikTokEventBatchStatusMalformed);
+    XCTAssertEqual(statuses[2], TikTokEventBatchStatusMissingName);
+    XCTAssertEqual(statuses[3], TikTokEventBatchStatusInvalidField);
+    XCTAssertEqual(statuses[4], TikTokEventBatchStatusDropped);
+    XCTAssertEqual(statuses[5], TikTokEventBatchStatusAccepted);
+
+    XCTAssertEqual(self.received.count, 3);
+    TikTokAppEvent *purchase = self.received[0];
+    XCTAssertEqualObjects(purchase.eventName, @"Purchase");
+    XCTAssertEqualObjects(purchase.properties[@"tt_event_id"], @"p1");
+    XCTAssertEqualObjects(purchase.properties[@"value"], @1.5);
+    XCTAssertEqualObjects(purchase.properties[@"currency"], @"USD");
+}
+
+- (void)testEscapedStrings {
+    NSString *batch = @"{\"event\":\"Caf\\u00e9 \\\"open\\\"\",\"properties\":{\"note\":\"a\\nb\"}}";
+    int32_t status = -1;
+    XCTAssertEqual([self track:batch statuses:&status capacity:1 sink:self.sink], 1);
+    XCTAssertEqual(status, TikTokEventBatchStatusAccepted);
+    XCTAssertEqualObjects(self.received.firstObject.eventName, @"Café \"open\"");
+    XCTAssertEqualObjects(self.received.firstObject.properties[@"note"], @"a\nb");
+}
+
+- (void)testStatusesBeyondCapacityAreStillTracked {
+    int32_t statuses[1] = { -1 };
+    XCTAssertEqual([self track:@"{\"event\":\"A\"}\n{\"event\":\"B\"}" statuses:statuses capacity:1 sink:self.sink], 2);
+    XCTAssertEqual(statuses[0], TikTokEventBatchStatusAccepted);
+    XCTAssertEqual(self.received.count, 2);
+}
+
+- (void)testNotTrackingWithoutSink {
+    int32_t statuses[2];
+    XCTAssertEqual([self track:@"{\"event\":\"A\"}\n{}" statuses:statuses capacity:2 sink:nil], 2);
+    XCTAssertEqual(statuses[0], TikTokEventBatchStatusNotTracking);
+    XCTAssertEqual(statuses[1], TikTokEventBatchStatusMissingName);
+}
+
+- (void)testNotTrackingWhenSinkDeclines {
+    int32_t status = -1;
+    TikTokBridgeEventSink declining = ^NSIndexSet *(NSArray<TikTokAppEvent *> *events) {
+        return nil;
+    };
+    XCTAssertEqual([self track:@"{\"event\":\"A\"}" statuses:&status capacity:1 sink:declining], 1);
+    XCTAssertEqual(status, TikTokEventBatchStatusNotTracking);
+}
+
+- (void)testTrackEventsReportsAdmissionWithScreenshots {
+    TikTokBusiness *business = [TikTokBusiness getInstance];
+    TikTokEventLogger *savedLogger = business.eventLogger;
+    BOOL savedRemoteSwitch = business.isRemoteSwitchOn;
+    business.eventLogger = [[TikTokEventLogger alloc] initWithConfig:nil];
+    [business setValue:@YES forKey:@"screenshotEnabled"];
+
+    NSString *orderID = [NSUUID UUID].UUIDString;
+    NSDictionary *properties = @{@"order": @{@"order_id": orderID}, @"value": @"0.99", @"currency": @"USD"};
+    NSArray<TikTokAppEvent *> *events = @[
+        [[TikTokAppEvent alloc] initWithEventName:@"Purchase" withProperties:properties withEventID:@""],
+        [[TikTokAppEvent alloc] initWithEventName:@"Purchase" withProperties:properties withEventID:@""],
+    ];
+
+    business.isRemoteSwitchOn = NO;
+    XCTAssertNil([business trackEvents:events]);
+
+    // the duplicate purchase is dropped before the screenshot is taken
+    business.isRemoteSwitchOn = YES;
+    XCTAssertEqualObjects([business trackEvents:events], [NSIndexSet indexSetWithIndex:0]);
+
+    [business setValue:@NO forKey:@"screenshotEnabled"];
+    business.isRemoteSwitchOn = savedRemoteSwitch;
+    business.eventLogger = savedLogger;
+}
+
+- (void)testNullBuffer {
+    XCTAssertEqual(TikTokUnityTrackEventsWithSink(NULL, 10, NULL, 0, self.sink), -1);
+    XCTAssertEqual(TikTokUnityTrackEvents(NULL, 10, NULL, 0), -1);
+}
+
+- (NSString *)benchmarkBatchWithRun:(NSUInteger)run {
+    NSMutableString *batch = [NSMutableString string];
+    for (int i = 0; i < kBenchmarkEvents; i++) {
+        [batch appendFormat:@"{\"event\":\"AddToCart\",\"event_id\":\"%lu-%d\",\"properties\":{\"value\":%d,\"currency\":\"USD\",\"content_id\":\"sku%d\"}}\n", (unsigned long)run, i, i, i];
+    }
+    return batch;
+}
+
+/// Run block with events tracked by the SDK into a journal in a temporary directory,
+/// passing a block that waits until the events tracked so far are persisted.
+- (void)withTemporaryEventStore:(void (^)(TikTokAppEventPersistence *persistence, dispatch_block_t waitForPersistence))block {
+    TikTokBusiness *business = [TikTokBusiness getInstance];
+    TikTokEventLogger *savedLogger = business.eventLogger;
+    BOOL savedRemoteSwitch = business.isRemoteSwitchOn;
+    TikTokAppEventPersistence *persistence = [TikTokAppEventPersistence persistence];
+    id savedStore = [persistence valueForKey:@"store"];
+    NSString *directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    [persistence setValue:[[TikTokJournalEventStore alloc] initWithDirectory:directory segmentSize:256 * 1024] forKey:@"store"];
+    TikTokEventLogger *logger = [[TikTokEventLogger alloc] initWithConfig:nil];
+    business.eventLogger = logger;
+    business.isRemoteSwitchOn = YES;
+
+    // Lane queues are serial, so a sync block runs after every write queued before it
+    dispatch_queue_t loggerQueue = [logger valueForKey:@"loggerQueue"];
+    block(persistence, ^{
+        dispatch_sync(loggerQueue, ^{});
+    });
+
+    business.isRemoteSwitchOn = savedRemoteSwitch;
+    business.eventLogger = savedLogger;
+    [persistence setValue:savedStore forKey:@"store"];
+    [[NSFileManager defaultManager] removeItemAtPath:directory error:nil];
+}
+
+// Events parsed from one batch, admitted together and persisted in one write per lane
+- (void)testBatchedBridgeThroughput {
+    [self withTemporaryEventStore:^(TikTokAppEventPersistence *persistence, dispatch_block_t waitForPersistence) {
+        TikTokBridgeEventSink sink = ^NSIndexSet *(NSArray<TikTokAppEvent *> *events) {
+            return [[TikTokBusiness getInstance] trackEvents:events];
+        };
+        int32_t *statuses = calloc(kBenchmarkEvents, sizeof(int32_t));
+        __block NSUInteger run = 0;
+        [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+            [persistence clearEvents];
+            NSString *batch = [self benchmarkBatchWithRun:run++];
+            [self startMeasuring];
+            [self track:batch statuses:statuses capacity:kBenchmarkEvents sink:sink];
+            waitForPersistence();
+            [self stopMeasuring];
+            XCTAssertEqual(statuses[kBenchmarkEvents - 1], TikTokEventBatchStatusAccepted);
+            XCTAssertEqual([persistence eventsCount], kBenchmarkEvents);
+        }];
+        free(statuses);
+    }];
+}
+
+// What a wrapper pays calling across the bridge once per event: strings marshaled
+// per call, properties parsed per call and each event tracked and persisted on its own
+- (void)testPerEventBridgeThroughput {
+    NSMutableArray<NSString *> *properties = [NSMutableArray array];
+    for (int i = 0; i < kBenchmarkEvents; i++) {
+        [properties addObject:[NSString stringWithFormat:@"{\"value\":%d,\"currency\":\"USD\",\"content_id\":\"sku%d\"}", i, i]];
+    }
+    [self withTemporaryEventStore:^(TikTokAppEventPersistence *persistence, dispatch_block_t waitForPersistence) {
+        __block NSUInteger run = 0;
+        [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+            [persistence clearEvents];
+            run++;
+            [self startMeasuring];
+            for (int i = 0; i < kBenchmarkEvents; i++) {
+                @autoreleasepool {
+                    NSString *name = [NSString stringWithUTF8String:"AddToCart"];
+                    NSString *eventId = [NSString stringWithFormat:@"%lu-%d", (unsigned long)run, i];
+                    NSData *data = [properties[i] dataUsingEncoding:NSUTF8StringEncoding];
+                    NSDictionary *dictionary = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+                    [TikTokBusiness trackTTEvent:[[TikTokBaseEvent alloc] initWithEventName:name properties:dictionary eventId:eventId]];
+                }
+            }
+            waitForPersistence();
+            [self stopMeasuring];
+            XCTAssertEqual([persistence eventsCount], kBenchmarkEvents);
+        }];
+    }];
+}
+
+@end
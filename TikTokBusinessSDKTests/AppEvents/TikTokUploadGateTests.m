@@ -0,0 +1,153 @@
+//
+//  TikTokUploadGateTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TikTokUploadGate.h"
+#import "TikTokUploadPolicy.h"
+#import "TikTokLaneScheduler.h"
+#import "TikTokRequestContext.h"
+
+// Reachability reported by the test
+@interface TikTokFakeReachability : NSObject <TikTokReachability>
+
+@property (nonatomic, copy, nullable) void (^reachabilityChanged)(BOOL reachable);
+
+- (void)report:(BOOL)reachable;
+
+@end
+
+@implementation TikTokFakeReachability
+
+- (void)start {
+}
+
+- (void)report:(BOOL)reachable {
+    self.reachabilityChanged(reachable);
+}
+
+@end
+
+@interface TikTokUploadGateTests : XCTestCase
+
+@property (nonatomic, strong) TikTokFakeReachability *reachability;
+@property (nonatomic, strong) TikTokLaneScheduler *scheduler;
+@property (nonatomic, strong) TikTokUploadGate *gate;
+
+@end
+
+@implementation TikTokUploadGateTests
+
+- (void)setUp {
+    [super setUp];
+    self.reachability = [TikTokFakeReachability new];
+    self.scheduler = [[TikTokLaneScheduler alloc] initWithMaxConcurrentSends:2 queue:dispatch_queue_create("com.TikTokBusiness.test", DISPATCH_QUEUE_SERIAL)];
+    self.gate = [[TikTokUploadGate alloc] initWithReachability:self.reachability scheduler:self.scheduler];
+}
+
+- (void)testPolicy {
+    TikTokUploadPolicy *policy = TikTokUploadPolicyCreate(2, 6);
+    // nothing reported yet
+    XCTAssertTrue(TikTokUploadPolicyShouldUpload(policy));
+    XCTAssertFalse(TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityReachable));
+    XCTAssertFalse(TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityUnreachable));
+    XCTAssertFalse(TikTokUploadPolicyShouldUpload(policy));
+    XCTAssertTrue(TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityReachable));
+    XCTAssertEqual(TikTokUploadPolicyMaxInFlight(policy), 6);
+    // flapping while draining doesn't start another drain
+    XCTAssertFalse(TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityUnreachable));
+    XCTAssertFalse(TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityReachable));
+    TikTokUploadPolicyEndDrain(policy);
+    XCTAssertFalse(TikTokUploadPolicyIsDraining(policy));
+    XCTAssertEqual(TikTokUploadPolicyMaxInFlight(policy), 2);
+    TikTokUploadPolicyDestroy(policy);
+}
+
+- (void)testUploadsHeldWhileUnreachable {
+    XCTAssertTrue([self.gate shouldUpload]);
+    [self.reachability report:NO];
+    XCTAssertFalse([self.gate shouldUpload]);
+    [self.reachability report:YES];
+    XCTAssertTrue([self.gate shouldUpload]);
+}
+
+- (void)testReconnectDrainsOnceWithWiderWindow {
+    __block NSInteger drains = 0;
+    __block dispatch_block_t finishDrain = nil;
+    self.gate.backlogDrain = ^(dispatch_block_t done) {
+        drains++;
+        finishDrain = done;
+    };
+
+    // the first report at launch isn't a reconnect
+    [self.reachability report:YES];
+    XCTAssertEqual(drains, 0);
+
+    [self.reachability report:NO];
+    [self.reachability report:YES];
+    XCTAssertEqual(drains, 1);
+    XCTAssertTrue([self.gate isDraining]);
+    XCTAssertGreaterThan(self.scheduler.maxConcurrentSends, 2);
+
+    [self.reachability report:NO];
+    [self.reachability report:YES];
+    XCTAssertEqual(drains, 1);
+
+    finishDrain();
+    XCTAssertFalse([self.gate isDraining]);
+    XCTAssertEqual(self.scheduler.maxConcurrentSends, 2);
+
+    [self.reachability report:NO];
+    [self.reachability report:YES];
+    XCTAssertEqual(drains, 2);
+}
+
+- (void)testOfflineAtLaunchDrainsOnceOnline {
+    __block NSInteger drains = 0;
+    self.gate.backlogDrain = ^(dispatch_block_t done) {
+        drains++;
+        done();
+    };
+
+    // what the system reachability reports when the first flags read is 0
+    [self.reachability report:NO];
+    XCTAssertFalse([self.gate shouldUpload]);
+    XCTAssertEqual(drains, 0);
+
+    [self.reachability report:YES];
+    XCTAssertTrue([self.gate shouldUpload]);
+    XCTAssertEqual(drains, 1);
+    XCTAssertFalse([self.gate isDraining]);
+}
+
+- (void)testNetworkChangeInvalidatesRequestContext {
+    NSUInteger version = [TikTokRequestContextCache sharedCache].version;
+    // e.g. Wi-Fi to cellular, reachable both times
+    [self.reachability report:YES];
+    [self.reachability report:YES];
+    XCTAssertGreaterThanOrEqual([TikTokRequestContextCache sharedCache].version, version + 2);
+}
+
+- (void)testSchedulerNotifiesWhenIdle {
+    XCTestExpectation *sent = [self expectationWithDescription:@"sent"];
+    XCTestExpectation *idle = [self expectationWithDescription:@"idle"];
+    __block BOOL sendFinished = NO;
+    [self.scheduler enqueueSend:^(dispatch_block_t done) {
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.05 * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+            sendFinished = YES;
+            [sent fulfill];
+            done();
+        });
+    } inLane:TikTokEventLaneStandard];
+    [self.scheduler notifyWhenIdle:^{
+        XCTAssertTrue(sendFinished);
+        [idle fulfill];
+    }];
+    [self waitForExpectations:@[sent, idle] timeout:2 enforceOrder:YES];
+}
+
+@end
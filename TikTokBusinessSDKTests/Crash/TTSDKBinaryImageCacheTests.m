@@ -0,0 +1,90 @@
+//
+//  TTSDKBinaryImageCacheTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <mach-o/dyld.h>
+#import "TTSDKDynamicLinker.h"
+
+@interface TTSDKBinaryImageCacheTests : XCTestCase
+
+@end
+
+@implementation TTSDKBinaryImageCacheTests
+
+- (void)setUp {
+    [super setUp];
+    ttsdkdl_init();
+}
+
+- (void)testCacheCoversLoadedImages {
+    int cachedCount = ttsdkdl_cachedImageCount();
+    XCTAssertGreaterThanOrEqual(cachedCount, (int)_dyld_image_count());
+}
+
+- (void)testCachedRecordsMatchParsedImages {
+    int cachedCount = ttsdkdl_cachedImageCount();
+    XCTAssertGreaterThan(cachedCount, 0);
+    NSMutableDictionary<NSNumber *, NSNumber *> *cachedIndexByAddress = [NSMutableDictionary dictionary];
+    for (int i = 0; i < cachedCount; i++) {
+        TTSDKBinaryImage image = { 0 };
+        if (ttsdkdl_getCachedBinaryImage(i, &image)) {
+            cachedIndexByAddress[@(image.address)] = @(i);
+        }
+    }
+
+    for (int i = 0; i < ttsdkdl_imageCount(); i++) {
+        TTSDKBinaryImage expected = { 0 };
+        XCTAssertTrue(ttsdkdl_getBinaryImage(i, &expected));
+        NSNumber *cachedIndex = cachedIndexByAddress[@(expected.address)];
+        XCTAssertNotNil(cachedIndex);
+        TTSDKBinaryImage actual = { 0 };
+        XCTAssertTrue(ttsdkdl_getCachedBinaryImage(cachedIndex.intValue, &actual));
+        XCTAssertEqual(actual.vmAddress, expected.vmAddress);
+        XCTAssertEqual(actual.size, expected.size);
+        XCTAssertEqual(actual.uuid, expected.uuid);
+        XCTAssertEqual(actual.cpuType, expected.cpuType);
+        XCTAssertEqual(actual.cpuSubType, expected.cpuSubType);
+        XCTAssertEqual(actual.majorVersion, expected.majorVersion);
+        XCTAssertEqual(actual.minorVersion, expected.minorVersion);
+        XCTAssertEqual(actual.revisionVersion, expected.revisionVersion);
+        XCTAssertEqual(actual.crashInfoMessage, expected.crashInfoMessage);
+        XCTAssertEqual(actual.crashInfoMessage2, expected.crashInfoMessage2);
+    }
+}
+
+- (void)testOutOfRangeIndexIsRejected {
+    TTSDKBinaryImage image = { 0 };
+    XCTAssertFalse(ttsdkdl_getCachedBinaryImage(-1, &image));
+    XCTAssertFalse(ttsdkdl_getCachedBinaryImage(ttsdkdl_cachedImageCount(), &image));
+}
+
+- (void)testParsedImagesPerformance {
+    [self measureBlock:^{
+        for (int pass = 0; pass < 10; pass++) {
+            int imageCount = ttsdkdl_imageCount();
+            for (int i = 0; i < imageCount; i++) {
+                TTSDKBinaryImage image = { 0 };
+                ttsdkdl_getBinaryImage(i, &image);
+            }
+        }
+    }];
+}
+
+- (void)testCachedImagesPerformance {
+    [self measureBlock:^{
+        for (int pass = 0; pass < 10; pass++) {
+            int imageCount = ttsdkdl_cachedImageCount();
+            for (int i = 0; i < imageCount; i++) {
+                TTSDKBinaryImage image = { 0 };
+                ttsdkdl_getCachedBinaryImage(i, &image);
+            }
+        }
+    }];
+}
+
+@end
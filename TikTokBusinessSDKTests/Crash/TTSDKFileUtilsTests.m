@@ -0,0 +1,117 @@
+//
+//  TTSDKFileUtilsTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TTSDKFileUtils.h"
+
+static const int kReportChunkLength = 200;
+static const int kReportChunkCount = 1500;
+
+@interface TTSDKFileUtilsTests : XCTestCase
+
+@property (nonatomic, copy) NSString *directory;
+
+@end
+
+@implementation TTSDKFileUtilsTests
+
+- (void)setUp {
+    [super setUp];
+    self.directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    [[NSFileManager defaultManager] createDirectoryAtPath:self.directory withIntermediateDirectories:YES attributes:nil error:nil];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:self.directory error:nil];
+    [super tearDown];
+}
+
+- (NSString *)pathForName:(NSString *)name {
+    return [self.directory stringByAppendingPathComponent:name];
+}
+
+- (void)writeBytes:(int)count toRegionOfSize:(int)regionSize {
+    NSString *regionPath = [self pathForName:@"region.bin"];
+    NSString *reportPath = [self pathForName:@"report.json"];
+    TTSDKMappedRegion region;
+    XCTAssertTrue(ttsdkfu_reserveMappedRegion(&region, regionPath.UTF8String, regionSize));
+
+    char buffer[64];
+    TTSDKBufferedWriter writer;
+    XCTAssertTrue(ttsdkfu_openMappedWriter(&writer, &region, reportPath.UTF8String, buffer, sizeof(buffer)));
+    for (int i = 0; i < count; i++) {
+        char ch = (char)('a' + i % 26);
+        XCTAssertTrue(ttsdkfu_writeBufferedWriter(&writer, &ch, 1));
+    }
+    ttsdkfu_closeBufferedWriter(&writer);
+
+    NSData *data = [NSData dataWithContentsOfFile:reportPath];
+    XCTAssertEqual((int)data.length, count);
+    const char *bytes = data.bytes;
+    for (int i = 0; i < count; i++) {
+        if (bytes[i] != (char)('a' + i % 26)) {
+            XCTFail(@"Unexpected byte at offset %d", i);
+            break;
+        }
+    }
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:regionPath]);
+}
+
+- (void)testMappedWriterTruncatesToWrittenSize {
+    [self writeBytes:1000 toRegionOfSize:4096];
+}
+
+- (void)testMappedWriterFallsBackWhenRegionOverflows {
+    [self writeBytes:10000 toRegionOfSize:4096];
+}
+
+- (void)testMappedRegionCanOnlyBeUsedOnce {
+    TTSDKMappedRegion region;
+    XCTAssertTrue(ttsdkfu_reserveMappedRegion(&region, [self pathForName:@"region.bin"].UTF8String, 4096));
+    char buffer[64];
+    TTSDKBufferedWriter writer;
+    XCTAssertTrue(ttsdkfu_openMappedWriter(&writer, &region, [self pathForName:@"1.json"].UTF8String, buffer, sizeof(buffer)));
+    ttsdkfu_closeBufferedWriter(&writer);
+    XCTAssertFalse(ttsdkfu_openMappedWriter(&writer, &region, [self pathForName:@"2.json"].UTF8String, buffer, sizeof(buffer)));
+}
+
+- (void)writeReportUsingRegion:(BOOL)useRegion {
+    NSString *reportPath = [self pathForName:@"report.json"];
+    char chunk[kReportChunkLength];
+    memset(chunk, 'x', sizeof(chunk));
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        [[NSFileManager defaultManager] removeItemAtPath:reportPath error:nil];
+        TTSDKMappedRegion region;
+        if (useRegion) {
+            ttsdkfu_reserveMappedRegion(&region, [self pathForName:@"region.bin"].UTF8String, 512 * 1024);
+        }
+        char buffer[1024];
+        TTSDKBufferedWriter writer;
+        [self startMeasuring];
+        if (useRegion) {
+            ttsdkfu_openMappedWriter(&writer, &region, reportPath.UTF8String, buffer, sizeof(buffer));
+        } else {
+            ttsdkfu_openBufferedWriter(&writer, reportPath.UTF8String, buffer, sizeof(buffer));
+        }
+        for (int i = 0; i < kReportChunkCount; i++) {
+            ttsdkfu_writeBufferedWriter(&writer, chunk, sizeof(chunk));
+        }
+        ttsdkfu_closeBufferedWriter(&writer);
+        [self stopMeasuring];
+    }];
+}
+
+- (void)testReportWriteLatencyWithBufferedWriter {
+    [self writeReportUsingRegion:NO];
+}
+
+- (void)testReportWriteLatencyWithMappedRegion {
+    [self writeReportUsingRegion:YES];
+}
+
+@end
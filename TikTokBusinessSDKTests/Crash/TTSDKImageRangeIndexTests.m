@@ -0,0 +1,163 @@
+//
+//  TTSDKImageRangeIndexTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TTSDKDynamicLinker.h"
+#import "TTSDKImageRangeIndex.h"
+
+static const int kImageCount = 600;
+static const int kSegmentsPerImage = 4;
+static const int kLookupCount = 100000;
+
+@interface TTSDKImageRangeIndexTests : XCTestCase
+
+@property (nonatomic, assign) TTSDKImageRange *ranges;
+@property (nonatomic, assign) uintptr_t *addresses;
+@property (nonatomic, assign) TTSDKImageRangeIndex *index;
+
+@end
+
+@implementation TTSDKImageRangeIndexTests
+
+- (void)setUp {
+    [super setUp];
+    // Synthetic layout: segments of random size with random gaps between them.
+    srand(1);
+    int rangeCount = kImageCount * kSegmentsPerImage;
+    self.ranges = calloc(rangeCount, sizeof(TTSDKImageRange));
+    uintptr_t base = 0x100000000;
+    for (int i = 0; i < rangeCount; i++) {
+        uintptr_t size = 0x1000 * (uintptr_t)(1 + rand() % 64);
+        self.ranges[i] = (TTSDKImageRange) {
+            .start = base,
+            .end = base + size,
+            .header = (const void *)(uintptr_t)(i / kSegmentsPerImage + 1),
+        };
+        base += size + 0x1000 * (uintptr_t)(rand() % 4);
+    }
+    self.addresses = calloc(kLookupCount, sizeof(uintptr_t));
+    for (int i = 0; i < kLookupCount; i++) {
+        self.addresses[i] = 0x100000000 + (uintptr_t)rand() % (base - 0x100000000);
+    }
+
+    // Add images in shuffled order, as dyld doesn't load them in address order.
+    self.index = ttsdkiri_create(16);
+    int order[kImageCount];
+    for (int i = 0; i < kImageCount; i++) {
+        order[i] = i;
+    }
+    for (int i = kImageCount - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+    for (int i = 0; i < kImageCount; i++) {
+        XCTAssertTrue(ttsdkiri_addImage(self.index, &self.ranges[order[i] * kSegmentsPerImage], kSegmentsPerImage));
+    }
+}
+
+- (void)tearDown {
+    ttsdkiri_destroy(self.index);
+    free(self.ranges);
+    free(self.addresses);
+    [super tearDown];
+}
+
+- (int)linearFind:(uintptr_t)address {
+    for (int i = 0; i < kImageCount * kSegmentsPerImage; i++) {
+        if (address >= self.ranges[i].start && address < self.ranges[i].end) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+- (void)testFindMatchesLinearSearch {
+    XCTAssertEqual(ttsdkiri_rangeCount(self.index), kImageCount * kSegmentsPerImage);
+    for (int i = 0; i < kLookupCount; i++) {
+        TTSDKImageRange range;
+        TTSDKImageRangeLookupResult result = ttsdkiri_find(self.index, self.addresses[i], &range);
+        int expected = [self linearFind:self.addresses[i]];
+        if (expected < 0) {
+            XCTAssertEqual(result, TTSDKImageRangeLookupNotFound);
+        } else {
+            XCTAssertEqual(result, TTSDKImageRangeLookupFound);
+            XCTAssertEqual(range.header, self.ranges[expected].header);
+        }
+    }
+}
+
+- (void)testRemoveImage {
+    TTSDKImageRange removed = self.ranges[10 * kSegmentsPerImage];
+    ttsdkiri_removeImage(self.index, removed.header);
+    XCTAssertEqual(ttsdkiri_rangeCount(self.index), (kImageCount - 1) * kSegmentsPerImage);
+    TTSDKImageRange range;
+    XCTAssertEqual(ttsdkiri_find(self.index, removed.start, &range), TTSDKImageRangeLookupNotFound);
+}
+
+- (void)testEmptyIndexIsUnavailable {
+    TTSDKImageRangeIndex *index = ttsdkiri_create(16);
+    TTSDKImageRange range;
+    XCTAssertEqual(ttsdkiri_find(index, 0x1000, &range), TTSDKImageRangeLookupUnavailable);
+    ttsdkiri_destroy(index);
+}
+
+- (void)testLookupsStayConsistentDuringUpdates {
+    TTSDKImageRangeIndex *index = self.index;
+    const TTSDKImageRange *churned = &self.ranges[(kImageCount - 1) * kSegmentsPerImage];
+    __block BOOL stop = NO;
+    dispatch_semaphore_t done = dispatch_semaphore_create(0);
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+        while (!stop) {
+            ttsdkiri_removeImage(index, churned->header);
+            ttsdkiri_addImage(index, churned, kSegmentsPerImage);
+        }
+        dispatch_semaphore_signal(done);
+    });
+    for (int i = 0; i < kLookupCount; i++) {
+        TTSDKImageRange range;
+        TTSDKImageRangeLookupResult result = ttsdkiri_find(index, self.addresses[i], &range);
+        int expected = [self linearFind:self.addresses[i]];
+        if (result == TTSDKImageRangeLookupUnavailable || (expected >= 0 && self.ranges[expected].header == churned->header)) {
+            continue;
+        }
+        XCTAssertEqual(result, expected < 0 ? TTSDKImageRangeLookupNotFound : TTSDKImageRangeLookupFound);
+    }
+    stop = YES;
+    dispatch_semaphore_wait(done, DISPATCH_TIME_FOREVER);
+}
+
+- (void)testDladdrMatchesSystem {
+    ttsdkdl_init();
+    uintptr_t address = (uintptr_t)&ttsdkiri_find;
+    Dl_info expected;
+    Dl_info actual;
+    XCTAssertTrue(dladdr((const void *)address, &expected) != 0);
+    XCTAssertTrue(ttsdkdl_dladdr(address, &actual));
+    XCTAssertEqual(actual.dli_fbase, expected.dli_fbase);
+}
+
+- (void)testLinearLookupPerformance {
+    [self measureBlock:^{
+        for (int i = 0; i < kLookupCount; i++) {
+            [self linearFind:self.addresses[i]];
+        }
+    }];
+}
+
+- (void)testIndexedLookupPerformance {
+    [self measureBlock:^{
+        for (int i = 0; i < kLookupCount; i++) {
+            TTSDKImageRange range;
+            ttsdkiri_find(self.index, self.addresses[i], &range);
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,161 @@
+//
+//  TTSDKRingLogTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <fcntl.h>
+#import "TTSDKRingLog.h"
+
+static const int kRingSize = 64 * 1024;
+static const int kLineCount = 100000;
+
+@interface TTSDKRingLogTests : XCTestCase
+
+@property (nonatomic, assign) TTSDKRingLog *ring;
+@property (nonatomic, strong) NSMutableData *output;
+@property (nonatomic, strong) NSMutableArray<NSString *> *lines;
+
+@end
+
+static void appendToData(const char *data, int length, void *context)
+{
+    [(__bridge NSMutableData *)context appendBytes:data length:(NSUInteger)length];
+}
+
+static void appendToLines(const char *data, int length, void *context)
+{
+    NSString *line = [[NSString alloc] initWithBytes:data length:(NSUInteger)length encoding:NSUTF8StringEncoding];
+    [(__bridge NSMutableArray *)context addObject:line];
+}
+
+@implementation TTSDKRingLogTests
+
+- (void)setUp {
+    [super setUp];
+    self.ring = ttsdkrl_create(kRingSize);
+    self.output = [NSMutableData data];
+    self.lines = [NSMutableArray array];
+}
+
+- (void)tearDown {
+    ttsdkrl_destroy(self.ring);
+    [super tearDown];
+}
+
+- (void)append:(NSString *)text {
+    ttsdkrl_append(self.ring, text.UTF8String, (int)strlen(text.UTF8String));
+}
+
+- (int)drain {
+    char buffer[1024];
+    return ttsdkrl_drain(self.ring, buffer, sizeof(buffer), appendToData, (__bridge void *)self.output);
+}
+
+- (NSString *)drainedText {
+    return [[NSString alloc] initWithData:self.output encoding:NSUTF8StringEncoding];
+}
+
+- (void)testDrainReturnsTextInOrder {
+    NSString *longLine = [[@"" stringByPaddingToLength:1000 withString:@"x" startingAtIndex:0] stringByAppendingString:@"\n"];
+    [self append:@"first\n"];
+    [self append:longLine];
+    [self append:@"last\n"];
+    XCTAssertEqual([self drain], 6 + 1001 + 5);
+    XCTAssertEqualObjects([self drainedText], ([NSString stringWithFormat:@"first\n%@last\n", longLine]));
+    XCTAssertEqual([self drain], 0);
+}
+
+- (void)testRecentLines {
+    for (int i = 0; i < 1000; i++) {
+        [self append:[NSString stringWithFormat:@"line %d\n", i]];
+    }
+    ttsdkrl_readRecentLines(self.ring, 1024, appendToLines, (__bridge void *)self.lines);
+    XCTAssertGreaterThan(self.lines.count, 0);
+    XCTAssertEqualObjects(self.lines.lastObject, @"line 999");
+    for (NSUInteger i = 0; i < self.lines.count; i++) {
+        XCTAssertEqualObjects(self.lines[i], ([NSString stringWithFormat:@"line %lu", 1000 - self.lines.count + i]));
+    }
+}
+
+- (void)testRecentLinesDoesNotConsume {
+    [self append:@"hello\n"];
+    ttsdkrl_readRecentLines(self.ring, 1024, appendToLines, (__bridge void *)self.lines);
+    XCTAssertEqualObjects(self.lines, (@[ @"hello" ]));
+    XCTAssertEqual([self drain], 6);
+}
+
+- (void)testMarkClearedHidesOlderLines {
+    [self append:@"before\n"];
+    ttsdkrl_markCleared(self.ring);
+    [self append:@"after\n"];
+    ttsdkrl_readRecentLines(self.ring, kRingSize, appendToLines, (__bridge void *)self.lines);
+    XCTAssertEqualObjects(self.lines, (@[ @"after" ]));
+}
+
+- (void)testOverwrittenTextIsCountedAsDropped {
+    for (int i = 0; i < kLineCount; i++) {
+        [self append:[NSString stringWithFormat:@"line %d\n", i]];
+    }
+    [self drain];
+    XCTAssertGreaterThan(ttsdkrl_droppedSlotCount(self.ring), 0);
+    XCTAssertLessThanOrEqual(self.output.length, (NSUInteger)kRingSize);
+    XCTAssertTrue([[self drainedText] hasSuffix:[NSString stringWithFormat:@"line %d\n", kLineCount - 1]]);
+}
+
+- (void)testConcurrentAppendersLoseNothingWhileDrained {
+    const int threadCount = 4;
+    const int linesPerThread = 2000;
+    dispatch_group_t group = dispatch_group_create();
+    for (int thread = 0; thread < threadCount; thread++) {
+        dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+            for (int i = 0; i < linesPerThread; i++) {
+                char line[32];
+                int length = snprintf(line, sizeof(line), "%d:%d\n", thread, i);
+                ttsdkrl_append(self.ring, line, length);
+                if (i % 64 == 0) {
+                    usleep(100);
+                }
+            }
+        });
+    }
+    while (dispatch_group_wait(group, DISPATCH_TIME_NOW) != 0) {
+        [self drain];
+    }
+    [self drain];
+    if (ttsdkrl_droppedSlotCount(self.ring) == 0) {
+        NSArray *lines = [[self drainedText] componentsSeparatedByString:@"\n"];
+        XCTAssertEqual(lines.count, (NSUInteger)(threadCount * linesPerThread + 1));
+        XCTAssertEqual([NSSet setWithArray:lines].count, lines.count);
+    }
+}
+
+- (void)testAppendPerformance {
+    const char *line = "DEBUG: TTSDKCrashC.c (123): ttsdkcrash_install: Installing crash reporter.\n";
+    int length = (int)strlen(line);
+    [self measureBlock:^{
+        for (int i = 0; i < kLineCount; i++) {
+            ttsdkrl_append(self.ring, line, length);
+        }
+    }];
+}
+
+- (void)testFileWritePerformance {
+    // What every log call used to cost: a write to the console log file.
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    int fd = open(path.fileSystemRepresentation, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    const char *line = "DEBUG: TTSDKCrashC.c (123): ttsdkcrash_install: Installing crash reporter.\n";
+    size_t length = strlen(line);
+    [self measureBlock:^{
+        for (int i = 0; i < kLineCount; i++) {
+            write(fd, line, length);
+        }
+    }];
+    close(fd);
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+}
+
+@end
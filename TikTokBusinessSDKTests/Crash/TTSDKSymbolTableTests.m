@@ -0,0 +1,160 @@
+//
+//  TTSDKSymbolTableTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TTSDKSymbolTable.h"
+
+static const uint64_t kBaseAddress = 0x100000000;
+static const int kSymbolCount = 50000;
+static const int kLookupCount = 2000;
+
+@interface TTSDKSymbolTableTests : XCTestCase
+
+@property (nonatomic, assign) TTSDKSymbolEntry *symbols;
+@property (nonatomic, assign) char *strings;
+@property (nonatomic, assign) uint32_t stringsSize;
+@property (nonatomic, assign) uint64_t *addresses;
+@property (nonatomic, assign) TTSDKSymbolTable *table;
+@property (nonatomic, copy) NSString *indexPath;
+
+@end
+
+@implementation TTSDKSymbolTableTests
+
+- (void)setUp {
+    [super setUp];
+    // Synthetic symbols in nlist order (unsorted, with duplicate addresses and some stripped names).
+    srand(1);
+    self.symbols = calloc(kSymbolCount, sizeof(TTSDKSymbolEntry));
+    self.strings = calloc(kSymbolCount, 16);
+    uint32_t position = 1;
+    for (int i = 0; i < kSymbolCount; i++) {
+        self.symbols[i].offset = (uint32_t)(rand() % (kSymbolCount * 8));
+        if (i % 97 == 0) {
+            self.symbols[i].nameOffset = TTSDKSymbolNoName;
+        } else {
+            self.symbols[i].nameOffset = position;
+            position += (uint32_t)sprintf(self.strings + position, "_symbol%d", i) + 1;
+        }
+    }
+    self.stringsSize = position;
+    self.addresses = calloc(kLookupCount, sizeof(uint64_t));
+    for (int i = 0; i < kLookupCount; i++) {
+        self.addresses[i] = kBaseAddress - 16 + (uint64_t)(rand() % (kSymbolCount * 9));
+    }
+    self.table = ttsdksym_createTable((const void *)0x1000, kBaseAddress, self.strings, self.stringsSize,
+                                      self.symbols, kSymbolCount);
+    self.indexPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+}
+
+- (void)tearDown {
+    ttsdksym_destroyTable(self.table);
+    free(self.symbols);
+    free(self.strings);
+    free(self.addresses);
+    [[NSFileManager defaultManager] removeItemAtPath:self.indexPath error:nil];
+    [super tearDown];
+}
+
+/** The nearest-match scan ttsdkdl_dladdr() used to do over the nlist array. */
+- (int)linearFind:(uint64_t)address {
+    int best = -1;
+    uint64_t bestDistance = UINT64_MAX;
+    for (int i = 0; i < kSymbolCount; i++) {
+        uint64_t symbolAddress = kBaseAddress + self.symbols[i].offset;
+        if (address >= symbolAddress && address - symbolAddress <= bestDistance) {
+            best = i;
+            bestDistance = address - symbolAddress;
+        }
+    }
+    return best;
+}
+
+- (void)assertTable:(const TTSDKSymbolTable *)table matchesLinearSearchForAddress:(uint64_t)address {
+    int expected = [self linearFind:address];
+    uint64_t symbolAddress = 0;
+    const char *symbolName = NULL;
+    BOOL found = ttsdksym_lookup(table, address, &symbolAddress, &symbolName);
+    XCTAssertEqual(found, expected >= 0);
+    if (expected < 0) {
+        return;
+    }
+    XCTAssertEqual(symbolAddress, kBaseAddress + self.symbols[expected].offset);
+    if (self.symbols[expected].nameOffset == TTSDKSymbolNoName) {
+        XCTAssertTrue(symbolName == NULL);
+    } else {
+        XCTAssertEqual(strcmp(symbolName, self.strings + self.symbols[expected].nameOffset), 0);
+    }
+}
+
+- (void)testLookupMatchesLinearSearch {
+    XCTAssertTrue(self.table != NULL);
+    XCTAssertLessThan(ttsdksym_symbolCount(self.table), kSymbolCount);
+    for (int i = 0; i < kLookupCount; i++) {
+        [self assertTable:self.table matchesLinearSearchForAddress:self.addresses[i]];
+    }
+}
+
+- (void)testIndexFileRoundTrip {
+    uint8_t uuid[16] = { 1, 2, 3, 4 };
+    XCTAssertTrue(ttsdksym_writeIndexFile(self.table, uuid, self.indexPath.fileSystemRepresentation));
+    TTSDKSymbolTable *loaded = ttsdksym_openIndexFile(self.indexPath.fileSystemRepresentation, (const void *)0x2000, uuid);
+    XCTAssertTrue(loaded != NULL);
+    XCTAssertEqual(ttsdksym_symbolCount(loaded), ttsdksym_symbolCount(self.table));
+    XCTAssertEqual(ttsdksym_baseAddress(loaded), kBaseAddress);
+    for (int i = 0; i < kLookupCount; i++) {
+        [self assertTable:loaded matchesLinearSearchForAddress:self.addresses[i]];
+    }
+    ttsdksym_destroyTable(loaded);
+}
+
+- (void)testIndexFileForOtherBinaryIsRejected {
+    uint8_t uuid[16] = { 1, 2, 3, 4 };
+    uint8_t otherUUID[16] = { 4, 3, 2, 1 };
+    XCTAssertTrue(ttsdksym_writeIndexFile(self.table, uuid, self.indexPath.fileSystemRepresentation));
+    XCTAssertTrue(ttsdksym_openIndexFile(self.indexPath.fileSystemRepresentation, NULL, otherUUID) == NULL);
+}
+
+- (void)testTruncatedIndexFileIsRejected {
+    uint8_t uuid[16] = { 1, 2, 3, 4 };
+    XCTAssertTrue(ttsdksym_writeIndexFile(self.table, uuid, self.indexPath.fileSystemRepresentation));
+    NSData *data = [NSData dataWithContentsOfFile:self.indexPath];
+    [[data subdataWithRange:NSMakeRange(0, data.length - 1)] writeToFile:self.indexPath atomically:YES];
+    XCTAssertTrue(ttsdksym_openIndexFile(self.indexPath.fileSystemRepresentation, NULL, uuid) == NULL);
+}
+
+- (void)testRegistry {
+    TTSDKSymbolEntry entry = { .offset = 0, .nameOffset = TTSDKSymbolNoName };
+    const void *header = (const void *)0x7000000;
+    TTSDKSymbolTable *table = ttsdksym_createTable(header, kBaseAddress, NULL, 0, &entry, 1);
+    XCTAssertTrue(ttsdksym_tableForImage(header) == NULL);
+    XCTAssertTrue(ttsdksym_publishTable(table));
+    XCTAssertTrue(ttsdksym_tableForImage(header) == table);
+    ttsdksym_retireTable(header);
+    XCTAssertTrue(ttsdksym_tableForImage(header) == NULL);
+}
+
+- (void)testLinearLookupPerformance {
+    [self measureBlock:^{
+        for (int i = 0; i < kLookupCount; i++) {
+            [self linearFind:self.addresses[i]];
+        }
+    }];
+}
+
+- (void)testTableLookupPerformance {
+    [self measureBlock:^{
+        for (int i = 0; i < kLookupCount; i++) {
+            uint64_t symbolAddress;
+            const char *symbolName;
+            ttsdksym_lookup(self.table, self.addresses[i], &symbolAddress, &symbolName);
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,123 @@
+//
+//  TTSDKThreadRegistryTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TTSDKThreadRegistry.h"
+
+static const int kThreadCount = 200;
+
+@interface TTSDKThreadRegistryTests : XCTestCase
+
+@property (nonatomic, assign) TTSDKThreadRegistry *registry;
+
+@end
+
+@implementation TTSDKThreadRegistryTests
+
+- (void)setUp {
+    [super setUp];
+    self.registry = ttsdktr_create(16);
+}
+
+- (void)tearDown {
+    ttsdktr_destroy(self.registry);
+    [super tearDown];
+}
+
+/** Synthetic thread list: mach ports are small numbers, every third thread is named, every fifth has a queue. */
+- (BOOL)updateWithThreadCount:(int)count renamedThread:(int)renamed {
+    XCTAssertTrue(ttsdktr_beginUpdate(self.registry, count));
+    char threadName[64];
+    char queueName[64];
+    for (int i = 0; i < count; i++) {
+        snprintf(threadName, sizeof(threadName), i == renamed ? "renamed-%d" : "thread-%d", i);
+        snprintf(queueName, sizeof(queueName), "com.example.queue-%d", i);
+        ttsdktr_addThread(self.registry, (TTSDKThread)(0x103 + i * 0x100), (TTSDKThread)(0x16d000000 + i * 0x1000),
+                          i % 3 == 0 ? threadName : NULL, i % 5 == 0 ? queueName : NULL);
+    }
+    return ttsdktr_commitUpdate(self.registry);
+}
+
+- (void)testNothingPublishedInitially {
+    int count = -1;
+    XCTAssertTrue(ttsdktr_getAllThreads(self.registry, &count) == NULL);
+    XCTAssertEqual(count, 0);
+    XCTAssertTrue(ttsdktr_getThreadName(self.registry, 0x103) == NULL);
+}
+
+- (void)testLookups {
+    XCTAssertTrue([self updateWithThreadCount:kThreadCount renamedThread:-1]);
+    int count = 0;
+    TTSDKThread *threads = ttsdktr_getAllThreads(self.registry, &count);
+    XCTAssertEqual(count, kThreadCount);
+    for (int i = 0; i < kThreadCount; i++) {
+        XCTAssertEqual(threads[i], (TTSDKThread)(0x103 + i * 0x100));
+        const char *threadName = ttsdktr_getThreadName(self.registry, threads[i]);
+        const char *queueName = ttsdktr_getQueueName(self.registry, threads[i]);
+        if (i % 3 == 0) {
+            XCTAssertEqualObjects(@(threadName), ([NSString stringWithFormat:@"thread-%d", i]));
+        } else {
+            XCTAssertTrue(threadName == NULL);
+        }
+        if (i % 5 == 0) {
+            XCTAssertEqualObjects(@(queueName), ([NSString stringWithFormat:@"com.example.queue-%d", i]));
+        } else {
+            XCTAssertTrue(queueName == NULL);
+        }
+    }
+    XCTAssertTrue(ttsdktr_getThreadName(self.registry, 0x2) == NULL);
+}
+
+- (void)testUnchangedUpdateIsNotPublished {
+    XCTAssertTrue([self updateWithThreadCount:kThreadCount renamedThread:-1]);
+    int generation = ttsdktr_generation(self.registry);
+    XCTAssertFalse([self updateWithThreadCount:kThreadCount renamedThread:-1]);
+    XCTAssertFalse([self updateWithThreadCount:kThreadCount renamedThread:-1]);
+    XCTAssertEqual(ttsdktr_generation(self.registry), generation);
+    XCTAssertEqualObjects(@(ttsdktr_getThreadName(self.registry, 0x103)), @"thread-0");
+}
+
+- (void)testRenamePublishes {
+    XCTAssertTrue([self updateWithThreadCount:kThreadCount renamedThread:-1]);
+    XCTAssertTrue([self updateWithThreadCount:kThreadCount renamedThread:3]);
+    XCTAssertEqualObjects(@(ttsdktr_getThreadName(self.registry, 0x103 + 3 * 0x100)), @"renamed-3");
+    XCTAssertEqualObjects(@(ttsdktr_getThreadName(self.registry, 0x103 + 6 * 0x100)), @"thread-6");
+}
+
+- (void)testExitedThreadsDisappear {
+    XCTAssertTrue([self updateWithThreadCount:kThreadCount renamedThread:-1]);
+    XCTAssertTrue([self updateWithThreadCount:10 renamedThread:-1]);
+    int count = 0;
+    ttsdktr_getAllThreads(self.registry, &count);
+    XCTAssertEqual(count, 10);
+    XCTAssertTrue(ttsdktr_getThreadName(self.registry, 0x103 + 99 * 0x100) == NULL);
+    XCTAssertEqualObjects(@(ttsdktr_getThreadName(self.registry, 0x103 + 9 * 0x100)), @"thread-9");
+}
+
+- (void)testSteadyStateUpdatePerformance {
+    [self updateWithThreadCount:kThreadCount renamedThread:-1];
+    [self measureBlock:^{
+        for (int i = 0; i < 1000; i++) {
+            [self updateWithThreadCount:kThreadCount renamedThread:-1];
+        }
+    }];
+}
+
+- (void)testNameLookupPerformance {
+    [self updateWithThreadCount:kThreadCount renamedThread:-1];
+    [self measureBlock:^{
+        for (int pass = 0; pass < 1000; pass++) {
+            for (int i = 0; i < kThreadCount; i++) {
+                ttsdktr_getThreadName(self.registry, (TTSDKThread)(0x103 + i * 0x100));
+                ttsdktr_getQueueName(self.registry, (TTSDKThread)(0x103 + i * 0x100));
+            }
+        }
+    }];
+}
+
+@end
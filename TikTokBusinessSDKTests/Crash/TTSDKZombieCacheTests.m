@@ -0,0 +1,140 @@
+//
+//  TTSDKZombieCacheTests.m
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TTSDKZombieCache.h"
+
+static const int kCacheSize = 0x8000;
+static const int kDeallocCount = 1000000;
+static const uintptr_t kHeapBase = 0x600000000000;
+
+@interface TTSDKZombieCacheTests : XCTestCase
+
+@property (nonatomic, assign) TTSDKZombieCache *cache;
+@property (nonatomic, assign) TTSDKClassFlagCache *classFlags;
+
+@end
+
+@implementation TTSDKZombieCacheTests
+
+- (void)setUp {
+    [super setUp];
+    self.cache = ttsdkzc_create(kCacheSize);
+    self.classFlags = ttsdkzc_createClassFlags(0x1000);
+}
+
+- (void)tearDown {
+    ttsdkzc_destroy(self.cache);
+    ttsdkzc_destroyClassFlags(self.classFlags);
+    [super tearDown];
+}
+
+/** Fraction of the most recently freed objects that a cache still knows about. */
+- (double)hitRateForRecent:(int)recentCount ofObjects:(const uintptr_t *)objects count:(int)count {
+    int hits = 0;
+    for (int i = count - recentCount; i < count; i++) {
+        if (ttsdkzc_className(self.cache, (const void *)objects[i]) != NULL) {
+            hits++;
+        }
+    }
+    return (double)hits / recentCount;
+}
+
+/** The same measurement for the old direct-mapped cache, which indexed by (address >> 7). */
+- (double)directMappedHitRateForRecent:(int)recentCount ofObjects:(const uintptr_t *)objects count:(int)count {
+    uintptr_t *table = calloc(kCacheSize, sizeof(uintptr_t));
+    for (int i = 0; i < count; i++) {
+        table[(objects[i] >> 7) & (kCacheSize - 1)] = objects[i];
+    }
+    int hits = 0;
+    for (int i = count - recentCount; i < count; i++) {
+        if (table[(objects[i] >> 7) & (kCacheSize - 1)] == objects[i]) {
+            hits++;
+        }
+    }
+    free(table);
+    return (double)hits / recentCount;
+}
+
+- (void)testPackedSmallObjectsAreFound {
+    // An allocator handing out consecutive 32-byte blocks: four of them share every 128 bytes.
+    const int count = kCacheSize / 4;
+    uintptr_t *objects = calloc(count, sizeof(uintptr_t));
+    for (int i = 0; i < count; i++) {
+        objects[i] = kHeapBase + (uintptr_t)i * 32;
+        ttsdkzc_add(self.cache, (const void *)objects[i], "NSObject");
+    }
+    double hitRate = [self hitRateForRecent:count ofObjects:objects count:count];
+    double directMappedHitRate = [self directMappedHitRateForRecent:count ofObjects:objects count:count];
+    XCTAssertGreaterThan(hitRate, 0.9);
+    XCTAssertLessThan(directMappedHitRate, 0.3);
+    free(objects);
+}
+
+- (void)testMixedSizeClassesAreFound {
+    srand(1);
+    const int count = kDeallocCount / 10;
+    const int recentCount = kCacheSize / 4;
+    uintptr_t *objects = calloc(count, sizeof(uintptr_t));
+    for (int i = 0; i < count; i++) {
+        uintptr_t sizeClass = 16 * (uintptr_t)(1 + rand() % 8);
+        objects[i] = kHeapBase + (uintptr_t)(rand() % 65536) * sizeClass;
+        ttsdkzc_add(self.cache, (const void *)objects[i], "NSObject");
+    }
+    double hitRate = [self hitRateForRecent:recentCount ofObjects:objects count:count];
+    double directMappedHitRate = [self directMappedHitRateForRecent:recentCount ofObjects:objects count:count];
+    XCTAssertGreaterThan(hitRate, directMappedHitRate);
+    XCTAssertGreaterThan(hitRate, 0.95);
+    free(objects);
+}
+
+- (void)testReusedAddressReportsLatestClass {
+    const void *object = (const void *)(kHeapBase + 0x40);
+    ttsdkzc_add(self.cache, object, "First");
+    ttsdkzc_add(self.cache, object, "Second");
+    XCTAssertEqual(strcmp(ttsdkzc_className(self.cache, object), "Second"), 0);
+    XCTAssertTrue(ttsdkzc_className(self.cache, (const void *)(kHeapBase + 0x80)) == NULL);
+}
+
+- (void)testLookedUpEntriesSurviveEviction {
+    // Find addresses that land in the same set as a victim, then keep touching the victim.
+    const void *victim = (const void *)kHeapBase;
+    ttsdkzc_add(self.cache, victim, "Victim");
+    for (int i = 1; i < kCacheSize * 8; i++) {
+        XCTAssertTrue(ttsdkzc_className(self.cache, victim) != NULL);
+        ttsdkzc_add(self.cache, (const void *)(kHeapBase + (uintptr_t)i * 16), "Other");
+    }
+    XCTAssertTrue(ttsdkzc_className(self.cache, victim) != NULL);
+}
+
+- (void)testClassFlags {
+    const void *exceptionClass = (const void *)0x100001000;
+    const void *otherClass = (const void *)0x100002000;
+    XCTAssertEqual(ttsdkzc_classFlag(self.classFlags, exceptionClass), TTSDKClassFlagUnknown);
+    ttsdkzc_setClassFlag(self.classFlags, exceptionClass, true);
+    ttsdkzc_setClassFlag(self.classFlags, otherClass, false);
+    XCTAssertEqual(ttsdkzc_classFlag(self.classFlags, exceptionClass), TTSDKClassFlagSet);
+    XCTAssertEqual(ttsdkzc_classFlag(self.classFlags, otherClass), TTSDKClassFlagClear);
+}
+
+- (void)testDeallocHookPerformance {
+    // What the dealloc hook does per object: record it, then consult the class bit.
+    const void *classes[64];
+    for (int i = 0; i < 64; i++) {
+        classes[i] = (const void *)(0x100000000 + (uintptr_t)i * 0x80);
+        ttsdkzc_setClassFlag(self.classFlags, classes[i], i == 0);
+    }
+    [self measureBlock:^{
+        for (int i = 0; i < kDeallocCount; i++) {
+            ttsdkzc_add(self.cache, (const void *)(kHeapBase + (uintptr_t)i * 48), "NSObject");
+            ttsdkzc_classFlag(self.classFlags, classes[i & 63]);
+        }
+    }];
+}
+
+@end
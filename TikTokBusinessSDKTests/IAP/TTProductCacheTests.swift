@@ -0,0 +1,62 @@
+//
+//  TTProductCacheTests.swift
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+
+import XCTest
+
+@testable import TikTokBusinessSDK
+
+@available(iOS 15.0, *)
+final class TTProductCacheTests: XCTestCase {
+
+    actor LoadRecorder {
+        var batches: [Set<String>] = []
+
+        func record(_ ids: Set<String>) {
+            batches.append(ids)
+        }
+    }
+
+    func makeCache(timeToLive: TimeInterval = 60, recorder: LoadRecorder) -> TTProductCache<String> {
+        return TTProductCache(timeToLive: timeToLive, batchWindow: 0.05) { ids in
+            await recorder.record(ids)
+            // a StoreKit round-trip
+            try? await Task.sleep(nanoseconds: 20_000_000)
+            return Dictionary(uniqueKeysWithValues: ids.filter { $0 != "unknown" }.map { ($0, "product:\($0)") })
+        }
+    }
+
+    func testConcurrentLookupsShareOneLoad() async {
+        let recorder = LoadRecorder()
+        let cache = makeCache(recorder: recorder)
+        async let first = cache.value(for: consumableProductId)
+        async let second = cache.value(for: consumableProductId)
+        async let third = cache.value(for: "subscription")
+        async let fourth = cache.value(for: "unknown")
+        let values = await [first, second, third, fourth]
+        XCTAssertEqual(values, ["product:\(consumableProductId)", "product:\(consumableProductId)", "product:subscription", nil])
+        let batches = await recorder.batches
+        XCTAssertEqual(batches, [[consumableProductId, "subscription", "unknown"]])
+    }
+
+    func testLoadedValuesAreCachedUntilTheyExpire() async {
+        let recorder = LoadRecorder()
+        var cache = makeCache(recorder: recorder)
+        _ = await cache.value(for: consumableProductId)
+        let cached = await cache.value(for: consumableProductId)
+        XCTAssertEqual(cached, "product:\(consumableProductId)")
+        _ = await cache.value(for: "unknown")
+        _ = await cache.value(for: "unknown")
+        var batches = await recorder.batches
+        XCTAssertEqual(batches, [[consumableProductId], ["unknown"], ["unknown"]])
+
+        cache = makeCache(timeToLive: 0, recorder: recorder)
+        _ = await cache.value(for: consumableProductId)
+        _ = await cache.value(for: consumableProductId)
+        batches = await recorder.batches
+        XCTAssertEqual(batches.count, 5)
+    }
+}
@@ -0,0 +1,103 @@
+//
+//  TikTokIAPTransactionLogTests.swift
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+
+import XCTest
+
+@testable import TikTokBusinessSDK
+
+@available(iOS 15.0, *)
+final class TikTokIAPTransactionLogTests: XCTestCase {
+
+    var directory: URL!
+
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    func key(_ index: Int) -> TTIAPTransactionLog.Key {
+        return .init(transactionId: String(2000000000 + index), productId: consumableProductId, eventName: "Purchase")
+    }
+
+    func testEntriesSurviveReopening() {
+        var log = TTIAPTransactionLog(directory: directory)
+        XCTAssertTrue(log.insert(key(1)))
+        XCTAssertFalse(log.insert(key(1)))
+        XCTAssertTrue(log.insert(key(2)))
+        XCTAssertFalse(log.contains(.init(transactionId: String(2000000001), productId: consumableProductId, eventName: "Subscribe")))
+
+        log = TTIAPTransactionLog(directory: directory)
+        XCTAssertEqual(log.count, 2)
+        XCTAssertTrue(log.contains(key(1)))
+        XCTAssertTrue(log.contains(key(2)))
+        XCTAssertFalse(log.needsCompaction)
+    }
+
+    func testEntriesExpireWithTheirSegment() {
+        let now = Date()
+        let log = TTIAPTransactionLog(directory: directory, now: now)
+        log.insert(key(1), date: now.addingTimeInterval(-40 * 24 * 60 * 60))
+        log.insert(key(2), date: now.addingTimeInterval(-10 * 24 * 60 * 60))
+        log.insert(key(3), date: now)
+        XCTAssertEqual(log.count, 2)
+        XCTAssertFalse(log.contains(key(1)))
+        XCTAssertEqual(log.segmentCount, 2)
+
+        let reopened = TTIAPTransactionLog(directory: directory, now: now.addingTimeInterval(25 * 24 * 60 * 60))
+        XCTAssertEqual(reopened.count, 1)
+        XCTAssertTrue(reopened.contains(key(3)))
+        XCTAssertEqual(try FileManager.default.contentsOfDirectory(atPath: directory.path).count, 1)
+    }
+
+    func testTornLineIsSkippedAndCompacted() throws {
+        var log = TTIAPTransactionLog(directory: directory)
+        log.insert(key(1))
+        log = TTIAPTransactionLog(directory: directory)
+
+        // a line cut off by a crash
+        let segment = directory.appendingPathComponent(try XCTUnwrap(FileManager.default.contentsOfDirectory(atPath: directory.path).first))
+        let handle = try FileHandle(forWritingTo: segment)
+        try handle.seekToEnd()
+        try handle.write(contentsOf: Data("2000000002\t\(consumableProductId)\tPur".utf8))
+        try handle.close()
+
+        log = TTIAPTransactionLog(directory: directory)
+        XCTAssertEqual(log.count, 1)
+        XCTAssertTrue(log.needsCompaction)
+        log.insert(key(3))
+        log.compact()
+        XCTAssertFalse(log.needsCompaction)
+
+        log = TTIAPTransactionLog(directory: directory)
+        XCTAssertEqual(log.count, 2)
+        XCTAssertTrue(log.contains(key(3)))
+        XCTAssertFalse(log.needsCompaction)
+    }
+
+    func testInsertLatencyAt10kEntries() {
+        measure {
+            try? FileManager.default.removeItem(at: directory)
+            let log = TTIAPTransactionLog(directory: directory)
+            for index in 0..<10_000 {
+                log.insert(key(index))
+            }
+        }
+    }
+
+    func testLookupLatencyAt10kEntries() {
+        let log = TTIAPTransactionLog(directory: directory)
+        log.insert((0..<10_000).map { (key($0), Date()) })
+        measure {
+            for index in 0..<20_000 {
+                _ = log.contains(key(index))
+            }
+        }
+    }
+}
@@ -71,6 +71,27 @@ final class TikTokIAPTransactionTests: XCTestCase {
         XCTAssertEqual(originalEventsCount + 1, eventsCount)
     }
 
+    func testPurchaseFromBothObserversIsPersistedOnce() async throws {
+        let exception = XCTestExpectation()
+        TikTokBusiness.getInstance().isRemoteSwitchOn = true
+        TikTokBusiness.getInstance().eventLogger = TikTokEventLogger.init(config: .init(accessToken: "tiktok", appId: "123456", tiktokAppId: "7890"))
+        let persistence = TikTokAppEventPersistence();
+        let originalEventsCount = persistence.eventsCount()
+
+        // The same transaction as TikTokPaymentObserver and TTStoreKitObserver report it
+        let transactionId = UUID().uuidString
+        let order = ["order_id": transactionId, "original_transaction_id": "", "order_time": "1760000000000"]
+        TikTokBusiness.trackTTEvent(.init(eventName: "Purchase", properties: ["order": order, "currency": "USD", "code": 1, "type": "auto", "value": "0.99"], eventId: ""))
+        TikTokBusiness.trackTTEvent(.init(eventName: "Purchase", properties: ["order": order, "currency": "USD", "code": 1, "type": "auto", "value": "0.99", "storekit_version": 1], eventId: ""))
+        Task.detached {
+            try await Task.sleep(nanoseconds: 2 * 1_000_000_000)
+            exception.fulfill()
+        }
+        await fulfillment(of: [exception], timeout: 5)
+        let eventsCount = persistence.eventsCount()
+        XCTAssertEqual(originalEventsCount + 1, eventsCount)
+    }
+
     func testPerformanceExample() throws {
         // This is an example of a performance test case.
         self.measure {
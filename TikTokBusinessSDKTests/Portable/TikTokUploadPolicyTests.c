@@ -0,0 +1,117 @@
+//
+//  TikTokUploadPolicyTests.c
+//  TikTokBusinessSDKTests
+//
+//  Created by TikTok on 2026/10/19.
+//  Copyright © 2026 TikTok. All rights reserved.
+//
+//  The upload policy is plain C, so it is also tested off Apple platforms. Not part of the
+//  Xcode test target; from the repository root:
+//
+//    cc -std=c11 -Wall -Wextra -pthread -ITikTokBusinessSDK/Core
+//       TikTokBusinessSDK/Core/TikTokUploadPolicy.c TikTokBusinessSDKTests/Portable/TikTokUploadPolicyTests.c
+//       -o TikTokUploadPolicyTests && ./TikTokUploadPolicyTests
+//
+
+#include "TikTokUploadPolicy.h"
+
+#include <stdio.h>
+
+static int failures = 0;
+
+#define EXPECT(condition)                                                   \
+    do {                                                                    \
+        if (!(condition)) {                                                 \
+            fprintf(stderr, "%s:%d: expected %s\n", __FILE__, __LINE__, #condition); \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+static void testFirstReport(void)
+{
+    TikTokUploadPolicy *policy = TikTokUploadPolicyCreate(2, 6);
+    // nothing reported yet
+    EXPECT(TikTokUploadPolicyGetReachability(policy) == TikTokUploadReachabilityUnknown);
+    EXPECT(TikTokUploadPolicyShouldUpload(policy));
+    // the first report at launch isn't a reconnect
+    EXPECT(!TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityReachable));
+    EXPECT(!TikTokUploadPolicyIsDraining(policy));
+    EXPECT(TikTokUploadPolicyMaxInFlight(policy) == 2);
+    TikTokUploadPolicyDestroy(policy);
+
+    // offline at launch holds uploads without starting a drain
+    policy = TikTokUploadPolicyCreate(2, 6);
+    EXPECT(!TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityUnreachable));
+    EXPECT(!TikTokUploadPolicyShouldUpload(policy));
+    EXPECT(!TikTokUploadPolicyIsDraining(policy));
+    TikTokUploadPolicyDestroy(policy);
+}
+
+static void testReconnect(void)
+{
+    TikTokUploadPolicy *policy = TikTokUploadPolicyCreate(2, 6);
+    TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityReachable);
+    EXPECT(!TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityUnreachable));
+    EXPECT(!TikTokUploadPolicyShouldUpload(policy));
+    EXPECT(TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityReachable));
+    EXPECT(TikTokUploadPolicyShouldUpload(policy));
+    EXPECT(TikTokUploadPolicyIsDraining(policy));
+    EXPECT(TikTokUploadPolicyMaxInFlight(policy) == 6);
+    // staying reachable isn't a reconnect
+    EXPECT(!TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityReachable));
+    TikTokUploadPolicyDestroy(policy);
+}
+
+static void testFlappingWhileDraining(void)
+{
+    TikTokUploadPolicy *policy = TikTokUploadPolicyCreate(2, 6);
+    TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityUnreachable);
+    EXPECT(TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityReachable));
+    // further reconnects while it runs don't start another drain
+    for (int i = 0; i < 3; i++) {
+        EXPECT(!TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityUnreachable));
+        EXPECT(!TikTokUploadPolicyShouldUpload(policy));
+        EXPECT(TikTokUploadPolicyIsDraining(policy));
+        EXPECT(!TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityReachable));
+        EXPECT(TikTokUploadPolicyShouldUpload(policy));
+    }
+    EXPECT(TikTokUploadPolicyMaxInFlight(policy) == 6);
+    TikTokUploadPolicyDestroy(policy);
+}
+
+static void testEndDrain(void)
+{
+    TikTokUploadPolicy *policy = TikTokUploadPolicyCreate(2, 6);
+    TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityUnreachable);
+    TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityReachable);
+    TikTokUploadPolicyEndDrain(policy);
+    EXPECT(!TikTokUploadPolicyIsDraining(policy));
+    EXPECT(TikTokUploadPolicyMaxInFlight(policy) == 2);
+    // the next reconnect drains again
+    TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityUnreachable);
+    EXPECT(TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityReachable));
+    TikTokUploadPolicyEndDrain(policy);
+    TikTokUploadPolicyDestroy(policy);
+
+    // the drain window is never narrower than the normal one
+    policy = TikTokUploadPolicyCreate(0, 0);
+    EXPECT(TikTokUploadPolicyMaxInFlight(policy) == 1);
+    TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityUnreachable);
+    TikTokUploadPolicySetReachability(policy, TikTokUploadReachabilityReachable);
+    EXPECT(TikTokUploadPolicyMaxInFlight(policy) == 1);
+    TikTokUploadPolicyDestroy(policy);
+}
+
+int main(void)
+{
+    testFirstReport();
+    testReconnect();
+    testFlappingWhileDraining();
+    testEndDrain();
+    if (failures > 0) {
+        fprintf(stderr, "%d expectation(s) failed\n", failures);
+        return 1;
+    }
+    printf("TikTokUploadPolicyTests passed\n");
+    return 0;
+}